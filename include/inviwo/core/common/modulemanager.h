@@ -43,6 +43,8 @@
 #include <set>
 #include <vector>
 #include <memory>
+#include <chrono>
+#include <utility>
 #include <warn/pop>
 
 namespace inviwo {
@@ -59,6 +61,7 @@ class SharedLibrary;
 class IVW_CORE_API ModuleManager {
 public:
     using IdSet = std::set<std::string, CaseInsensitiveCompare>;
+    using Timings = std::vector<std::pair<std::string, std::chrono::nanoseconds>>;
 
     ModuleManager(InviwoApplication* app);
     ModuleManager(const ModuleManager& rhs) = delete;
@@ -134,7 +137,15 @@ public:
     static std::function<bool(const std::string&)> getEnabledFilter();
     void reloadModules();
 
+    /**
+     * \brief Time spent in each step of the latest call to registerModules, in order of execution.
+     * The creation of each module is a separate step named after the module. The steps are also
+     * recorded as "startup" events by the Tracer when tracing is enabled.
+     */
+    const Timings& getRegistrationTimes() const;
+
 private:
+    void registerFactoryObjects(std::vector<std::unique_ptr<InviwoModuleFactoryObject>> mfo);
     void registerModule(std::unique_ptr<InviwoModule> module);
     bool checkDependencies(const InviwoModuleFactoryObject& obj) const;
     std::vector<std::string> deregisterDependetModules(
@@ -156,6 +167,7 @@ private:
     std::vector<std::unique_ptr<InviwoModuleFactoryObject>> factoryObjects_;
     std::vector<std::unique_ptr<InviwoModule>> modules_;
     util::OnScopeExit clearModules_;
+    Timings registrationTimes_;
 };
 
 template <class T>
@@ -0,0 +1,226 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace inviwo {
+
+namespace detail {
+
+inline int countTrailingZeros(std::uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * \ingroup datastructures
+ * \brief A compressed set of 32 bit unsigned integers, modeled after Roaring bitmaps.
+ *
+ * The values are split into blocks of 2^16 values by their upper 16 bits. A block stores the lower
+ * 16 bits of its values in a sorted array while it has at most 4096 values, and in a bitmap of 2^16
+ * bits otherwise. A block hence never needs more than 8 kB, and sparse sets need about two bytes
+ * per value. Union, intersection, and difference work block by block, on bitmaps 64 values at a
+ * time. Values are iterated in increasing order.
+ *
+ * The interface follows std::set where it makes sense, i.e. insert, erase, count, size, empty,
+ * begin and end, such that it can replace a std::unordered_set<size_t> of indices.
+ */
+class IVW_CORE_API BitSet {
+    struct Container;
+
+public:
+    using value_type = std::uint32_t;
+    using size_type = size_t;
+
+    class IVW_CORE_API const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::uint32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::uint32_t*;
+        using reference = std::uint32_t;
+
+        const_iterator() = default;
+
+        reference operator*() const { return value_; }
+        const_iterator& operator++();
+        const_iterator operator++(int);
+
+        friend bool operator==(const const_iterator& a, const const_iterator& b) {
+            return a.container_ == b.container_ && a.pos_ == b.pos_;
+        }
+        friend bool operator!=(const const_iterator& a, const const_iterator& b) {
+            return !(a == b);
+        }
+
+    private:
+        friend class BitSet;
+        const_iterator(const std::vector<Container>* containers, size_t container);
+        void seek();
+
+        const std::vector<Container>* containers_ = nullptr;
+        size_t container_ = 0;
+        size_t pos_ = 0;
+        std::uint32_t value_ = 0;
+    };
+    using iterator = const_iterator;
+
+    BitSet() = default;
+    BitSet(std::initializer_list<std::uint32_t> values);
+    /**
+     * Create a set from the values in [begin, end). The values are sorted first, hence the set is
+     * built in one pass regardless of the order of the values.
+     * @throw RangeException if a value does not fit in 32 bits
+     */
+    template <typename InputIt>
+    BitSet(InputIt begin, InputIt end);
+
+    bool empty() const;
+    size_t size() const;
+
+    bool contains(size_t value) const;
+    size_t count(size_t value) const;
+
+    /**
+     * Add value to the set. Adding values in increasing order is fast.
+     * @return true if the value was not already in the set
+     * @throw RangeException if value does not fit in 32 bits
+     */
+    bool insert(size_t value);
+    /**
+     * Add all values in [begin, end) to the set.
+     * @throw RangeException if end - 1 does not fit in 32 bits
+     */
+    void insertRange(size_t begin, size_t end);
+    /**
+     * Remove value from the set.
+     * @return the number of removed values, i.e. 0 or 1
+     */
+    size_t erase(size_t value);
+    void clear();
+
+    /**
+     * Union, add all values of rhs
+     */
+    BitSet& operator|=(const BitSet& rhs);
+    /**
+     * Intersection, only keep values that are also in rhs
+     */
+    BitSet& operator&=(const BitSet& rhs);
+    /**
+     * Difference, remove all values of rhs
+     */
+    BitSet& operator-=(const BitSet& rhs);
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /**
+     * Call f(value) for each value in increasing order, faster than using the iterators.
+     */
+    template <typename F>
+    void forEach(F&& f) const;
+
+    std::vector<std::uint32_t> toVector() const;
+
+    /**
+     * The number of bytes allocated by the set.
+     */
+    size_t sizeInBytes() const;
+
+    friend IVW_CORE_API bool operator==(const BitSet& a, const BitSet& b);
+    friend IVW_CORE_API bool operator!=(const BitSet& a, const BitSet& b);
+
+private:
+    struct Container {
+        std::uint16_t key = 0;
+        std::uint32_t cardinality = 0;
+        std::vector<std::uint16_t> array;   //!< sorted values, while cardinality <= 4096
+        std::vector<std::uint64_t> bitmap;  //!< 2^16 bits, while cardinality > 4096
+        bool isBitmap() const { return !bitmap.empty(); }
+    };
+
+    static std::uint32_t toValue(size_t value);
+    void assign(std::vector<std::uint32_t> values);
+
+    std::vector<Container> containers_;
+};
+
+IVW_CORE_API BitSet operator|(BitSet a, const BitSet& b);
+IVW_CORE_API BitSet operator&(BitSet a, const BitSet& b);
+IVW_CORE_API BitSet operator-(BitSet a, const BitSet& b);
+
+template <typename InputIt>
+BitSet::BitSet(InputIt begin, InputIt end) {
+    std::vector<std::uint32_t> values;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                    typename std::iterator_traits<InputIt>::iterator_category>) {
+        values.reserve(std::distance(begin, end));
+    }
+    for (; begin != end; ++begin) values.push_back(toValue(static_cast<size_t>(*begin)));
+    assign(std::move(values));
+}
+
+template <typename F>
+void BitSet::forEach(F&& f) const {
+    for (const auto& c : containers_) {
+        const auto high = static_cast<std::uint32_t>(c.key) << 16;
+        if (c.isBitmap()) {
+            for (size_t i = 0; i < c.bitmap.size(); ++i) {
+                for (auto word = c.bitmap[i]; word != 0; word &= word - 1) {
+                    f(high | static_cast<std::uint32_t>(i * 64 + detail::countTrailingZeros(word)));
+                }
+            }
+        } else {
+            for (auto low : c.array) f(high | low);
+        }
+    }
+}
+
+}  // namespace inviwo
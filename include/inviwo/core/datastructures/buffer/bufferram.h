@@ -77,6 +77,7 @@ public:
     virtual void setFromNormalizedDVec4(const size_t& pos, dvec4 val) = 0;
 
     virtual std::type_index getTypeIndex() const override final;
+    virtual size_t getMemoryUsage() const override;
 
     /**
      * Dispatch functionality to retrieve the actual underlaying BufferRamPrecision.
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/datastructures/copyonwrite.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/glm.h>
 
@@ -39,6 +40,12 @@ namespace inviwo {
 
 /**
  * \ingroup datastructures
+ * The data is shared between copies of the representation, and only duplicated when one of them
+ * is modified. A non-const function that hands out a pointer or reference to the data, like
+ * getData(), stops the sharing: the data is duplicated if it is shared, and later copies get
+ * their own data right away. Data passed in by pointer, or viewed from an external owner, is
+ * handed out from the start.
+ * @see CopyOnWrite
  */
 template <typename T, BufferTarget Target = BufferTarget::Data>
 class BufferRAMPrecision : public BufferRAM {
@@ -53,6 +60,8 @@ public:
     BufferRAMPrecision<T, Target>& operator=(const BufferRAMPrecision<T, Target>& that) = default;
     virtual ~BufferRAMPrecision() = default;
     virtual BufferRAMPrecision<T, Target>* clone() const override;
+    virtual bool sharesDataOnCopy() const override;
+    virtual std::weak_ptr<const void> getMemoryStorage() const override;
 
     virtual void setSize(size_t size) override;
     virtual size_t getSize() const override;
@@ -99,7 +108,7 @@ public:
     virtual void clear() override;
 
 private:
-    std::vector<T> data_;
+    CopyOnWrite<std::vector<T>> data_;
 };
 
 using FloatBufferRAM = BufferRAMPrecision<float>;
@@ -111,12 +120,12 @@ using IndexBufferRAM = BufferRAMPrecision<std::uint32_t, BufferTarget::Index>;
 
 template <typename T, BufferTarget Target>
 const T& inviwo::BufferRAMPrecision<T, Target>::operator[](size_t i) const {
-    return data_[i];
+    return data_.get()[i];
 }
 
 template <typename T, BufferTarget Target>
 T& inviwo::BufferRAMPrecision<T, Target>::operator[](size_t i) {
-    return data_[i];
+    return data_.expose()[i];
 }
 
 template <typename T, BufferTarget Target>
@@ -125,7 +134,7 @@ BufferRAMPrecision<T, Target>::BufferRAMPrecision(BufferUsage usage)
 
 template <typename T, BufferTarget Target>
 BufferRAMPrecision<T, Target>::BufferRAMPrecision(size_t size, BufferUsage usage)
-    : BufferRAM(DataFormat<T>::get(), usage, Target), data_(size) {}
+    : BufferRAM(DataFormat<T>::get(), usage, Target), data_(std::vector<T>(size)) {}
 
 template <typename T, BufferTarget Target>
 inviwo::BufferRAMPrecision<T, Target>::BufferRAMPrecision(std::vector<T> data, BufferUsage usage)
@@ -136,161 +145,180 @@ BufferRAMPrecision<T, Target>* BufferRAMPrecision<T, Target>::clone() const {
     return new BufferRAMPrecision<T, Target>(*this);
 }
 
+template <typename T, BufferTarget Target>
+bool BufferRAMPrecision<T, Target>::sharesDataOnCopy() const {
+    return !data_.isExposed();
+}
+
+template <typename T, BufferTarget Target>
+std::weak_ptr<const void> BufferRAMPrecision<T, Target>::getMemoryStorage() const {
+    return data_.storage();
+}
+
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setSize(size_t size) {
-    return data_.resize(size);
+    data_.edit().resize(size);
 }
 
 template <typename T, BufferTarget Target>
 size_t BufferRAMPrecision<T, Target>::getSize() const {
-    return data_.size();
+    return data_.get().size();
 }
 
 template <typename T, BufferTarget Target>
 void* BufferRAMPrecision<T, Target>::getData() {
-    return (data_.empty() ? nullptr : data_.data());
+    auto& data = data_.expose();
+    return (data.empty() ? nullptr : data.data());
 }
 
 template <typename T, BufferTarget Target>
 const void* BufferRAMPrecision<T, Target>::getData() const {
-    return (data_.empty() ? nullptr : data_.data());
+    const auto& data = data_.get();
+    return (data.empty() ? nullptr : data.data());
 }
 
 template <typename T, BufferTarget Target>
 std::vector<T>& inviwo::BufferRAMPrecision<T, Target>::getDataContainer() {
-    return data_;
+    return data_.expose();
 }
 
 template <typename T, BufferTarget Target>
 const std::vector<T>& BufferRAMPrecision<T, Target>::getDataContainer() const {
-    return data_;
+    return data_.get();
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::reserve(size_t size) {
-    data_.reserve(size);
+    data_.edit().reserve(size);
 }
 
 template <typename T, BufferTarget Target>
 double BufferRAMPrecision<T, Target>::getAsDouble(const size_t& pos) const {
-    return util::glm_convert<double>(data_[pos]);
+    return util::glm_convert<double>(data_.get()[pos]);
 }
 
 template <typename T, BufferTarget Target>
 dvec2 BufferRAMPrecision<T, Target>::getAsDVec2(const size_t& pos) const {
-    return util::glm_convert<dvec2>(data_[pos]);
+    return util::glm_convert<dvec2>(data_.get()[pos]);
 }
 
 template <typename T, BufferTarget Target>
 dvec3 BufferRAMPrecision<T, Target>::getAsDVec3(const size_t& pos) const {
-    return util::glm_convert<dvec3>(data_[pos]);
+    return util::glm_convert<dvec3>(data_.get()[pos]);
 }
 
 template <typename T, BufferTarget Target>
 dvec4 BufferRAMPrecision<T, Target>::getAsDVec4(const size_t& pos) const {
-    return util::glm_convert<dvec4>(data_[pos]);
+    return util::glm_convert<dvec4>(data_.get()[pos]);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setFromDouble(const size_t& pos, double val) {
-    data_[pos] = util::glm_convert<T>(val);
+    data_.edit()[pos] = util::glm_convert<T>(val);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setFromDVec2(const size_t& pos, dvec2 val) {
-    data_[pos] = util::glm_convert<T>(val);
+    data_.edit()[pos] = util::glm_convert<T>(val);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setFromDVec3(const size_t& pos, dvec3 val) {
-    data_[pos] = util::glm_convert<T>(val);
+    data_.edit()[pos] = util::glm_convert<T>(val);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setFromDVec4(const size_t& pos, dvec4 val) {
-    data_[pos] = util::glm_convert<T>(val);
+    data_.edit()[pos] = util::glm_convert<T>(val);
 }
 
 template <typename T, BufferTarget Target>
 double BufferRAMPrecision<T, Target>::getAsNormalizedDouble(const size_t& pos) const {
-    return util::glm_convert_normalized<double>(data_[pos]);
+    return util::glm_convert_normalized<double>(data_.get()[pos]);
 }
 
 template <typename T, BufferTarget Target>
 dvec2 BufferRAMPrecision<T, Target>::getAsNormalizedDVec2(const size_t& pos) const {
-    return util::glm_convert_normalized<dvec2>(data_[pos]);
+    return util::glm_convert_normalized<dvec2>(data_.get()[pos]);
 }
 
 template <typename T, BufferTarget Target>
 dvec3 BufferRAMPrecision<T, Target>::getAsNormalizedDVec3(const size_t& pos) const {
-    return util::glm_convert_normalized<dvec3>(data_[pos]);
+    return util::glm_convert_normalized<dvec3>(data_.get()[pos]);
 }
 
 template <typename T, BufferTarget Target>
 dvec4 BufferRAMPrecision<T, Target>::getAsNormalizedDVec4(const size_t& pos) const {
-    return util::glm_convert_normalized<dvec4>(data_[pos]);
+    return util::glm_convert_normalized<dvec4>(data_.get()[pos]);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setFromNormalizedDouble(const size_t& pos, double val) {
-    data_[pos] = util::glm_convert_normalized<T>(val);
+    data_.edit()[pos] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setFromNormalizedDVec2(const size_t& pos, dvec2 val) {
-    data_[pos] = util::glm_convert_normalized<T>(val);
+    data_.edit()[pos] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setFromNormalizedDVec3(const size_t& pos, dvec3 val) {
-    data_[pos] = util::glm_convert_normalized<T>(val);
+    data_.edit()[pos] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::setFromNormalizedDVec4(const size_t& pos, dvec4 val) {
-    data_[pos] = util::glm_convert_normalized<T>(val);
+    data_.edit()[pos] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::add(const T& item) {
-    data_.push_back(item);
+    data_.edit().push_back(item);
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::add(std::initializer_list<T> data) {
+    auto& dest = data_.edit();
     for (auto& elem : data) {
-        data_.push_back(elem);
+        dest.push_back(elem);
     }
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::append(const std::vector<T>* data) {
-    data_.insert(data_.end(), data->begin(), data->end());
+    auto& dest = data_.edit();
+    dest.insert(dest.end(), data->begin(), data->end());
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::append(const std::vector<T>& data) {
-    data_.insert(data_.end(), data.begin(), data.end());
+    auto& dest = data_.edit();
+    dest.insert(dest.end(), data.begin(), data.end());
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::set(size_t index, const T& item) {
-    data_[index] = item;
+    data_.edit()[index] = item;
 }
 
 template <typename T, BufferTarget Target>
 T BufferRAMPrecision<T, Target>::get(size_t index) const {
-    return data_[index];
+    return data_.get()[index];
 }
 
 template <typename T, BufferTarget Target>
 T& BufferRAMPrecision<T, Target>::get(size_t index) {
-    return data_[index];
+    return data_.expose()[index];
 }
 
 template <typename T, BufferTarget Target>
 void BufferRAMPrecision<T, Target>::clear() {
-    data_.clear();
+    if (data_.isShared()) {
+        data_ = CopyOnWrite<std::vector<T>>{};
+    } else {
+        data_.edit().clear();
+    }
 }
 
 }  // namespace inviwo
@@ -0,0 +1,230 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+
+namespace inviwo {
+
+/**
+ * \ingroup datastructures
+ * \brief A value that is shared between copies until one of them is modified
+ *
+ * Copying a CopyOnWrite only copies a reference to the value. The value is duplicated the first
+ * time one of the copies asks for write access using edit() while the value is shared. Reading
+ * through get() never copies. This is used by the RAM representations so that cloning a Volume,
+ * Layer or Buffer does not duplicate the data until it is actually edited.
+ *
+ * A reference from edit() must only be used until the CopyOnWrite is copied. A reference that is
+ * handed out, and might be kept, has to be taken with expose() instead. An exposed value is never
+ * shared again: copies made after expose() get their own copy of the value right away, such that
+ * writes through the kept reference never show up in them. Also, edit() and expose() of an
+ * exposed value do not need to check whether the value is shared.
+ *
+ * The reference count is thread safe, as for std::shared_ptr, so copies can be used from different
+ * threads. But edit() replaces the value of a shared CopyOnWrite, hence it must not be called
+ * concurrently with other functions of the same object. To write from several threads, call
+ * edit() once before and share the result. References returned by get() stay valid until the next
+ * call to edit() or until the CopyOnWrite is destroyed.
+ */
+template <typename T>
+class CopyOnWrite {
+public:
+    CopyOnWrite() : data_{std::make_shared<T>()} {}
+    explicit CopyOnWrite(T value) : data_{std::make_shared<T>(std::move(value))} {}
+    CopyOnWrite(const CopyOnWrite& rhs)
+        : data_{rhs.exposed_ ? std::make_shared<T>(*rhs.data_) : rhs.data_} {}
+    CopyOnWrite(CopyOnWrite&& rhs) noexcept = default;
+    CopyOnWrite& operator=(const CopyOnWrite& that) {
+        if (this != &that) *this = CopyOnWrite(that);
+        return *this;
+    }
+    CopyOnWrite& operator=(CopyOnWrite&& that) noexcept = default;
+
+    const T& get() const { return *data_; }
+    /**
+     * Write access to the value, makes a private copy of the value first if it is shared. The
+     * reference must not be used after the CopyOnWrite has been copied.
+     */
+    T& edit() {
+        if (isShared()) data_ = std::make_shared<T>(*data_);
+        return *data_;
+    }
+    /**
+     * Write access to the value for a reference that is handed out and might be kept. Makes a
+     * private copy of the value first if it is shared, and copies the value eagerly in all later
+     * copies of this CopyOnWrite.
+     */
+    T& expose() {
+        edit();
+        exposed_ = true;
+        return *data_;
+    }
+
+    /**
+     * True if the value is shared with another CopyOnWrite, i.e. if edit() would make a copy
+     */
+    bool isShared() const { return !exposed_ && data_.use_count() > 1; }
+    /**
+     * True if a reference to the value has been handed out using expose()
+     */
+    bool isExposed() const { return exposed_; }
+
+    /**
+     * Identifies the storage of the value, which is the same for all copies that share it
+     */
+    std::weak_ptr<const void> storage() const { return data_; }
+
+private:
+    std::shared_ptr<T> data_;
+    bool exposed_ = false;
+};
+
+/**
+ * \ingroup datastructures
+ * \brief A dynamically allocated array that is shared between copies until one of them is
+ * modified.
+ *
+ * The array either owns memory allocated with `new T[]`, or views external memory that is kept
+ * alive by a separate owner. The owner might write to the external memory, hence a view is always
+ * exposed: edit() writes directly to the external memory, and copies get their own array.
+ * @see CopyOnWrite
+ */
+template <typename T>
+class CopyOnWrite<T[]> {
+public:
+    CopyOnWrite() = default;
+    /**
+     * Take ownership of data, which has to be allocated with `new T[size]`. The caller still has
+     * a pointer to the data, hence the array is exposed.
+     */
+    CopyOnWrite(T* data, size_t size) : data_{data, Deleter{}}, size_{size}, exposed_{true} {}
+    /**
+     * Take ownership of newly allocated data that no one else has a pointer to
+     */
+    static CopyOnWrite allocate(size_t size) {
+        CopyOnWrite res{new T[size](), size};
+        res.exposed_ = false;
+        return res;
+    }
+    /**
+     * View data owned by dataOwner without copying it
+     */
+    CopyOnWrite(std::shared_ptr<void> dataOwner, T* data, size_t size)
+        : data_{std::move(dataOwner), data}, size_{size}, exposed_{true} {}
+    CopyOnWrite(const CopyOnWrite& rhs) : size_{rhs.size_} {
+        if (rhs.exposed_ && rhs.data_) {
+            data_ = std::shared_ptr<T>(new T[size_], Deleter{});
+            std::copy(rhs.data_.get(), rhs.data_.get() + size_, data_.get());
+        } else {
+            data_ = rhs.data_;
+        }
+    }
+    CopyOnWrite(CopyOnWrite&& rhs) noexcept = default;
+    CopyOnWrite& operator=(const CopyOnWrite& that) {
+        if (this != &that) *this = CopyOnWrite(that);
+        return *this;
+    }
+    CopyOnWrite& operator=(CopyOnWrite&& that) noexcept = default;
+
+    const T* get() const { return data_.get(); }
+    /**
+     * Write access to the array, makes a private copy of the array first if it is shared. The
+     * pointer must not be used after the CopyOnWrite has been copied.
+     */
+    T* edit() {
+        if (isShared()) {
+            auto copy = new T[size_];
+            std::copy(data_.get(), data_.get() + size_, copy);
+            data_ = std::shared_ptr<T>(copy, Deleter{});
+        }
+        return data_.get();
+    }
+    /**
+     * Write access to the array for a pointer that is handed out and might be kept. Makes a
+     * private copy of the array first if it is shared, and copies the array eagerly in all later
+     * copies of this CopyOnWrite.
+     */
+    T* expose() {
+        edit();
+        exposed_ = true;
+        return data_.get();
+    }
+
+    size_t size() const { return size_; }
+
+    /**
+     * True if the array is shared with another CopyOnWrite, i.e. if edit() would make a copy
+     */
+    bool isShared() const { return !exposed_ && data_.use_count() > 1; }
+    /**
+     * True if a pointer to the array has been handed out, or if it views external memory
+     */
+    bool isExposed() const { return exposed_; }
+
+    /**
+     * Identifies the storage of the array, which is the same for all copies that share it
+     */
+    std::weak_ptr<const void> storage() const { return data_; }
+
+    /**
+     * Stop deleting the array. The caller takes over the ownership of the memory returned by
+     * expose(). Throws an Exception if the array is shared with other copies or views external
+     * memory, since the memory can not be handed over then.
+     */
+    void release() {
+        auto deleter = std::get_deleter<Deleter>(data_);
+        if (!deleter || data_.use_count() > 1) {
+            throw Exception("Can not release memory that is shared or not owned",
+                            IVW_CONTEXT_CUSTOM("CopyOnWrite::release"));
+        }
+        deleter->owns = false;
+        exposed_ = true;
+    }
+
+private:
+    struct Deleter {
+        bool owns = true;
+        void operator()(T* ptr) const {
+            if (owns) delete[] ptr;
+        }
+    };
+
+    std::shared_ptr<T> data_;
+    size_t size_ = 0;
+    bool exposed_ = false;
+};
+
+}  // namespace inviwo
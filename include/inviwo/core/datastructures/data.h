@@ -33,11 +33,14 @@
 #include <inviwo/core/datastructures/representationfactory.h>
 #include <inviwo/core/datastructures/representationconverterfactory.h>
 #include <inviwo/core/datastructures/representationfactorymanager.h>
+#include <inviwo/core/resourcemanager/memorymanager.h>
 
+#include <algorithm>
 #include <typeindex>
 #include <mutex>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 namespace inviwo {
 
@@ -80,7 +83,17 @@ namespace inviwo {
  * 1 and 2 are needed to be a vaild member type of std::vector.
  * 3 is needed for the factory pattern, 3 should be implemented using 1.
  *
+ * A copy only gets one representation, a clone of a valid RAM representation if there is one,
+ * otherwise of the last valid representation. The RAM representations share their data with
+ * their clones until either of them is accessed through a non-const function, hence passing data
+ * through processors that only change, for example, the transformations or meta data does not
+ * copy the data.
  *
+ * The main memory used by the representations is reported to the MemoryManager. When the
+ * memory budget is exceeded the MemoryManager may remove the RAM representations of data that has
+ * a valid reloadable representation, like a VolumeDisk. They are recreated from the disk
+ * representation the next time they are requested. Representations held through
+ * getSharedRepresentation are never removed.
  *
  * @note Do not use the same representation in different Data objects.
  * This can cause inconsistencies since the Data objects cannot know if
@@ -94,7 +107,7 @@ public:
     using repr = Repr;
 
     virtual Data<Self, Repr>* clone() const = 0;
-    virtual ~Data() = default;
+    virtual ~Data();
 
     /**
      * Get a representation of type T. If there already is a valid representation of type T, just
@@ -106,6 +119,15 @@ public:
     template <typename T>
     const T* getRepresentation() const;
 
+    /**
+     * Get a representation of type T, like getRepresentation, and keep it alive while the
+     * returned pointer is held. The MemoryManager does not evict the representations of the data
+     * while it is held, hence use this for representations that are used outside of the network
+     * evaluation, like in samplers and background jobs.
+     */
+    template <typename T>
+    std::shared_ptr<const T> getSharedRepresentation() const;
+
     /**
      * Get an editable representation. This will invalidate all other representations.
      * They will now have to be updated from this one before use.
@@ -165,6 +187,12 @@ public:
      */
     void invalidateAllOther(const Repr* repr);
 
+    /**
+     * The number of bytes of main memory used by the representations.
+     * @see MemoryManager
+     */
+    size_t getMemoryUsage() const;
+
 protected:
     Data() = default;
     Data(const Data<Self, Repr>& rhs);
@@ -176,12 +204,30 @@ protected:
 
     std::shared_ptr<Repr> addRepresentationInternal(std::shared_ptr<Repr> representation) const;
 
+    /**
+     * Report the memory usage to the MemoryManager and mark the data as used.
+     * Has to be called with the mutex locked.
+     */
+    void updateMemoryUsage() const;
+    /**
+     * Remove the representations that use main memory if there is a valid reloadable
+     * representation. Called by the MemoryManager.
+     * @return the number of bytes freed
+     */
+    size_t evictReloadableRepresentations() const;
+
     mutable std::mutex mutex_;
     mutable std::unordered_map<std::type_index, std::shared_ptr<Repr>> representations_;
     // A pointer to the the most recently updated representation. Makes updates and creation faster.
     mutable std::shared_ptr<Repr> lastValidRepresentation_;
+    mutable std::shared_ptr<MemoryManager::Entry> memoryEntry_;
 };
 
+template <typename Self, typename Repr>
+Data<Self, Repr>::~Data() {
+    if (memoryEntry_) memoryEntry_->detach();
+}
+
 template <typename Self, typename Repr>
 Data<Self, Repr>::Data(const Data<Self, Repr>& rhs) : lastValidRepresentation_{nullptr} {
     rhs.copyRepresentationsTo(this);
@@ -198,6 +244,12 @@ Data<Self, Repr>& Data<Self, Repr>::operator=(const Data<Self, Repr>& that) {
 template <typename Self, typename Repr>
 template <typename T>
 const T* Data<Self, Repr>::getRepresentation() const {
+    return getSharedRepresentation<T>().get();
+}
+
+template <typename Self, typename Repr>
+template <typename T>
+std::shared_ptr<const T> Data<Self, Repr>::getSharedRepresentation() const {
     std::unique_lock<std::mutex> lock(mutex_);
     if (representations_.empty()) {
         lock.unlock();
@@ -209,13 +261,16 @@ const T* Data<Self, Repr>::getRepresentation() const {
         lastValidRepresentation_ = addRepresentationInternal(repr);
     }
 
+    const T* result = nullptr;
     auto it = representations_.find(std::type_index(typeid(T)));
     if (it != representations_.end() && it->second->isValid()) {
         lastValidRepresentation_ = it->second;
-        return dynamic_cast<const T*>(lastValidRepresentation_.get());
+        result = dynamic_cast<const T*>(lastValidRepresentation_.get());
     } else {
-        return getValidRepresentation<T>();
+        result = getValidRepresentation<T>();
     }
+    updateMemoryUsage();
+    return std::shared_ptr<const T>(lastValidRepresentation_, result);
 }
 
 template <typename Self, typename Repr>
@@ -278,14 +333,26 @@ template <typename Self, typename Repr>
 void Data<Self, Repr>::clearRepresentations() {
     std::unique_lock<std::mutex> lock(mutex_);
     representations_.clear();
+    updateMemoryUsage();
 }
 
 template <typename Self, typename Repr>
 void Data<Self, Repr>::copyRepresentationsTo(Data<Self, Repr>* targetData) const {
     targetData->clearRepresentations();
 
-    if (lastValidRepresentation_) {
-        auto rep = std::shared_ptr<Repr>(lastValidRepresentation_->clone());
+    std::shared_ptr<Repr> source;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        // Prefer a valid representation that shares its data with the copy, i.e. a RAM
+        // representation, over duplicating the last valid one.
+        auto it = std::find_if(representations_.begin(), representations_.end(), [](auto& elem) {
+            return elem.second->isValid() && elem.second->sharesDataOnCopy();
+        });
+        source = it != representations_.end() ? it->second : lastValidRepresentation_;
+    }
+
+    if (source) {
+        auto rep = std::shared_ptr<Repr>(source->clone());
         targetData->addRepresentation(rep);
     }
 }
@@ -303,6 +370,7 @@ template <typename Self, typename Repr>
 void Data<Self, Repr>::addRepresentation(std::shared_ptr<Repr> representation) {
     std::unique_lock<std::mutex> lock(mutex_);
     lastValidRepresentation_ = addRepresentationInternal(representation);
+    updateMemoryUsage();
 }
 
 template <typename Self, typename Repr>
@@ -325,6 +393,7 @@ void Data<Self, Repr>::removeRepresentation(const Repr* representation) {
             }
         }
     }
+    updateMemoryUsage();
 }
 
 template <typename Self, typename Repr>
@@ -346,6 +415,7 @@ void Data<Self, Repr>::removeOtherRepresentations(const Repr* representation) {
         }
     }
     std::swap(repr, representations_);
+    updateMemoryUsage();
 }
 
 template <typename Self, typename Repr>
@@ -354,4 +424,62 @@ bool Data<Self, Repr>::hasRepresentations() const {
     return !representations_.empty();
 }
 
+template <typename Self, typename Repr>
+size_t Data<Self, Repr>::getMemoryUsage() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    size_t bytes = 0;
+    for (auto& elem : representations_) bytes += elem.second->getMemoryUsage();
+    return bytes;
+}
+
+template <typename Self, typename Repr>
+void Data<Self, Repr>::updateMemoryUsage() const {
+    std::vector<MemoryManager::Usage> usages;
+    for (auto& elem : representations_) {
+        if (const auto bytes = elem.second->getMemoryUsage()) {
+            usages.push_back({elem.second->getMemoryStorage(), bytes});
+        }
+    }
+
+    if (!memoryEntry_) {
+        if (usages.empty() || !MemoryManager::isInitialized()) return;
+        memoryEntry_ = MemoryManager::getPtr()->track(
+            [this]() { return evictReloadableRepresentations(); });
+    }
+    memoryEntry_->setUsage(std::move(usages));
+    memoryEntry_->touch();
+}
+
+template <typename Self, typename Repr>
+size_t Data<Self, Repr>::evictReloadableRepresentations() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto source = std::find_if(representations_.begin(), representations_.end(), [](auto& elem) {
+        return elem.second->isValid() && elem.second->isReloadable();
+    });
+    if (source == representations_.end()) return 0;
+
+    // Representations held through getSharedRepresentation are in use, keep the data
+    const auto inUse = std::any_of(representations_.begin(), representations_.end(), [&](auto& e) {
+        const long owners = e.second == lastValidRepresentation_ ? 2 : 1;
+        return e.second->getMemoryUsage() > 0 && e.second.use_count() > owners;
+    });
+    if (inUse) return 0;
+
+    if (lastValidRepresentation_ && lastValidRepresentation_->getMemoryUsage() > 0) {
+        lastValidRepresentation_ = source->second;
+    }
+    size_t freed = 0;
+    for (auto it = representations_.begin(); it != representations_.end();) {
+        if (const auto bytes = it->second->getMemoryUsage()) {
+            freed += bytes;
+            it = representations_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    // Do not touch the entry here, evicted data should not count as used
+    if (memoryEntry_) memoryEntry_->setUsage(0);
+    return freed;
+}
+
 }  // namespace inviwo
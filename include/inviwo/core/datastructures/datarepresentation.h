@@ -31,6 +31,7 @@
 
 #include <inviwo/core/util/formats.h>
 #include <inviwo/core/util/exception.h>
+#include <memory>
 #include <typeindex>
 
 namespace inviwo {
@@ -60,6 +61,32 @@ public:
 
     virtual std::type_index getTypeIndex() const = 0;
 
+    /**
+     * True if clone() shares the data with this representation until one of them is edited,
+     * instead of copying it. Data will prefer to copy such representations.
+     */
+    virtual bool sharesDataOnCopy() const;
+
+    /**
+     * The number of bytes of main memory used by the data of the representation. Zero for
+     * representations that do not keep their data in main memory.
+     * @see MemoryManager
+     */
+    virtual size_t getMemoryUsage() const;
+
+    /**
+     * Identifies the memory reported by getMemoryUsage() if it is shared with other
+     * representations, such that the MemoryManager only counts it once. Empty if not shared.
+     */
+    virtual std::weak_ptr<const void> getMemoryStorage() const;
+
+    /**
+     * True if the other representations can be recreated from this one at any time, for example
+     * a disk representation with a loader. While such a representation is valid the
+     * MemoryManager may evict the representations that use main memory.
+     */
+    virtual bool isReloadable() const;
+
     void setOwner(const Owner* owner);
     const Owner* getOwner() const;
 
@@ -102,6 +129,26 @@ void DataRepresentation<Owner>::setDataFormat(const DataFormatBase* format) {
     dataFormatBase_ = format;
 }
 
+template <typename Owner>
+bool DataRepresentation<Owner>::sharesDataOnCopy() const {
+    return false;
+}
+
+template <typename Owner>
+size_t DataRepresentation<Owner>::getMemoryUsage() const {
+    return 0;
+}
+
+template <typename Owner>
+std::weak_ptr<const void> DataRepresentation<Owner>::getMemoryStorage() const {
+    return {};
+}
+
+template <typename Owner>
+bool DataRepresentation<Owner>::isReloadable() const {
+    return false;
+}
+
 template <typename Owner>
 void DataRepresentation<Owner>::setOwner(const Owner* owner) {
     owner_ = owner;
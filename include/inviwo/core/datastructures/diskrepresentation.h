@@ -60,6 +60,7 @@ public:
     bool hasSourceFile() const;
 
     void setLoader(DiskRepresentationLoader<Repr>* loader);
+    const DiskRepresentationLoader<Repr>* getLoader() const;
 
     std::shared_ptr<Repr> createRepresentation() const;
     void updateRepresentation(std::shared_ptr<Repr> dest) const;
@@ -96,6 +97,11 @@ void DiskRepresentation<Repr, Self>::setLoader(DiskRepresentationLoader<Repr>* l
     loader_.reset(loader);
 }
 
+template <typename Repr, typename Self>
+const DiskRepresentationLoader<Repr>* DiskRepresentation<Repr, Self>::getLoader() const {
+    return loader_.get();
+}
+
 template <typename Repr, typename Self>
 std::shared_ptr<Repr> DiskRepresentation<Repr, Self>::createRepresentation() const {
     if (!loader_) throw Exception("No loader available to create representation", IVW_CONTEXT);
@@ -197,6 +197,11 @@ public:
     const BufferVector& getBuffers() const;
     const IndexVector& getIndexBuffers() const;
 
+    /**
+     * The number of bytes of main memory used by the representations of all buffers.
+     */
+    size_t getMemoryUsage() const;
+
     const BufferBase* getBuffer(size_t idx) const;
 
     BufferInfo getBufferInfo(size_t idx) const;
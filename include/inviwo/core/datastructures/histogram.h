@@ -32,10 +32,17 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/util/glm.h>
 
+#include <algorithm>
+#include <array>
 #include <iterator>
+#include <limits>
+#include <type_traits>
 #include <vector>
 
 namespace inviwo {
+
+class HistogramContainer;
+
 enum class HistogramMode { Off, All, P99, P95, P90, Log };
 
 /**
@@ -73,9 +80,96 @@ protected:
     double maximumBinCount_;
 };
 
+/**
+ * Accumulates per channel histograms together with count, min, max, mean, and variance of
+ * the values. The moments are accumulated in blocks using a two pass scheme and combined with the
+ * pairwise update of Chan et al., which is numerically stable also for very large data sets.
+ * Accumulators of disjoint parts of the data can be combined using merge, hence they can be
+ * computed in parallel and combined in the end (see util::accumulateHistogram). Since the counts
+ * and moments are exact, the contribution of a part can also be removed using subtract to
+ * incrementally update the histogram of a region that has changed.
+ */
+class IVW_CORE_API HistogramAccumulator {
+public:
+    HistogramAccumulator() = default;
+    /**
+     * @param dataRange the values in dataRange are mapped linearly to the bins
+     * @param bins number of bins per channel
+     * @param channels number of components in the values
+     */
+    HistogramAccumulator(dvec2 dataRange, size_t bins, size_t channels);
+
+    /**
+     * Create an accumulator for values of type T. For integral types the number of bins is
+     * limited to the number of integers in dataRange.
+     */
+    template <typename T>
+    static HistogramAccumulator forType(dvec2 dataRange, size_t bins);
+
+    template <typename T>
+    void add(const T& value);
+
+    template <typename ForwardIt>
+    void add(ForwardIt begin, ForwardIt end);
+
+    /**
+     * Add the contribution of other. The two accumulators have to use the same range and bins.
+     */
+    void merge(const HistogramAccumulator& other);
+    /**
+     * Remove the contribution of other, that has been previously added or merged. Counts, mean,
+     * and variance are updated exactly, while min and max only can be kept as bounds.
+     */
+    void subtract(const HistogramAccumulator& other);
+
+    dvec2 getDataRange() const { return dataRange_; }
+    size_t getBins() const { return bins_; }
+    size_t getChannels() const { return channels_.size(); }
+    size_t getCount() const { return count_; }
+
+    const std::vector<double>& getCounts(size_t channel) const { return channels_[channel].bins; }
+    double getMin(size_t channel) const { return channels_[channel].min; }
+    double getMax(size_t channel) const { return channels_[channel].max; }
+    double getMean(size_t channel) const { return channels_[channel].mean; }
+    /**
+     * The sample variance
+     */
+    double getVariance(size_t channel) const;
+    double getStandardDeviation(size_t channel) const;
+
+    /**
+     * Create normalized histograms for each channel.
+     */
+    HistogramContainer getHistograms() const;
+
+private:
+    struct Channel {
+        std::vector<double> bins;
+        double min = std::numeric_limits<double>::max();
+        double max = std::numeric_limits<double>::lowest();
+        double mean = 0.0;
+        double m2 = 0.0;  //< sum of squared differences from the mean
+    };
+
+    template <typename T>
+    void addBlock(const T* values, size_t size);
+
+    // Add a set of values with the given count, mean and m2 to a channel.
+    static void combine(Channel& channel, size_t count, size_t otherCount, double mean, double m2);
+
+    static constexpr size_t blockSize = 1024;
+
+    dvec2 dataRange_{0.0, 0.0};
+    size_t bins_ = 0;
+    double scale_ = 0.0;
+    size_t count_ = 0;
+    std::vector<Channel> channels_;
+};
+
 class IVW_CORE_API HistogramContainer {
 public:
     HistogramContainer() = default;
+    explicit HistogramContainer(std::vector<NormalizedHistogram> histograms);
     template <typename FirstIter, typename LastIter>
     HistogramContainer(dvec2 range, size_t bins, FirstIter begin, LastIter end);
 
@@ -94,66 +188,105 @@ private:
     std::vector<NormalizedHistogram> histograms_;
 };
 
-template <typename FirstIter, typename LastIter>
-HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter begin,
-                                       LastIter end) {
-    using T = typename std::iterator_traits<FirstIter>::value_type;
-
-    // a double type with the same extent as T
-    using D = typename util::same_extent<T, double>::type;
-    // a size_t type with same extent as T
-    using I = typename util::same_extent<T, size_t>::type;
-
+template <typename T>
+HistogramAccumulator HistogramAccumulator::forType(dvec2 dataRange, size_t bins) {
     constexpr size_t extent = util::rank<T>::value > 0 ? util::extent<T>::value : 1;
-
     // check whether number of bins exceeds the data range only if it is an integral type
     if constexpr (!util::is_floating_point<typename util::value_type<T>::type>::value) {
         bins = std::min(bins, static_cast<std::size_t>(dataRange.y - dataRange.x + 1));
     }
+    return HistogramAccumulator(dataRange, bins, extent);
+}
 
-    std::array<std::vector<double>, extent> histData;
-    for (size_t i = 0; i < extent; ++i) {
-        histData[i].resize(bins, 0.0);
+template <typename T>
+void HistogramAccumulator::add(const T& value) {
+    ++count_;
+    const auto n = static_cast<double>(count_);
+    for (size_t i = 0; i < channels_.size(); ++i) {
+        auto& channel = channels_[i];
+        const auto val = static_cast<double>(util::glmcomp(value, i));
+        channel.min = std::min(channel.min, val);
+        channel.max = std::max(channel.max, val);
+        const auto delta = val - channel.mean;
+        channel.mean += delta / n;
+        channel.m2 += delta * (val - channel.mean);
+
+        const auto bin = (val - dataRange_.x) * scale_;
+        if (bin > -1.0 && bin < static_cast<double>(bins_)) {
+            channel.bins[static_cast<size_t>(bin)]++;
+        }
     }
+}
 
+template <typename ForwardIt>
+void HistogramAccumulator::add(ForwardIt begin, ForwardIt end) {
+    using T = typename std::iterator_traits<ForwardIt>::value_type;
+    if constexpr (std::is_pointer_v<ForwardIt>) {
+        const auto size = static_cast<size_t>(std::distance(begin, end));
+        for (size_t offset = 0; offset < size; offset += blockSize) {
+            addBlock<T>(begin + offset, std::min(blockSize, size - offset));
+        }
+    } else {
+        std::array<T, blockSize> block;
+        while (begin != end) {
+            size_t size = 0;
+            for (; size < blockSize && begin != end; ++size, ++begin) block[size] = *begin;
+            addBlock<T>(block.data(), size);
+        }
+    }
+}
+
+template <typename T>
+void HistogramAccumulator::addBlock(const T* values, size_t size) {
+    if (size == 0) return;
+    // a double type with the same extent as T
+    using D = typename util::same_extent<T, double>::type;
+    constexpr size_t extent = util::rank<T>::value > 0 ? util::extent<T>::value : 1;
+
+    // First pass: min, max, sum, and binning, second pass: squared differences from the block
+    // mean. The block will still be in the cache for the second pass.
     D min(std::numeric_limits<double>::max());
     D max(std::numeric_limits<double>::lowest());
     D sum(0);
-    D sum2(0);
-    size_t count(0);
-
-    const D rangeMin(dataRange.x);
-    const D rangeScaleFactor(static_cast<double>(bins - 1) / (dataRange.y - dataRange.x));
-
-    for (; begin != end; ++begin) {
-
-        const auto val = static_cast<D>(*begin);
-
+    for (size_t j = 0; j < size; ++j) {
+        const auto val = static_cast<D>(values[j]);
         min = glm::min(min, val);
         max = glm::max(max, val);
         sum += val;
-        sum2 += val * val;
-        count++;
-
-        const auto ind = static_cast<I>((val - rangeMin) * rangeScaleFactor);
-
         for (size_t i = 0; i < extent; ++i) {
-            const auto v = util::glmcomp(ind, i);
-            if (v < bins) {
-                histData[i][v]++;
+            const auto bin = (util::glmcomp(val, i) - dataRange_.x) * scale_;
+            if (bin > -1.0 && bin < static_cast<double>(bins_)) {
+                channels_[i].bins[static_cast<size_t>(bin)]++;
             }
         }
     }
-
-    const auto dcount = static_cast<double>(count);
-    const auto mean = sum / dcount;
-    const auto stddev = glm::sqrt((dcount * sum2 - sum * sum) / (dcount * (dcount - D{1})));
+    const D mean = sum / static_cast<double>(size);
+    D m2(0);
+    for (size_t j = 0; j < size; ++j) {
+        const auto delta = static_cast<D>(values[j]) - mean;
+        m2 += delta * delta;
+    }
 
     for (size_t i = 0; i < extent; ++i) {
-        histograms_.emplace_back(dataRange, std::move(histData[i]), util::glmcomp(min, i),
-                                 util::glmcomp(max, i), util::glmcomp(mean, i),
-                                 util::glmcomp(stddev, i));
+        auto& channel = channels_[i];
+        channel.min = std::min(channel.min, util::glmcomp(min, i));
+        channel.max = std::max(channel.max, util::glmcomp(max, i));
+        combine(channel, count_, size, util::glmcomp(mean, i), util::glmcomp(m2, i));
+    }
+    count_ += size;
+}
+
+template <typename FirstIter, typename LastIter>
+HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter begin,
+                                       LastIter end) {
+    using T = typename std::iterator_traits<FirstIter>::value_type;
+    auto accumulator = HistogramAccumulator::forType<T>(dataRange, bins);
+    if constexpr (std::is_same_v<FirstIter, LastIter>) {
+        accumulator.add(begin, end);
+    } else {
+        for (; begin != end; ++begin) accumulator.add(*begin);
     }
+    *this = accumulator.getHistograms();
 }
 
 }  // namespace inviwo
@@ -35,6 +35,8 @@
 #include <inviwo/core/datastructures/volume/volumeram.h>
 
 #include <atomic>
+#include <functional>
+#include <future>
 #include <memory>
 #include <vector>
 
@@ -61,9 +63,11 @@ public:
 
 private:
     std::weak_ptr<HistogramContainer> container_;
+    std::shared_ptr<HistogramAccumulator> accumulator_;
     Dispatcher<void(const HistogramContainer&)> callbacks_;
     std::vector<std::shared_ptr<std::function<void(const HistogramContainer&)>>> callbackHandles_;
     std::shared_ptr<std::atomic<bool>> stop_;
+    std::future<void> job_;
     bool done = false;
 
     size_t bins_;
@@ -88,12 +92,47 @@ protected:
     std::shared_ptr<HistogramCalculationState> startCalculation(
         std::shared_ptr<const VolumeRAM> volumeRam, dvec2 dataRange, size_t bins) const;
 
+    /**
+     * Modify the values in the region [offset, offset + dims) of volumeRam using edit. If the
+     * histograms have been calculated they are updated by only re-binning the region. A
+     * calculation that has not finished yet is cancelled and discarded instead, since it might
+     * have seen the old values.
+     */
+    void editRegion(VolumeRAM& volumeRam, size3_t offset, size3_t dims,
+                    const std::function<void(VolumeRAM&)>& edit) const;
+
 private:
     static void done(std::shared_ptr<HistogramCalculationState> state,
+                     std::shared_ptr<HistogramAccumulator> accumulator,
                      HistogramContainer histograms);
 
     mutable std::shared_ptr<HistogramCalculationState> calculation_;
     mutable std::shared_ptr<HistogramContainer> histograms_;
 };
 
+namespace util {
+
+/**
+ * Accumulate the histograms and statistics of all values in volume. The volume is split into
+ * chunks that are processed in parallel using util::parallelReduce.
+ * @param volume the data to use
+ * @param dataRange the range mapped to the bins
+ * @param bins the number of bins per channel
+ * @param stop optional flag to cancel the calculation, the result is incomplete if it was set.
+ */
+IVW_CORE_API HistogramAccumulator accumulateHistogram(const VolumeRAM& volume, dvec2 dataRange,
+                                                      size_t bins,
+                                                      const std::atomic<bool>* stop = nullptr);
+
+/**
+ * Accumulate the histograms and statistics of the values in the region [offset, offset + dims) of
+ * volume in parallel.
+ * @see accumulateHistogram(const VolumeRAM&, dvec2, size_t, const std::atomic<bool>*)
+ */
+IVW_CORE_API HistogramAccumulator accumulateHistogram(const VolumeRAM& volume, dvec2 dataRange,
+                                                      size_t bins, size3_t offset, size3_t dims,
+                                                      const std::atomic<bool>* stop = nullptr);
+
+}  // namespace util
+
 }  // namespace inviwo
@@ -73,6 +73,11 @@ public:
 
     size2_t getDimensions() const;
 
+    /**
+     * The number of bytes of main memory used by the representations of all the layers.
+     */
+    size_t getMemoryUsage() const;
+
     /**
      * Resize all representation to dimension. This is destructive, the data will not be
      * preserved. Use copyRepresentationsTo to update the data.
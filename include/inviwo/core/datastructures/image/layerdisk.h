@@ -71,6 +71,7 @@ public:
      */
     void updateDataFormat(const DataFormatBase* format);
     virtual std::type_index getTypeIndex() const override final;
+    virtual bool isReloadable() const override;
 
     /**
      * \brief update the swizzle mask of the channels for sampling color layers
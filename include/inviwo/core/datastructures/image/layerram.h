@@ -85,6 +85,7 @@ public:
     static size_t posToIndex(const size2_t& pos, const size2_t& dim);
 
     virtual std::type_index getTypeIndex() const override final;
+    virtual size_t getMemoryUsage() const override;
 
     /**
      * Dispatch functionality to retrieve the actual underlaying LayerRamPrecision.
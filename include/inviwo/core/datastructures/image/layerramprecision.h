@@ -30,6 +30,7 @@
 #pragma once
 
 #include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/datastructures/copyonwrite.h>
 
 #include <algorithm>
 
@@ -37,6 +38,12 @@ namespace inviwo {
 
 /**
  * \ingroup datastructures
+ * The data is shared between copies of the representation, and only duplicated when one of them
+ * is modified. A non-const function that hands out a pointer or reference to the data, like
+ * getData(), stops the sharing: the data is duplicated if it is shared, and later copies get
+ * their own data right away. Data passed in by pointer, or viewed from an external owner, is
+ * handed out from the start.
+ * @see CopyOnWrite
  */
 template <typename T>
 class LayerRAMPrecision : public LayerRAM {
@@ -52,10 +59,21 @@ public:
                       const SwizzleMask& swizzleMask = swizzlemasks::rgba,
                       InterpolationType interpolation = InterpolationType::Linear,
                       const Wrapping2D& wrap = wrapping2d::clampAll);
+    /**
+     * Create a layer viewing external data without copying it, i.e. a NumPy array. The layer does
+     * not take ownership of data but keeps dataOwner alive as long as data is used.
+     */
+    LayerRAMPrecision(std::shared_ptr<void> dataOwner, T* data, size2_t dimensions,
+                      LayerType type = LayerType::Color,
+                      const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                      InterpolationType interpolation = InterpolationType::Linear,
+                      const Wrapping2D& wrap = wrapping2d::clampAll);
     LayerRAMPrecision(const LayerRAMPrecision<T>& rhs);
     LayerRAMPrecision<T>& operator=(const LayerRAMPrecision<T>& that);
     virtual LayerRAMPrecision<T>* clone() const override;
-    virtual ~LayerRAMPrecision() = default;
+    virtual bool sharesDataOnCopy() const override;
+    virtual std::weak_ptr<const void> getMemoryStorage() const override;
+    virtual ~LayerRAMPrecision();
 
     T* getDataTyped();
     const T* getDataTyped() const;
@@ -102,7 +120,7 @@ public:
 
 private:
     size2_t dimensions_;
-    std::unique_ptr<T[]> data_;
+    CopyOnWrite<T[]> data_;
     SwizzleMask swizzleMask_;
     InterpolationType interpolation_;
     Wrapping2D wrapping_;
@@ -126,17 +144,30 @@ IVW_CORE_API std::shared_ptr<LayerRAM> createLayerRAM(
     InterpolationType interpolation = InterpolationType::Linear,
     const Wrapping2D& wrapping = wrapping2d::clampAll);
 
+/**
+ * Factory for layers viewing external data.
+ * Creates an LayerRAM with data type specified by format, that uses dataPtr without copying or
+ * taking ownership of it. dataOwner is kept alive as long as the layer uses dataPtr.
+ * @see createLayerRAM(const size2_t&, LayerType, const DataFormatBase*, const SwizzleMask&,
+ * InterpolationType, const Wrapping2D&)
+ */
+IVW_CORE_API std::shared_ptr<LayerRAM> createLayerRAM(
+    const size2_t& dimensions, LayerType type, const DataFormatBase* format, void* dataPtr,
+    std::shared_ptr<void> dataOwner, const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+    InterpolationType interpolation = InterpolationType::Linear,
+    const Wrapping2D& wrapping = wrapping2d::clampAll);
+
 template <typename T>
 LayerRAMPrecision<T>::LayerRAMPrecision(size2_t dimensions, LayerType type,
                                         const SwizzleMask& swizzleMask,
                                         InterpolationType interpolation, const Wrapping2D& wrapping)
     : LayerRAM(type, DataFormat<T>::get())
     , dimensions_(dimensions)
-    , data_(new T[dimensions_.x * dimensions_.y]())
+    , data_(CopyOnWrite<T[]>::allocate(glm::compMul(dimensions_)))
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
     , wrapping_{wrapping} {
-    std::fill(data_.get(), data_.get() + glm::compMul(dimensions_),
+    std::fill(data_.edit(), data_.edit() + glm::compMul(dimensions_),
               (type == LayerType::Depth) ? T{1} : T{0});
 }
 
@@ -146,53 +177,56 @@ LayerRAMPrecision<T>::LayerRAMPrecision(T* data, size2_t dimensions, LayerType t
                                         InterpolationType interpolation, const Wrapping2D& wrapping)
     : LayerRAM(type, DataFormat<T>::get())
     , dimensions_(dimensions)
-    , data_(data ? data : new T[dimensions_.x * dimensions_.y]())
+    , data_(data ? CopyOnWrite<T[]>(data, glm::compMul(dimensions_))
+                 : CopyOnWrite<T[]>::allocate(glm::compMul(dimensions_)))
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
     , wrapping_{wrapping} {
     if (!data) {
-        std::fill(data_.get(), data_.get() + glm::compMul(dimensions_),
+        std::fill(data_.edit(), data_.edit() + glm::compMul(dimensions_),
                   (type == LayerType::Depth) ? T{1} : T{0});
     }
 }
 
 template <typename T>
-LayerRAMPrecision<T>::LayerRAMPrecision(const LayerRAMPrecision<T>& rhs)
-    : LayerRAM(rhs)
-    , dimensions_(rhs.dimensions_)
-    , data_(new T[dimensions_.x * dimensions_.y])
-    , swizzleMask_(rhs.swizzleMask_)
-    , interpolation_{rhs.interpolation_}
-    , wrapping_{rhs.wrapping_} {
-    std::memcpy(data_.get(), rhs.data_.get(), dimensions_.x * dimensions_.y * sizeof(T));
-}
+LayerRAMPrecision<T>::LayerRAMPrecision(std::shared_ptr<void> dataOwner, T* data,
+                                        size2_t dimensions, LayerType type,
+                                        const SwizzleMask& swizzleMask,
+                                        InterpolationType interpolation, const Wrapping2D& wrapping)
+    : LayerRAM(type, DataFormat<T>::get())
+    , dimensions_(dimensions)
+    , data_(std::move(dataOwner), data, glm::compMul(dimensions_))
+    , swizzleMask_(swizzleMask)
+    , interpolation_{interpolation}
+    , wrapping_{wrapping} {}
 
 template <typename T>
-LayerRAMPrecision<T>& LayerRAMPrecision<T>::operator=(const LayerRAMPrecision<T>& that) {
-    if (this != &that) {
-        LayerRAM::operator=(that);
+LayerRAMPrecision<T>::LayerRAMPrecision(const LayerRAMPrecision<T>& rhs) = default;
 
-        const auto dim = that.dimensions_;
-        auto data = std::make_unique<T[]>(dim.x * dim.y);
-        std::memcpy(data.get(), that.data_.get(), dim.x * dim.y * sizeof(T));
-        data_.swap(data);
+template <typename T>
+LayerRAMPrecision<T>& LayerRAMPrecision<T>::operator=(const LayerRAMPrecision<T>& that) = default;
 
-        dimensions_ = that.dimensions_;
-        swizzleMask_ = that.swizzleMask_;
-        interpolation_ = that.interpolation_;
-        wrapping_ = that.wrapping_;
-    }
-    return *this;
-}
+template <typename T>
+LayerRAMPrecision<T>::~LayerRAMPrecision() = default;
 
 template <typename T>
 LayerRAMPrecision<T>* LayerRAMPrecision<T>::clone() const {
     return new LayerRAMPrecision<T>(*this);
 }
 
+template <typename T>
+bool LayerRAMPrecision<T>::sharesDataOnCopy() const {
+    return !data_.isExposed();
+}
+
+template <typename T>
+std::weak_ptr<const void> LayerRAMPrecision<T>::getMemoryStorage() const {
+    return data_.storage();
+}
+
 template <typename T>
 T* inviwo::LayerRAMPrecision<T>::getDataTyped() {
-    return data_.get();
+    return data_.expose();
 }
 
 template <typename T>
@@ -202,26 +236,25 @@ const T* inviwo::LayerRAMPrecision<T>::getDataTyped() const {
 
 template <typename T>
 void* LayerRAMPrecision<T>::getData() {
-    return data_.get();
+    return data_.expose();
 }
+
 template <typename T>
 const void* LayerRAMPrecision<T>::getData() const {
-    return const_cast<const T*>(data_.get());
+    return data_.get();
 }
 
 template <typename T>
 void inviwo::LayerRAMPrecision<T>::setData(void* d, size2_t dimensions) {
-    std::unique_ptr<T[]> data(static_cast<T*>(d));
-    data_.swap(data);
-    std::swap(dimensions_, dimensions);
+    data_ = CopyOnWrite<T[]>(static_cast<T*>(d), glm::compMul(dimensions));
+    dimensions_ = dimensions;
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setDimensions(size2_t dimensions) {
     if (dimensions != dimensions_) {
-        auto data = std::make_unique<T[]>(dimensions.x * dimensions.y);
-        data_.swap(data);
-        std::swap(dimensions, dimensions_);
+        data_ = CopyOnWrite<T[]>::allocate(glm::compMul(dimensions));
+        dimensions_ = dimensions;
     }
 }
 
@@ -262,82 +295,82 @@ Wrapping2D LayerRAMPrecision<T>::getWrapping() const {
 
 template <typename T>
 double LayerRAMPrecision<T>::getAsDouble(const size2_t& pos) const {
-    return util::glm_convert<double>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert<double>(data_.get()[posToIndex(pos, dimensions_)]);
 }
 
 template <typename T>
 dvec2 LayerRAMPrecision<T>::getAsDVec2(const size2_t& pos) const {
-    return util::glm_convert<dvec2>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert<dvec2>(data_.get()[posToIndex(pos, dimensions_)]);
 }
 
 template <typename T>
 dvec3 LayerRAMPrecision<T>::getAsDVec3(const size2_t& pos) const {
-    return util::glm_convert<dvec3>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert<dvec3>(data_.get()[posToIndex(pos, dimensions_)]);
 }
 
 template <typename T>
 dvec4 LayerRAMPrecision<T>::getAsDVec4(const size2_t& pos) const {
-    return util::glm_convert<dvec4>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert<dvec4>(data_.get()[posToIndex(pos, dimensions_)]);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDouble(const size2_t& pos, double val) {
-    data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
+    data_.edit()[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDVec2(const size2_t& pos, dvec2 val) {
-    data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
+    data_.edit()[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDVec3(const size2_t& pos, dvec3 val) {
-    data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
+    data_.edit()[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDVec4(const size2_t& pos, dvec4 val) {
-    data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
+    data_.edit()[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 double LayerRAMPrecision<T>::getAsNormalizedDouble(const size2_t& pos) const {
-    return util::glm_convert_normalized<double>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert_normalized<double>(data_.get()[posToIndex(pos, dimensions_)]);
 }
 
 template <typename T>
 dvec2 LayerRAMPrecision<T>::getAsNormalizedDVec2(const size2_t& pos) const {
-    return util::glm_convert_normalized<dvec2>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert_normalized<dvec2>(data_.get()[posToIndex(pos, dimensions_)]);
 }
 
 template <typename T>
 dvec3 LayerRAMPrecision<T>::getAsNormalizedDVec3(const size2_t& pos) const {
-    return util::glm_convert_normalized<dvec3>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert_normalized<dvec3>(data_.get()[posToIndex(pos, dimensions_)]);
 }
 
 template <typename T>
 dvec4 LayerRAMPrecision<T>::getAsNormalizedDVec4(const size2_t& pos) const {
-    return util::glm_convert_normalized<dvec4>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert_normalized<dvec4>(data_.get()[posToIndex(pos, dimensions_)]);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDouble(const size2_t& pos, double val) {
-    data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
+    data_.edit()[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDVec2(const size2_t& pos, dvec2 val) {
-    data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
+    data_.edit()[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDVec3(const size2_t& pos, dvec3 val) {
-    data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
+    data_.edit()[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDVec4(const size2_t& pos, dvec4 val) {
-    data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
+    data_.edit()[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 }  // namespace inviwo
@@ -39,6 +39,7 @@ namespace kind {
 struct Base {};
 struct Disk {};
 struct RAM {};
+struct Bricked {};
 }  // namespace kind
 
 template <typename DataType, typename Kind>
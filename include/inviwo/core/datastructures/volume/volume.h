@@ -156,6 +156,13 @@ public:
 
     std::shared_ptr<HistogramCalculationState> calculateHistograms(size_t bins = 2048) const;
 
+    /**
+     * Modify the values in the region [offset, offset + dims) by calling edit with the editable
+     * VolumeRAM representation. Calculated histograms are updated by only re-binning the region.
+     * @see HistogramSupplier::editRegion
+     */
+    void editRegion(size3_t offset, size3_t dims, const std::function<void(VolumeRAM&)>& edit);
+
 protected:
     size3_t defaultDimensions_;
     const DataFormatBase* defaultDataFormat_;
@@ -0,0 +1,126 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/stdextensions.h>
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+/**
+ * \ingroup datastructures
+ * A thread safe least recently used cache of volume bricks, used by VolumeBricked. The cache is
+ * bounded by the total number of bytes of the cached bricks. When a new brick is added the least
+ * recently used bricks are evicted until the size is within the capacity again. Bricks that are
+ * still used somewhere are kept alive by their shared pointers, the cache only drops its own
+ * reference.
+ *
+ * Bricks are identified by a source id, given by newSourceId(), and a brick index within that
+ * source. If several threads ask for the same brick at the same time it is only loaded once.
+ */
+class IVW_CORE_API VolumeBrickCache {
+public:
+    /**
+     * @param capacity maximum number of bytes to keep in the cache
+     */
+    explicit VolumeBrickCache(size_t capacity);
+    VolumeBrickCache(const VolumeBrickCache&) = delete;
+    VolumeBrickCache& operator=(const VolumeBrickCache&) = delete;
+    ~VolumeBrickCache();
+
+    /**
+     * The cache used by VolumeBricked by default, with a capacity of 2 GB.
+     */
+    static std::shared_ptr<VolumeBrickCache> getDefault();
+
+    /**
+     * A new unique source id.
+     */
+    size_t newSourceId();
+
+    /**
+     * Get brick from source. If the brick is not in the cache it is loaded by calling load in the
+     * calling thread. Exceptions thrown by load are propagated to all threads waiting for the
+     * brick and the brick is not cached. Neither is a brick for which load returns nullptr.
+     */
+    std::shared_ptr<const VolumeRAM> get(size_t source, size_t brick,
+                                         const std::function<std::shared_ptr<VolumeRAM>()>& load);
+
+    /**
+     * Remove all bricks of source
+     */
+    void erase(size_t source);
+    void clear();
+
+    /**
+     * Set the capacity in bytes, evicting bricks if needed.
+     */
+    void setCapacity(size_t capacity);
+    size_t getCapacity() const;
+    /**
+     * The number of bytes of the cached bricks
+     */
+    size_t getSize() const;
+    /**
+     * The number of cached bricks
+     */
+    size_t getNumberOfBricks() const;
+
+private:
+    using Key = std::pair<size_t, size_t>;
+    struct Entry {
+        Key key;
+        std::shared_future<std::shared_ptr<const VolumeRAM>> brick;
+        size_t bytes;  //< Zero while loading
+        size_t load;   //< Identifies the call to get that loads the brick
+    };
+    void evict();
+
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;  //< Most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator> lookup_;
+    size_t capacity_;
+    size_t size_;
+    size_t sourceId_;
+    size_t loadId_;
+};
+
+}  // namespace inviwo
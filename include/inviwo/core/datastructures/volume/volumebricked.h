@@ -0,0 +1,233 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/datastructures/volume/volumerepresentation.h>
+#include <inviwo/core/datastructures/volume/volumebrickcache.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/util/brickiterator.h>
+#include <inviwo/core/util/glm.h>
+
+#include <memory>
+
+namespace inviwo {
+
+class Volume;
+class VolumeRegionLoader;
+
+/**
+ * \ingroup datastructures
+ * A read only, out-of-core volume representation. The volume is split into bricks that are loaded
+ * on demand using a VolumeRegionLoader and kept in a bounded VolumeBrickCache, hence only the
+ * bricks that are accessed are ever loaded and the memory used is bounded by the capacity of the
+ * cache, no matter the size of the volume.
+ *
+ * A VolumeBricked is created from a VolumeDisk whose loader implements VolumeRegionLoader, i.e.
+ * volumes read with a RawVolumeRAMLoader. Converting it to a VolumeRAM loads the whole volume.
+ * Use util::getBrickedRepresentation to check if a volume should be accessed by bricks.
+ *
+ * Example, summing the voxels of a sub region while only loading the bricks overlapping it:
+ * \code{.cpp}
+ * if (auto bricked = util::getBrickedRepresentation(volume)) {
+ *     double sum = 0.0;
+ *     util::forEachVoxel<float>(*bricked, offset, extent,
+ *                               [&](const size3_t& pos, const float& value) { sum += value; });
+ * }
+ * \endcode
+ * \see VolumeBrickCache, VolumeRegionLoader
+ */
+class IVW_CORE_API VolumeBricked : public VolumeRepresentation {
+public:
+    static constexpr size_t defaultBrickSize = 64;
+
+    /**
+     * @param loader used to load the bricks
+     * @param src defines the dimensions, format, swizzle mask, interpolation, and wrapping
+     * @param brickSize the size of each brick, bricks at the upper borders might be smaller
+     * @param cache the cache to store the bricks in, if nullptr VolumeBrickCache::getDefault()
+     */
+    VolumeBricked(std::shared_ptr<const VolumeRegionLoader> loader, const VolumeRepresentation& src,
+                  size3_t brickSize = size3_t{defaultBrickSize},
+                  std::shared_ptr<VolumeBrickCache> cache = nullptr);
+    VolumeBricked(const VolumeBricked& rhs) = default;
+    VolumeBricked& operator=(const VolumeBricked& that) = default;
+    virtual VolumeBricked* clone() const override;
+    virtual ~VolumeBricked() = default;
+
+    virtual std::type_index getTypeIndex() const override final;
+
+    /**
+     * A VolumeBricked can not be resized, throws an Exception.
+     */
+    virtual void setDimensions(size3_t dimensions) override;
+    virtual const size3_t& getDimensions() const override;
+
+    virtual void setSwizzleMask(const SwizzleMask& mask) override;
+    virtual SwizzleMask getSwizzleMask() const override;
+
+    virtual void setInterpolation(InterpolationType interpolation) override;
+    virtual InterpolationType getInterpolation() const override;
+
+    virtual void setWrapping(const Wrapping3D& wrapping) override;
+    virtual Wrapping3D getWrapping() const override;
+
+    const size3_t& getBrickSize() const;
+    /**
+     * The number of bricks in each direction
+     */
+    size3_t getNumberOfBricks() const;
+    const VolumeRegionLoader& getLoader() const;
+    VolumeBrickCache& getCache() const;
+
+    /**
+     * Get brick with index brick, loading it if it is not in the cache. Each brick covers the
+     * region [brick * brickSize, min((brick + 1) * brickSize, dimensions)).
+     * Each thread keeps a reference to the brick it got last, and asking for it again does not
+     * go through the cache. Hence there can be one brick per thread in use beyond the capacity
+     * of the cache.
+     */
+    std::shared_ptr<const VolumeRAM> getBrick(const size3_t& brick) const;
+
+    /**
+     * Get the brick containing the voxel pos.
+     */
+    std::shared_ptr<const VolumeRAM> getBrickContaining(const size3_t& pos) const;
+
+    /**
+     * Copy the region [offset, offset + extent) into a new VolumeRAM, only the bricks overlapping
+     * the region are loaded.
+     */
+    std::shared_ptr<VolumeRAM> getRegion(const size3_t& offset, const size3_t& extent) const;
+
+    /**
+     * Call callback for each brick overlapping the region [offset, offset + extent), as
+     * `void(const VolumeRAM& brick, const size3_t& brickOffset)`, where brickOffset is the
+     * position of the first voxel of the brick in the volume. Only one brick at a time is kept
+     * alive by this function.
+     */
+    template <typename C>
+    void forEachBrick(const size3_t& offset, const size3_t& extent, C callback) const;
+
+    double getAsDouble(const size3_t& pos) const;
+    dvec2 getAsDVec2(const size3_t& pos) const;
+    dvec3 getAsDVec3(const size3_t& pos) const;
+    dvec4 getAsDVec4(const size3_t& pos) const;
+
+private:
+    // Shared by all copies, removes the bricks from the cache when the last copy is destroyed
+    struct Source {
+        Source(std::shared_ptr<VolumeBrickCache> cache);
+        Source(const Source&) = delete;
+        Source& operator=(const Source&) = delete;
+        ~Source();
+        std::shared_ptr<VolumeBrickCache> cache;
+        size_t id;
+    };
+
+    size3_t dimensions_;
+    SwizzleMask swizzleMask_;
+    InterpolationType interpolation_;
+    Wrapping3D wrapping_;
+    size3_t brickSize_;
+    std::shared_ptr<const VolumeRegionLoader> loader_;
+    std::shared_ptr<Source> source_;
+};
+
+template <>
+struct representation_traits<Volume, kind::Bricked> {
+    using type = VolumeBricked;
+};
+
+template <typename C>
+void VolumeBricked::forEachBrick(const size3_t& offset, const size3_t& extent, C callback) const {
+    if (glm::compMul(extent) == 0) return;
+    const size3_t first = offset / brickSize_;
+    const size3_t last = (offset + extent - size3_t{1}) / brickSize_;
+    size3_t brick;
+    for (brick.z = first.z; brick.z <= last.z; ++brick.z) {
+        for (brick.y = first.y; brick.y <= last.y; ++brick.y) {
+            for (brick.x = first.x; brick.x <= last.x; ++brick.x) {
+                const auto ram = getBrick(brick);
+                callback(*ram, brick * brickSize_);
+            }
+        }
+    }
+}
+
+namespace util {
+
+/**
+ * Get the bricked representation of volume if the volume should be accessed by bricks, i.e. it
+ * has a VolumeBricked already, or it only has a VolumeDisk with a loader that implements
+ * VolumeRegionLoader and it is larger than minBytes. If the volume already has a VolumeRAM, or
+ * should not be bricked, nullptr is returned and the VolumeRAM should be used instead.
+ */
+IVW_CORE_API const VolumeBricked* getBrickedRepresentation(const Volume& volume, size_t minBytes);
+
+/**
+ * Get the bricked representation of volume if the volume does not fit in the default brick cache.
+ * Smaller volumes are faster to load and access as a whole.
+ * @see getBrickedRepresentation(const Volume&, size_t)
+ */
+IVW_CORE_API const VolumeBricked* getBrickedRepresentation(const Volume& volume);
+
+/**
+ * Call callback for each voxel in the region [offset, offset + extent) of volume, as
+ * `void(const size3_t& pos, const T& value)`. The voxels are visited brick by brick, using a
+ * util::BrickIterator for each brick, hence only the bricks overlapping the region are loaded.
+ * T has to match the data format of the volume.
+ */
+template <typename T, typename C>
+void forEachVoxel(const VolumeBricked& volume, const size3_t& offset, const size3_t& extent,
+                  C callback) {
+    volume.forEachBrick(offset, extent, [&](const VolumeRAM& brick, const size3_t& brickOffset) {
+        const auto brickDims = brick.getDimensions();
+        const auto begin = glm::max(offset, brickOffset) - brickOffset;
+        const auto end = glm::min(offset + extent, brickOffset + brickDims) - brickOffset;
+        const auto data = static_cast<const T*>(brick.getData());
+        for (auto it = BrickIterator{data, brickDims, begin, end - begin}; it != it.end(); ++it) {
+            callback(brickOffset + it.globalPos(), *it);
+        }
+    });
+}
+
+/**
+ * Call callback for each voxel of volume, as `void(const size3_t& pos, const T& value)`.
+ * @see forEachVoxel(const VolumeBricked&, const size3_t&, const size3_t&, C)
+ */
+template <typename T, typename C>
+void forEachVoxel(const VolumeBricked& volume, C callback) {
+    forEachVoxel<T>(volume, size3_t{0}, volume.getDimensions(), callback);
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -58,6 +58,7 @@ public:
     virtual ~VolumeDisk() = default;
 
     virtual std::type_index getTypeIndex() const override final;
+    virtual bool isReloadable() const override;
 
     virtual void setDimensions(size3_t dimensions) override;
     virtual const size3_t& getDimensions() const override;
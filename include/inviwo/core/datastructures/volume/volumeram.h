@@ -63,6 +63,11 @@ public:
      * @param dimensions is the dimensions of the data.
      */
     virtual void setData(void* data, size3_t dimensions) = 0;
+    /**
+     * \brief Stop deleting the data, the caller takes over the ownership of getData()
+     * Throws an Exception if the data is shared with a copy of the representation or if the
+     * representation does not own its data.
+     */
     virtual void removeDataOwnership() = 0;
 
     // uniform getters and setters
@@ -87,6 +92,7 @@ public:
     virtual void setFromNormalizedDVec4(const size3_t& pos, dvec4 val) = 0;
 
     virtual size_t getNumberOfBytes() const = 0;
+    virtual size_t getMemoryUsage() const override;
 
     template <typename T>
     static T posToIndex(const glm::tvec3<T, glm::defaultp>& pos,
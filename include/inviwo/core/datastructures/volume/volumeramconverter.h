@@ -33,6 +33,7 @@
 #include <inviwo/core/datastructures/representationconverter.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumebricked.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 
 namespace inviwo {
@@ -46,4 +47,29 @@ public:
                         std::shared_ptr<VolumeRAM> destination) const override;
 };
 
+/**
+ * Creates a VolumeBricked from a VolumeDisk, requires that the loader of the VolumeDisk
+ * implements VolumeRegionLoader.
+ */
+class IVW_CORE_API VolumeDisk2BrickedConverter
+    : public RepresentationConverterType<VolumeRepresentation, VolumeDisk, VolumeBricked> {
+public:
+    virtual std::shared_ptr<VolumeBricked> createFrom(
+        std::shared_ptr<const VolumeDisk> source) const override;
+    virtual void update(std::shared_ptr<const VolumeDisk> source,
+                        std::shared_ptr<VolumeBricked> destination) const override;
+};
+
+/**
+ * Loads the whole volume of a VolumeBricked into a VolumeRAM, bypassing the brick cache.
+ */
+class IVW_CORE_API VolumeBricked2RAMConverter
+    : public RepresentationConverterType<VolumeRepresentation, VolumeBricked, VolumeRAM> {
+public:
+    virtual std::shared_ptr<VolumeRAM> createFrom(
+        std::shared_ptr<const VolumeBricked> source) const override;
+    virtual void update(std::shared_ptr<const VolumeBricked> source,
+                        std::shared_ptr<VolumeRAM> destination) const override;
+};
+
 }  // namespace inviwo
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/copyonwrite.h>
 #include <inviwo/core/util/glm.h>
 #include <inviwo/core/util/stdextensions.h>
 
@@ -37,6 +38,12 @@ namespace inviwo {
 
 /**
  * \ingroup datastructures
+ * The data is shared between copies of the representation, and only duplicated when one of them
+ * is modified. A non-const function that hands out a pointer or reference to the data, like
+ * getData(), stops the sharing: the data is duplicated if it is shared, and later copies get
+ * their own data right away. Data passed in by pointer, or viewed from an external owner, is
+ * handed out from the start.
+ * @see CopyOnWrite
  */
 template <typename T>
 class VolumeRAMPrecision : public VolumeRAM {
@@ -51,9 +58,19 @@ public:
                        const SwizzleMask& swizzleMask = swizzlemasks::rgba,
                        InterpolationType interpolation = InterpolationType::Linear,
                        const Wrapping3D& wrapping = wrapping3d::clampAll);
+    /**
+     * Create a volume viewing external data without copying it, i.e. a memory mapped file. The
+     * volume does not take ownership of data but keeps dataOwner alive as long as data is used.
+     */
+    VolumeRAMPrecision(std::shared_ptr<void> dataOwner, T* data, size3_t dimensions,
+                       const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                       InterpolationType interpolation = InterpolationType::Linear,
+                       const Wrapping3D& wrapping = wrapping3d::clampAll);
     VolumeRAMPrecision(const VolumeRAMPrecision<T>& rhs);
     VolumeRAMPrecision<T>& operator=(const VolumeRAMPrecision<T>& that);
     virtual VolumeRAMPrecision<T>* clone() const override;
+    virtual bool sharesDataOnCopy() const override;
+    virtual std::weak_ptr<const void> getMemoryStorage() const override;
     virtual ~VolumeRAMPrecision();
 
     T* getDataTyped();
@@ -110,8 +127,7 @@ public:
 
 private:
     size3_t dimensions_;
-    bool ownsDataPtr_;
-    std::unique_ptr<T[]> data_;
+    CopyOnWrite<T[]> data_;
     SwizzleMask swizzleMask_;
     InterpolationType interpolation_;
     Wrapping3D wrapping_;
@@ -135,14 +151,26 @@ IVW_CORE_API std::shared_ptr<VolumeRAM> createVolumeRAM(
     InterpolationType interpolation = InterpolationType::Linear,
     const Wrapping3D& wrapping = wrapping3d::clampAll);
 
+/**
+ * Factory for volumes viewing external data.
+ * Creates an VolumeRAM with data type specified by format, that uses dataPtr without copying or
+ * taking ownership of it. dataOwner is kept alive as long as the volume uses dataPtr.
+ * @see createVolumeRAM(const size3_t&, const DataFormatBase*, void*, const SwizzleMask&,
+ * InterpolationType, const Wrapping3D&)
+ */
+IVW_CORE_API std::shared_ptr<VolumeRAM> createVolumeRAM(
+    const size3_t& dimensions, const DataFormatBase* format, void* dataPtr,
+    std::shared_ptr<void> dataOwner, const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+    InterpolationType interpolation = InterpolationType::Linear,
+    const Wrapping3D& wrapping = wrapping3d::clampAll);
+
 template <typename T>
 VolumeRAMPrecision<T>::VolumeRAMPrecision(size3_t dimensions, const SwizzleMask& swizzleMask,
                                           InterpolationType interpolation,
                                           const Wrapping3D& wrapping)
     : VolumeRAM(DataFormat<T>::get())
     , dimensions_(dimensions)
-    , ownsDataPtr_(true)
-    , data_(new T[dimensions_.x * dimensions_.y * dimensions_.z]())
+    , data_(CopyOnWrite<T[]>::allocate(glm::compMul(dimensions_)))
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
     , wrapping_{wrapping} {}
@@ -154,52 +182,49 @@ VolumeRAMPrecision<T>::VolumeRAMPrecision(T* data, size3_t dimensions,
                                           const Wrapping3D& wrapping)
     : VolumeRAM(DataFormat<T>::get())
     , dimensions_(dimensions)
-    , ownsDataPtr_(true)
-    , data_(data ? data : new T[dimensions_.x * dimensions_.y * dimensions_.z]())
+    , data_(data ? CopyOnWrite<T[]>(data, glm::compMul(dimensions_))
+                 : CopyOnWrite<T[]>::allocate(glm::compMul(dimensions_)))
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
     , wrapping_{wrapping} {}
 
 template <typename T>
-VolumeRAMPrecision<T>::VolumeRAMPrecision(const VolumeRAMPrecision<T>& rhs)
-    : VolumeRAM(rhs)
-    , dimensions_(rhs.dimensions_)
-    , ownsDataPtr_(true)
-    , data_(new T[dimensions_.x * dimensions_.y * dimensions_.z])
-    , swizzleMask_(rhs.swizzleMask_)
-    , interpolation_{rhs.interpolation_}
-    , wrapping_{rhs.wrapping_} {
-    std::memcpy(data_.get(), rhs.data_.get(),
-                dimensions_.x * dimensions_.y * dimensions_.z * sizeof(T));
-}
-
-template <typename T>
-VolumeRAMPrecision<T>& VolumeRAMPrecision<T>::operator=(const VolumeRAMPrecision<T>& that) {
-    if (this != &that) {
-        VolumeRAM::operator=(that);
-        auto dim = that.dimensions_;
-        auto data = std::make_unique<T[]>(dim.x * dim.y * dim.z);
-        std::memcpy(data.get(), that.data_.get(), dim.x * dim.y * dim.z * sizeof(T));
-        data_.swap(data);
-        std::swap(dim, dimensions_);
-        ownsDataPtr_ = true;
-        swizzleMask_ = that.swizzleMask_;
-        interpolation_ = that.interpolation_;
-        wrapping_ = that.wrapping_;
-    }
-    return *this;
-}
+VolumeRAMPrecision<T>::VolumeRAMPrecision(std::shared_ptr<void> dataOwner, T* data,
+                                          size3_t dimensions, const SwizzleMask& swizzleMask,
+                                          InterpolationType interpolation,
+                                          const Wrapping3D& wrapping)
+    : VolumeRAM(DataFormat<T>::get())
+    , dimensions_(dimensions)
+    , data_(std::move(dataOwner), data, glm::compMul(dimensions_))
+    , swizzleMask_(swizzleMask)
+    , interpolation_{interpolation}
+    , wrapping_{wrapping} {}
 
 template <typename T>
-VolumeRAMPrecision<T>::~VolumeRAMPrecision() {
-    if (!ownsDataPtr_) data_.release();
-}
+VolumeRAMPrecision<T>::VolumeRAMPrecision(const VolumeRAMPrecision<T>& rhs) = default;
+
+template <typename T>
+VolumeRAMPrecision<T>& VolumeRAMPrecision<T>::operator=(const VolumeRAMPrecision<T>& that) =
+    default;
+
+template <typename T>
+VolumeRAMPrecision<T>::~VolumeRAMPrecision() = default;
 
 template <typename T>
 VolumeRAMPrecision<T>* VolumeRAMPrecision<T>::clone() const {
     return new VolumeRAMPrecision<T>(*this);
 }
 
+template <typename T>
+bool VolumeRAMPrecision<T>::sharesDataOnCopy() const {
+    return !data_.isExposed();
+}
+
+template <typename T>
+std::weak_ptr<const void> VolumeRAMPrecision<T>::getMemoryStorage() const {
+    return data_.storage();
+}
+
 template <typename T>
 const T* inviwo::VolumeRAMPrecision<T>::getDataTyped() const {
     return data_.get();
@@ -207,41 +232,37 @@ const T* inviwo::VolumeRAMPrecision<T>::getDataTyped() const {
 
 template <typename T>
 T* inviwo::VolumeRAMPrecision<T>::getDataTyped() {
-    return data_.get();
+    return data_.expose();
 }
 
 template <typename T>
 void* VolumeRAMPrecision<T>::getData() {
-    return data_.get();
+    return data_.expose();
 }
 template <typename T>
 const void* VolumeRAMPrecision<T>::getData() const {
-    return const_cast<const T*>(data_.get());
+    return data_.get();
 }
 
 template <typename T>
 void* VolumeRAMPrecision<T>::getData(size_t pos) {
-    return data_.get() + pos;
+    return data_.expose() + pos;
 }
 
 template <typename T>
 const void* VolumeRAMPrecision<T>::getData(size_t pos) const {
-    return const_cast<const T*>(data_.get()) + pos;
+    return data_.get() + pos;
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setData(void* d, size3_t dimensions) {
-    std::unique_ptr<T[]> data(static_cast<T*>(d));
-    data_.swap(data);
-    std::swap(dimensions_, dimensions);
-
-    if (!ownsDataPtr_) data.release();
-    ownsDataPtr_ = true;
+    data_ = CopyOnWrite<T[]>(static_cast<T*>(d), glm::compMul(dimensions));
+    dimensions_ = dimensions;
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::removeDataOwnership() {
-    ownsDataPtr_ = false;
+    data_.release();
 }
 
 template <typename T>
@@ -257,11 +278,8 @@ size_t VolumeRAMPrecision<T>::getNumberOfBytes() const {
 template <typename T>
 void VolumeRAMPrecision<T>::setDimensions(size3_t dimensions) {
     if (dimensions_ != dimensions) {
-        auto data = std::make_unique<T[]>(dimensions.x * dimensions.y * dimensions.z);
-        data_.swap(data);
+        data_ = CopyOnWrite<T[]>::allocate(glm::compMul(dimensions));
         dimensions_ = dimensions;
-        if (!ownsDataPtr_) data.release();
-        ownsDataPtr_ = true;
     }
 }
 
@@ -297,82 +315,82 @@ Wrapping3D VolumeRAMPrecision<T>::getWrapping() const {
 
 template <typename T>
 double VolumeRAMPrecision<T>::getAsDouble(const size3_t& pos) const {
-    return util::glm_convert<double>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert<double>(data_.get()[posToIndex(pos, dimensions_)]);
 }
 
 template <typename T>
 dvec2 VolumeRAMPrecision<T>::getAsDVec2(const size3_t& pos) const {
-    return util::glm_convert<dvec2>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert<dvec2>(data_.get()[posToIndex(pos, dimensions_)]);
 }
 
 template <typename T>
 dvec3 VolumeRAMPrecision<T>::getAsDVec3(const size3_t& pos) const {
-    return util::glm_convert<dvec3>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert<dvec3>(data_.get()[posToIndex(pos, dimensions_)]);
 }
 
 template <typename T>
 dvec4 VolumeRAMPrecision<T>::getAsDVec4(const size3_t& pos) const {
-    return util::glm_convert<dvec4>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert<dvec4>(data_.get()[posToIndex(pos, dimensions_)]);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDouble(const size3_t& pos, double val) {
-    data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
+    data_.edit()[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec2(const size3_t& pos, dvec2 val) {
-    data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
+    data_.edit()[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec3(const size3_t& pos, dvec3 val) {
-    data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
+    data_.edit()[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec4(const size3_t& pos, dvec4 val) {
-    data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
+    data_.edit()[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 double VolumeRAMPrecision<T>::getAsNormalizedDouble(const size3_t& pos) const {
-    return util::glm_convert_normalized<double>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert_normalized<double>(data_.get()[posToIndex(pos, dimensions_)]);
 }
 
 template <typename T>
 dvec2 VolumeRAMPrecision<T>::getAsNormalizedDVec2(const size3_t& pos) const {
-    return util::glm_convert_normalized<dvec2>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert_normalized<dvec2>(data_.get()[posToIndex(pos, dimensions_)]);
 }
 
 template <typename T>
 dvec3 VolumeRAMPrecision<T>::getAsNormalizedDVec3(const size3_t& pos) const {
-    return util::glm_convert_normalized<dvec3>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert_normalized<dvec3>(data_.get()[posToIndex(pos, dimensions_)]);
 }
 
 template <typename T>
 dvec4 VolumeRAMPrecision<T>::getAsNormalizedDVec4(const size3_t& pos) const {
-    return util::glm_convert_normalized<dvec4>(data_[posToIndex(pos, dimensions_)]);
+    return util::glm_convert_normalized<dvec4>(data_.get()[posToIndex(pos, dimensions_)]);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDouble(const size3_t& pos, double val) {
-    data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
+    data_.edit()[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec2(const size3_t& pos, dvec2 val) {
-    data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
+    data_.edit()[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec3(const size3_t& pos, dvec3 val) {
-    data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
+    data_.edit()[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec4(const size3_t& pos, dvec4 val) {
-    data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
+    data_.edit()[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 }  // namespace inviwo
@@ -0,0 +1,65 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/glmvec.h>
+
+#include <memory>
+
+namespace inviwo {
+
+class VolumeRAM;
+class VolumeRepresentation;
+
+/**
+ * \ingroup datastructures
+ * Interface for DiskRepresentationLoaders that can load a sub region of a volume without loading
+ * the whole volume. Loaders implementing it make it possible to convert a VolumeDisk into a
+ * VolumeBricked.
+ * \see VolumeBricked, RawVolumeRAMLoader
+ */
+class IVW_CORE_API VolumeRegionLoader {
+public:
+    virtual ~VolumeRegionLoader() = default;
+
+    /**
+     * Load the region [offset, offset + extent) of the volume described by src.
+     * @param src the disk representation, defines the format, dimensions, swizzle mask,
+     * interpolation, and wrapping of the volume.
+     * @param offset first voxel of the region
+     * @param extent size of the region, offset + extent has to be within the dimensions of src
+     * @return a VolumeRAM with dimensions equal to extent
+     */
+    virtual std::shared_ptr<VolumeRAM> loadRegion(const VolumeRepresentation& src, size3_t offset,
+                                                  size3_t extent) const = 0;
+};
+
+}  // namespace inviwo
@@ -36,8 +36,25 @@ namespace inviwo {
 
 namespace util {
 
+/**
+ * Read bytes from file starting at offset into dest.
+ * @param file the file to read from
+ * @param offset in bytes from the start of the file
+ * @param bytes number of bytes to read
+ * @param littleEndian if false the byte order of each value is reversed after reading
+ * @param elementSize the size of each value to swap, i.e. the size of one component
+ * @param dest buffer of at least bytes size
+ */
 void IVW_CORE_API readBytesIntoBuffer(const std::string& file, size_t offset, size_t bytes,
                                       bool littleEndian, size_t elementSize, void* dest);
+
+/**
+ * Reverse the byte order of each value of elementSize bytes in data, in place. Sizes of 2, 4, and
+ * 8 bytes use branch free loops that the compiler can vectorize, large buffers are processed in
+ * parallel.
+ */
+void IVW_CORE_API swapByteOrder(void* data, size_t bytes, size_t elementSize);
+
 }  // namespace util
 
 }  // namespace inviwo
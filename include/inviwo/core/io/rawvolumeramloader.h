@@ -35,6 +35,7 @@
 #include <inviwo/core/io/datareaderexception.h>
 #include <inviwo/core/datastructures/diskrepresentation.h>
 #include <inviwo/core/datastructures/volume/volumerepresentation.h>
+#include <inviwo/core/datastructures/volume/volumeregionloader.h>
 
 #include <string>
 #include <memory>
@@ -45,21 +46,38 @@ namespace inviwo {
  * \class RawVolumeRAMLoader
  * \brief A loader of raw files. Used to create VolumeRAM representations.
  * This class us used by the DatVolumeSequenceReader, IvfVolumeReader and RawVolumeReader.
+ *
+ * By default the data is read into a new buffer. If memoryMap is true the file is memory mapped
+ * instead and the VolumeRAM views the mapped memory directly, hence creating the representation
+ * is almost instant and the pages are loaded on demand and shared with other processes using the
+ * same file. The mapping is copy-on-write, modifying the volume never changes the file. Big
+ * endian data is swapped in place in the mapped memory. If the data can not be mapped it is read
+ * instead.
+ * Only map files that are not modified while the volume is in use. Changes made to the file
+ * might show up in the volume, and truncating the file makes accessing the volume crash.
+ *
+ * The loader can also load sub regions of the volume, which makes it possible to access the volume
+ * by bricks using a VolumeBricked, \see VolumeRegionLoader.
  */
 
-class IVW_CORE_API RawVolumeRAMLoader : public DiskRepresentationLoader<VolumeRepresentation> {
+class IVW_CORE_API RawVolumeRAMLoader : public DiskRepresentationLoader<VolumeRepresentation>,
+                                         public VolumeRegionLoader {
 public:
-    RawVolumeRAMLoader(const std::string& rawFile, size_t offset, bool littleEndian);
+    RawVolumeRAMLoader(const std::string& rawFile, size_t offset, bool littleEndian,
+                       bool memoryMap = false);
     virtual RawVolumeRAMLoader* clone() const override;
     virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
         const VolumeRepresentation& src) const override;
     virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
                                       const VolumeRepresentation& src) const override;
+    virtual std::shared_ptr<VolumeRAM> loadRegion(const VolumeRepresentation& src, size3_t offset,
+                                                  size3_t extent) const override;
 
 private:
     std::string rawFile_;
     size_t offset_;
     bool littleEndian_;
+    bool memoryMap_;
 };
 
 }  // namespace inviwo
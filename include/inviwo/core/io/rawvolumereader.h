@@ -45,6 +45,9 @@ class MetaDataOwner;
 
 /**
  * \ingroup dataio
+ * Supported options, see DataReader::setOption:
+ *   - __MemoryMap__ (bool, default false) memory map the file instead of reading it, see
+ *     RawVolumeRAMLoader. Only use it for files that are not modified while the volume is in use.
  */
 class IVW_CORE_API RawVolumeReader : public DataReaderType<Volume> {
 public:
@@ -61,6 +64,9 @@ public:
     virtual std::shared_ptr<Volume> readData(const std::string& filePath,
                                              MetaDataOwner* metadata) override;
 
+    virtual bool setOption(std::string_view key, std::any value) override;
+    virtual std::any getOption(std::string_view key) override;
+
     bool haveReadLittleEndian() const { return littleEndian_; }
     const DataFormatBase* getFormat() const { return format_; }
 
@@ -73,6 +79,7 @@ private:
     DataMapper dataMapper_;
     size_t byteOffset_;
     bool parametersSet_;
+    bool memoryMap_;
 };
 
 }  // namespace inviwo
@@ -35,11 +35,23 @@
 #include <inviwo/core/network/processornetworkevaluationobserver.h>
 #include <inviwo/core/network/evaluationerrorhandler.h>
 
+#include <exception>
+
 namespace inviwo {
 
 class Processor;
 class ProcessorNetwork;
 
+/**
+ * \brief Strategy used by the ProcessorNetworkEvaluator to evaluate the network
+ */
+enum class EvaluationMode {
+    Serial,   ///< Evaluate one processor at the time in topological order on the main thread.
+    Parallel  ///< Process independent CPU processors concurrently in the thread pool. Processors
+              ///< that require the main thread (GL, CL, Python, processor widgets, PoolProcessors)
+              ///< are still processed serially on the main thread.
+};
+
 class IVW_CORE_API ProcessorNetworkEvaluator : public ProcessorNetworkObserver,
                                                public ProcessorObserver,
                                                public ProcessorNetworkEvaluationObservable {
@@ -50,6 +62,20 @@ public:
     virtual ~ProcessorNetworkEvaluator() = default;
     void setExceptionHandler(EvaluationErrorHandler handler);
 
+    /**
+     * Select how the network is evaluated, the default is EvaluationMode::Serial.
+     * In EvaluationMode::Parallel the processors are scheduled according to the port connections.
+     * A processor is processed as soon as all its predecessors are done. Processors tagged as CPU
+     * only, are processed in the thread pool, all other processors are processed on the main
+     * thread. initializeResources, inport onChange callbacks and observer notifications are always
+     * called on the main thread, only Processor::process is called on a worker thread. Hence,
+     * a CPU processor must not modify properties, interact with the GUI, or wait for the main
+     * thread in process() when this mode is used.
+     * @see EvaluationMode
+     */
+    void setEvaluationMode(EvaluationMode mode);
+    EvaluationMode getEvaluationMode() const;
+
 private:
     // ProcessorNetworkObserver overrides
     virtual void onProcessorNetworkEvaluateRequest() override;
@@ -65,12 +91,30 @@ private:
 
     void requestEvaluate();
     void evaluate();
+    void evaluateSerial();
+    void evaluateParallel();
+
+    /**
+     * Call doIfNotReady if the processor is invalid but not ready.
+     * @return true if the processor should be processed.
+     */
+    bool shouldProcess(Processor* processor);
+    /**
+     * Initialize resources and call onChange of changed inports.
+     * @return false if an error occurred and the processor should be skipped.
+     */
+    bool prepareProcess(Processor* processor);
+    /**
+     * Report any error from process, mark the processor valid if still ready and notify observers.
+     */
+    void finishProcess(Processor* processor, std::exception_ptr error);
 
     ProcessorNetwork* processorNetwork_;
     // the sorted list of processors obtained through topological sorting
     std::vector<Processor*> processorsSorted_;
     bool evaulationQueued_;
     EvaluationErrorHandler exceptionHandler_;
+    EvaluationMode evaluationMode_;
 };
 
 }  // namespace inviwo
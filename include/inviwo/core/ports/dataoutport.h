@@ -34,6 +34,7 @@
 #include <inviwo/core/ports/outport.h>
 #include <inviwo/core/ports/outportiterable.h>
 #include <inviwo/core/ports/porttraits.h>
+#include <inviwo/core/resourcemanager/memorymanager.h>
 #include <inviwo/core/util/stringconversion.h>
 #include <inviwo/core/util/document.h>
 
@@ -88,6 +89,7 @@ public:
     void setData(T&& data);
 
     virtual bool hasData() const override;
+    virtual size_t getMemoryUsage() const override;
 
 protected:
     std::shared_ptr<const T> data_;
@@ -155,6 +157,11 @@ bool DataOutport<T>::hasData() const {
     return data_.get() != nullptr;
 }
 
+template <typename T>
+size_t DataOutport<T>::getMemoryUsage() const {
+    return util::memoryUsage(data_);
+}
+
 template <typename T>
 void DataOutport<T>::clear() {
     data_.reset();
@@ -98,6 +98,12 @@ public:
      */
     virtual bool hasData() const = 0;
 
+    /**
+     * The number of bytes of main memory used by the data in the outport.
+     * @see MemoryManager
+     */
+    virtual size_t getMemoryUsage() const;
+
     /**
      * Clear the outport of any data
      */
@@ -42,6 +42,9 @@ class InviwoApplication;
 
 /**
  * \class CompositeProcessorFactoryObject
+ * Factory object for a composite processor saved in a workspace file. The display name and tags
+ * are read from the file the first time they are needed, the class identifier is derived from
+ * the file name. Hence registering many composite processors does not parse their files.
  */
 class IVW_CORE_API CompositeProcessorFactoryObject : public ProcessorFactoryObject {
 public:
@@ -51,6 +54,7 @@ public:
     virtual std::unique_ptr<Processor> create(InviwoApplication* app) override;
 
 private:
+    static std::string makeClassIdentifier(const std::string& file);
     static ProcessorInfo makeProcessorInfo(const std::string& file);
     std::string file_;
 };
@@ -39,6 +39,7 @@
 #include <inviwo/core/util/assertion.h>
 #include <inviwo/core/util/rendercontext.h>
 #include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/resourcemanager/memorymanager.h>
 
 #include <atomic>
 #include <chrono>
@@ -546,20 +547,30 @@ inline std::shared_ptr<pool::detail::StateTemplate<Result, Done>> PoolProcessor:
 template <typename Result, typename Job>
 inline std::shared_ptr<std::packaged_task<Result()>> PoolProcessor::makeTask(
     Job&& job, [[maybe_unused]] pool::Stop stop, [[maybe_unused]] pool::Progress progress) {
+    // The job may use representations outside of the network evaluation, hold a lease to keep the
+    // MemoryManager from evicting them while it runs.
+    auto leased = [job = std::forward<Job>(job)](auto&&... args) mutable {
+        const MemoryManager::Lease lease;
+        return job(std::forward<decltype(args)>(args)...);
+    };
     if constexpr (std::is_invocable_v<Job, pool::Stop, pool::Progress>) {
         return std::make_shared<std::packaged_task<Result()>>(
-            [job = std::forward<Job>(job), stop, progress]() { return job(stop, progress); });
+            [leased = std::move(leased), stop, progress]() mutable {
+                return leased(stop, progress);
+            });
     } else if constexpr (std::is_invocable_v<Job, pool::Progress, pool::Stop>) {
         return std::make_shared<std::packaged_task<Result()>>(
-            [job = std::forward<Job>(job), stop, progress]() { return job(progress, stop); });
+            [leased = std::move(leased), stop, progress]() mutable {
+                return leased(progress, stop);
+            });
     } else if constexpr (std::is_invocable_v<Job, pool::Stop>) {
         return std::make_shared<std::packaged_task<Result()>>(
-            [job = std::forward<Job>(job), stop]() { return job(stop); });
+            [leased = std::move(leased), stop]() mutable { return leased(stop); });
     } else if constexpr (std::is_invocable_v<Job, pool::Progress>) {
         return std::make_shared<std::packaged_task<Result()>>(
-            [job = std::forward<Job>(job), progress]() { return job(progress); });
+            [leased = std::move(leased), progress]() mutable { return leased(progress); });
     } else {
-        return std::make_shared<std::packaged_task<Result()>>(std::forward<Job>(job));
+        return std::make_shared<std::packaged_task<Result()>>(std::move(leased));
     }
 }
 
@@ -39,6 +39,10 @@
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/utilities.h>
 
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
 #include <type_traits>
 #include <string>
 
@@ -46,21 +50,39 @@ namespace inviwo {
 
 class IVW_CORE_API ProcessorFactoryObject {
 public:
-    ProcessorFactoryObject(ProcessorInfo info) : info_(std::move(info)) {}
+    ProcessorFactoryObject(ProcessorInfo info);
+    /**
+     * Create a factory object that defers the lookup of the processor info until it is first
+     * needed. Only the class identifier is needed to register the object in the ProcessorFactory,
+     * use this when the info is expensive to get, like for a composite processor that has to be
+     * deserialized. The class identifier of the info returned by getInfo is ignored.
+     */
+    ProcessorFactoryObject(std::string classIdentifier, std::function<ProcessorInfo()> getInfo);
     virtual ~ProcessorFactoryObject() = default;
 
     virtual std::unique_ptr<Processor> create(InviwoApplication* app) = 0;
 
-    ProcessorInfo getProcessorInfo() const { return info_; }
-    std::string getClassIdentifier() const { return info_.classIdentifier; }
-    std::string getDisplayName() const { return info_.displayName; }
-    Tags getTags() const { return info_.tags; }
-    std::string getCategory() const { return info_.category; }
-    CodeState getCodeState() const { return info_.codeState; }
-    bool isVisible() { return info_.visible; }
+    ProcessorInfo getProcessorInfo() const { return info(); }
+    std::string getClassIdentifier() const { return classIdentifier_; }
+    std::string getDisplayName() const { return info().displayName; }
+    Tags getTags() const { return info().tags; }
+    std::string getCategory() const { return info().category; }
+    CodeState getCodeState() const { return info().codeState; }
+    bool isVisible() { return info().visible; }
+
+    /**
+     * False if the processor info is deferred and has not been looked up yet.
+     */
+    bool hasProcessorInfo() const;
 
 private:
-    const ProcessorInfo info_;
+    const ProcessorInfo& info() const;
+
+    const std::string classIdentifier_;
+    mutable std::function<ProcessorInfo()> getInfo_;
+    mutable std::optional<ProcessorInfo> info_;
+    mutable std::once_flag infoFlag_;
+    mutable std::atomic<bool> hasInfo_;
 };
 
 #include <warn/push>
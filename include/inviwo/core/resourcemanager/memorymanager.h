@@ -0,0 +1,283 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/singleton.h>
+#include <inviwo/core/util/detected.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \class MemoryManager
+ * \brief Keeps track of the main memory used by the RAM representations of all Data objects and
+ * enforces a memory budget.
+ *
+ * Every Data object holding representations that use main memory (VolumeRAM, LayerRAM,
+ * BufferRAM, ...) registers an Entry with the manager. The entry records the number of bytes used
+ * and when the data was last accessed. Memory that is shared between copies of the data, see
+ * CopyOnWrite, is only counted once in the total usage. When the total usage exceeds the budget,
+ * enforceBudget() evicts the least recently used RAM representations that can be recreated from
+ * a valid reloadable representation, i.e. a VolumeDisk or LayerDisk with a loader. Edited data,
+ * and data without a disk representation, is never evicted.
+ *
+ * Eviction is only done in enforceBudget(), which the ProcessorNetworkEvaluator calls after
+ * each network evaluation. Data that was accessed since the previous call is never evicted, hence
+ * representation pointers retrieved while processing stay valid for the rest of the evaluation.
+ * Representations used outside of the network evaluation have to be pinned, either by holding
+ * them through Data::getSharedRepresentation, which keeps the data from being evicted, or by
+ * holding a Lease, which postpones all eviction. PoolProcessor jobs hold a Lease while running.
+ *
+ * The Data objects only register with the manager when it is initialized, which is done by the
+ * InviwoApplication.
+ * @see ResourceManager
+ */
+class IVW_CORE_API MemoryManager : public Singleton<MemoryManager> {
+    struct Counters;
+
+public:
+    /**
+     * Memory used by a representation. Memory with the same storage, i.e. shared by copies of a
+     * representation, is only counted once. An empty storage means that the memory is not shared.
+     */
+    struct Usage {
+        std::weak_ptr<const void> storage;
+        size_t bytes;
+    };
+
+    /**
+     * The handle used by a Data object to report its memory usage. The Data object owns the
+     * entry and has to call detach() before it is destroyed.
+     */
+    class IVW_CORE_API Entry {
+    public:
+        /**
+         * @param counters shared counters of the manager
+         * @param evict called to evict the reloadable representations, should return the number
+         * of bytes freed.
+         */
+        Entry(std::shared_ptr<Counters> counters, std::function<size_t()> evict);
+        Entry(const Entry&) = delete;
+        Entry& operator=(const Entry&) = delete;
+        ~Entry();
+
+        /**
+         * Update the number of bytes used by the data, memory that is not shared
+         */
+        void setUsage(size_t bytes);
+        /**
+         * Update the memory used by the data, memory shared with other entries is only counted
+         * once in the total usage.
+         */
+        void setUsage(std::vector<Usage> usages);
+        /**
+         * The number of bytes used by the data, including memory shared with other entries
+         */
+        size_t getUsage() const;
+
+        /**
+         * Mark the data as used now
+         */
+        void touch();
+        std::uint64_t getLastUsed() const;
+
+        /**
+         * Evict the reloadable representations of the data, if it is still alive.
+         * @return the number of bytes freed
+         */
+        size_t evict();
+
+        /**
+         * Disconnect the entry from the data. After this call evict() will do nothing.
+         */
+        void detach();
+
+    private:
+        std::shared_ptr<Counters> counters_;
+        std::atomic<size_t> bytes_;
+        std::atomic<std::uint64_t> lastUsed_;
+        std::mutex mutex_;
+        std::function<size_t()> evict_;
+        std::mutex usageMutex_;
+        std::vector<Usage> usages_;
+    };
+
+    /**
+     * Postpones all eviction while alive. Held by code that uses representation pointers outside
+     * of the network evaluation, like the jobs of a PoolProcessor. Does nothing if the
+     * MemoryManager is not initialized.
+     */
+    class IVW_CORE_API Lease {
+    public:
+        /**
+         * Lease from the MemoryManager singleton, if initialized
+         */
+        Lease();
+        explicit Lease(MemoryManager& manager);
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease();
+
+    private:
+        std::shared_ptr<Counters> counters_;
+    };
+
+    MemoryManager();
+    MemoryManager(const MemoryManager&) = delete;
+    MemoryManager& operator=(const MemoryManager&) = delete;
+    virtual ~MemoryManager();
+
+    /**
+     * Register a new data object, the returned entry should be kept by the data object.
+     * @see Entry
+     */
+    std::shared_ptr<Entry> track(std::function<size_t()> evict);
+
+    /**
+     * The total number of bytes of main memory used by the tracked data.
+     */
+    size_t getUsage() const;
+
+    /**
+     * The number of live tracked data objects.
+     */
+    size_t getNumberOfEntries() const;
+
+    /**
+     * Set the budget in bytes, zero means unlimited.
+     */
+    void setBudget(size_t bytes);
+    size_t getBudget() const;
+
+    /**
+     * Evict least recently used reloadable data, not accessed since the previous call, until the
+     * usage is within the budget or no more data can be evicted. Does nothing while a Lease is
+     * held.
+     * @return the number of bytes freed
+     */
+    size_t enforceBudget();
+
+private:
+    struct Counters {
+        void claim(const Usage& usage);
+        void release(const Usage& usage);
+
+        std::atomic<size_t> usage{0};
+        std::atomic<std::uint64_t> clock{0};
+
+        // Held while evicting, and while taking a lease
+        std::mutex evictionMutex;
+        size_t leases = 0;
+
+        struct Storage {
+            size_t bytes;
+            size_t count;
+        };
+        std::mutex storageMutex;
+        std::map<std::weak_ptr<const void>, Storage, std::owner_less<>> storages;
+    };
+
+    std::shared_ptr<Counters> counters_;
+    std::atomic<size_t> budget_;
+    std::uint64_t lastEnforced_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::weak_ptr<Entry>> entries_;
+    size_t pruneAt_;
+
+    static MemoryManager* instance_;
+    friend Singleton<MemoryManager>;
+};
+
+namespace util {
+
+namespace detail {
+template <typename T>
+using memoryUsageType = decltype(std::declval<const T&>().getMemoryUsage());
+}  // namespace detail
+
+template <typename T>
+size_t memoryUsage(const T& data);
+template <typename T>
+size_t memoryUsage(T* data);
+template <typename T>
+size_t memoryUsage(const std::shared_ptr<T>& data);
+template <typename T, typename D>
+size_t memoryUsage(const std::unique_ptr<T, D>& data);
+template <typename T, typename A>
+size_t memoryUsage(const std::vector<T, A>& data);
+
+/**
+ * The number of bytes of main memory used by the representations of data, for use with the data
+ * of a port. Uses `size_t T::getMemoryUsage() const` if available, looks through pointers and
+ * vectors, and returns zero for everything else.
+ */
+template <typename T>
+size_t memoryUsage(const T& data) {
+    if constexpr (util::is_detected_exact_v<size_t, detail::memoryUsageType, T>) {
+        return data.getMemoryUsage();
+    } else {
+        return 0;
+    }
+}
+
+template <typename T>
+size_t memoryUsage(T* data) {
+    return data ? memoryUsage(*data) : 0;
+}
+
+template <typename T>
+size_t memoryUsage(const std::shared_ptr<T>& data) {
+    return data ? memoryUsage(*data) : 0;
+}
+
+template <typename T, typename D>
+size_t memoryUsage(const std::unique_ptr<T, D>& data) {
+    return data ? memoryUsage(*data) : 0;
+}
+
+template <typename T, typename A>
+size_t memoryUsage(const std::vector<T, A>& data) {
+    size_t bytes = 0;
+    for (const auto& elem : data) bytes += memoryUsage(elem);
+    return bytes;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
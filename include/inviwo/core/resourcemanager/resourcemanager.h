@@ -40,6 +40,9 @@
 
 namespace inviwo {
 
+class Outport;
+class Processor;
+
 /**
  * \class ResourceManager
  * \brief A resource manager to store data to avoid creating/loading the same dataset twice.
@@ -146,6 +149,32 @@ public:
      */
     size_t numberOfResources() const;
 
+    /**
+     * The number of bytes of main memory used by the RAM representations of all live data.
+     * Returns zero if the MemoryManager is not initialized.
+     * @see MemoryManager
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * The number of bytes of main memory used by the data in the outport.
+     */
+    size_t getMemoryUsage(const Outport& port) const;
+
+    /**
+     * The number of bytes of main memory used by the data in all outports of the processor.
+     */
+    size_t getMemoryUsage(const Processor& processor) const;
+
+    /**
+     * Set the budget, in bytes, for the main memory used by RAM representations. Zero means
+     * unlimited. When exceeded, RAM representations that can be reloaded from disk are evicted
+     * after each network evaluation.
+     * @see MemoryManager::enforceBudget
+     */
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const;
+
 private:
     /**
      * \brief Convenience function to create a std::pair for uses in resources_ map.
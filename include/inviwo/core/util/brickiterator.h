@@ -125,7 +125,7 @@ public:
         return *this;
     }
     BrickIterator operator++(int) {
-        auto it = this;
+        auto it = *this;
         operator++();
         return it;
     }
@@ -146,7 +146,7 @@ public:
         return *this;
     }
     BrickIterator operator--(int) {
-        auto it = this;
+        auto it = *this;
         operator--();
         return it;
     }
@@ -157,8 +157,7 @@ public:
     bool operator==(const BrickIterator& rhs) const { return current_ == rhs.current_; }
     bool operator!=(const BrickIterator& rhs) const { return current_ != rhs.current_; }
 
-    const Iter& base() const { return iterator_ + im_(start_ + current_); }
-    Iter& base() { return iterator_ + im_(start_ + current_); }
+    Iter base() const { return iterator_ + im_(start_ + current_); }
 
     size3_t globalPos() const { return start_ + current_; }
     size3_t blockPos() const { return current_; }
@@ -32,6 +32,7 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/glmvec.h>
+#include <inviwo/core/util/parallel.h>
 #include <inviwo/core/datastructures/image/image.h>
 #include <inviwo/core/datastructures/image/layer.h>
 #include <inviwo/core/datastructures/image/layerram.h>
@@ -63,35 +64,15 @@ void forEachPixel(const LayerRAM& layer, C callback) {
     forEachPixel(layer.getDimensions(), callback);
 }
 
+/**
+ * Call callback for each pixel position in dims using util::parallelFor. The layer is split in
+ * rows, if jobs is zero (default) the number of tasks is chosen based on the pool size, otherwise
+ * it is split into about jobs tasks.
+ */
 template <typename C>
 void forEachPixelParallel(const size2_t dims, C callback, size_t jobs = 0) {
-    if (jobs == 0) {
-        jobs = 4 * detail::getPoolSize();
-        if (jobs == 0) {  // if poolsize is zero
-            forEachPixel(dims, callback);
-            return;
-        }
-    }
-
-    std::vector<std::future<void>> futures;
-    for (size_t job = 0; job < jobs; ++job) {
-        size2_t start = size2_t(0, job * dims.y / jobs);
-        size2_t stop = size2_t(dims.x, std::min(dims.y, (job + 1) * dims.y / jobs));
-
-        futures.push_back(dispatchPool([&callback, start, stop]() {
-            size2_t pos{0};
-
-            for (pos.y = start.y; pos.y < stop.y; ++pos.y) {
-                for (pos.x = start.x; pos.x < stop.x; ++pos.x) {
-                    callback(pos);
-                }
-            }
-        }));
-    }
-
-    for (const auto& e : futures) {
-        e.wait();
-    }
+    const size_t grain = jobs == 0 ? 0 : (dims.y + jobs - 1) / jobs;
+    parallelFor(dims, callback, grain);
 }
 
 template <typename C>
@@ -70,12 +70,12 @@ public:
         , sharedImage_(nullptr) {}
 
     /**
-     * Creates a ImageSpatialSampler for the given Layer, does not take ownership of ram.
-     * Use ImageSpatialSampler(std::shared_ptr<const Image>) to ensure that the Layer is available
-     * for the lifetime of the ImageSpatialSampler
+     * Creates a ImageSpatialSampler for the given Layer, does not take ownership of the layer but
+     * keeps its LayerRAM. Use ImageSpatialSampler(std::shared_ptr<const Image>) to ensure that the
+     * Layer is available for the lifetime of the ImageSpatialSampler
      */
     ImageSpatialSampler(const Layer *layer)
-        : ImageSpatialSampler(layer->getRepresentation<LayerRAM>()) {}
+        : ImageSpatialSampler(layer->getSharedRepresentation<LayerRAM>()) {}
 
     /**
      * Creates a ImageSpatialSampler for the given Image, does not take ownership of ram.
@@ -138,6 +138,10 @@ protected:
     }
 
 private:
+    ImageSpatialSampler(std::shared_ptr<const LayerRAM> ram) : ImageSpatialSampler(ram.get()) {
+        sharedRam_ = std::move(ram);
+    }
+
     dvec4 getPixel(const size2_t &pos) const {
         auto p = glm::clamp(pos, size2_t(0), dims_ - size2_t(1));
         return layer_->getAsDVec4(p);
@@ -146,6 +150,8 @@ private:
     size2_t dims_;
 
     std::shared_ptr<const Image> sharedImage_;
+    // Keeps the MemoryManager from evicting the LayerRAM while the sampler is alive
+    std::shared_ptr<const LayerRAM> sharedRam_;
 };
 
 using ImageSampler = ImageSpatialSampler<4, double>;  // For backwards compatibility
@@ -186,12 +192,16 @@ public:
     T sample(P x, P y);
 
 private:
+    TemplateImageSampler(std::shared_ptr<const LayerRAM> ram);
+
     T getPixel(const size2_t &pos);
     const T *data_;
     size2_t dims_;
     util::IndexMapper2D ic_;
 
     std::shared_ptr<const Image> sharedImage_;
+    // Keeps the MemoryManager from evicting the LayerRAM while the sampler is alive
+    std::shared_ptr<const LayerRAM> sharedRam_;
 };
 
 template <typename T, typename P>
@@ -211,7 +221,13 @@ TemplateImageSampler<T, P>::TemplateImageSampler(const LayerRAM *ram)
 
 template <typename T, typename P>
 TemplateImageSampler<T, P>::TemplateImageSampler(const Layer *layer)
-    : TemplateImageSampler(layer->getRepresentation<LayerRAM>()) {}
+    : TemplateImageSampler(layer->getSharedRepresentation<LayerRAM>()) {}
+
+template <typename T, typename P>
+TemplateImageSampler<T, P>::TemplateImageSampler(std::shared_ptr<const LayerRAM> ram)
+    : TemplateImageSampler(ram.get()) {
+    sharedRam_ = std::move(ram);
+}
 
 template <typename T, typename P>
 TemplateImageSampler<T, P>::TemplateImageSampler(const Image *img)
@@ -0,0 +1,197 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/glmvec.h>
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+class ThreadPool;
+
+namespace util {
+
+namespace detail {
+
+/**
+ * Non owning reference to a chunk functor `void(size_t begin, size_t end)`. Keeps the scheduling
+ * code out of the templates.
+ */
+class ChunkRef {
+public:
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, ChunkRef>>>
+    ChunkRef(F& f)
+        : obj_{&f}, call_{[](void* obj, size_t begin, size_t end) {
+            (*static_cast<F*>(obj))(begin, end);
+        }} {}
+    void operator()(size_t begin, size_t end) const { call_(obj_, begin, end); }
+
+private:
+    void* obj_;
+    void (*call_)(void*, size_t, size_t);
+};
+
+struct NoStop {
+    constexpr explicit operator bool() const noexcept { return false; }
+};
+
+/**
+ * The pool used by parallelFor and parallelReduce, nullptr if there is no InviwoApplication.
+ * The number of threads is governed by the "Pool Size" system setting.
+ */
+IVW_CORE_API ThreadPool* getParallelPool();
+
+/**
+ * The number of elements per chunk used for a range of the given size. If grain is zero the
+ * range is split into about 4 chunks per available thread.
+ */
+IVW_CORE_API size_t getGrainSize(ThreadPool* pool, size_t size, size_t grain);
+
+/**
+ * Split [begin, end) into chunks of grain elements and call chunk for each of them using the
+ * calling thread and the workers of the pool. The chunks are distributed dynamically, hence the
+ * calling thread never waits for tasks that have not been started which makes it safe to nest
+ * calls. The first exception thrown by chunk is rethrown once all started chunks have finished,
+ * the remaining chunks are skipped.
+ */
+IVW_CORE_API void parallelChunks(ThreadPool* pool, size_t begin, size_t end, size_t grain,
+                                 ChunkRef chunk);
+
+}  // namespace detail
+
+/**
+ * Call body for all indices in [begin, end) using the Inviwo thread pool. The body can either take
+ * one index `void(size_t i)` or a sub range `void(size_t begin, size_t end)`. The latter is useful
+ * to set up temporary buffers once per chunk.
+ * If the pool size is zero everything is executed directly in the calling thread.
+ *
+ * @param begin first index
+ * @param end one past the last index
+ * @param body functor to call
+ * @param grain minimum number of indices per task, if zero (default) the range is split into
+ * about four tasks per thread.
+ * @param stop optional stop token, for example a pool::Stop, evaluated before each chunk. Once it
+ * is true the remaining chunks will be skipped.
+ */
+template <typename Body, typename Stop = detail::NoStop>
+void parallelFor(size_t begin, size_t end, Body&& body, size_t grain = 0,
+                 const Stop& stop = Stop{}) {
+    auto chunk = [&](size_t chunkBegin, size_t chunkEnd) {
+        if (static_cast<bool>(stop)) return;
+        if constexpr (std::is_invocable_v<Body&, size_t, size_t>) {
+            body(chunkBegin, chunkEnd);
+        } else {
+            for (size_t i = chunkBegin; i < chunkEnd; ++i) body(i);
+        }
+    };
+    detail::parallelChunks(detail::getParallelPool(), begin, end, grain, chunk);
+}
+
+/**
+ * Call body for all positions in dims using the Inviwo thread pool. The body should be callable
+ * as `void(const size2_t& pos)`. The work is split along rows, the grain is given in rows.
+ * @see parallelFor(size_t, size_t, Body&&, size_t, const Stop&)
+ */
+template <typename Body, typename Stop = detail::NoStop>
+void parallelFor(const size2_t& dims, Body&& body, size_t grain = 0, const Stop& stop = Stop{}) {
+    parallelFor(
+        size_t{0}, dims.y,
+        [&](size_t begin, size_t end) {
+            size2_t pos{0};
+            for (pos.y = begin; pos.y < end; ++pos.y) {
+                for (pos.x = 0; pos.x < dims.x; ++pos.x) {
+                    body(pos);
+                }
+            }
+        },
+        grain, stop);
+}
+
+/**
+ * Call body for all positions in dims using the Inviwo thread pool. The body should be callable
+ * as `void(const size3_t& pos)`. The work is split along lines in x, i.e. over both y and z, the
+ * grain is given in lines.
+ * @see parallelFor(size_t, size_t, Body&&, size_t, const Stop&)
+ */
+template <typename Body, typename Stop = detail::NoStop>
+void parallelFor(const size3_t& dims, Body&& body, size_t grain = 0, const Stop& stop = Stop{}) {
+    if (dims.y == 0) return;
+    parallelFor(
+        size_t{0}, dims.y * dims.z,
+        [&](size_t begin, size_t end) {
+            size3_t pos{0};
+            for (size_t line = begin; line < end; ++line) {
+                pos.y = line % dims.y;
+                pos.z = line / dims.y;
+                for (pos.x = 0; pos.x < dims.x; ++pos.x) {
+                    body(pos);
+                }
+            }
+        },
+        grain, stop);
+}
+
+/**
+ * Reduce the range [begin, end) in parallel using the Inviwo thread pool. The range is split in
+ * chunks and body is called as `T(size_t begin, size_t end, T init)` for each chunk with init set
+ * to identity. The partial results are then combined in chunk order using
+ * `T combine(T a, T b)`, hence the result does not depend on the number of threads for a given
+ * grain.
+ * @see parallelFor(size_t, size_t, Body&&, size_t, const Stop&)
+ */
+template <typename T, typename Body, typename Combine, typename Stop = detail::NoStop>
+T parallelReduce(size_t begin, size_t end, const T& identity, Body&& body, Combine&& combine,
+                 size_t grain = 0, const Stop& stop = Stop{}) {
+    if (end <= begin) return identity;
+
+    auto pool = detail::getParallelPool();
+    grain = detail::getGrainSize(pool, end - begin, grain);
+
+    std::vector<T> partials((end - begin + grain - 1) / grain, identity);
+    auto chunk = [&](size_t chunkBegin, size_t chunkEnd) {
+        if (static_cast<bool>(stop)) return;
+        partials[(chunkBegin - begin) / grain] = body(chunkBegin, chunkEnd, identity);
+    };
+    detail::parallelChunks(pool, begin, end, grain, chunk);
+
+    T result = identity;
+    for (auto& partial : partials) {
+        result = combine(std::move(result), std::move(partial));
+    }
+    return result;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
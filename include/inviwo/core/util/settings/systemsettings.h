@@ -32,6 +32,7 @@
 #include <inviwo/core/util/settings/settings.h>
 #include <inviwo/core/properties/optionproperty.h>
 #include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/buttonproperty.h>
 #include <inviwo/core/properties/ordinalproperty.h>
 #include <inviwo/core/properties/stringproperty.h>
 
@@ -51,6 +52,7 @@ public:
     StringProperty workspaceAuthor_;
     TemplateOptionProperty<UsageMode> applicationUsageMode_;
     IntSizeTProperty poolSize_;
+    BoolProperty parallelEvaluation_;
     BoolProperty enablePortInspectors_;
     IntProperty portInspectorSize_;
     BoolProperty enableTouchProperty_;
@@ -59,9 +61,12 @@ public:
     BoolProperty logStackTraceProperty_;
     BoolProperty runtimeModuleReloading_;
     BoolProperty enableResourceManager_;
+    IntSizeTProperty memoryBudget_;
     TemplateOptionProperty<MessageBreakLevel> breakOnMessage_;
     BoolProperty breakOnException_;
     BoolProperty stackTraceInException_;
+    BoolProperty enableTracing_;
+    ButtonProperty exportTrace_;
 
     BoolProperty redirectCout_;
     BoolProperty redirectCerr_;
@@ -32,10 +32,18 @@
 #include <inviwo/core/datastructures/spatialdata.h>
 #include <inviwo/core/datastructures/datatraits.h>
 
+#include <algorithm>
+#include <array>
+
+#include <tcb/span.hpp>
+
 namespace inviwo {
 
 /**
  * \class SpatialSampler
+ * Base class for sampling spatial data. Use sampleBatch to sample many positions at once, it
+ * transforms all positions to data space with a single matrix and does only one virtual call for
+ * the whole batch. Derived samplers can override sampleBatchDataSpace with a specialized loop.
  */
 template <unsigned int SpatialDims, unsigned int DataDims, typename T>
 class SpatialSampler {
@@ -60,6 +68,21 @@ public:
     virtual bool withinBounds(const Vector<SpatialDims, double> &pos, Space space) const;
     virtual bool withinBounds(const Vector<SpatialDims, float> &pos, Space space) const;
 
+    /**
+     * Sample all positions, given in the space of the sampler, and write the values to result.
+     * Gives the same values as calling sample for each position.
+     * @pre result.size() >= positions.size()
+     */
+    void sampleBatch(util::span<const Vector<SpatialDims, double>> positions,
+                     util::span<Vector<DataDims, T>> result) const;
+
+    /**
+     * Sample all positions, given in space, and write the values to result.
+     * @pre result.size() >= positions.size()
+     */
+    void sampleBatch(util::span<const Vector<SpatialDims, double>> positions,
+                     util::span<Vector<DataDims, T>> result, Space space) const;
+
     Matrix<SpatialDims, float> getBasis() const;
     Matrix<SpatialDims + 1, float> getModelMatrix() const;
     Matrix<SpatialDims + 1, float> getWorldMatrix() const;
@@ -70,9 +93,21 @@ protected:
     virtual Vector<DataDims, T> sampleDataSpace(const Vector<SpatialDims, double> &pos) const = 0;
     virtual bool withinBoundsDataSpace(const Vector<SpatialDims, double> &pos) const = 0;
 
+    /**
+     * Sample positions given in data space. The default implementation calls sampleDataSpace for
+     * each position.
+     */
+    virtual void sampleBatchDataSpace(util::span<const Vector<SpatialDims, double>> positions,
+                                      util::span<Vector<DataDims, T>> result) const;
+
     Space space_;
     const SpatialEntity<SpatialDims> &spatialEntity_;
     Matrix<SpatialDims + 1, double> transform_;
+
+private:
+    void transformAndSampleBatch(util::span<const Vector<SpatialDims, double>> positions,
+                                 util::span<Vector<DataDims, T>> result,
+                                 const Matrix<SpatialDims + 1, double> &toData) const;
 };
 
 template <unsigned int SpatialDims, unsigned int DataDims, typename T>
@@ -171,6 +206,57 @@ bool SpatialSampler<SpatialDims, DataDims, T>::withinBounds(const Vector<Spatial
     }
 }
 
+template <unsigned int SpatialDims, unsigned int DataDims, typename T>
+void SpatialSampler<SpatialDims, DataDims, T>::sampleBatch(
+    util::span<const Vector<SpatialDims, double>> positions,
+    util::span<Vector<DataDims, T>> result) const {
+    if (space_ != Space::Data) {
+        transformAndSampleBatch(positions, result, transform_);
+    } else {
+        sampleBatchDataSpace(positions, result);
+    }
+}
+
+template <unsigned int SpatialDims, unsigned int DataDims, typename T>
+void SpatialSampler<SpatialDims, DataDims, T>::sampleBatch(
+    util::span<const Vector<SpatialDims, double>> positions, util::span<Vector<DataDims, T>> result,
+    Space space) const {
+    if (space != Space::Data) {
+        transformAndSampleBatch(
+            positions, result,
+            Matrix<SpatialDims + 1, double>{
+                spatialEntity_.getCoordinateTransformer().getMatrix(space, Space::Data)});
+    } else {
+        sampleBatchDataSpace(positions, result);
+    }
+}
+
+template <unsigned int SpatialDims, unsigned int DataDims, typename T>
+void SpatialSampler<SpatialDims, DataDims, T>::transformAndSampleBatch(
+    util::span<const Vector<SpatialDims, double>> positions, util::span<Vector<DataDims, T>> result,
+    const Matrix<SpatialDims + 1, double> &toData) const {
+    // Transform the positions in blocks, to keep the temporary buffer on the stack
+    constexpr size_t blockSize = 256;
+    std::array<Vector<SpatialDims, double>, blockSize> dataPositions;
+    for (size_t begin = 0; begin < positions.size(); begin += blockSize) {
+        const size_t count = std::min(blockSize, positions.size() - begin);
+        for (size_t i = 0; i < count; ++i) {
+            const auto p = toData * Vector<SpatialDims + 1, double>(positions[begin + i], 1.0);
+            dataPositions[i] = Vector<SpatialDims, double>(p) / p[SpatialDims];
+        }
+        sampleBatchDataSpace({dataPositions.data(), count}, result.subspan(begin, count));
+    }
+}
+
+template <unsigned int SpatialDims, unsigned int DataDims, typename T>
+void SpatialSampler<SpatialDims, DataDims, T>::sampleBatchDataSpace(
+    util::span<const Vector<SpatialDims, double>> positions,
+    util::span<Vector<DataDims, T>> result) const {
+    for (size_t i = 0; i < positions.size(); ++i) {
+        result[i] = sampleDataSpace(positions[i]);
+    }
+}
+
 template <unsigned int SpatialDims, unsigned int DataDims, typename T>
 const SpatialCoordinateTransformer<SpatialDims>
     &SpatialSampler<SpatialDims, DataDims, T>::getCoordinateTransformer() const {
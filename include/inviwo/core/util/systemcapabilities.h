@@ -102,11 +102,11 @@ private:
     ProcessMemoryInfo infoProcRAM_;
     util::BuildInfo buildInfo_;
 
-    bool successOSInfo_;
-    bool successCPUInfo_;
-    bool successMemoryInfo_;
-    bool successDiskInfo_;
-    bool successProcessMemoryInfo_;
+    bool successOSInfo_ = false;
+    bool successCPUInfo_ = false;
+    bool successMemoryInfo_ = false;
+    bool successDiskInfo_ = false;
+    bool successProcessMemoryInfo_ = false;
 
 #ifdef IVW_USE_SIGAR
     sigar_t* sigar_;
@@ -52,7 +52,7 @@
  *
  *********************************************************************************/
 
-// following https://github.com/progschj/ThreadPool
+// Based on https://github.com/progschj/ThreadPool, altered to use work stealing and priorities
 
 #pragma once
 
@@ -61,21 +61,80 @@
 #include <warn/push>
 #include <warn/ignore/all>
 #include <vector>
-#include <queue>
+#include <deque>
+#include <array>
 #include <memory>
 #include <thread>
 #include <mutex>
+#include <shared_mutex>
 #include <condition_variable>
 #include <future>
 #include <functional>
 #include <stdexcept>
 #include <atomic>
+#include <chrono>
+#include <type_traits>
 #include <warn/pop>
 
 namespace inviwo {
 
+namespace detail {
+
+/**
+ * A move only type erased task, used to avoid the extra allocation of wrapping move only
+ * functors, like std::packaged_task, in a std::shared_ptr to make them copyable.
+ */
+class Task {
+public:
+    Task() = default;
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+    explicit Task(F&& f) : impl_{std::make_unique<Model<std::decay_t<F>>>(std::forward<F>(f))} {}
+    Task(const Task&) = delete;
+    Task(Task&&) noexcept = default;
+    Task& operator=(const Task&) = delete;
+    Task& operator=(Task&&) noexcept = default;
+    ~Task() = default;
+
+    void operator()() { impl_->call(); }
+    explicit operator bool() const noexcept { return static_cast<bool>(impl_); }
+
+private:
+    struct Concept {
+        virtual ~Concept() = default;
+        virtual void call() = 0;
+    };
+    template <typename F>
+    struct Model final : Concept {
+        template <typename U>
+        explicit Model(U&& f) : func{std::forward<U>(f)} {}
+        virtual void call() override { func(); }
+        F func;
+    };
+    std::unique_ptr<Concept> impl_;
+};
+
+}  // namespace detail
+
+/**
+ * A work stealing thread pool. Every worker has its own task queue (one deque per Priority).
+ * Tasks enqueued from outside the pool are put in a shared queue, while tasks enqueued from
+ * within a worker are put on the end of that worker's own queue. A worker will first run tasks
+ * from the end of its own queue, then from the shared queue, and lastly steal tasks from the front
+ * of the other workers' queues. Tasks of higher priority are always considered before tasks of
+ * lower priority.
+ *
+ * To wait for tasks from within a task (nested fork/join) use ThreadPool::wait, it will run other
+ * queued tasks while waiting instead of blocking the worker.
+ */
 class IVW_CORE_API ThreadPool {
 public:
+    enum class Priority : size_t {
+        High = 0,    //< Interactive tasks, i.e. PoolProcessor jobs.
+        Normal = 1,  //< Default
+        Low = 2      //< Background tasks, i.e. loading of data.
+    };
+    static constexpr size_t nPriorities = 3;
+
     ThreadPool(size_t threads, std::function<void()> onThreadStart = []() {},
                std::function<void()> onThreadStop = []() {});
     ~ThreadPool();
@@ -87,10 +146,33 @@ public:
     template <class F, class... Args>
     auto enqueue(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>;
 
+    /**
+     * Enqueue function f with arguments args using the given priority. The function f may throw
+     * exceptions.
+     * @return a future to the result of f
+     */
+    template <class F, class... Args>
+    auto enqueue(Priority priority, F&& f, Args&&... args)
+        -> std::future<std::invoke_result_t<F, Args...>>;
+
     /**
      * Enqueue a plain functor. The functor may not throw exceptions.
      */
-    void enqueueRaw(std::function<void()> f);
+    void enqueueRaw(std::function<void()> f, Priority priority = Priority::Normal);
+
+    /**
+     * Run one queued task in the calling thread if there is one.
+     * @return true if a task was run.
+     */
+    bool runPendingTask();
+
+    /**
+     * Wait for the future to become ready. If called from one of the workers of this pool, queued
+     * tasks will be run while waiting. This makes it safe to wait for tasks from within a task.
+     * From any other thread this is equivalent to future.wait().
+     */
+    template <typename T>
+    void wait(const std::future<T>& future);
 
     size_t trySetSize(size_t size);
     size_t getSize() const;
@@ -114,18 +196,39 @@ private:
         Worker& operator=(Worker&& rhs) = delete;
         ~Worker();
 
+        ThreadPool& pool;
         std::atomic<State> state;  //< State of the worker
+        std::mutex queue_mutex;    //< Guards tasks
+        std::array<std::deque<detail::Task>, nPriorities> tasks;
+        std::atomic<size_t> count;  //< Number of tasks in this worker's queue
         std::thread thread;
     };
+
+    /**
+     * The worker of this pool that is running in the calling thread, or nullptr.
+     */
+    Worker* currentWorker() const;
+    static Worker*& threadWorker();
+    void push(detail::Task task, Priority priority);
+    detail::Task pop(Worker* worker);
+
     // need to keep track of threads so we can join them
     std::vector<std::unique_ptr<Worker>> workers;
+    // guards the workers vector against modification while stealing
+    mutable std::shared_mutex workers_mutex;
+    std::atomic<size_t> nWorkers;
 
-    // the task queue
-    std::queue<std::function<void()>> tasks;
-
-    // synchronization
+    // the shared task queue
+    std::array<std::deque<detail::Task>, nPriorities> tasks;
     std::mutex queue_mutex;
+    std::atomic<size_t> count;  //< Number of tasks in the shared queue
+    // total number of queued tasks in the shared queue and all the worker queues
+    std::atomic<size_t> queued;
+
+    // synchronization for idle workers
+    std::mutex sleep_mutex;
     std::condition_variable condition;
+    std::atomic<size_t> sleeping;
 
     // Thread start end exit actions
     std::function<void()> onThreadStart_;
@@ -135,21 +238,36 @@ private:
 // add new work item to the pool
 template <class F, class... Args>
 auto ThreadPool::enqueue(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
+    return enqueue(Priority::Normal, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+template <class F, class... Args>
+auto ThreadPool::enqueue(Priority priority, F&& f, Args&&... args)
+    -> std::future<std::invoke_result_t<F, Args...>> {
     using return_type = std::invoke_result_t<F, Args...>;
 
-    auto task = std::make_shared<std::packaged_task<return_type()>>(
+    std::packaged_task<return_type()> task(
         std::bind(std::forward<F>(f), std::forward<Args>(args)...));
 
-    std::future<return_type> res = task->get_future();
+    std::future<return_type> res = task.get_future();
 
-    if (workers.empty()) {
-        (*task)();  // No worker threads, just run the task.
+    if (nWorkers == 0) {
+        task();  // No worker threads, just run the task.
     } else {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        tasks.emplace([task]() { (*task)(); });
+        push(detail::Task{std::move(task)}, priority);
     }
-    condition.notify_one();
     return res;
 }
 
+template <typename T>
+void ThreadPool::wait(const std::future<T>& future) {
+    if (!currentWorker()) {
+        future.wait();
+        return;
+    }
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        if (!runPendingTask()) future.wait_for(std::chrono::microseconds(100));
+    }
+}
+
 }  // namespace inviwo
@@ -0,0 +1,147 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \class Tracer
+ * \brief Records timed events, like the evaluation of processors and links, for profiling.
+ *
+ * Tracing is disabled by default and can be toggled at runtime, in the system settings or by
+ * calling setEnabled(). While disabled a TraceScope only checks an atomic flag. Each thread
+ * records into its own fixed size ring buffer without locking, when full the oldest events of
+ * the thread are overwritten. The recorded events can be retrieved with getEvents() or exported
+ * as Chrome trace event JSON, which can be viewed in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * The ProcessorNetworkEvaluator records the evaluation of the network and the
+ * initializeResources, inport onChange and process calls of each processor. The LinkEvaluator
+ * records each link that is evaluated and the PoolProcessor each background job.
+ * @see TraceScope
+ */
+class IVW_CORE_API Tracer {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /// Number of events kept for each thread
+    static constexpr size_t capacity = 8192;
+    /// Longer names are truncated
+    static constexpr size_t maxNameLength = 63;
+
+    struct Event {
+        const char* category;
+        std::string name;
+        /// Time since the tracer was first used
+        std::chrono::nanoseconds begin;
+        std::chrono::nanoseconds duration;
+        /// A small number identifying the recording thread
+        std::uint32_t thread;
+    };
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /**
+     * Record an event in the ring buffer of the calling thread, if tracing is enabled.
+     * @param category a string literal, or any other string that outlives the tracer
+     * @param name a descriptive name, truncated to maxNameLength characters
+     * @param begin start of the event
+     * @param end end of the event
+     */
+    static void record(const char* category, std::string_view name, clock::time_point begin,
+                       clock::time_point end);
+
+    /**
+     * Get the events recorded since the last call to clear(), from all threads, ordered by their
+     * begin time. Can be called while other threads are recording, events that are overwritten
+     * while they are read are skipped.
+     */
+    static std::vector<Event> getEvents();
+
+    /**
+     * Discard all events recorded so far
+     */
+    static void clear();
+
+    /**
+     * Write the events as Chrome trace event JSON
+     * @see getEvents
+     */
+    static void exportChromeTrace(std::ostream& os);
+    static void exportChromeTrace(const std::string& filename);
+};
+
+/**
+ * \class TraceScope
+ * \brief Records the lifetime of the scope as a Tracer event.
+ *
+ * The name can be given as a callable that returns a string, it is then only called when tracing
+ * is enabled. Hence names that have to be constructed add no cost when tracing is disabled:
+ * \code{.cpp}
+ *     TraceScope trace{"process", [&]() { return processor->getIdentifier(); }};
+ * \endcode
+ * The name is copied, it only has to be valid during the construction of the TraceScope.
+ */
+class IVW_CORE_API TraceScope {
+public:
+    TraceScope(const char* category, std::string_view name);
+
+    template <typename NameFunc,
+              typename = std::enable_if_t<std::is_invocable_v<NameFunc> &&
+                                          !std::is_convertible_v<NameFunc, std::string_view>>>
+    TraceScope(const char* category, NameFunc&& name) : category_{nullptr}, length_{0} {
+        if (Tracer::isEnabled()) start(category, std::string_view{name()});
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+    ~TraceScope();
+
+private:
+    void start(const char* category, std::string_view name);
+
+    const char* category_;  ///< nullptr if not recording
+    size_t length_;
+    std::array<char, Tracer::maxNameLength> name_;
+    Tracer::clock::time_point begin_;
+};
+
+}  // namespace inviwo
@@ -32,6 +32,7 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/parallel.h>
 
 namespace inviwo {
 
@@ -54,40 +55,18 @@ void forEachVoxel(const VolumeRAM &v, C callback) {
     forEachVoxel(v.getDimensions(), callback);
 }
 
+/**
+ * Call callback for each voxel position in dims using util::parallelFor. The volume is split in
+ * lines along x, if jobs is zero (default) the number of tasks is chosen based on the pool size,
+ * otherwise it is split into about jobs tasks.
+ */
 template <typename C>
 void forEachVoxelParallel(const size3_t dims, C callback, size_t jobs = 0) {
-    if (InviwoApplication::isInitialized() && jobs == 0) {
-        jobs = 4 * InviwoApplication::getPtr()->getPoolSize();
-    }
-
-    if (jobs == 0 || !InviwoApplication::isInitialized()) {
-        // fallback to serial version
-        forEachVoxel(dims, callback);
-        return;
-    }
-
-    std::vector<std::future<void>> futures;
-    for (size_t job = 0; job < jobs; ++job) {
-        size3_t start = size3_t(0, 0, job * dims.z / jobs);
-        size3_t stop = size3_t(dims.x, dims.y, std::min(dims.z, (job + 1) * dims.z / jobs));
-
-        futures.push_back(dispatchPool([&callback, start, stop]() {
-            size3_t pos{0};
-
-            for (pos.z = start.z; pos.z < stop.z; ++pos.z) {
-                for (pos.y = start.y; pos.y < stop.y; ++pos.y) {
-                    for (pos.x = start.x; pos.x < stop.x; ++pos.x) {
-                        callback(pos);
-                    }
-                }
-            }
-        }));
-    }
-
-    for (const auto &e : futures) {
-        e.wait();
-    }
+    const size_t lines = dims.y * dims.z;
+    const size_t grain = jobs == 0 ? 0 : (lines + jobs - 1) / jobs;
+    parallelFor(dims, callback, grain);
 }
+
 template <typename C>
 void forEachVoxelParallel(const VolumeRAM &v, C callback, size_t jobs = 0) {
     forEachVoxelParallel(v.getDimensions(), callback, jobs);
@@ -35,13 +35,21 @@
 #include <inviwo/core/util/interpolation.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumebricked.h>
 
 #include <inviwo/core/util/spatialsampler.h>
 
+#include <algorithm>
+
 namespace inviwo {
 
 /**
  * \class VolumeDoubleSampler
+ * Samples a volume using trilinear interpolation. If the volume can be accessed by bricks, \see
+ * util::getBrickedRepresentation, only the bricks that are sampled are loaded.
+ * For a VolumeRAM the data format is resolved once on construction, the voxels are then read
+ * directly from the typed data instead of through the virtual VolumeRAM::getAsDVec4 and friends.
  */
 template <unsigned int DataDims>
 class VolumeDoubleSampler : public SpatialSampler<3, DataDims, double> {
@@ -57,11 +65,31 @@ public:
     virtual bool withinBoundsDataSpace(const dvec3 &pos) const override;
 
 protected:
+    virtual void sampleBatchDataSpace(util::span<const dvec3> positions,
+                                      util::span<Vector<DataDims, double>> result) const override;
+
+    using TypedSampler = void (*)(const VolumeDoubleSampler &, util::span<const dvec3>,
+                                  util::span<Vector<DataDims, double>>);
+    /**
+     * Sample a VolumeRAMPrecision<T>, only using T and the data pointer of ram_
+     */
+    template <typename T>
+    static void sampleTyped(const VolumeDoubleSampler &sampler, util::span<const dvec3> positions,
+                            util::span<Vector<DataDims, double>> result);
+
     Vector<DataDims, double> getVoxel(const size3_t &pos) const;
+    /**
+     * Get the value at pos of a VolumeRAM or VolumeBricked
+     */
+    template <typename Repr>
+    static Vector<DataDims, double> getValue(const Repr &repr, const size3_t &pos);
 
     std::shared_ptr<const Volume> volume_;
-    const VolumeRAM *ram_;
+    const VolumeBricked *bricked_;
+    // Shared to keep the MemoryManager from evicting it while the sampler is alive
+    std::shared_ptr<const VolumeRAM> ram_;
     size3_t dims_;
+    TypedSampler typedSampler_ = nullptr;
 };
 
 using VolumeSampler = VolumeDoubleSampler<4>;
@@ -76,11 +104,23 @@ VolumeDoubleSampler<DataDims>::VolumeDoubleSampler(std::shared_ptr<const Volume>
 template <unsigned int DataDims>
 VolumeDoubleSampler<DataDims>::VolumeDoubleSampler(const Volume &vol, CoordinateSpace space)
     : SpatialSampler<3, DataDims, double>(vol, space)
-    , ram_(vol.getRepresentation<VolumeRAM>())
-    , dims_(vol.getDimensions()) {}
+    , bricked_(util::getBrickedRepresentation(vol))
+    , ram_(bricked_ ? nullptr : vol.getSharedRepresentation<VolumeRAM>())
+    , dims_(vol.getDimensions()) {
+    if (ram_) {
+        typedSampler_ = ram_->dispatch<TypedSampler>([](auto vrprecision) -> TypedSampler {
+            return &sampleTyped<util::PrecisionValueType<decltype(vrprecision)>>;
+        });
+    }
+}
 
 template <unsigned int DataDims>
 Vector<DataDims, double> VolumeDoubleSampler<DataDims>::sampleDataSpace(const dvec3 &pos) const {
+    if (typedSampler_) {
+        Vector<DataDims, double> res;
+        typedSampler_(*this, {&pos, 1}, {&res, 1});
+        return res;
+    }
     if (!withinBoundsDataSpace(pos)) {
         return Vector<DataDims, double>(0.0);
     }
@@ -89,41 +129,104 @@ Vector<DataDims, double> VolumeDoubleSampler<DataDims>::sampleDataSpace(const dv
     const dvec3 interpolants = samplePos - dvec3(indexPos);
 
     Vector<DataDims, double> samples[8];
-    samples[0] = getVoxel(indexPos);
-    samples[1] = getVoxel(indexPos + size3_t(1, 0, 0));
-    samples[2] = getVoxel(indexPos + size3_t(0, 1, 0));
-    samples[3] = getVoxel(indexPos + size3_t(1, 1, 0));
-
-    samples[4] = getVoxel(indexPos + size3_t(0, 0, 1));
-    samples[5] = getVoxel(indexPos + size3_t(1, 0, 1));
-    samples[6] = getVoxel(indexPos + size3_t(0, 1, 1));
-    samples[7] = getVoxel(indexPos + size3_t(1, 1, 1));
+    // Corner i is at indexPos + (i & 1, (i >> 1) & 1, (i >> 2) & 1), relative to offset in repr
+    const auto fetch = [&](const auto &repr, const size3_t &offset) {
+        for (size_t i = 0; i < 8; ++i) {
+            const size3_t corner{indexPos.x + (i & 1), indexPos.y + ((i >> 1) & 1),
+                                 indexPos.z + ((i >> 2) & 1)};
+            samples[i] = getValue(repr, glm::min(corner, dims_ - size3_t(1)) - offset);
+        }
+    };
+
+    if (ram_) {
+        fetch(*ram_, size3_t(0));
+    } else {
+        // Look up the brick once if all the corners are within the same brick
+        const auto &brickSize = bricked_->getBrickSize();
+        const auto first = indexPos / brickSize;
+        const auto last = glm::min(indexPos + size3_t(1), dims_ - size3_t(1)) / brickSize;
+        if (first == last) {
+            fetch(*bricked_->getBrick(first), first * brickSize);
+        } else {
+            fetch(*bricked_, size3_t(0));
+        }
+    }
 
     return Interpolation<Vector<DataDims, double>>::trilinear(samples, interpolants);
 }
 
-template <>
-inline Vector<1, double> VolumeDoubleSampler<1>::getVoxel(const size3_t &pos) const {
-    const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
-    return ram_->getAsDouble(p);
+template <unsigned int DataDims>
+void VolumeDoubleSampler<DataDims>::sampleBatchDataSpace(
+    util::span<const dvec3> positions, util::span<Vector<DataDims, double>> result) const {
+    if (typedSampler_) {
+        typedSampler_(*this, positions, result);
+    } else {
+        SpatialSampler<3, DataDims, double>::sampleBatchDataSpace(positions, result);
+    }
 }
 
-template <>
-inline Vector<2, double> VolumeDoubleSampler<2>::getVoxel(const size3_t &pos) const {
-    const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
-    return ram_->getAsDVec2(p);
+template <unsigned int DataDims>
+template <typename T>
+void VolumeDoubleSampler<DataDims>::sampleTyped(const VolumeDoubleSampler &sampler,
+                                                util::span<const dvec3> positions,
+                                                util::span<Vector<DataDims, double>> result) {
+    using V = Vector<DataDims, double>;
+    const auto data = static_cast<const T *>(sampler.ram_->getData());
+    const size3_t last = sampler.dims_ - size3_t(1);
+    const dvec3 scale{last};
+    const size_t strideY = sampler.dims_.x;
+    const size_t strideZ = sampler.dims_.x * sampler.dims_.y;
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const dvec3 &pos = positions[i];
+        if (!sampler.VolumeDoubleSampler::withinBoundsDataSpace(pos)) {
+            result[i] = V(0.0);
+            continue;
+        }
+        const dvec3 samplePos = pos * scale;
+        const size3_t indexPos = size3_t(samplePos);
+        const dvec3 interpolants = samplePos - dvec3(indexPos);
+
+        // The corners are clamped to the volume, as in the generic path
+        const size_t x0 = std::min(indexPos.x, last.x);
+        const size_t x1 = std::min(indexPos.x + 1, last.x);
+        const size_t y0 = std::min(indexPos.y, last.y) * strideY;
+        const size_t y1 = std::min(indexPos.y + 1, last.y) * strideY;
+        const size_t z0 = std::min(indexPos.z, last.z) * strideZ;
+        const size_t z1 = std::min(indexPos.z + 1, last.z) * strideZ;
+
+        const V samples[8] = {util::glm_convert<V>(data[x0 + y0 + z0]),
+                              util::glm_convert<V>(data[x1 + y0 + z0]),
+                              util::glm_convert<V>(data[x0 + y1 + z0]),
+                              util::glm_convert<V>(data[x1 + y1 + z0]),
+                              util::glm_convert<V>(data[x0 + y0 + z1]),
+                              util::glm_convert<V>(data[x1 + y0 + z1]),
+                              util::glm_convert<V>(data[x0 + y1 + z1]),
+                              util::glm_convert<V>(data[x1 + y1 + z1])};
+
+        result[i] = Interpolation<V>::trilinear(samples, interpolants);
+    }
 }
 
-template <>
-inline Vector<3, double> VolumeDoubleSampler<3>::getVoxel(const size3_t &pos) const {
-    const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
-    return ram_->getAsDVec3(p);
+template <unsigned int DataDims>
+template <typename Repr>
+Vector<DataDims, double> VolumeDoubleSampler<DataDims>::getValue(const Repr &repr,
+                                                                const size3_t &pos) {
+    if constexpr (DataDims == 1) {
+        return repr.getAsDouble(pos);
+    } else if constexpr (DataDims == 2) {
+        return repr.getAsDVec2(pos);
+    } else if constexpr (DataDims == 3) {
+        return repr.getAsDVec3(pos);
+    } else {
+        return repr.getAsDVec4(pos);
+    }
 }
 
-template <>
-inline Vector<4, double> VolumeDoubleSampler<4>::getVoxel(const size3_t &pos) const {
+template <unsigned int DataDims>
+Vector<DataDims, double> VolumeDoubleSampler<DataDims>::getVoxel(const size3_t &pos) const {
     const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
-    return ram_->getAsDVec4(p);
+    return ram_ ? getValue(*ram_, p) : getValue(*bricked_, p);
 }
 
 template <unsigned int DataDims>
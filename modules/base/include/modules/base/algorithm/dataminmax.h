@@ -33,6 +33,12 @@
 #include <modules/base/basemoduledefine.h>
 #include <inviwo/core/common/inviwo.h>
 #include <modules/base/algorithm/algorithmoptions.h>
+#include <inviwo/core/util/parallel.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <type_traits>
 
 namespace inviwo {
 
@@ -66,50 +72,117 @@ IVW_MODULE_BASE_API std::pair<dvec4, dvec4> bufferMinMax(
 
 namespace detail {
 
-// Specialization for double, float, half
-template <typename ValueType,
-          typename std::enable_if<util::is_floating_point<ValueType>::value, int>::type = 0>
-std::pair<dvec4, dvec4> dataMinMax(const ValueType* data, size_t size,
-                                   IgnoreSpecialValues ignore = IgnoreSpecialValues::No) {
-    using Res = std::pair<ValueType, ValueType>;
-    Res minmax{DataFormat<ValueType>::max(), DataFormat<ValueType>::lowest()};
-
-    if (ignore == IgnoreSpecialValues::Yes) {
-        minmax = std::accumulate(
-            data, data + size, minmax, [](const Res& mm, const ValueType& v) -> Res {
-                Res res(mm);
-                for (size_t i = 0; i < util::flat_extent<ValueType>::value; ++i) {
-                    if (util::isfinite(util::glmcomp(v, i))) {
-                        util::glmcomp(res.first, i) =
-                            std::min(util::glmcomp(mm.first, i), util::glmcomp(v, i));
-                        util::glmcomp(res.second, i) =
-                            std::max(util::glmcomp(mm.second, i), util::glmcomp(v, i));
-                    }
-                }
-                return res;
-            });
-    } else {
-        minmax = std::accumulate(data, data + size, minmax,
-                                 [](const Res& mm, const ValueType& v) -> Res {
-                                     return {glm::min(mm.first, v), glm::max(mm.second, v)};
-                                 });
+template <typename T, size_t Extent>
+struct ComponentMinMax {
+    std::array<T, Extent> min;
+    std::array<T, Extent> max;
+};
+
+// The limits of T stored as A
+template <typename T, typename A, size_t Extent>
+ComponentMinMax<A, Extent> initialMinMax() {
+    ComponentMinMax<A, Extent> res;
+    res.min.fill(static_cast<A>(std::numeric_limits<T>::max()));
+    res.max.fill(static_cast<A>(std::numeric_limits<T>::lowest()));
+    return res;
+}
+
+/**
+ * Component wise min and max of size values with Extent components each, stored consecutively in
+ * data. The loop keeps a number of independent lanes, lane l only sees component l % Extent, and
+ * uses branch free updates so that the compiler can vectorize it using the instruction set of the
+ * target (SSE, AVX2, NEON, ...). Comparisons with NaN are always false, hence NaN never changes
+ * the result. If IgnoreSpecial is true infinite values are skipped as well.
+ */
+template <bool IgnoreSpecial, size_t Extent, typename T>
+void componentMinMax(const T* data, size_t size, ComponentMinMax<T, Extent>& res) {
+    constexpr size_t lanes = std::max<size_t>(1, 64 / (sizeof(T) * Extent)) * Extent;
+    std::array<T, lanes> min;
+    std::array<T, lanes> max;
+    for (size_t l = 0; l < lanes; ++l) {
+        min[l] = res.min[l % Extent];
+        max[l] = res.max[l % Extent];
     }
 
-    return {util::glm_convert<dvec4>(minmax.first), util::glm_convert<dvec4>(minmax.second)};
+    const auto update = [](T v, T& lmin, T& lmax) {
+        bool valid = true;
+        if constexpr (IgnoreSpecial) valid = (v - v) == T{0};  // false for inf and NaN
+        lmin = (valid & (v < lmin)) ? v : lmin;
+        lmax = (valid & (v > lmax)) ? v : lmax;
+    };
+
+    const size_t components = size * Extent;
+    size_t i = 0;
+    for (; i + lanes <= components; i += lanes) {
+        for (size_t l = 0; l < lanes; ++l) update(data[i + l], min[l], max[l]);
+    }
+    for (size_t l = 0; i < components; ++i, ++l) update(data[i], min[l], max[l]);
+
+    for (size_t l = 0; l < lanes; ++l) {
+        res.min[l % Extent] = std::min(res.min[l % Extent], min[l]);
+        res.max[l % Extent] = std::max(res.max[l % Extent], max[l]);
+    }
 }
-// Specialization for integer types. They do not have special values
-template <typename ValueType,
-          typename std::enable_if<!util::is_floating_point<ValueType>::value, int>::type = 0>
+
+// Half precision values are converted to float in small blocks, since there is no native half
+// arithmetic the conversion is needed anyway.
+template <bool IgnoreSpecial, size_t Extent>
+void componentMinMax(const half_float::half* data, size_t size,
+                     ComponentMinMax<float, Extent>& res) {
+    constexpr size_t blockSize = 256;
+    std::array<float, blockSize * Extent> block;
+    for (size_t begin = 0; begin < size; begin += blockSize) {
+        const size_t count = std::min(blockSize, size - begin);
+        std::transform(data + begin * Extent, data + (begin + count) * Extent, block.begin(),
+                       [](half_float::half v) { return static_cast<float>(v); });
+        componentMinMax<IgnoreSpecial>(block.data(), count, res);
+    }
+}
+
+/**
+ * Compute the component wise min and max in parallel using util::parallelReduce, chunks are
+ * processed using componentMinMax.
+ */
+template <typename ValueType>
 std::pair<dvec4, dvec4> dataMinMax(const ValueType* data, size_t size,
-                                   IgnoreSpecialValues = IgnoreSpecialValues::No) {
-    using Res = std::pair<ValueType, ValueType>;
-    Res minmax{DataFormat<ValueType>::max(), DataFormat<ValueType>::lowest()};
-    minmax =
-        std::accumulate(data, data + size, minmax, [](const Res& mm, const ValueType& v) -> Res {
-            return {glm::min(mm.first, v), glm::max(mm.second, v)};
-        });
-
-    return {util::glm_convert<dvec4>(minmax.first), util::glm_convert<dvec4>(minmax.second)};
+                                   IgnoreSpecialValues ignore = IgnoreSpecialValues::No) {
+    using T = typename util::value_type<ValueType>::type;
+    // Accumulate half values as float
+    using A = std::conditional_t<std::is_same_v<T, half_float::half>, float, T>;
+    constexpr size_t extent = util::flat_extent<ValueType>::value;
+    static_assert(sizeof(ValueType) == extent * sizeof(T), "Components have to be packed");
+
+    const auto flat = reinterpret_cast<const T*>(data);
+    const bool ignoreSpecial =
+        util::is_floating_point<T>::value && ignore == IgnoreSpecialValues::Yes;
+
+    // Use large chunks, the kernel is limited by memory bandwidth.
+    const size_t grain = std::max(size_t{1} << 16, size / 256);
+    const auto res = util::parallelReduce(
+        size_t{0}, size, initialMinMax<T, A, extent>(),
+        [&](size_t begin, size_t end, ComponentMinMax<A, extent> minmax) {
+            if (ignoreSpecial) {
+                componentMinMax<true>(flat + begin * extent, end - begin, minmax);
+            } else {
+                componentMinMax<false>(flat + begin * extent, end - begin, minmax);
+            }
+            return minmax;
+        },
+        [](ComponentMinMax<A, extent> a, const ComponentMinMax<A, extent>& b) {
+            for (size_t i = 0; i < extent; ++i) {
+                a.min[i] = std::min(a.min[i], b.min[i]);
+                a.max[i] = std::max(a.max[i], b.max[i]);
+            }
+            return a;
+        },
+        grain);
+
+    std::pair<dvec4, dvec4> minmax{dvec4{0.0}, dvec4{0.0}};
+    for (size_t i = 0; i < std::min<size_t>(4, extent); ++i) {
+        minmax.first[i] = static_cast<double>(static_cast<T>(res.min[i]));
+        minmax.second[i] = static_cast<double>(static_cast<T>(res.max[i]));
+    }
+    return minmax;
 }
 
 }  // namespace detail
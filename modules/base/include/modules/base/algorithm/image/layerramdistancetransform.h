@@ -35,10 +35,7 @@
 #include <inviwo/core/datastructures/image/layer.h>
 #include <inviwo/core/datastructures/image/layerram.h>
 #include <inviwo/core/datastructures/image/layerramprecision.h>
-
-#ifdef IVW_USE_OPENMP
-#include <omp.h>
-#endif
+#include <inviwo/core/util/parallel.h>
 
 namespace inviwo {
 
@@ -96,10 +93,6 @@ void util::layerRAMDistanceTransform(const LayerRAMPrecision<T>* inLayer,
                                      Predicate predicate, ValueTransform valueTransform,
                                      ProgressCallback callback) {
 
-#ifdef IVW_USE_OPENMP
-    omp_set_num_threads(std::thread::hardware_concurrency());
-#endif
-
     using int64 = glm::int64;
 
     auto square = [](auto a) { return a * a; };
@@ -153,12 +146,11 @@ void util::layerRAMDistanceTransform(const LayerRAMPrecision<T>* inLayer,
         return predicate(src[srcInd(x / sm.x, y / sm.y)]);
     };
 
-// first pass, forward and backward scan along x
-// result: min distance in x direction
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64 y = 0; y < dstDim.y; ++y) {
+    // first pass, forward and backward scan along x
+    // result: min distance in x direction
+    util::parallelFor(size_t{0}, static_cast<size_t>(dstDim.y), [&](size_t row) {
+        const auto y = static_cast<int64>(row);
+
         // forward
         U dist = static_cast<U>(dstDim.x);
         for (int64 x = 0; x < dstDim.x; ++x) {
@@ -180,22 +172,15 @@ void util::layerRAMDistanceTransform(const LayerRAMPrecision<T>* inLayer,
             }
             dst[dstInd(x, y)] = std::min<U>(dst[dstInd(x, y)], squareVoxelSize.x * square(dist));
         }
-    }
+    });
 
     // second pass, scan y direction
     // for each voxel v(x,y,z) find min_i(data(x,i,z) + (y - i)^2), 0 <= i < dimY
     // result: min distance in x and y direction
     callback(0.45);
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel
-#endif
-    {
-        std::vector<U> buff;
-        buff.resize(dstDim.y);
-#ifdef IVW_USE_OPENMP
-#pragma omp for
-#endif
-        for (int64 x = 0; x < dstDim.x; ++x) {
+    util::parallelFor(size_t{0}, static_cast<size_t>(dstDim.x), [&](size_t begin, size_t end) {
+        std::vector<U> buff(dstDim.y);
+        for (auto x = static_cast<int64>(begin); x < static_cast<int64>(end); ++x) {
 
             // cache column data into temporary buffer
             for (int64 y = 0; y < dstDim.y; ++y) {
@@ -216,17 +201,12 @@ void util::layerRAMDistanceTransform(const LayerRAMPrecision<T>* inLayer,
                 dst[dstInd(x, y)] = d;
             }
         }
-    }
+    });
 
     // scale data
     callback(0.9);
-    const int64 layerSize = dstDim.x * dstDim.y;
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64 i = 0; i < layerSize; ++i) {
-        dst[i] = valueTransform(dst[i]);
-    }
+    const auto layerSize = static_cast<size_t>(dstDim.x * dstDim.y);
+    util::parallelFor(size_t{0}, layerSize, [&](size_t i) { dst[i] = valueTransform(dst[i]); });
     callback(1.0);
 }
 
@@ -0,0 +1,160 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+
+#include <inviwo/core/datastructures/image/imagetypes.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/util/glm.h>
+
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+class Image;
+class Layer;
+class LayerRAM;
+
+/**
+ * Weights for converting a color into a luminance value, see util::layerGrayscale.
+ */
+enum class LuminanceModel { Perceived, Relative, Average, RedOnly, GreenOnly, BlueOnly };
+
+/**
+ * Blend modes of util::layerMix, the same as the ones of the ImageMixer processor.
+ */
+enum class ImageBlendMode {
+    Mix,           //!< f(a,b) = a * (1 - weight) + b * weight
+    Over,          //!< f(a,b) = b over a, regular front-to-back blending
+    Multiply,      //!< f(a,b) = a * b
+    Screen,        //!< f(a,b) = 1 - (1 - a) * (1 - b)
+    Overlay,       //!< f(a,b) = 2 * a * b if a < 0.5, 1 - 2(1 - a)(1 - b) otherwise
+    HardLight,     //!< Overlay with a and b swapped
+    Divide,        //!< f(a,b) = a / b
+    Addition,      //!< f(a,b) = a + b
+    Subtraction,   //!< f(a,b) = a - b
+    Difference,    //!< f(a,b) = |a - b|
+    DarkenOnly,    //!< f(a,b) = min(a, b), per component
+    BrightenOnly,  //!< f(a,b) = max(a, b), per component
+};
+
+/*
+ * Image filters on the CPU, versions of the image processing shaders of the BaseGL module for
+ * machines without a GPU. Like a texture lookup, the input is read as normalized RGBA: integer
+ * formats are mapped to [0, 1] or [-1, 1], missing color channels are zero, and a missing alpha
+ * channel is one. All filters return float layers. Samples outside of the layer are clamped to the
+ * border.
+ *
+ * The layers are processed in blocks of rows on the thread pool. The inner loops work on
+ * contiguous rows of vec4, so that the compiler can vectorize them for the target instruction set.
+ */
+namespace util {
+
+//! Read any layer as normalized RGBA floats
+IVW_MODULE_BASE_API std::shared_ptr<LayerRAMPrecision<vec4>> layerToRGBA(const LayerRAM& layer);
+
+/**
+ * \brief Convolve the layer with the same 1D kernel along both axes
+ * The kernel should have odd size, its center is applied to the current pixel.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<LayerRAMPrecision<vec4>> layerSeparableConvolution(
+    const LayerRAM& layer, const std::vector<float>& kernel);
+
+/**
+ * \brief Average over a square window of size kernelSize
+ * Even kernel sizes are rounded up to the next odd size.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<LayerRAMPrecision<vec4>> layerLowPass(const LayerRAM& layer,
+                                                                          int kernelSize);
+
+/**
+ * \brief Gaussian smoothing
+ * The kernel covers +- 2.576 sigma, which contains 99% of the weight.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<LayerRAMPrecision<vec4>> layerGaussianLowPass(
+    const LayerRAM& layer, float sigma);
+
+/**
+ * \brief Difference between each pixel and the average of its neighbors in a square window
+ * The result is (p - avg + 1) / 2, or 2p - avg if sharpen is true. Only the color channels are
+ * filtered, alpha is kept.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<LayerRAMPrecision<vec4>> layerHighPass(const LayerRAM& layer,
+                                                                           int kernelSize,
+                                                                           bool sharpen);
+
+/**
+ * \brief Gradient of one channel using central differences
+ * The gradient is per pixel, or if renormalize is true scaled by the width of the layer along
+ * both axes, matching the GLSL Image Gradient processor.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<LayerRAMPrecision<vec2>> layerGradient(const LayerRAM& layer,
+                                                                           size_t channel,
+                                                                           bool renormalize);
+
+IVW_MODULE_BASE_API vec3 luminanceWeights(LuminanceModel model);
+
+//! Replace the color of each pixel by its luminance, alpha is kept
+IVW_MODULE_BASE_API std::shared_ptr<LayerRAMPrecision<vec4>> layerGrayscale(const LayerRAM& layer,
+                                                                            LuminanceModel model);
+
+//! White where the first channel is larger or equal to threshold, black otherwise
+IVW_MODULE_BASE_API std::shared_ptr<LayerRAMPrecision<vec4>> layerBinary(const LayerRAM& layer,
+                                                                         float threshold);
+
+/**
+ * \brief Blend two layers of the same size
+ * The color channels are combined according to mode, the alpha channel is the maximum of the two
+ * except for Mix and Over.
+ * @throw Exception if the dimensions differ
+ */
+IVW_MODULE_BASE_API std::shared_ptr<LayerRAMPrecision<vec4>> layerMix(const LayerRAM& a,
+                                                                      const LayerRAM& b,
+                                                                      ImageBlendMode mode,
+                                                                      float weight,
+                                                                      bool clampValues = false);
+
+//! Resample the layer to new dimensions using linear or nearest neighbor interpolation
+IVW_MODULE_BASE_API std::shared_ptr<LayerRAMPrecision<vec4>> layerResample(
+    const LayerRAM& layer, size2_t dimensions,
+    InterpolationType interpolation = InterpolationType::Linear);
+
+/**
+ * \brief Wrap a filtered representation in a new image
+ * The model and world matrices, and the meta data, are taken from source.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<Image> filteredImage(std::shared_ptr<LayerRAM> result,
+                                                         const Image& source);
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -48,7 +48,9 @@ namespace util {
  * Extracts an iso surface from a volume using the Marching Cubes algorithm
  *
  * Note: Shares interface with util::marchingcbes and util::marchingtetrahedron
- * This is an optimized version of util::marchingcubes
+ * This is an optimized version of util::marchingcubes. The volume is split into slabs along z
+ * which are processed in parallel on the thread pool, blocks of cells without any iso crossing are
+ * skipped. Vertices on the boundary between two slabs are shared, not duplicated.
  *
  * @param volume the scalar volume
  * @param iso iso-value for the extracted surface
@@ -57,9 +59,9 @@ namespace util {
  * iso-value is 'outside' of the surface)
  * @param enclose whether to create surface where the iso surface intersects the volume boundaries
  * @param progressCallback if set, will be called will executing with the current progress in the
- * interval [0,1], useful for progress bars
+ * interval [0,1], useful for progress bars, calls might come from any thread but are never concurrent
  * @param maskingCallback optional callback to test whether current cell should be evaluated or not
- * (return true to include current cell)
+ * (return true to include current cell). Will be called concurrently from several threads.
  */
 
 IVW_MODULE_BASE_API std::shared_ptr<Mesh> marchingCubesOpt(
@@ -0,0 +1,175 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/processors/poolprocessor.h>
+#include <inviwo/core/util/glm.h>
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+class Volume;
+
+/**
+ * A lazily built mip pyramid of a Volume. Level 0 is the volume itself and each following level
+ * halves the dimensions of the previous one, along all axes larger than one, using a box filter
+ * (util::volumeSubSample). Levels are added until all dimensions are at most minDimension.
+ *
+ * A level is only built when it is asked for, either blocking with getLevel, or in the background
+ * with request. Once built a level is kept until the pyramid is destroyed. Level one of a volume
+ * that is accessed by bricks (util::getBrickedRepresentation) is built one block of bricks at a
+ * time, hence the full resolution volume is never loaded into memory.
+ *
+ * Pyramids are shared using VolumePyramid::get, which returns the same pyramid for the same
+ * volume as long as someone holds on to it. Hence a processor should keep the pyramid of its input
+ * as a member to reuse the levels between evaluations. The pyramid does not keep the volume alive,
+ * levels can only be built while someone else holds on to it. The volume is assumed not to be
+ * modified while it has a pyramid, as for any data that has been put on an outport.
+ *
+ * A typical use in a PoolProcessor is to show the best level available now, and dispatch a job to
+ * get the requested one:
+ * \code{.cpp}
+ * pyramid_ = VolumePyramid::get(inport_.getData());
+ * if (auto best = pyramid_->getBestAvailable(level)) {
+ *     outport_.setData(best->second);
+ * }
+ * if (!pyramid_->isAvailable(level)) {
+ *     dispatchOne([pyramid = pyramid_, level](pool::Stop stop, pool::Progress progress) {
+ *         return pyramid->getLevel(level, stop, progress);
+ *     }, [this](std::shared_ptr<const Volume> result) {
+ *         outport_.setData(result);
+ *         newResults();
+ *     });
+ * }
+ * \endcode
+ */
+class IVW_MODULE_BASE_API VolumePyramid : public std::enable_shared_from_this<VolumePyramid> {
+public:
+    static constexpr size_t minDimension = 16;
+
+    /**
+     * Get the pyramid of volume, creating it if there is none. The pyramid only keeps a weak
+     * reference to the volume.
+     */
+    static std::shared_ptr<VolumePyramid> get(const std::shared_ptr<const Volume>& volume);
+
+    VolumePyramid(const VolumePyramid&) = delete;
+    VolumePyramid& operator=(const VolumePyramid&) = delete;
+    ~VolumePyramid();
+
+    /**
+     * The volume of the pyramid, or nullptr if it has been destroyed.
+     */
+    std::shared_ptr<const Volume> getVolume() const;
+    size_t getNumberOfLevels() const;
+    size3_t getDimensions(size_t level) const;
+
+    /**
+     * The subsample factors used to build level from level - 1, one or two along each axis.
+     */
+    size3_t getFactors(size_t level) const;
+
+    /**
+     * Find the level that results from subsampling the volume by factors, i.e. if factors is
+     * 2^level along all axes larger than one.
+     */
+    std::optional<size_t> findLevel(const size3_t& factors) const;
+
+    /**
+     * Get level, building it and all finer levels if needed. Blocks until the level is
+     * available. Can be called from any thread, a level is only built once.
+     * @param level the level, has to be less than getNumberOfLevels()
+     * @param progress optional callback reporting the progress in [0, 1]
+     * @throw Exception if the volume has been destroyed before the level was built
+     */
+    std::shared_ptr<const Volume> getLevel(size_t level,
+                                           const std::function<void(float)>& progress = {});
+
+    /**
+     * Same as above, but stops building levels and returns nullptr as soon as stop returns true.
+     * Levels that were stopped are built by the next call asking for them.
+     */
+    std::shared_ptr<const Volume> getLevel(size_t level, const std::function<bool()>& stop,
+                                           const std::function<void(float)>& progress = {});
+
+    /**
+     * Overload to be used in the jobs of a PoolProcessor, returns nullptr if the job is stopped.
+     */
+    std::shared_ptr<const Volume> getLevel(size_t level, pool::Stop stop,
+                                           const std::function<void(float)>& progress = {}) {
+        return getLevel(
+            level, [stop]() { return static_cast<bool>(stop); }, progress);
+    }
+
+    /**
+     * Is level built. Level 0 is considered available if the volume has a VolumeRAM.
+     */
+    bool isAvailable(size_t level) const;
+
+    /**
+     * The available level closest to level, preferring coarser levels over finer ones since they
+     * are cheaper to use. Returns std::nullopt if no level is available.
+     */
+    std::optional<std::pair<size_t, std::shared_ptr<const Volume>>> getBestAvailable(
+        size_t level) const;
+
+    /**
+     * Build all levels up to and including level in the background, using the thread pool with low
+     * priority. Does nothing if there is no InviwoApplication.
+     */
+    void request(size_t level);
+
+private:
+    struct Level {
+        size3_t dimensions;
+        std::once_flag once;
+        std::promise<std::shared_ptr<const Volume>> promise;
+        std::shared_future<std::shared_ptr<const Volume>> result;
+        std::atomic<bool> ready{false};
+    };
+
+    explicit VolumePyramid(const std::shared_ptr<const Volume>& volume);
+    std::shared_ptr<const Volume> build(size_t level, const std::function<bool()>& stop,
+                                        const std::function<void(float)>& progress);
+
+    std::weak_ptr<const Volume> volume_;
+    std::vector<std::unique_ptr<Level>> levels_;
+};
+
+}  // namespace inviwo
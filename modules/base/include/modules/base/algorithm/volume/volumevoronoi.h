@@ -38,6 +38,12 @@
 #include <vector>
 
 namespace inviwo {
+
+enum class VoronoiAlgorithm {
+    BruteForce,  ///< Compare every voxel to every seed point
+    KDTree       ///< Find the closest seed point of each voxel using a FlatKDTree
+};
+
 namespace util {
 
 /**
@@ -55,12 +61,18 @@ namespace util {
  *     * weigths is an optional vector containing the weights for each seed point.
  *     * weightedVoronoi is a boolean deciding if the weighted version of voronoi should be used.
  *       If true, the weights must be provided.
+ *     * algorithm selects how the closest seed point is found. Both algorithms give the same
+ *       result, the voxels are processed in parallel in either case. VoronoiAlgorithm::KDTree
+ *       puts the seed points in a FlatKDTree, the weighted version lifts them into four
+ *       dimensions such that the closest point in 4D is the closest according to the power
+ *       distance. VoronoiAlgorithm::BruteForce is only faster for a handful of seed points.
  */
 
 IVW_MODULE_BASE_API std::shared_ptr<Volume> voronoiSegmentation(
     const size3_t volumeDimensions, const mat4& indexToModelMatrix,
     const std::vector<std::pair<uint32_t, vec3>>& seedPointsWithIndices,
-    const std::optional<std::vector<float>>& weights, bool weightedVoronoi);
+    const std::optional<std::vector<float>>& weights, bool weightedVoronoi,
+    VoronoiAlgorithm algorithm = VoronoiAlgorithm::KDTree);
 
 }  // namespace util
 }  // namespace inviwo
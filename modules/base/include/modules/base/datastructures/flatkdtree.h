@@ -0,0 +1,342 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/parallel.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * A static, balanced KD-tree stored in flat arrays. The tree is built once from a set of points
+ * and can then be queried for the nearest point, the k nearest points, or all points within a
+ * radius. Queries return the index of the points in the vector the tree was built from.
+ *
+ * The tree is implicit, node i has the children 2i+1 and 2i+2, and every node splits its range of
+ * points at the median along the axis of largest extent. Hence only the split value and axis are
+ * stored per node. The points are reordered such that the points of each leaf are contiguous, and
+ * stored as one array per component. The leaves hold at most leafSize points which are tested
+ * with a linear scan.
+ *
+ * The build handles all nodes of a level in parallel, and the batched queries, taking a vector of
+ * query points, are split over the thread pool, see util::parallelFor. Single queries can be done
+ * concurrently from any thread since the tree is never modified after it has been built.
+ *
+ * Compared to KDTree, which allocates a node per point and is built by inserting one point at a
+ * time, this tree is always balanced and does not support insertion or removal. Rebuild it if the
+ * points change.
+ *
+ * \code{.cpp}
+ * FlatKDTree<3> tree(positions);
+ * auto nearest = tree.nearest(vec3{0.5f});        // index into positions
+ * auto knn = tree.kNearest(queries, 8);           // 8 indices per query
+ * auto close = tree.withinRadius(queries, 0.1f);  // one vector per query
+ * \endcode
+ */
+template <unsigned int N, typename P = float>
+class FlatKDTree {
+    static_assert(N >= 2 && N <= 4, "Only 2, 3, and 4 dimensional points are supported");
+
+public:
+    using Point = Vector<N, P>;
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+    static constexpr size_t defaultLeafSize = 8;
+
+    FlatKDTree() = default;
+    explicit FlatKDTree(const std::vector<Point>& points, size_t leafSize = defaultLeafSize);
+
+    size_t size() const { return ids_.size(); }
+    bool empty() const { return ids_.empty(); }
+    /**
+     * The number of levels of internal nodes, the tree has 2^depth leaves.
+     */
+    size_t depth() const { return levels_; }
+
+    /**
+     * Index of the point closest to pos, npos if the tree is empty. Ties are resolved in favor of
+     * the lowest index.
+     */
+    size_t nearest(const Point& pos) const;
+
+    /**
+     * Indices of the min(k, size()) points closest to pos, ordered by increasing distance.
+     */
+    std::vector<size_t> kNearest(const Point& pos, size_t k) const;
+
+    /**
+     * Indices of all points with a distance to pos of at most radius, in no particular order.
+     */
+    std::vector<size_t> withinRadius(const Point& pos, P radius) const;
+
+    /**
+     * Nearest point of each query point, computed in parallel.
+     * @see nearest(const Point&) const
+     */
+    std::vector<size_t> nearest(const std::vector<Point>& queries) const;
+
+    /**
+     * The min(k, size()) nearest points of each query point, computed in parallel. The result
+     * holds the indices of query i at [i * min(k, size()), (i + 1) * min(k, size())).
+     * @see kNearest(const Point&, size_t) const
+     */
+    std::vector<size_t> kNearest(const std::vector<Point>& queries, size_t k) const;
+
+    /**
+     * The points within radius of each query point, computed in parallel.
+     * @see withinRadius(const Point&, P) const
+     */
+    std::vector<std::vector<size_t>> withinRadius(const std::vector<Point>& queries,
+                                                  P radius) const;
+
+private:
+    using Candidate = std::pair<P, size_t>;
+
+    size_t internalNodes() const { return splits_.size(); }
+
+    /**
+     * Depth first traversal of the nodes that might contain points with a squared distance to pos
+     * of at most bound. leaf(begin, end) is called for the point ranges of the visited leaves and
+     * may shrink bound.
+     */
+    template <typename Leaf>
+    void search(const Point& pos, const P& bound, Leaf&& leaf) const;
+
+    P distance2(const Point& pos, size_t i) const {
+        P d2{0};
+        for (unsigned int d = 0; d < N; ++d) {
+            const P diff = coords_[d][i] - pos[d];
+            d2 += diff * diff;
+        }
+        return d2;
+    }
+
+    size_t levels_ = 0;
+    std::vector<P> splits_;
+    std::vector<std::uint8_t> axes_;
+    std::array<std::vector<P>, N> coords_;
+    std::vector<size_t> ids_;
+};
+
+template <typename P = float>
+using FlatK2DTree = FlatKDTree<2, P>;
+template <typename P = float>
+using FlatK3DTree = FlatKDTree<3, P>;
+template <typename P = float>
+using FlatK4DTree = FlatKDTree<4, P>;
+
+template <unsigned int N, typename P>
+FlatKDTree<N, P>::FlatKDTree(const std::vector<Point>& points, size_t leafSize) {
+    const size_t n = points.size();
+    leafSize = std::max(leafSize, size_t{1});
+    // Halving a range at its middle gives ranges of size floor or ceil of n / 2^level.
+    while (((n + (size_t{1} << levels_) - 1) >> levels_) > leafSize) ++levels_;
+
+    splits_.resize((size_t{1} << levels_) - 1);
+    axes_.resize(splits_.size());
+    ids_.resize(n);
+    for (size_t i = 0; i < n; ++i) ids_[i] = i;
+
+    std::vector<std::pair<size_t, size_t>> ranges{{0, n}};
+    std::vector<std::pair<size_t, size_t>> next;
+    for (size_t level = 0; level < levels_; ++level) {
+        const size_t first = (size_t{1} << level) - 1;
+        next.resize(ranges.size() * 2);
+        util::parallelFor(
+            size_t{0}, ranges.size(),
+            [&](size_t k) {
+                const auto [begin, end] = ranges[k];
+                Point lower{std::numeric_limits<P>::max()};
+                Point upper{std::numeric_limits<P>::lowest()};
+                for (size_t i = begin; i < end; ++i) {
+                    lower = glm::min(lower, points[ids_[i]]);
+                    upper = glm::max(upper, points[ids_[i]]);
+                }
+                unsigned int axis = 0;
+                for (unsigned int d = 1; d < N; ++d) {
+                    if (upper[d] - lower[d] > upper[axis] - lower[axis]) axis = d;
+                }
+                const size_t mid = begin + (end - begin) / 2;
+                std::nth_element(
+                    ids_.begin() + begin, ids_.begin() + mid, ids_.begin() + end,
+                    [&](size_t a, size_t b) { return points[a][axis] < points[b][axis]; });
+
+                splits_[first + k] = points[ids_[mid]][axis];
+                axes_[first + k] = static_cast<std::uint8_t>(axis);
+                next[2 * k] = {begin, mid};
+                next[2 * k + 1] = {mid, end};
+            },
+            1);
+        std::swap(ranges, next);
+    }
+
+    for (auto& coord : coords_) coord.resize(n);
+    util::parallelFor(size_t{0}, n, [&](size_t i) {
+        for (unsigned int d = 0; d < N; ++d) coords_[d][i] = points[ids_[i]][d];
+    });
+}
+
+template <unsigned int N, typename P>
+template <typename Leaf>
+void FlatKDTree<N, P>::search(const Point& pos, const P& bound, Leaf&& leaf) const {
+    if (empty()) return;
+
+    struct Entry {
+        size_t node;
+        size_t begin;
+        size_t end;
+        P dist2;  // lower bound of the squared distance from pos to the points of the node
+    };
+    // Every level pushes at most two entries and pops one.
+    std::array<Entry, 2 * std::numeric_limits<size_t>::digits> stack;
+    size_t top = 0;
+    stack[top++] = Entry{0, 0, size(), P{0}};
+
+    while (top > 0) {
+        const auto entry = stack[--top];
+        if (entry.dist2 > bound) continue;
+
+        if (entry.node >= internalNodes()) {
+            leaf(entry.begin, entry.end);
+            continue;
+        }
+
+        const size_t mid = entry.begin + (entry.end - entry.begin) / 2;
+        const P diff = pos[axes_[entry.node]] - splits_[entry.node];
+        const Entry left{2 * entry.node + 1, entry.begin, mid, entry.dist2};
+        const Entry right{2 * entry.node + 2, mid, entry.end, entry.dist2};
+        // Visit the side containing pos first, the other one only if it can still be closer.
+        if (diff < P{0}) {
+            stack[top] = right;
+            stack[top++].dist2 = std::max(entry.dist2, diff * diff);
+            stack[top++] = left;
+        } else {
+            stack[top] = left;
+            stack[top++].dist2 = std::max(entry.dist2, diff * diff);
+            stack[top++] = right;
+        }
+    }
+}
+
+template <unsigned int N, typename P>
+size_t FlatKDTree<N, P>::nearest(const Point& pos) const {
+    size_t best = npos;
+    P bound = std::numeric_limits<P>::max();
+    search(pos, bound, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const P d2 = distance2(pos, i);
+            if (d2 < bound || (d2 == bound && ids_[i] < best)) {
+                bound = d2;
+                best = ids_[i];
+            }
+        }
+    });
+    return best;
+}
+
+template <unsigned int N, typename P>
+std::vector<size_t> FlatKDTree<N, P>::kNearest(const Point& pos, size_t k) const {
+    k = std::min(k, size());
+    if (k == 0) return {};
+
+    // Max heap of the k closest points found so far, ordered by distance and index.
+    std::vector<Candidate> heap;
+    heap.reserve(k);
+    P bound = std::numeric_limits<P>::max();
+    search(pos, bound, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const Candidate candidate{distance2(pos, i), ids_[i]};
+            if (heap.size() < k) {
+                heap.push_back(candidate);
+                std::push_heap(heap.begin(), heap.end());
+            } else if (candidate < heap.front()) {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = candidate;
+                std::push_heap(heap.begin(), heap.end());
+            }
+            if (heap.size() == k) bound = heap.front().first;
+        }
+    });
+
+    std::sort_heap(heap.begin(), heap.end());
+    std::vector<size_t> res(k);
+    std::transform(heap.begin(), heap.end(), res.begin(),
+                   [](const Candidate& c) { return c.second; });
+    return res;
+}
+
+template <unsigned int N, typename P>
+std::vector<size_t> FlatKDTree<N, P>::withinRadius(const Point& pos, P radius) const {
+    std::vector<size_t> res;
+    const P bound = radius * radius;
+    search(pos, bound, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (distance2(pos, i) <= bound) res.push_back(ids_[i]);
+        }
+    });
+    return res;
+}
+
+template <unsigned int N, typename P>
+std::vector<size_t> FlatKDTree<N, P>::nearest(const std::vector<Point>& queries) const {
+    std::vector<size_t> res(queries.size());
+    util::parallelFor(size_t{0}, queries.size(), [&](size_t i) { res[i] = nearest(queries[i]); });
+    return res;
+}
+
+template <unsigned int N, typename P>
+std::vector<size_t> FlatKDTree<N, P>::kNearest(const std::vector<Point>& queries,
+                                               size_t k) const {
+    k = std::min(k, size());
+    std::vector<size_t> res(queries.size() * k);
+    util::parallelFor(size_t{0}, queries.size(), [&](size_t i) {
+        const auto knn = kNearest(queries[i], k);
+        std::copy(knn.begin(), knn.end(), res.begin() + i * k);
+    });
+    return res;
+}
+
+template <unsigned int N, typename P>
+std::vector<std::vector<size_t>> FlatKDTree<N, P>::withinRadius(const std::vector<Point>& queries,
+                                                                P radius) const {
+    std::vector<std::vector<size_t>> res(queries.size());
+    util::parallelFor(size_t{0}, queries.size(),
+                      [&](size_t i) { res[i] = withinRadius(queries[i], radius); });
+    return res;
+}
+
+}  // namespace inviwo
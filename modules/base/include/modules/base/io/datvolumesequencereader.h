@@ -66,6 +66,10 @@ namespace inviwo {
  *     + Datfile: sequence0.dat
  *     + Datfile: sequence1.dat
  *     + Datfile: sequence2.dat
+ *
+ * Supported options, see DataReader::setOption:
+ *   - __MemoryMap__ (bool, default false) memory map the raw files instead of reading them, see
+ *     RawVolumeRAMLoader. Only use it for files that are not modified while the volume is in use.
  */
 class IVW_MODULE_BASE_API DatVolumeSequenceReader
     : public DataReaderType<std::vector<std::shared_ptr<Volume>>> {
@@ -80,8 +84,12 @@ public:
 
     virtual std::shared_ptr<VolumeSequence> readData(const std::string& filePath) override;
 
+    virtual bool setOption(std::string_view key, std::any value) override;
+    virtual std::any getOption(std::string_view key) override;
+
 private:
     bool enableLogOutput_;
+    bool memoryMap_;
 };
 
 }  // namespace inviwo
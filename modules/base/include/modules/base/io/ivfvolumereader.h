@@ -38,6 +38,9 @@
 namespace inviwo {
 /**
  * \ingroup dataio
+ * Supported options, see DataReader::setOption:
+ *   - __MemoryMap__ (bool, default false) memory map the raw file instead of reading it, see
+ *     RawVolumeRAMLoader. Only use it for files that are not modified while the volume is in use.
  */
 class IVW_MODULE_BASE_API IvfVolumeReader : public DataReaderType<Volume> {
 public:
@@ -48,6 +51,12 @@ public:
     virtual ~IvfVolumeReader() = default;
 
     virtual std::shared_ptr<Volume> readData(const std::string& filePath) override;
+
+    virtual bool setOption(std::string_view key, std::any value) override;
+    virtual std::any getOption(std::string_view key) override;
+
+private:
+    bool memoryMap_;
 };
 
 }  // namespace inviwo
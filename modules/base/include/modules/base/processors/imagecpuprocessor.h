@@ -0,0 +1,70 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+
+#include <inviwo/core/processors/poolprocessor.h>
+#include <inviwo/core/ports/imageport.h>
+
+#include <functional>
+#include <memory>
+
+namespace inviwo {
+
+class LayerRAM;
+
+/**
+ * \brief Base class for image processing on the CPU
+ *
+ * The CPU counterpart of ImageGLProcessor. Derived classes return the filter to apply to the
+ * color layer of the input image, which is then run on a background thread. The filter should
+ * capture the property values it needs, since the processor may change while it is running.
+ * The model and world matrices, and the meta data, are passed on from the input image.
+ *
+ * \see util::layerLowPass
+ */
+class IVW_MODULE_BASE_API ImageCPUProcessor : public PoolProcessor {
+public:
+    using Filter = std::function<std::shared_ptr<LayerRAM>(const LayerRAM&)>;
+
+    ImageCPUProcessor();
+    virtual ~ImageCPUProcessor() = default;
+
+    virtual void process() override;
+
+protected:
+    virtual Filter filter() const = 0;
+
+    ImageInport inport_;
+    ImageOutport outport_;
+};
+
+}  // namespace inviwo
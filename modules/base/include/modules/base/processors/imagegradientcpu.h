@@ -0,0 +1,71 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+
+#include <modules/base/processors/imagecpuprocessor.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/optionproperty.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.ImageGradientCPU, Image Gradient CPU}
+ * ![](org.inviwo.ImageGradientCPU.png?classIdentifier=org.inviwo.ImageGradientCPU)
+ * Computes the gradient of one channel of the input image using central differences, the CPU
+ * version of Image Gradient.
+ *
+ * ### Inports
+ *   * __inputImage__ Input image
+ *
+ * ### Outports
+ *   * __outputImage__ Gradient image (vec2 float)
+ *
+ * ### Properties
+ *   * __Channel__ The channel to compute the gradient of
+ *   * __Renormalization__ Scale the gradient to texture coordinates instead of pixels
+ */
+class IVW_MODULE_BASE_API ImageGradientCPU : public ImageCPUProcessor {
+public:
+    ImageGradientCPU();
+    virtual ~ImageGradientCPU() = default;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+protected:
+    virtual Filter filter() const override;
+
+private:
+    OptionPropertyInt channel_;
+    BoolProperty renormalization_;
+};
+
+}  // namespace inviwo
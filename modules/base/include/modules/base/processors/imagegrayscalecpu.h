@@ -0,0 +1,72 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+
+#include <modules/base/processors/imagecpuprocessor.h>
+#include <modules/base/algorithm/image/layerramfilters.h>
+#include <inviwo/core/properties/optionproperty.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.ImageGrayscaleCPU, Image Grayscale CPU}
+ * ![](org.inviwo.ImageGrayscaleCPU.png?classIdentifier=org.inviwo.ImageGrayscaleCPU)
+ * Computes the luminance of the input image, the CPU version of Image Grayscale.
+ *
+ * ### Inports
+ *   * __inputImage__ Input image
+ *
+ * ### Outports
+ *   * __outputImage__ Grayscale image (vec4 float)
+ *
+ * ### Properties
+ *   * __Luminance Model__ Model for converting the input to grayscale
+ *     * __Perceived__ Perceived luminance, 0.299 r + 0.587 g + 0.114 b
+ *     * __Relative__ Relative luminance, 0.2126 r + 0.7152 g + 0.0722 b
+ *     * __Average__ Average of the color channels
+ *     * __Red only__, __Green only__, __Blue only__ A single channel
+ */
+class IVW_MODULE_BASE_API ImageGrayscaleCPU : public ImageCPUProcessor {
+public:
+    ImageGrayscaleCPU();
+    virtual ~ImageGrayscaleCPU() = default;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+protected:
+    virtual Filter filter() const override;
+
+private:
+    TemplateOptionProperty<LuminanceModel> luminanceModel_;
+};
+
+}  // namespace inviwo
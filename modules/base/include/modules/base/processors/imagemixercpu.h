@@ -0,0 +1,80 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+
+#include <modules/base/algorithm/image/layerramfilters.h>
+#include <inviwo/core/processors/poolprocessor.h>
+#include <inviwo/core/ports/imageport.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/properties/optionproperty.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.ImageMixerCPU, Image Mixer CPU}
+ * ![](org.inviwo.ImageMixerCPU.png?classIdentifier=org.inviwo.ImageMixerCPU)
+ * Mixes two input images according to the chosen blend mode, the CPU version of Image Mixer.
+ * Both images need to have the same dimensions.
+ *
+ * ### Inports
+ *   * __inport0__ Background image
+ *   * __inport1__ Foreground image
+ *
+ * ### Outports
+ *   * __outport__ Blended image (vec4 float)
+ *
+ * ### Properties
+ *   * __Blend Mode__ See ImageBlendMode, the same modes as Image Mixer
+ *   * __Weight__ Weight of the second image, only used by Mix
+ *   * __Clamp values to zero and one__ Clamp the result to [0, 1]
+ */
+class IVW_MODULE_BASE_API ImageMixerCPU : public PoolProcessor {
+public:
+    ImageMixerCPU();
+    virtual ~ImageMixerCPU() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    ImageInport inport0_;
+    ImageInport inport1_;
+    ImageOutport outport_;
+
+    TemplateOptionProperty<ImageBlendMode> blendingMode_;
+    FloatProperty weight_;
+    BoolProperty clamp_;
+};
+
+}  // namespace inviwo
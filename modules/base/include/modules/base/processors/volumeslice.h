@@ -34,13 +34,14 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/ports/volumeport.h>
 #include <inviwo/core/ports/imageport.h>
-#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/properties/optionproperty.h>
 #include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/properties/ordinalproperty.h>
 #include <inviwo/core/properties/eventproperty.h>
 #include <inviwo/core/datastructures/geometry/geometrytype.h>
 #include <modules/base/datastructures/imagereusecache.h>
+#include <modules/base/algorithm/volume/volumepyramid.h>
 
 namespace inviwo {
 
@@ -61,8 +62,10 @@ namespace inviwo {
 
 /**
  * \brief Outputs a slice from a volume, CPU-based
+ * For bricked volumes the slice is extracted in the background, meanwhile a slice of a coarser
+ * level of the VolumePyramid of the volume is shown if one has already been built.
  */
-class IVW_MODULE_BASE_API VolumeSlice : public Processor {
+class IVW_MODULE_BASE_API VolumeSlice : public PoolProcessor {
 public:
     VolumeSlice();
     ~VolumeSlice();
@@ -87,6 +90,7 @@ private:
     ImageOutport outport_;
 
     ImageReuseCache imageCache_;
+    std::shared_ptr<VolumePyramid> pyramid_;
 
     TemplateOptionProperty<CartesianCoordinateAxis> sliceAlongAxis_;
     IntSizeTProperty sliceNumber_;
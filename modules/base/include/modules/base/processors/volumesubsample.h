@@ -37,6 +37,7 @@
 #include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/properties/ordinalproperty.h>
 #include <modules/base/algorithm/volume/volumeramsubsample.h>
+#include <modules/base/algorithm/volume/volumepyramid.h>
 #include <inviwo/core/processors/activityindicator.h>
 
 namespace inviwo {
@@ -56,6 +57,9 @@ namespace inviwo {
  *   * __Enable Operation__ ...
  *   * __Factors__ ...
  *
+ * Power of two factors of floating point volumes are taken from the VolumePyramid of the input
+ * volume, hence they are only computed once per volume. Integer volumes are always subsampled in
+ * a single pass, since the chained pyramid levels would round the values at every level.
  */
 class IVW_MODULE_BASE_API VolumeSubsample : public PoolProcessor {
 public:
@@ -76,6 +80,8 @@ private:
 
     BoolProperty enabled_;
     IntVec3Property subSampleFactors_;
+
+    std::shared_ptr<VolumePyramid> pyramid_;
 };
 }  // namespace inviwo
 
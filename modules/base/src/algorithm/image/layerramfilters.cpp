@@ -0,0 +1,485 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/image/layerramfilters.h>
+
+#include <inviwo/core/datastructures/image/image.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/parallel.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+// Number of rows processed per task, aims at roughly 16k pixels per task
+size_t rowGrain(size2_t dims) {
+    return std::max<size_t>(1, size_t{16384} / std::max<size_t>(1, dims.x));
+}
+
+template <typename F>
+void forEachRowBlock(size2_t dims, size_t minRows, F&& body) {
+    util::parallelFor(size_t{0}, dims.y, std::forward<F>(body),
+                      std::max(minRows, rowGrain(dims)));
+}
+
+template <typename T>
+std::shared_ptr<LayerRAMPrecision<T>> createLike(size2_t dims, const LayerRAM& layer,
+                                                 const SwizzleMask& swizzle) {
+    return std::make_shared<LayerRAMPrecision<T>>(dims, layer.getLayerType(), swizzle,
+                                                  layer.getInterpolation(), layer.getWrapping());
+}
+
+/*
+ * Convolve one row with the kernel, clamping at the borders. The interior is accumulated one
+ * kernel tap at a time over the whole row, which keeps the inner loop contiguous.
+ */
+void convolveRow(const vec4* in, vec4* out, std::ptrdiff_t width,
+                 const std::vector<float>& kernel) {
+    const auto r = static_cast<std::ptrdiff_t>(kernel.size() / 2);
+    const auto size = static_cast<std::ptrdiff_t>(kernel.size());
+    const auto innerBegin = std::min(r, width);
+    const auto innerEnd = std::max(innerBegin, width - r);
+
+    const auto border = [&](std::ptrdiff_t x) {
+        vec4 sum{0.0f};
+        for (std::ptrdiff_t k = 0; k < size; ++k) {
+            sum += kernel[k] * in[std::clamp<std::ptrdiff_t>(x + k - r, 0, width - 1)];
+        }
+        out[x] = sum;
+    };
+    for (std::ptrdiff_t x = 0; x < innerBegin; ++x) border(x);
+    for (std::ptrdiff_t x = innerEnd; x < width; ++x) border(x);
+
+    std::fill(out + innerBegin, out + innerEnd, vec4{0.0f});
+    for (std::ptrdiff_t k = 0; k < size; ++k) {
+        const float w = kernel[k];
+        const vec4* src = in + (k - r + innerBegin);
+        vec4* dst = out + innerBegin;
+        const auto n = innerEnd - innerBegin;
+        for (std::ptrdiff_t x = 0; x < n; ++x) dst[x] += w * src[x];
+    }
+}
+
+std::shared_ptr<LayerRAMPrecision<vec4>> convolve(const LayerRAMPrecision<vec4>& src,
+                                                  const std::vector<float>& kernel) {
+    if (kernel.size() % 2 == 0) {
+        throw Exception("Convolution kernel size has to be odd",
+                        IVW_CONTEXT_CUSTOM("util::layerSeparableConvolution"));
+    }
+
+    const auto dims = src.getDimensions();
+    auto dst = createLike<vec4>(dims, src, src.getSwizzleMask());
+    if (dims.x == 0 || dims.y == 0) return dst;
+
+    const auto r = static_cast<std::ptrdiff_t>(kernel.size() / 2);
+    const auto width = static_cast<std::ptrdiff_t>(dims.x);
+    const auto height = static_cast<std::ptrdiff_t>(dims.y);
+    const vec4* in = src.getDataTyped();
+    vec4* out = dst->getDataTyped();
+
+    // Each block of rows first filters the rows it needs horizontally into a local buffer, and
+    // then filters that buffer vertically. Neighboring blocks redo 2r rows of the horizontal
+    // pass, but all intermediate data stays in the cache of one thread.
+    forEachRowBlock(dims, static_cast<size_t>(4 * r), [&](size_t begin, size_t end) {
+        const auto y0 = static_cast<std::ptrdiff_t>(begin);
+        const auto y1 = static_cast<std::ptrdiff_t>(end);
+        const auto lo = std::max<std::ptrdiff_t>(0, y0 - r);
+        const auto hi = std::min(height, y1 + r);
+
+        std::vector<vec4> rows(static_cast<size_t>((hi - lo) * width));
+        for (auto y = lo; y < hi; ++y) {
+            convolveRow(in + y * width, rows.data() + (y - lo) * width, width, kernel);
+        }
+
+        for (auto y = y0; y < y1; ++y) {
+            vec4* dstRow = out + y * width;
+            std::fill(dstRow, dstRow + width, vec4{0.0f});
+            for (std::ptrdiff_t k = 0; k < static_cast<std::ptrdiff_t>(kernel.size()); ++k) {
+                const float w = kernel[k];
+                const auto sy = std::clamp<std::ptrdiff_t>(y + k - r, 0, height - 1);
+                const vec4* srcRow = rows.data() + (sy - lo) * width;
+                for (std::ptrdiff_t x = 0; x < width; ++x) dstRow[x] += w * srcRow[x];
+            }
+        }
+    });
+    return dst;
+}
+
+std::vector<float> boxKernel(int radius) {
+    return std::vector<float>(static_cast<size_t>(2 * radius + 1),
+                              1.0f / static_cast<float>(2 * radius + 1));
+}
+
+// Apply func(in, out) to every pixel of the layer
+template <typename Out, typename F>
+std::shared_ptr<LayerRAMPrecision<Out>> mapPixels(const LayerRAMPrecision<vec4>& src,
+                                                  const SwizzleMask& swizzle, F func) {
+    const auto dims = src.getDimensions();
+    auto dst = createLike<Out>(dims, src, swizzle);
+    const vec4* in = src.getDataTyped();
+    Out* out = dst->getDataTyped();
+    forEachRowBlock(dims, 1, [&](size_t begin, size_t end) {
+        const auto first = begin * dims.x;
+        const auto last = end * dims.x;
+        for (size_t i = first; i < last; ++i) out[i] = func(in[i]);
+    });
+    return dst;
+}
+
+template <typename F>
+void blend(const vec4* a, const vec4* b, vec4* out, size2_t dims, F func) {
+    forEachRowBlock(dims, 1, [&](size_t begin, size_t end) {
+        const auto first = begin * dims.x;
+        const auto last = end * dims.x;
+        for (size_t i = first; i < last; ++i) out[i] = func(a[i], b[i]);
+    });
+}
+
+vec3 overlay(const vec3& a, const vec3& b) {
+    const vec3 low = 2.0f * a * b;
+    const vec3 high = 1.0f - 2.0f * (1.0f - a) * (1.0f - b);
+    return glm::clamp(glm::mix(high, low, vec3(glm::lessThan(a, vec3(0.5f)))), 0.0f, 1.0f);
+}
+
+}  // namespace
+
+std::shared_ptr<LayerRAMPrecision<vec4>> layerToRGBA(const LayerRAM& layer) {
+    const auto dims = layer.getDimensions();
+    auto dst = createLike<vec4>(dims, layer, layer.getSwizzleMask());
+    vec4* out = dst->getDataTyped();
+
+    layer.dispatch<void>([&](auto lrprecision) {
+        using ValueType = util::PrecisionValueType<decltype(lrprecision)>;
+        constexpr size_t components = util::extent<ValueType>::value;
+        const ValueType* in = lrprecision->getDataTyped();
+
+        forEachRowBlock(dims, 1, [&](size_t begin, size_t end) {
+            const auto first = begin * dims.x;
+            const auto last = end * dims.x;
+            for (size_t i = first; i < last; ++i) {
+                vec4 v{0.0f, 0.0f, 0.0f, 1.0f};
+                for (size_t c = 0; c < components; ++c) {
+                    v[static_cast<glm::length_t>(c)] =
+                        util::glm_convert_normalized<float>(util::glmcomp(in[i], c));
+                }
+                out[i] = v;
+            }
+        });
+    });
+    return dst;
+}
+
+std::shared_ptr<LayerRAMPrecision<vec4>> layerSeparableConvolution(
+    const LayerRAM& layer, const std::vector<float>& kernel) {
+    return convolve(*layerToRGBA(layer), kernel);
+}
+
+std::shared_ptr<LayerRAMPrecision<vec4>> layerLowPass(const LayerRAM& layer, int kernelSize) {
+    return convolve(*layerToRGBA(layer), boxKernel(std::max(0, kernelSize / 2)));
+}
+
+std::shared_ptr<LayerRAMPrecision<vec4>> layerGaussianLowPass(const LayerRAM& layer,
+                                                              float sigma) {
+    const int radius = std::max(1, static_cast<int>(2.576f * sigma));
+    std::vector<float> kernel(static_cast<size_t>(2 * radius + 1));
+    const float s2 = 2.0f * sigma * sigma;
+    float sum = 0.0f;
+    for (int i = -radius; i <= radius; ++i) {
+        const float w = s2 > 0.0f ? std::exp(-static_cast<float>(i * i) / s2)
+                                  : (i == 0 ? 1.0f : 0.0f);
+        kernel[i + radius] = w;
+        sum += w;
+    }
+    for (auto& w : kernel) w /= sum;
+    return convolve(*layerToRGBA(layer), kernel);
+}
+
+std::shared_ptr<LayerRAMPrecision<vec4>> layerHighPass(const LayerRAM& layer, int kernelSize,
+                                                       bool sharpen) {
+    const int radius = std::max(1, kernelSize / 2);
+    const auto src = layerToRGBA(layer);
+    auto dst = convolve(*src, boxKernel(radius));
+
+    // The low pass includes the pixel itself, remove it to get the average of the neighbors
+    const float n = static_cast<float>((2 * radius + 1) * (2 * radius + 1));
+    const float scale = 1.0f / (n - 1.0f);
+    const vec4* in = src->getDataTyped();
+    vec4* out = dst->getDataTyped();
+    const auto dims = src->getDimensions();
+    forEachRowBlock(dims, 1, [&](size_t begin, size_t end) {
+        const auto first = begin * dims.x;
+        const auto last = end * dims.x;
+        for (size_t i = first; i < last; ++i) {
+            const vec4 p = in[i];
+            const vec3 avg = (vec3(out[i]) * n - vec3(p)) * scale;
+            const vec3 res = sharpen ? 2.0f * vec3(p) - avg : (vec3(p) - avg + 1.0f) * 0.5f;
+            out[i] = vec4(res, p.a);
+        }
+    });
+    return dst;
+}
+
+std::shared_ptr<LayerRAMPrecision<vec2>> layerGradient(const LayerRAM& layer, size_t channel,
+                                                       bool renormalize) {
+    if (channel > 3) {
+        throw Exception("Invalid channel " + toString(channel),
+                        IVW_CONTEXT_CUSTOM("util::layerGradient"));
+    }
+    const auto src = layerToRGBA(layer);
+    const auto dims = src->getDimensions();
+    auto dst = createLike<vec2>(
+        dims, layer, {{ImageChannel::Red, ImageChannel::Green, ImageChannel::Zero,
+                       ImageChannel::One}});
+    if (dims.x == 0 || dims.y == 0) return dst;
+
+    // Extract the channel once so that the difference loops only touch floats
+    const auto c = static_cast<glm::length_t>(channel);
+    std::vector<float> values(dims.x * dims.y);
+    const vec4* in = src->getDataTyped();
+    forEachRowBlock(dims, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin * dims.x; i < end * dims.x; ++i) values[i] = in[i][c];
+    });
+
+    // Like imagegradient.frag, renormalization scales both components by the width
+    const vec2 scale{0.5f * (renormalize ? static_cast<float>(dims.x) : 1.0f)};
+    const auto width = dims.x;
+    vec2* out = dst->getDataTyped();
+    forEachRowBlock(dims, 1, [&](size_t begin, size_t end) {
+        for (size_t y = begin; y < end; ++y) {
+            const float* row = values.data() + y * width;
+            const float* up = values.data() + std::min(y + 1, dims.y - 1) * width;
+            const float* down = values.data() + (y > 0 ? y - 1 : 0) * width;
+            vec2* dstRow = out + y * width;
+
+            for (size_t x = 0; x < width; ++x) {
+                dstRow[x].y = (up[x] - down[x]) * scale.y;
+            }
+            if (width == 1) {
+                dstRow[0].x = 0.0f;
+                continue;
+            }
+            dstRow[0].x = (row[1] - row[0]) * scale.x;
+            for (size_t x = 1; x + 1 < width; ++x) {
+                dstRow[x].x = (row[x + 1] - row[x - 1]) * scale.x;
+            }
+            dstRow[width - 1].x = (row[width - 1] - row[width - 2]) * scale.x;
+        }
+    });
+    return dst;
+}
+
+vec3 luminanceWeights(LuminanceModel model) {
+    switch (model) {
+        case LuminanceModel::Perceived:
+            return vec3{0.299f, 0.587f, 0.114f};
+        case LuminanceModel::Relative:
+            return vec3{0.2126f, 0.7152f, 0.0722f};
+        case LuminanceModel::Average:
+            return vec3{1.0f / 3.0f};
+        case LuminanceModel::RedOnly:
+            return vec3{1.0f, 0.0f, 0.0f};
+        case LuminanceModel::GreenOnly:
+            return vec3{0.0f, 1.0f, 0.0f};
+        case LuminanceModel::BlueOnly:
+            return vec3{0.0f, 0.0f, 1.0f};
+        default:
+            return vec3{0.299f, 0.587f, 0.114f};
+    }
+}
+
+std::shared_ptr<LayerRAMPrecision<vec4>> layerGrayscale(const LayerRAM& layer,
+                                                        LuminanceModel model) {
+    const vec3 weights = luminanceWeights(model);
+    return mapPixels<vec4>(*layerToRGBA(layer), swizzlemasks::rgba, [weights](const vec4& p) {
+        return vec4(vec3(glm::dot(vec3(p), weights)), p.a);
+    });
+}
+
+std::shared_ptr<LayerRAMPrecision<vec4>> layerBinary(const LayerRAM& layer, float threshold) {
+    return mapPixels<vec4>(*layerToRGBA(layer), swizzlemasks::rgba, [threshold](const vec4& p) {
+        const float v = p.r >= threshold ? 1.0f : 0.0f;
+        return vec4(v, v, v, 1.0f);
+    });
+}
+
+std::shared_ptr<LayerRAMPrecision<vec4>> layerMix(const LayerRAM& a, const LayerRAM& b,
+                                                  ImageBlendMode mode, float weight,
+                                                  bool clampValues) {
+    if (a.getDimensions() != b.getDimensions()) {
+        throw Exception("Layer dimensions do not match (" + toString(a.getDimensions()) +
+                            " and " + toString(b.getDimensions()) + ")",
+                        IVW_CONTEXT_CUSTOM("util::layerMix"));
+    }
+    const auto srcA = layerToRGBA(a);
+    const auto srcB = layerToRGBA(b);
+    const auto dims = srcA->getDimensions();
+    auto dst = createLike<vec4>(dims, a, swizzlemasks::rgba);
+
+    const vec4* pa = srcA->getDataTyped();
+    const vec4* pb = srcB->getDataTyped();
+    vec4* out = dst->getDataTyped();
+
+    // Modes other than Mix and Over combine the colors and keep the largest alpha
+    const auto rgb = [&](auto func) {
+        blend(pa, pb, out, dims, [func](const vec4& x, const vec4& y) {
+            return vec4(func(vec3(x), vec3(y)), std::max(x.a, y.a));
+        });
+    };
+
+    switch (mode) {
+        case ImageBlendMode::Mix:
+            blend(pa, pb, out, dims,
+                  [weight](const vec4& x, const vec4& y) { return glm::mix(x, y, weight); });
+            break;
+        case ImageBlendMode::Over:
+            blend(pa, pb, out, dims, [](const vec4& x, const vec4& y) {
+                return vec4(glm::mix(vec3(x) * x.a, vec3(y), y.a), y.a + (1.0f - y.a) * x.a);
+            });
+            break;
+        case ImageBlendMode::Multiply:
+            rgb([](const vec3& x, const vec3& y) { return x * y; });
+            break;
+        case ImageBlendMode::Screen:
+            rgb([](const vec3& x, const vec3& y) {
+                return glm::clamp(1.0f - (1.0f - x) * (1.0f - y), 0.0f, 1.0f);
+            });
+            break;
+        case ImageBlendMode::Overlay:
+            rgb([](const vec3& x, const vec3& y) { return overlay(x, y); });
+            break;
+        case ImageBlendMode::HardLight:
+            rgb([](const vec3& x, const vec3& y) { return overlay(y, x); });
+            break;
+        case ImageBlendMode::Divide:
+            rgb([](const vec3& x, const vec3& y) { return x / y; });
+            break;
+        case ImageBlendMode::Addition:
+            rgb([](const vec3& x, const vec3& y) { return x + y; });
+            break;
+        case ImageBlendMode::Subtraction:
+            rgb([](const vec3& x, const vec3& y) { return x - y; });
+            break;
+        case ImageBlendMode::Difference:
+            rgb([](const vec3& x, const vec3& y) { return glm::abs(x - y); });
+            break;
+        case ImageBlendMode::DarkenOnly:
+            rgb([](const vec3& x, const vec3& y) { return glm::min(x, y); });
+            break;
+        case ImageBlendMode::BrightenOnly:
+            rgb([](const vec3& x, const vec3& y) { return glm::max(x, y); });
+            break;
+    }
+
+    if (clampValues) {
+        forEachRowBlock(dims, 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin * dims.x; i < end * dims.x; ++i) {
+                out[i] = glm::clamp(out[i], 0.0f, 1.0f);
+            }
+        });
+    }
+    return dst;
+}
+
+std::shared_ptr<LayerRAMPrecision<vec4>> layerResample(const LayerRAM& layer, size2_t dimensions,
+                                                       InterpolationType interpolation) {
+    const auto src = layerToRGBA(layer);
+    const auto srcDims = src->getDimensions();
+    auto dst = createLike<vec4>(dimensions, layer, layer.getSwizzleMask());
+    if (srcDims.x == 0 || srcDims.y == 0 || dimensions.x == 0 || dimensions.y == 0) return dst;
+
+    // Map pixel centers of the destination onto the source, returns the lower sample and the
+    // weight of the upper one
+    const auto sample = [](size_t i, size_t dstSize, size_t srcSize) {
+        const float pos = (static_cast<float>(i) + 0.5f) * static_cast<float>(srcSize) /
+                              static_cast<float>(dstSize) -
+                          0.5f;
+        const float clamped = std::clamp(pos, 0.0f, static_cast<float>(srcSize - 1));
+        const auto lower = static_cast<size_t>(clamped);
+        return std::make_pair(lower, clamped - static_cast<float>(lower));
+    };
+
+    // The column indices and weights are the same for every row
+    std::vector<size_t> x0(dimensions.x);
+    std::vector<size_t> x1(dimensions.x);
+    std::vector<float> fx(dimensions.x);
+    for (size_t x = 0; x < dimensions.x; ++x) {
+        const auto [lower, frac] = sample(x, dimensions.x, srcDims.x);
+        x0[x] = lower;
+        x1[x] = std::min(lower + 1, srcDims.x - 1);
+        fx[x] = frac;
+    }
+
+    const vec4* in = src->getDataTyped();
+    vec4* out = dst->getDataTyped();
+    const bool nearest = interpolation == InterpolationType::Nearest;
+    forEachRowBlock(dimensions, 1, [&](size_t begin, size_t end) {
+        for (size_t y = begin; y < end; ++y) {
+            const auto [lower, fy] = sample(y, dimensions.y, srcDims.y);
+            const vec4* r0 = in + lower * srcDims.x;
+            const vec4* r1 = in + std::min(lower + 1, srcDims.y - 1) * srcDims.x;
+            vec4* dstRow = out + y * dimensions.x;
+            if (nearest) {
+                const vec4* row = fy < 0.5f ? r0 : r1;
+                for (size_t x = 0; x < dimensions.x; ++x) {
+                    dstRow[x] = fx[x] < 0.5f ? row[x0[x]] : row[x1[x]];
+                }
+            } else {
+                for (size_t x = 0; x < dimensions.x; ++x) {
+                    const vec4 top = glm::mix(r0[x0[x]], r0[x1[x]], fx[x]);
+                    const vec4 bottom = glm::mix(r1[x0[x]], r1[x1[x]], fx[x]);
+                    dstRow[x] = glm::mix(top, bottom, fy);
+                }
+            }
+        }
+    });
+    return dst;
+}
+
+std::shared_ptr<Image> filteredImage(std::shared_ptr<LayerRAM> result, const Image& source) {
+    auto layer = std::make_shared<Layer>(result);
+    if (auto srcLayer = source.getColorLayer()) {
+        layer->setModelMatrix(srcLayer->getModelMatrix());
+        layer->setWorldMatrix(srcLayer->getWorldMatrix());
+    }
+    auto image = std::make_shared<Image>(layer);
+    image->copyMetaDataFrom(source);
+    return image;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
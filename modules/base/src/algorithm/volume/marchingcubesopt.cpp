@@ -30,13 +30,17 @@
 #include <modules/base/algorithm/volume/marchingcubesopt.h>
 #include <modules/base/algorithm/volume/surfaceextraction.h>
 #include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/parallel.h>
 
 #include <modules/base/datastructures/disjointsets.h>
 #include <glm/gtx/normal.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <bitset>
+#include <mutex>
+#include <unordered_map>
 
 namespace inviwo {
 
@@ -240,195 +244,54 @@ std::array<size_t, 8> marching::Config::calcIncrenents(std::bitset<8> corners, b
 
 namespace {
 
-class VCache {
-public:
-    enum CacheName { xCacheCurr, xCacheNext, yCacheCurr, yCacheNext, zCacheCurr, zCacheNext };
-    enum CachePosName { xCurr0, xCurr1, xNext0, xNext1, yCurr, yNext, zCurr, zNext };
-    VCache(const size2_t &dim) : cIm{dim} {
-        cache[xCacheCurr].resize(dim.x * dim.y);
-        cache[xCacheNext].resize(dim.x * dim.y);
-        cache[yCacheCurr].resize(dim.x * dim.y);
-        cache[yCacheNext].resize(dim.x * dim.y);
-        cache[zCacheCurr].resize(dim.x);
-        cache[zCacheNext].resize(dim.x);
-    }
+constexpr std::uint32_t noVertex = std::numeric_limits<std::uint32_t>::max();
+// Marks indices referring to vertices owned by the next slab
+constexpr std::uint32_t foreignFlag = std::uint32_t{1} << 31;
 
-    std::pair<size_t, bool> find(const size3_t &ind, int edge, const size_t &val) {
-        switch (edge) {
-            case 0:
-                if (ind.z == 0 && ind.y == 0) {
-                    cache[xCacheCurr][cIm(pos[xCurr0], ind.y)] = val;
-                    return {val, true};
-                } else {
-                    return {cache[xCacheCurr][cIm(pos[xCurr0], ind.y)], false};
-                }
-            case 1:
-                if (ind.z == 0) {
-                    cache[yCacheCurr][cIm(pos[yCurr] + 1, ind.y)] = val;
-                    return {val, true};
-                } else {
-                    return {cache[yCacheCurr][cIm(pos[yCurr] + 1, ind.y)], false};
-                }
-            case 2:
-                if (ind.z == 0) {
-                    cache[xCacheCurr][cIm(pos[xCurr1], ind.y + 1)] = val;
-                    return {val, true};
-                } else {
-                    return {cache[xCacheCurr][cIm(pos[xCurr1], ind.y + 1)], false};
-                }
-            case 3:
-                if (ind.z == 0 && ind.x == 0) {
-                    cache[yCacheCurr][cIm(pos[yCurr], ind.y)] = val;
-                    return {val, true};
-                } else {
-                    return {cache[yCacheCurr][cIm(pos[yCurr], ind.y)], false};
-                }
+// Number of cells per side of the blocks used to skip empty regions
+constexpr size_t blockSize = 8;
 
-            case 4:
-                if (ind.x == 0 && ind.y == 0) {
-                    cache[zCacheCurr][pos[zCurr]] = val;
-                    return {val, true};
-                } else {
-                    return {cache[zCacheCurr][pos[zCurr]], false};
-                }
-            case 5:
-                if (ind.y == 0) {
-                    cache[zCacheCurr][pos[zCurr] + 1] = val;
-                    return {val, true};
-                } else {
-                    return {cache[zCacheCurr][pos[zCurr] + 1], false};
-                }
-            case 6:  // add
-                cache[zCacheNext][pos[zNext] + 1] = val;
-                return {val, true};
-            case 7:
-                if (ind.x == 0) {
-                    cache[zCacheNext][pos[zNext]] = val;
-                    return {val, true};
-                } else {
-                    return {cache[zCacheNext][pos[zNext]], false};
-                }
-
-            case 8:
-                if (ind.y == 0) {
-                    cache[xCacheNext][cIm(pos[xNext0], ind.y)] = val;
-                    return {val, true};
-                } else {
-                    return {cache[xCacheNext][cIm(pos[xNext0], ind.y)], false};
-                }
-            case 9:  // add
-                cache[yCacheNext][cIm(pos[yNext] + 1, ind.y)] = val;
-                return {val, true};
-            case 10:  // add
-                cache[xCacheNext][cIm(pos[xNext1], ind.y + 1)] = val;
-                return {val, true};
-            case 11:
-                if (ind.x == 0) {
-                    cache[yCacheNext][cIm(pos[yNext], ind.y)] = val;
-                    return {val, true};
-                } else {
-                    return {cache[yCacheNext][cIm(pos[yNext], ind.y)], false};
-                }
-        }
-        return {0, false};
-    }
-    void incX(const std::array<size_t, 8> &increments) {
-        for (int i = 0; i < 8; ++i) {
-            pos[i] += increments[i];
-        }
-    }
-    void incY() {
-        std::swap(cache[zCacheCurr], cache[zCacheNext]);
-        pos[xCurr0] = 0;
-        pos[xNext0] = 0;
-        pos[xCurr1] = 0;
-        pos[xNext1] = 0;
-        pos[yCurr] = 0;
-        pos[yNext] = 0;
-        pos[zCurr] = 0;
-        pos[zNext] = 0;
-    }
-    void incZ() {
-        std::swap(cache[xCacheCurr], cache[xCacheNext]);
-        std::swap(cache[yCacheCurr], cache[yCacheNext]);
-    }
-
-private:
-    util::IndexMapper2D cIm;
-    std::array<std::vector<size_t>, 6> cache;
-    std::array<size_t, 8> pos;
-};
-
-struct OffsetIndexMasks {
-    OffsetIndexMasks(int next, int curr, size3_t off)
-        : nextMask{next}, currMask{curr}, offset{off} {}
-    const int nextMask;
-    const int currMask;
-    const size3_t offset;
+/**
+ * The lower end of a cube edge relative to the cell and the axis it is aligned with.
+ */
+struct EdgeInfo {
+    size3_t offset;
+    size_t axis;
 };
 
-template <typename T, typename IsoTest>
-class Index {
-public:
-    Index(const T *src, const util::IndexMapper3D &im, const IsoTest &test)
-        : offsets0_{[&]() {
-            std::array<size_t, 4> tmp;
-            std::transform(oim_.begin(), oim_.end(), tmp.begin(),
-                           [&](const auto &item) { return im(item.offset); });
-            return tmp;
-        }()}
-        , offsets1_{[&]() {
-            std::array<size_t, 4> tmp;
-            std::transform(oim_.begin(), oim_.end(), tmp.begin(), [&](const auto &item) {
-                return im(item.offset + size3_t{1, 0, 0});
-            });
-            return tmp;
-        }()}
-        , src_{src}
-        , test_{test} {}
-
-    void init(const size_t &gridIndex) {
-        int next = 0;
-        for (int v = 0; v < 4; ++v) {
-            const auto val = src_[gridIndex + offsets0_[v]];
-            if (test_(val)) {
-                next |= 1 << oim_[v].nextMask;
-            }
-        }
-        next_ = next;
-    }
-
-    void update(const size_t &gridIndex) {
-        int curr = next_;
-        int next = 0;
-        for (int v = 0; v < 4; ++v) {
-            const auto val = src_[gridIndex + offsets1_[v]];
-            if (test_(val)) {
-                next |= 1 << oim_[v].nextMask;
-                curr |= 1 << oim_[v].currMask;
-            }
-        }
-        next_ = next;
-        curr_ = curr;
-    }
-
-    operator size_t() { return curr_; }
-
-private:
-    static const std::array<OffsetIndexMasks, 4> oim_;
-    const std::array<size_t, 4> offsets0_;
-    const std::array<size_t, 4> offsets1_;
+std::array<EdgeInfo, 12> makeEdgeInfos(const marching::Config &cube) {
+    return util::make_array<12>([&](size_t e) {
+        const auto a = cube.vertices[cube.edges[e][0]];
+        const auto b = cube.vertices[cube.edges[e][1]];
+        const auto axis = static_cast<size_t>(a.x != b.x ? 0 : (a.y != b.y ? 1 : 2));
+        return EdgeInfo{glm::min(a, b), axis};
+    });
+}
 
-    const T *src_;
-    const IsoTest &test_;
-    int next_;
-    int curr_;
+/**
+ * A range of cell layers [z0, z1) processed by one task. Vertices on edges along x and y in the
+ * plane z0 and all edges between z0 and z1 are owned by the slab. The vertices in the plane z1 are
+ * owned by the next slab, they are referenced through foreign indices and resolved when the slabs
+ * are joined. Every vertex is thereby only created once.
+ */
+struct Slab {
+    size_t z0;
+    size_t z1;
+
+    std::vector<vec3> positions;
+    std::vector<vec3> normals;
+    std::vector<std::uint32_t> indices;
+
+    // (edge key, vertex index) of the vertices in plane z0, ordered by edge key
+    std::vector<std::pair<size_t, std::uint32_t>> bottom;
+
+    // Local copies of the vertices of the next slab, needed for the normals
+    std::vector<size_t> foreignKeys;
+    std::vector<vec3> foreignPositions;
+    std::vector<vec3> foreignNormals;
+    std::vector<std::uint32_t> foreignIndices;  //< Vertex indices in the next slab
 };
 
-template <typename T, typename IsoTest>
-const std::array<OffsetIndexMasks, 4> Index<T, IsoTest>::oim_ = {
-    {{0, 1, {0, 0, 0}}, {3, 2, {0, 1, 0}}, {4, 5, {0, 0, 1}}, {7, 6, {0, 1, 1}}}};
-
 }  // namespace
 
 namespace util {
@@ -455,86 +318,248 @@ std::shared_ptr<Mesh> marchingCubesOpt(std::shared_ptr<const Volume> volume, dou
     const auto mc = [&](auto ram, auto isoTest, auto mapValue) {
         using T = util::PrecisionValueType<decltype(ram)>;
         static const marching::Config cube{};
+        static const auto edgeInfos = makeEdgeInfos(cube);
 
         const T *src = ram->getDataTyped();
         const size3_t dim{volume->getDimensions()};
-        const size3_t dim1 = dim - size3_t{1, 1, 1};
         const util::IndexMapper3D im(dim);
-
         const auto dr = dvec3(1.0) / dvec3{glm::max(size3_t{1}, (dim - size3_t{1}))};
-        const auto doffs = [&]() {
-            std::array<dvec3, 8> tmp;
-            std::transform(cube.vertices.begin(), cube.vertices.end(), tmp.begin(),
-                           [dr](auto &v) { return dr * dvec3{v}; });
-            return tmp;
-        }();
-
-        const auto interpolate = [src, im, &mapValue, &doffs](const size3_t &ind, const dvec3 &pos,
-                                                              marching::Config::EdgeId e) {
-            const auto a = cube.edges[e][0];
-            const auto b = cube.edges[e][1];
-            const auto tv0 = src[im(ind + cube.vertices[a])];
-            const auto v0 = mapValue(tv0);
-            const auto tv1 = src[im(ind + cube.vertices[b])];
-            const auto v1 = mapValue(tv1);
 
-            const auto t = v0 / (v0 - v1);
-            const auto r0 = pos + doffs[a];
-            const auto r1 = pos + doffs[b];
-            return r0 + t * (r1 - r0);
+        if (glm::any(glm::lessThan(dim, size3_t{2}))) return;
+        const size3_t dim1 = dim - size3_t{1, 1, 1};
+        const size_t planeSize = dim.x * dim.y;
+
+        // Blocks of cells where all voxels are on the same side of the iso value are skipped
+        const size3_t blocks = (dim1 + size3_t{blockSize - 1}) / size3_t{blockSize};
+        const util::IndexMapper3D bim(blocks);
+        std::vector<char> active(blocks.x * blocks.y * blocks.z);
+        util::parallelFor(blocks, [&](const size3_t &block) {
+            const size3_t begin = block * blockSize;
+            const size3_t end = glm::min(begin + size3_t{blockSize + 1}, dim);
+            auto minVal = src[im(begin)];
+            auto maxVal = minVal;
+            for (size_t z = begin.z; z < end.z; ++z) {
+                for (size_t y = begin.y; y < end.y; ++y) {
+                    const auto row = src + im(0, y, z);
+                    for (size_t x = begin.x; x < end.x; ++x) {
+                        minVal = std::min(minVal, row[x]);
+                        maxVal = std::max(maxVal, row[x]);
+                    }
+                }
+            }
+            active[bim(block)] = isoTest(minVal) != isoTest(maxVal);
+        });
+
+        // The inside bits of the four corners (y,z), (y+1,z), (y,z+1), (y+1,z+1) of a cell face
+        // mapped onto the left (x) or right (x+1) cube vertices
+        static constexpr std::array<int, 4> leftVertices{0, 3, 4, 7};
+        static constexpr std::array<int, 4> rightVertices{1, 2, 5, 6};
+        const auto faceBits = [&](const std::array<int, 4> &vertices) {
+            return util::make_array<16>([&](size_t corners) {
+                int bits = 0;
+                for (size_t i = 0; i < 4; ++i) {
+                    if (corners & (size_t{1} << i)) bits |= 1 << vertices[i];
+                }
+                return bits;
+            });
+        };
+        static const auto leftBits = faceBits(leftVertices);
+        static const auto rightBits = faceBits(rightVertices);
+        const auto face = [&](size_t i) {
+            return static_cast<int>(isoTest(src[i])) |
+                   (static_cast<int>(isoTest(src[i + dim.x])) << 1) |
+                   (static_cast<int>(isoTest(src[i + planeSize])) << 2) |
+                   (static_cast<int>(isoTest(src[i + planeSize + dim.x])) << 3);
         };
 
-        VCache vcache(size2_t{dim.x, dim.y});
-        Index<T, decltype(isoTest)> index(src, im, isoTest);
-        size3_t ind;
-        dvec3 pos;
+        const auto interpolate = [&](const size3_t &g, size_t axis) {
+            size3_t g1{g};
+            ++g1[axis];
+            const auto v0 = mapValue(src[im(g)]);
+            const auto v1 = mapValue(src[im(g1)]);
+            const auto t = v0 / (v0 - v1);
+            const auto r0 = dvec3{g} * dr;
+            const auto r1 = dvec3{g1} * dr;
+            return vec3{r0 + t * (r1 - r0)};
+        };
 
         const float err =
             static_cast<float>(4.0 * glm::epsilon<double>() * glm::epsilon<double>() * dr.x * dr.y);
 
-        for (ind.z = 0, pos.z = 0.0; ind.z < dim1.z; ++ind.z, pos.z += dr.z) {
-            vcache.incZ();
-            for (ind.y = 0, pos.y = 0.0; ind.y < dim1.y; ++ind.y, pos.y += dr.y) {
-                ind.x = 0;
-                const auto cInd = im(ind);
-                vcache.incY();
-                index.init(cInd);
-                for (pos.x = 0.0; ind.x < dim1.x; ++ind.x, pos.x += dr.x) {
-                    index.update(cInd + ind.x);
-                    if (index == 0 || index == 255) continue;
-                    if (maskingCallback && !maskingCallback(ind)) continue;
-
-                    std::array<size_t, 12> inds;
-                    for (const auto edge : cube.caseEdges[index]) {
-                        const auto c = vcache.find(ind, edge, positions.size());
-                        inds[edge] = c.first;
-                        if (c.second) {
-                            const auto vertex = interpolate(ind, pos, edge);
-                            positions.emplace_back(vertex);
-                            normals.emplace_back(0.0f, 0.0f, 0.0f);
-                        }
+        std::mutex progressMutex;
+        std::atomic<size_t> layersDone{0};
+
+        const auto process = [&](Slab &slab, bool last) {
+            // Vertex indices of the edges along x and y (x edges first) in the planes z and z+1,
+            // and along z between them.
+            std::array<std::vector<std::uint32_t>, 2> planes{
+                std::vector<std::uint32_t>(2 * planeSize, noVertex),
+                std::vector<std::uint32_t>(2 * planeSize, noVertex)};
+            std::vector<std::uint32_t> zEdges(planeSize, noVertex);
+
+            const auto position = [&](std::uint32_t i) -> const vec3 & {
+                return (i & foreignFlag) ? slab.foreignPositions[i & ~foreignFlag]
+                                         : slab.positions[i];
+            };
+            const auto normal = [&](std::uint32_t i) -> vec3 & {
+                return (i & foreignFlag) ? slab.foreignNormals[i & ~foreignFlag] : slab.normals[i];
+            };
+
+            const auto vertex = [&](const size3_t &ind, marching::Config::EdgeId e) {
+                const auto &info = edgeInfos[e];
+                const size3_t g = ind + info.offset;
+                const size_t i2 = g.y * dim.x + g.x;
+                const size_t plane = g.z - ind.z;
+                auto &slot =
+                    info.axis == 2 ? zEdges[i2] : planes[plane][info.axis * planeSize + i2];
+                if (slot == noVertex) {
+                    const auto pos = interpolate(g, info.axis);
+                    if (plane == 1 && !last && g.z == slab.z1) {
+                        slot = foreignFlag | static_cast<std::uint32_t>(slab.foreignKeys.size());
+                        slab.foreignKeys.push_back(info.axis * planeSize + i2);
+                        slab.foreignPositions.push_back(pos);
+                        slab.foreignNormals.emplace_back(0.0f, 0.0f, 0.0f);
+                    } else {
+                        slot = static_cast<std::uint32_t>(slab.positions.size());
+                        slab.positions.push_back(pos);
+                        slab.normals.emplace_back(0.0f, 0.0f, 0.0f);
                     }
-                    for (const auto &tri : cube.caseTriangles[index]) {
-                        const auto side0 = positions[inds[tri[1]]] - positions[inds[tri[0]]];
-                        const auto side1 = positions[inds[tri[2]]] - positions[inds[tri[0]]];
-                        auto n = glm::cross(side0, side1);
-                        if (glm::length2(n) < err) {
-                            continue;  // triangle is so small area is 0.
+                }
+                return slot;
+            };
+
+            const auto cell = [&](const size3_t &ind, int index) {
+                std::array<std::uint32_t, 12> inds;
+                for (const auto edge : cube.caseEdges[index]) {
+                    inds[edge] = vertex(ind, edge);
+                }
+                for (const auto &tri : cube.caseTriangles[index]) {
+                    const auto &p0 = position(inds[tri[0]]);
+                    const auto side0 = position(inds[tri[1]]) - p0;
+                    const auto side1 = position(inds[tri[2]]) - p0;
+                    auto n = glm::cross(side0, side1);
+                    if (glm::length2(n) < err) {
+                        continue;  // triangle is so small area is 0.
+                    }
+                    n = glm::normalize(n);
+                    for (int v = 0; v < 3; ++v) {
+                        slab.indices.push_back(inds[tri[v]]);
+                        normal(inds[tri[v]]) += n;
+                    }
+                }
+            };
+
+            size3_t ind;
+            for (ind.z = slab.z0; ind.z < slab.z1; ++ind.z) {
+                for (ind.y = 0; ind.y < dim1.y; ++ind.y) {
+                    const size_t row = im(0, ind.y, ind.z);
+                    const size_t blockRow = bim(0, ind.y / blockSize, ind.z / blockSize);
+                    int left = -1;
+                    for (ind.x = 0; ind.x < dim1.x;) {
+                        const size_t blockEnd = std::min(ind.x + blockSize, dim1.x);
+                        if (!active[blockRow + ind.x / blockSize]) {
+                            ind.x = blockEnd;
+                            left = -1;
+                            continue;
+                        }
+                        if (left < 0) left = face(row + ind.x);
+                        for (; ind.x < blockEnd; ++ind.x) {
+                            const int right = face(row + ind.x + 1);
+                            const int index = leftBits[left] | rightBits[right];
+                            left = right;
+                            if (index == 0 || index == 255) continue;
+                            if (maskingCallback && !maskingCallback(ind)) continue;
+                            cell(ind, index);
                         }
-                        n = glm::normalize(n);
-                        for (int v = 0; v < 3; ++v) {
-                            indices.push_back(static_cast<uint32_t>(inds[tri[v]]));
-                            normals[inds[tri[v]]] += n;
+                    }
+                }
+
+                if (ind.z == slab.z0) {
+                    for (size_t key = 0; key < 2 * planeSize; ++key) {
+                        if (planes[0][key] != noVertex) {
+                            slab.bottom.emplace_back(key, planes[0][key]);
                         }
                     }
-                    vcache.incX(cube.caseIncrements[index]);
+                }
+                std::swap(planes[0], planes[1]);
+                std::fill(planes[1].begin(), planes[1].end(), noVertex);
+                std::fill(zEdges.begin(), zEdges.end(), noVertex);
+
+                if (progressCallback) {
+                    const auto done = ++layersDone;
+                    std::scoped_lock lock{progressMutex};
+                    progressCallback(static_cast<float>(done) / static_cast<float>(dim1.z));
                 }
             }
-            if (progressCallback) {
-                progressCallback(static_cast<float>(ind.z + 1) / static_cast<float>(dim.z - 1));
+        };
+
+        const size_t layersPerSlab = std::max(blockSize, dim1.z / 64);
+        std::vector<Slab> slabs;
+        for (size_t z0 = 0; z0 < dim1.z; z0 += layersPerSlab) {
+            slabs.push_back(Slab{z0, std::min(z0 + layersPerSlab, dim1.z)});
+        }
+        util::parallelFor(
+            size_t{0}, slabs.size(), [&](size_t i) { process(slabs[i], i + 1 == slabs.size()); },
+            1);
+
+        // Resolve the vertices shared with the next slab. A vertex might be missing if the
+        // masking callback excluded all of the cells of the next slab using it.
+        for (size_t i = 0; i + 1 < slabs.size(); ++i) {
+            auto &slab = slabs[i];
+            auto &next = slabs[i + 1];
+            std::unordered_map<size_t, std::uint32_t> added;
+            for (size_t j = 0; j < slab.foreignKeys.size(); ++j) {
+                const auto key = slab.foreignKeys[j];
+                auto it = std::lower_bound(next.bottom.begin(), next.bottom.end(),
+                                           std::make_pair(key, std::uint32_t{0}));
+                std::uint32_t index;
+                if (it != next.bottom.end() && it->first == key) {
+                    index = it->second;
+                } else if (auto ait = added.find(key); ait != added.end()) {
+                    index = ait->second;
+                } else {
+                    index = static_cast<std::uint32_t>(next.positions.size());
+                    next.positions.push_back(slab.foreignPositions[j]);
+                    next.normals.emplace_back(0.0f, 0.0f, 0.0f);
+                    added.emplace(key, index);
+                }
+                next.normals[index] += slab.foreignNormals[j];
+                slab.foreignIndices.push_back(index);
             }
         }
 
+        std::vector<size_t> vertexOffsets(slabs.size() + 1, 0);
+        std::vector<size_t> indexOffsets(slabs.size() + 1, 0);
+        for (size_t i = 0; i < slabs.size(); ++i) {
+            vertexOffsets[i + 1] = vertexOffsets[i] + slabs[i].positions.size();
+            indexOffsets[i + 1] = indexOffsets[i] + slabs[i].indices.size();
+        }
+        positions.resize(vertexOffsets.back());
+        normals.resize(vertexOffsets.back());
+        indices.resize(indexOffsets.back());
+
+        util::parallelFor(
+            size_t{0}, slabs.size(),
+            [&](size_t i) {
+                auto &slab = slabs[i];
+                std::copy(slab.positions.begin(), slab.positions.end(),
+                          positions.begin() + vertexOffsets[i]);
+                std::copy(slab.normals.begin(), slab.normals.end(),
+                          normals.begin() + vertexOffsets[i]);
+                const auto offset = static_cast<std::uint32_t>(vertexOffsets[i]);
+                const auto nextOffset = static_cast<std::uint32_t>(vertexOffsets[i + 1]);
+                const auto &foreign = slab.foreignIndices;
+                std::transform(slab.indices.begin(), slab.indices.end(),
+                               indices.begin() + indexOffsets[i], [&](std::uint32_t index) {
+                                   if (index & foreignFlag) {
+                                       return nextOffset + foreign[index & ~foreignFlag];
+                                   }
+                                   return offset + index;
+                               });
+                slab = Slab{};
+            },
+            1);
+
         if (enclose) {
             marching::encloseSurfce(src, dim, indexRAM, positions, normals, iso, invert, dr.x, dr.y,
                                     dr.z);
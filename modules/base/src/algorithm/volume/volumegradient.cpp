@@ -29,11 +29,13 @@
 
 #include <modules/base/algorithm/volume/volumegradient.h>
 
-#include <inviwo/core/util/volumeramutils.h>
 #include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/parallel.h>
 #include <inviwo/core/util/volumesampler.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 
+#include <vector>
+
 namespace inviwo {
 namespace util {
 
@@ -56,26 +58,38 @@ std::shared_ptr<Volume> gradientVolume(std::shared_ptr<const Volume> volume, int
     VolumeDoubleSampler<4> sampler(volume);
     const auto worldSpace = VolumeDoubleSampler<3>::Space::World;
 
-    util::IndexMapper3D index(volume->getDimensions());
+    const size3_t dims{volume->getDimensions()};
+    util::IndexMapper3D index(dims);
     auto data = static_cast<vec3*>(newVolume->getEditableRepresentation<VolumeRAM>()->getData());
 
-    auto func = [&](const size3_t& pos) {
-        const vec3 world{m * vec4(vec3(pos) / vec3(volume->getDimensions() - size3_t(1)), 1)};
-
-        vec3 g;
-        g.x = static_cast<float>((sampler.sample(world + ox, worldSpace) -
-                                  sampler.sample(world - ox, worldSpace))[channel] /
-                                 (2.0 * spacing.x));
-        g.y = static_cast<float>((sampler.sample(world + oy, worldSpace) -
-                                  sampler.sample(world - oy, worldSpace))[channel] /
-                                 (2.0 * spacing.y));
-        g.z = static_cast<float>((sampler.sample(world + oz, worldSpace) -
-                                  sampler.sample(world - oz, worldSpace))[channel] /
-                                 (2.0 * spacing.z));
-        data[index(pos)] = g;
-    };
+    // Sample the six neighbors of all voxels of a line along x in one batch
+    util::parallelFor(size_t{0}, dims.y * dims.z, [&](size_t begin, size_t end) {
+        std::vector<dvec3> positions(6 * dims.x);
+        std::vector<dvec4> samples(6 * dims.x);
+        for (size_t line = begin; line < end; ++line) {
+            size3_t pos{0, line % dims.y, line / dims.y};
+            for (pos.x = 0; pos.x < dims.x; ++pos.x) {
+                const vec3 world{m * vec4(vec3(pos) / vec3(dims - size3_t(1)), 1)};
+                auto p = positions.begin() + 6 * pos.x;
+                p[0] = dvec3(world + ox);
+                p[1] = dvec3(world - ox);
+                p[2] = dvec3(world + oy);
+                p[3] = dvec3(world - oy);
+                p[4] = dvec3(world + oz);
+                p[5] = dvec3(world - oz);
+            }
+            sampler.sampleBatch(positions, samples, worldSpace);
 
-    util::forEachVoxelParallel(*volume->getRepresentation<VolumeRAM>(), func);
+            for (pos.x = 0; pos.x < dims.x; ++pos.x) {
+                const auto s = samples.begin() + 6 * pos.x;
+                vec3 g;
+                g.x = static_cast<float>((s[0] - s[1])[channel] / (2.0 * spacing.x));
+                g.y = static_cast<float>((s[2] - s[3])[channel] / (2.0 * spacing.y));
+                g.z = static_cast<float>((s[4] - s[5])[channel] / (2.0 * spacing.z));
+                data[index(pos)] = g;
+            }
+        }
+    });
 
     return newVolume;
 }
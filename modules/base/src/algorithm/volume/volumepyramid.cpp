@@ -0,0 +1,291 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/volume/volumepyramid.h>
+#include <modules/base/algorithm/volume/volumeramsubsample.h>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumebricked.h>
+#include <inviwo/core/resourcemanager/memorymanager.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/parallel.h>
+#include <inviwo/core/util/threadpool.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<const Volume> makeLevel(const Volume& volume, std::shared_ptr<VolumeRAM> ram) {
+    ram->setSwizzleMask(volume.getSwizzleMask());
+    ram->setInterpolation(volume.getInterpolation());
+    ram->setWrapping(volume.getWrapping());
+
+    auto level = std::make_shared<Volume>(std::move(ram));
+    level->copyMetaDataFrom(volume);
+    level->dataMap_ = volume.dataMap_;
+    level->setModelMatrix(volume.getModelMatrix());
+    level->setWorldMatrix(volume.getWorldMatrix());
+    return level;
+}
+
+// Thrown out of std::call_once when a level is stopped, such that the level is not marked as built
+struct Stopped {};
+
+/*
+ * Subsample a bricked volume in blocks of whole bricks. The block size is rounded up to a multiple
+ * of the factors, hence each block maps to a separate region of the result. Returns nullptr if
+ * stopped, the remaining blocks are then skipped.
+ */
+std::shared_ptr<VolumeRAM> subsampleBricked(const VolumeBricked& bricked, const size3_t& f,
+                                            const std::function<bool()>& stop,
+                                            const std::function<void(float)>& progress) {
+    const auto srcDims = bricked.getDimensions();
+    const auto dstDims = srcDims / f;
+    const size3_t block = (bricked.getBrickSize() + f - size3_t{1}) / f * f;
+    const util::IndexMapper3D blockIndex((srcDims + block - size3_t{1}) / block);
+    const util::IndexMapper3D dstIndex(dstDims);
+    const size_t nBlocks = glm::compMul((srcDims + block - size3_t{1}) / block);
+
+    auto dst = createVolumeRAM(dstDims, bricked.getDataFormat());
+    auto dstData = static_cast<char*>(dst->getData());
+    const auto elementSize = bricked.getDataFormat()->getSize();
+
+    std::mutex progressMutex;
+    size_t finished = 0;
+    std::atomic<bool> stopped{false};
+
+    util::parallelFor(
+        size_t{0}, nBlocks,
+        [&](size_t i) {
+            if (stopped || (stop && stop())) {
+                stopped = true;
+                return;
+            }
+            const auto offset = blockIndex(i) * block;
+            const auto extent = glm::min(block, srcDims - offset);
+            if (glm::all(glm::greaterThanEqual(extent, f))) {
+                const auto sub = util::volumeSubSample(bricked.getRegion(offset, extent).get(), f);
+                const auto subDims = sub->getDimensions();
+                const auto subData = static_cast<const char*>(sub->getData());
+                const util::IndexMapper3D subIndex(subDims);
+                const auto dstOffset = offset / f;
+                for (size_t z = 0; z < subDims.z; ++z) {
+                    for (size_t y = 0; y < subDims.y; ++y) {
+                        std::memcpy(dstData + dstIndex(dstOffset + size3_t{0, y, z}) * elementSize,
+                                    subData + subIndex(0, y, z) * elementSize,
+                                    subDims.x * elementSize);
+                    }
+                }
+            }
+            if (progress) {
+                std::scoped_lock lock{progressMutex};
+                progress(static_cast<float>(++finished) / static_cast<float>(nBlocks));
+            }
+        },
+        1);
+
+    return stopped ? nullptr : dst;
+}
+
+}  // namespace
+
+std::shared_ptr<VolumePyramid> VolumePyramid::get(const std::shared_ptr<const Volume>& volume) {
+    static std::mutex mutex;
+    static std::vector<std::weak_ptr<VolumePyramid>> pyramids;
+
+    std::scoped_lock lock{mutex};
+    pyramids.erase(std::remove_if(pyramids.begin(), pyramids.end(),
+                                  [](const auto& weak) {
+                                      auto pyramid = weak.lock();
+                                      return !pyramid || pyramid->volume_.expired();
+                                  }),
+                   pyramids.end());
+
+    for (const auto& weak : pyramids) {
+        if (auto pyramid = weak.lock(); pyramid && pyramid->volume_.lock() == volume) {
+            return pyramid;
+        }
+    }
+    // The constructor is private, so make_shared can not be used.
+    auto pyramid = std::shared_ptr<VolumePyramid>(new VolumePyramid(volume));
+    pyramids.push_back(pyramid);
+    return pyramid;
+}
+
+VolumePyramid::VolumePyramid(const std::shared_ptr<const Volume>& volume) : volume_{volume} {
+    if (!volume) throw Exception("Missing volume", IVW_CONTEXT);
+
+    auto dims = volume->getDimensions();
+    while (true) {
+        auto level = std::make_unique<Level>();
+        level->dimensions = dims;
+        level->result = level->promise.get_future().share();
+        levels_.push_back(std::move(level));
+        if (glm::compMax(dims) <= minDimension) break;
+        dims /= glm::max(glm::min(dims, size3_t{2}), size3_t{1});
+    }
+}
+
+VolumePyramid::~VolumePyramid() = default;
+
+std::shared_ptr<const Volume> VolumePyramid::getVolume() const { return volume_.lock(); }
+
+size_t VolumePyramid::getNumberOfLevels() const { return levels_.size(); }
+
+size3_t VolumePyramid::getDimensions(size_t level) const { return levels_.at(level)->dimensions; }
+
+size3_t VolumePyramid::getFactors(size_t level) const {
+    if (level == 0 || level >= levels_.size()) {
+        throw RangeException("Invalid level " + std::to_string(level), IVW_CONTEXT);
+    }
+    return glm::max(glm::min(levels_[level - 1]->dimensions, size3_t{2}), size3_t{1});
+}
+
+std::optional<size_t> VolumePyramid::findLevel(const size3_t& factors) const {
+    size3_t accumulated{1};
+    for (size_t level = 0; level < levels_.size(); ++level) {
+        if (level > 0) accumulated *= getFactors(level);
+        if (accumulated == factors) return level;
+    }
+    return std::nullopt;
+}
+
+std::shared_ptr<const Volume> VolumePyramid::getLevel(size_t level,
+                                                      const std::function<void(float)>& progress) {
+    return getLevel(level, std::function<bool()>{}, progress);
+}
+
+std::shared_ptr<const Volume> VolumePyramid::getLevel(size_t level,
+                                                      const std::function<bool()>& stop,
+                                                      const std::function<void(float)>& progress) {
+    if (level >= levels_.size()) {
+        throw RangeException("Invalid level " + std::to_string(level), IVW_CONTEXT);
+    }
+    if (level == 0) {
+        if (auto volume = volume_.lock()) return volume;
+        throw Exception("The volume of the pyramid has been destroyed", IVW_CONTEXT);
+    }
+
+    try {
+        for (size_t i = 1; i <= level; ++i) {
+            auto& current = *levels_[i];
+            std::call_once(current.once, [&]() {
+                try {
+                    auto levelProgress = [&](float p) {
+                        if (progress) progress((static_cast<float>(i - 1) + p) / level);
+                    };
+                    current.promise.set_value(build(i, stop, levelProgress));
+                    current.ready = true;
+                } catch (const Stopped&) {
+                    throw;
+                } catch (...) {
+                    current.promise.set_exception(std::current_exception());
+                }
+            });
+        }
+    } catch (const Stopped&) {
+        return nullptr;
+    }
+    if (progress) progress(1.0f);
+    return levels_[level]->result.get();
+}
+
+std::shared_ptr<const Volume> VolumePyramid::build(size_t level,
+                                                   const std::function<bool()>& stop,
+                                                   const std::function<void(float)>& progress) {
+    if (stop && stop()) throw Stopped{};
+    const auto volume = volume_.lock();
+    if (!volume) throw Exception("The volume of the pyramid has been destroyed", IVW_CONTEXT);
+
+    const auto f = getFactors(level);
+    if (level == 1) {
+        if (auto bricked = util::getBrickedRepresentation(*volume)) {
+            auto ram = subsampleBricked(*bricked, f, stop, progress);
+            if (!ram) throw Stopped{};
+            return makeLevel(*volume, std::move(ram));
+        }
+    }
+    const auto& src = level == 1 ? volume : levels_[level - 1]->result.get();
+    // Held such that the MemoryManager does not evict it while the level is built
+    const auto srcRam = src->getSharedRepresentation<VolumeRAM>();
+    auto ram = util::volumeSubSample(srcRam.get(), f);
+    progress(1.0f);
+    return makeLevel(*volume, std::move(ram));
+}
+
+bool VolumePyramid::isAvailable(size_t level) const {
+    if (level >= levels_.size()) return false;
+    if (level == 0) {
+        const auto volume = volume_.lock();
+        return volume && volume->hasRepresentation<VolumeRAM>();
+    }
+    return levels_[level]->ready;
+}
+
+auto VolumePyramid::getBestAvailable(size_t level) const
+    -> std::optional<std::pair<size_t, std::shared_ptr<const Volume>>> {
+    const auto get = [&](size_t i) -> std::pair<size_t, std::shared_ptr<const Volume>> {
+        return {i, i == 0 ? volume_.lock() : levels_[i]->result.get()};
+    };
+
+    level = std::min(level, levels_.size() - 1);
+    for (size_t i = level; i < levels_.size(); ++i) {
+        if (isAvailable(i)) return get(i);
+    }
+    for (size_t i = level; i-- > 0;) {
+        if (isAvailable(i)) return get(i);
+    }
+    return std::nullopt;
+}
+
+void VolumePyramid::request(size_t level) {
+    if (!InviwoApplication::isInitialized() || isAvailable(level)) return;
+    InviwoApplication::getPtr()->getThreadPool().enqueueRaw(
+        [weak = weak_from_this(), level]() {
+            if (auto pyramid = weak.lock()) {
+                const MemoryManager::Lease lease;
+                try {
+                    pyramid->getLevel(level);
+                } catch (...) {
+                    // The error is stored in the level and rethrown by getLevel.
+                }
+            }
+        },
+        ThreadPool::Priority::Low);
+}
+
+}  // namespace inviwo
@@ -31,10 +31,7 @@
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/util/indexmapper.h>
-
-#ifdef IVW_USE_OPENMP
-#include <omp.h>
-#endif
+#include <inviwo/core/util/parallel.h>
 
 namespace inviwo {
 
@@ -62,33 +59,23 @@ std::shared_ptr<VolumeRAM> util::volumeSubSample(const VolumeRAM* volume, size3_
 
             const double samplesInv = 1.0 / (f.x * f.y * f.z);
 
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-            for (long long z_ = 0; z_ < static_cast<long long>(destDims.z); ++z_) {
-                const size_t z = static_cast<size_t>(z_);  // OpenMP need signed integral type.
-                for (size_t y = 0; y < destDims.y; ++y) {
-                    for (size_t x = 0; x < destDims.x; ++x) {
-                        const size_t px{x * f.x};
-                        const size_t py{y * f.y};
-                        const size_t pz{z * f.z};
-                        P val{0.0};
+            util::parallelFor(destDims, [&](const size3_t& pos) {
+                const size3_t p{pos * f};
+                P val{0.0};
 
-                        for (size_t oz = 0; oz < f.z; ++oz) {
-                            for (size_t oy = 0; oy < f.y; ++oy) {
-                                for (size_t ox = 0; ox < f.x; ++ox) {
-                                    val += src[o(px + ox, py + oy, pz + oz)];
-                                }
-                            }
+                for (size_t oz = 0; oz < f.z; ++oz) {
+                    for (size_t oy = 0; oy < f.y; ++oy) {
+                        for (size_t ox = 0; ox < f.x; ++ox) {
+                            val += src[o(p.x + ox, p.y + oy, p.z + oz)];
                         }
+                    }
+                }
 
 #include <warn/push>
 #include <warn/ignore/conversion>
-                        dst[n(x, y, z)] = static_cast<ValueType>(val * samplesInv);
+                dst[n(pos)] = static_cast<ValueType>(val * samplesInv);
 #include <warn/pop>
-                    }
-                }
-            }
+            });
 
             return destVol;
         });
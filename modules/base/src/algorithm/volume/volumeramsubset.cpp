@@ -28,10 +28,7 @@
  *********************************************************************************/
 
 #include <modules/base/algorithm/volume/volumeramsubset.h>
-
-#ifdef IVW_USE_OPENMP
-#include <omp.h>
-#endif
+#include <inviwo/core/util/parallel.h>
 
 namespace inviwo {
 
@@ -99,19 +96,18 @@ std::shared_ptr<VolumeRAM> VolumeRAMSubSetDispatcher::operator()(const VolumeRep
     const T* src = static_cast<const T*>(volume->getData());
     T* dst = static_cast<T*>(newVolume->getData());
     // memcpy each row for every slice to form sub volume
-
-    for (int i = 0; i < static_cast<int>(copyDimsWithoutBorder.z); i++) {
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-        for (int j = 0; j < static_cast<int>(copyDimsWithoutBorder.y); j++) {
-            size_t volumePos = (j * dataDims.x) + (i * dataDims.x * dataDims.y);
-            size_t subVolumePos = ((j + trueBorder.llf.y) * dimsWithBorder.x) +
-                                  ((i + trueBorder.llf.z) * dimsWithBorder.x * dimsWithBorder.y) +
-                                  trueBorder.llf.x;
-            std::memcpy(dst + subVolumePos, (src + volumePos + initialStartPos), dataSize);
-        }
-    }
+    util::parallelFor(size2_t{copyDimsWithoutBorder.y, copyDimsWithoutBorder.z},
+                      [&](const size2_t& row) {
+                          const auto j = row.x;
+                          const auto i = row.y;
+                          size_t volumePos = (j * dataDims.x) + (i * dataDims.x * dataDims.y);
+                          size_t subVolumePos =
+                              ((j + trueBorder.llf.y) * dimsWithBorder.x) +
+                              ((i + trueBorder.llf.z) * dimsWithBorder.x * dimsWithBorder.y) +
+                              trueBorder.llf.x;
+                          std::memcpy(dst + subVolumePos, (src + volumePos + initialStartPos),
+                                      dataSize);
+                      });
 
     return newVolume;
 }
@@ -28,6 +28,9 @@
  *********************************************************************************/
 
 #include <modules/base/algorithm/volume/volumevoronoi.h>
+#include <modules/base/datastructures/flatkdtree.h>
+
+#include <cmath>
 
 namespace inviwo {
 namespace util {
@@ -35,7 +38,8 @@ namespace util {
 std::shared_ptr<Volume> voronoiSegmentation(
     const size3_t volumeDimensions, const mat4& indexToModelMatrix,
     const std::vector<std::pair<uint32_t, vec3>>& seedPointsWithIndices,
-    const std::optional<std::vector<float>>& weights, bool weightedVoronoi) {
+    const std::optional<std::vector<float>>& weights, bool weightedVoronoi,
+    VoronoiAlgorithm algorithm) {
 
     if (seedPointsWithIndices.size() == 0) {
         throw Exception("No seed points, cannot create volume voronoi segmentation",
@@ -62,10 +66,64 @@ std::shared_ptr<Volume> voronoiSegmentation(
 
     auto volumeIndices = newVolumeRep->getDataTyped();
     util::IndexMapper3D index(volumeDimensions);
+    const mat3 indexToModel{indexToModelMatrix};
+
+    if (algorithm == VoronoiAlgorithm::KDTree) {
+        if (weightedVoronoi) {
+            // The power distance |p - s|^2 - w^2 equals |p' - s'|^2 - W^2 with the seeds lifted
+            // to s' = (s, sqrt(W^2 - w^2)), the voxels to p' = (p, 0), and W the largest weight.
+            // The closest lifted seed is refined by comparing all seeds that are about as close
+            // using the power distance, to get the same result as the brute force version.
+            const auto& w = weights.value();
+            float maxWeight2 = 0.0f;
+            for (auto weight : w) maxWeight2 = std::max(maxWeight2, weight * weight);
+
+            std::vector<vec4> lifted(seedPointsWithIndices.size());
+            for (size_t i = 0; i < lifted.size(); ++i) {
+                lifted[i] = vec4{seedPointsWithIndices[i].second,
+                                 std::sqrt(std::max(0.0f, maxWeight2 - w[i] * w[i]))};
+            }
+            const FlatKDTree<4> tree(lifted);
+
+            util::forEachVoxelParallel(volumeDimensions, [&](const size3_t& voxelPos) {
+                const auto transformedVoxelPos = indexToModel * vec3{voxelPos};
+                const vec4 query{transformedVoxelPos, 0.0f};
+                const auto closest = tree.nearest(query);
+                const float dist2 = glm::distance2(lifted[closest], query);
+                const float tolerance = 1e-5f * (dist2 + maxWeight2);
+
+                size_t best = closest;
+                float bestDist = glm::distance2(seedPointsWithIndices[closest].second,
+                                                transformedVoxelPos) -
+                                 w[closest] * w[closest];
+                for (auto i : tree.withinRadius(query, std::sqrt(dist2 + tolerance))) {
+                    const float dist =
+                        glm::distance2(seedPointsWithIndices[i].second, transformedVoxelPos) -
+                        w[i] * w[i];
+                    if (dist < bestDist || (dist == bestDist && i < best)) {
+                        best = i;
+                        bestDist = dist;
+                    }
+                }
+                volumeIndices[index(voxelPos)] =
+                    static_cast<unsigned short>(seedPointsWithIndices[best].first);
+            });
+        } else {
+            std::vector<vec3> positions(seedPointsWithIndices.size());
+            std::transform(seedPointsWithIndices.begin(), seedPointsWithIndices.end(),
+                           positions.begin(), [](const auto& seed) { return seed.second; });
+            const FlatKDTree<3> tree(positions);
 
-    if (weightedVoronoi && weights.has_value()) {
+            util::forEachVoxelParallel(volumeDimensions, [&](const size3_t& voxelPos) {
+                const auto transformedVoxelPos = indexToModel * vec3{voxelPos};
+                const auto closest = tree.nearest(transformedVoxelPos);
+                volumeIndices[index(voxelPos)] =
+                    static_cast<unsigned short>(seedPointsWithIndices[closest].first);
+            });
+        }
+    } else if (weightedVoronoi && weights.has_value()) {
         util::forEachVoxelParallel(volumeDimensions, [&](const size3_t& voxelPos) {
-            const auto transformedVoxelPos = mat3(indexToModelMatrix) * voxelPos;
+            const auto transformedVoxelPos = indexToModel * vec3{voxelPos};
             auto zipped = util::zip(seedPointsWithIndices, weights.value());
 
             auto&& [posWithIndex, weight] = *std::min_element(
@@ -80,7 +138,7 @@ std::shared_ptr<Volume> voronoiSegmentation(
         });
     } else {
         util::forEachVoxelParallel(volumeDimensions, [&](const size3_t& voxelPos) {
-            const auto transformedVoxelPos = mat3(indexToModelMatrix) * voxelPos;
+            const auto transformedVoxelPos = indexToModel * vec3{voxelPos};
             auto it = std::min_element(seedPointsWithIndices.cbegin(), seedPointsWithIndices.cend(),
                                        [transformedVoxelPos](const auto& p1, const auto& p2) {
                                            return glm::distance2(p1.second, transformedVoxelPos) <
@@ -39,6 +39,13 @@
 #include <modules/base/processors/gridplanes.h>
 #include <modules/base/processors/heightfieldmapper.h>
 #include <modules/base/processors/imageinformation.h>
+#include <modules/base/processors/imagebinarycpu.h>
+#include <modules/base/processors/imagegradientcpu.h>
+#include <modules/base/processors/imagegrayscalecpu.h>
+#include <modules/base/processors/imagehighpasscpu.h>
+#include <modules/base/processors/imagelowpasscpu.h>
+#include <modules/base/processors/imagemixercpu.h>
+#include <modules/base/processors/imageresamplecpu.h>
 #include <modules/base/processors/inputselector.h>
 #include <modules/base/processors/layerdistancetransformram.h>
 #include <modules/base/processors/imageexport.h>
@@ -143,8 +150,15 @@ BaseModule::BaseModule(InviwoApplication* app) : InviwoModule(app, "Base") {
     registerProcessor<GridPlanes>();
     registerProcessor<MeshSource>();
     registerProcessor<HeightFieldMapper>();
+    registerProcessor<ImageBinaryCPU>();
     registerProcessor<ImageExport>();
+    registerProcessor<ImageGradientCPU>();
+    registerProcessor<ImageGrayscaleCPU>();
+    registerProcessor<ImageHighPassCPU>();
     registerProcessor<ImageInformation>();
+    registerProcessor<ImageLowPassCPU>();
+    registerProcessor<ImageMixerCPU>();
+    registerProcessor<ImageResampleCPU>();
     registerProcessor<ImageSnapshot>();
     registerProcessor<ImageSource>();
     registerProcessor<ImageSourceSeries>();
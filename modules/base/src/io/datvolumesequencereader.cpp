@@ -47,7 +47,7 @@
 namespace inviwo {
 
 DatVolumeSequenceReader::DatVolumeSequenceReader()
-    : DataReaderType<VolumeSequence>(), enableLogOutput_(true) {
+    : DataReaderType<VolumeSequence>(), enableLogOutput_(true), memoryMap_(false) {
     addExtension(FileExtension("dat", "Inviwo dat file format"));
 }
 
@@ -59,6 +59,21 @@ DatVolumeSequenceReader* DatVolumeSequenceReader::clone() const {
     return new DatVolumeSequenceReader(*this);
 }
 
+bool DatVolumeSequenceReader::setOption(std::string_view key, std::any value) {
+    if (auto* memoryMap = std::any_cast<bool>(&value); memoryMap && key == "MemoryMap") {
+        memoryMap_ = *memoryMap;
+        return true;
+    }
+    return false;
+}
+
+std::any DatVolumeSequenceReader::getOption(std::string_view key) {
+    if (key == "MemoryMap") {
+        return memoryMap_;
+    }
+    return std::any{};
+}
+
 std::shared_ptr<DatVolumeSequenceReader::VolumeSequence> DatVolumeSequenceReader::readData(
     const std::string& filePath) {
     std::string fileName = filePath;
@@ -252,6 +267,7 @@ std::shared_ptr<DatVolumeSequenceReader::VolumeSequence> DatVolumeSequenceReader
         for (size_t t = 0; t < state.datFiles.size(); ++t) {
             auto datVolReader = std::make_unique<DatVolumeSequenceReader>();
             datVolReader->enableLogOutput_ = false;
+            datVolReader->memoryMap_ = memoryMap_;
             auto path = filesystem::isAbsolutePath(state.datFiles[t])
                             ? state.datFiles[t]
                             : fileDirectory + "/" + state.datFiles[t];
@@ -347,8 +363,8 @@ std::shared_ptr<DatVolumeSequenceReader::VolumeSequence> DatVolumeSequenceReader
                                                          state.wrapping);
             const auto filePos = t * bytes + state.byteOffset;
 
-            auto loader = std::make_unique<RawVolumeRAMLoader>(fileDirectory + "/" + state.rawFile,
-                                                               filePos, state.littleEndian);
+            auto loader = std::make_unique<RawVolumeRAMLoader>(
+                fileDirectory + "/" + state.rawFile, filePos, state.littleEndian, memoryMap_);
             diskRepr->setLoader(loader.release());
             volumes->back()->addRepresentation(diskRepr);
             // Compute data range if not specified
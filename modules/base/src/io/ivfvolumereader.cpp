@@ -37,12 +37,27 @@
 
 namespace inviwo {
 
-IvfVolumeReader::IvfVolumeReader() : DataReaderType<Volume>() {
+IvfVolumeReader::IvfVolumeReader() : DataReaderType<Volume>(), memoryMap_(false) {
     addExtension(FileExtension("ivf", "Inviwo ivf file format"));
 }
 
 IvfVolumeReader* IvfVolumeReader::clone() const { return new IvfVolumeReader(*this); }
 
+bool IvfVolumeReader::setOption(std::string_view key, std::any value) {
+    if (auto* memoryMap = std::any_cast<bool>(&value); memoryMap && key == "MemoryMap") {
+        memoryMap_ = *memoryMap;
+        return true;
+    }
+    return false;
+}
+
+std::any IvfVolumeReader::getOption(std::string_view key) {
+    if (key == "MemoryMap") {
+        return memoryMap_;
+    }
+    return std::any{};
+}
+
 std::shared_ptr<Volume> IvfVolumeReader::readData(const std::string& filePath) {
     if (!filesystem::fileExists(filePath)) {
         throw DataReaderException("Error could not find input file: " + filePath, IVW_CONTEXT);
@@ -93,7 +108,8 @@ std::shared_ptr<Volume> IvfVolumeReader::readData(const std::string& filePath) {
     auto vd = std::make_shared<VolumeDisk>(filePath, dimensions, format, swizzleMask, interpolation,
                                            wrapping);
 
-    auto loader = std::make_unique<RawVolumeRAMLoader>(rawFile, byteOffset, littleEndian);
+    auto loader =
+        std::make_unique<RawVolumeRAMLoader>(rawFile, byteOffset, littleEndian, memoryMap_);
     vd->setLoader(loader.release());
 
     volume->addRepresentation(vd);
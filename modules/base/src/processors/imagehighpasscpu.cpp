@@ -0,0 +1,60 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/processors/imagehighpasscpu.h>
+
+#include <modules/base/algorithm/image/layerramfilters.h>
+
+namespace inviwo {
+
+const ProcessorInfo ImageHighPassCPU::processorInfo_{
+    "org.inviwo.ImageHighPassCPU",  // Class identifier
+    "Image High Pass CPU",          // Display name
+    "Image Operation",              // Category
+    CodeState::Experimental,        // Code state
+    Tags::CPU,                      // Tags
+};
+const ProcessorInfo ImageHighPassCPU::getProcessorInfo() const { return processorInfo_; }
+
+ImageHighPassCPU::ImageHighPassCPU()
+    : ImageCPUProcessor()
+    , kernelSize_("kernelSize", "Kernel Size", 3, 1, 15, 2)
+    , sharpen_("sharpen", "Sharpen", false) {
+
+    addProperties(kernelSize_, sharpen_);
+}
+
+ImageCPUProcessor::Filter ImageHighPassCPU::filter() const {
+    return [size = kernelSize_.get(),
+            sharpen = sharpen_.get()](const LayerRAM& layer) -> std::shared_ptr<LayerRAM> {
+        return util::layerHighPass(layer, size, sharpen);
+    };
+}
+
+}  // namespace inviwo
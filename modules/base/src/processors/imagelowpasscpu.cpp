@@ -0,0 +1,69 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/processors/imagelowpasscpu.h>
+
+#include <modules/base/algorithm/image/layerramfilters.h>
+
+namespace inviwo {
+
+const ProcessorInfo ImageLowPassCPU::processorInfo_{
+    "org.inviwo.ImageLowPassCPU",  // Class identifier
+    "Image Low Pass CPU",          // Display name
+    "Image Operation",             // Category
+    CodeState::Experimental,       // Code state
+    Tags::CPU,                     // Tags
+};
+const ProcessorInfo ImageLowPassCPU::getProcessorInfo() const { return processorInfo_; }
+
+ImageLowPassCPU::ImageLowPassCPU()
+    : ImageCPUProcessor()
+    , kernelSize_("kernelSize", "Kernel Size", 3, 1, 25, 1)
+    , gaussian_("gaussian", "Use Gaussian weights", true)
+    , sigma_("sigma", "Sigma", 1.f, 0.01f, 100.f, 0.01f) {
+
+    addProperties(gaussian_, kernelSize_, sigma_);
+
+    kernelSize_.visibilityDependsOn(gaussian_, [](const auto& p) { return !p.get(); });
+    sigma_.visibilityDependsOn(gaussian_, [](const auto& p) { return p.get(); });
+}
+
+ImageCPUProcessor::Filter ImageLowPassCPU::filter() const {
+    if (gaussian_) {
+        return [sigma = sigma_.get()](const LayerRAM& layer) -> std::shared_ptr<LayerRAM> {
+            return util::layerGaussianLowPass(layer, sigma);
+        };
+    } else {
+        return [size = kernelSize_.get()](const LayerRAM& layer) -> std::shared_ptr<LayerRAM> {
+            return util::layerLowPass(layer, size);
+        };
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,95 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/processors/imagemixercpu.h>
+
+#include <inviwo/core/datastructures/image/image.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerram.h>
+
+namespace inviwo {
+
+const ProcessorInfo ImageMixerCPU::processorInfo_{
+    "org.inviwo.ImageMixerCPU",  // Class identifier
+    "Image Mixer CPU",           // Display name
+    "Image Operation",           // Category
+    CodeState::Experimental,     // Code state
+    Tags::CPU,                   // Tags
+};
+const ProcessorInfo ImageMixerCPU::getProcessorInfo() const { return processorInfo_; }
+
+ImageMixerCPU::ImageMixerCPU()
+    : PoolProcessor()
+    , inport0_("inport0")
+    , inport1_("inport1")
+    , outport_("outport", false)
+    , blendingMode_("blendMode", "Blend Mode",
+                    {{"mix", "Mix", ImageBlendMode::Mix},
+                     {"over", "Over", ImageBlendMode::Over},
+                     {"multiply", "Multiply", ImageBlendMode::Multiply},
+                     {"screen", "Screen", ImageBlendMode::Screen},
+                     {"overlay", "Overlay", ImageBlendMode::Overlay},
+                     {"hardlight", "Hard Light", ImageBlendMode::HardLight},
+                     {"divide", "Divide", ImageBlendMode::Divide},
+                     {"addition", "Addition", ImageBlendMode::Addition},
+                     {"subtraction", "Subtraction", ImageBlendMode::Subtraction},
+                     {"difference", "Difference", ImageBlendMode::Difference},
+                     {"darkenonly", "DarkenOnly (min)", ImageBlendMode::DarkenOnly},
+                     {"brightenonly", "BrightenOnly (max)", ImageBlendMode::BrightenOnly}},
+                    0)
+    , weight_("weight", "Weight", 0.5f, 0.0f, 1.0f)
+    , clamp_("clamp", "Clamp values to zero and one", false) {
+
+    addPort(inport0_);
+    addPort(inport1_);
+    addPort(outport_);
+
+    addProperties(blendingMode_, weight_, clamp_);
+
+    weight_.visibilityDependsOn(blendingMode_,
+                                [](const auto& p) { return p.get() == ImageBlendMode::Mix; });
+}
+
+void ImageMixerCPU::process() {
+    const auto calc = [image0 = inport0_.getData(), image1 = inport1_.getData(),
+                       mode = blendingMode_.get(), weight = weight_.get(),
+                       clamp = clamp_.get()]() -> std::shared_ptr<Image> {
+        const auto* ram0 = image0->getColorLayer()->getRepresentation<LayerRAM>();
+        const auto* ram1 = image1->getColorLayer()->getRepresentation<LayerRAM>();
+        return util::filteredImage(util::layerMix(*ram0, *ram1, mode, weight, clamp), *image0);
+    };
+
+    outport_.clear();
+    dispatchOne(calc, [this](std::shared_ptr<Image> result) {
+        outport_.setData(result);
+        newResults();
+    });
+}
+
+}  // namespace inviwo
@@ -0,0 +1,64 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/processors/imageresamplecpu.h>
+
+#include <modules/base/algorithm/image/layerramfilters.h>
+
+namespace inviwo {
+
+const ProcessorInfo ImageResampleCPU::processorInfo_{
+    "org.inviwo.ImageResampleCPU",  // Class identifier
+    "Image Resample CPU",           // Display name
+    "Image Operation",              // Category
+    CodeState::Experimental,        // Code state
+    Tags::CPU,                      // Tags
+};
+const ProcessorInfo ImageResampleCPU::getProcessorInfo() const { return processorInfo_; }
+
+ImageResampleCPU::ImageResampleCPU()
+    : ImageCPUProcessor()
+    , interpolationType_("interpolationType", "Interpolation Type",
+                         {{"linear", "Linear", InterpolationType::Linear},
+                          {"nearest", "Nearest", InterpolationType::Nearest}},
+                         0)
+    , targetResolution_("targetResolution", "Target Resolution", ivec2(256, 256), ivec2(1, 1),
+                        ivec2(4096, 4096)) {
+
+    addProperties(interpolationType_, targetResolution_);
+}
+
+ImageCPUProcessor::Filter ImageResampleCPU::filter() const {
+    return [interpolation = interpolationType_.get(), dims = size2_t(targetResolution_.get())](
+               const LayerRAM& layer) -> std::shared_ptr<LayerRAM> {
+        return util::layerResample(layer, dims, interpolation);
+    };
+}
+
+}  // namespace inviwo
@@ -34,13 +34,110 @@
 
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumebricked.h>
 #include <inviwo/core/datastructures/image/imageram.h>
 #include <inviwo/core/datastructures/image/layerramprecision.h>
 
 #include <inviwo/core/util/indexmapper.h>
 
+#include <algorithm>
+
 namespace inviwo {
 
+namespace {
+
+std::shared_ptr<Image> extractSlice(const VolumeRAM& volumeRAM, CartesianCoordinateAxis axis,
+                                    size_t slice, ImageReuseCache& cache) {
+    return volumeRAM.dispatch<std::shared_ptr<Image>, dispatching::filter::All>(
+        [axis, slice, &cache](const auto vrprecision) {
+            using T = util::PrecisionValueType<decltype(vrprecision)>;
+
+            const T* voldata = vrprecision->getDataTyped();
+            const auto voldim = vrprecision->getDimensions();
+
+            const auto imgdim = [&]() {
+                switch (axis) {
+                    default:
+                        return size2_t(voldim.z, voldim.y);
+                    case CartesianCoordinateAxis::X:
+                        return size2_t(voldim.z, voldim.y);
+                    case CartesianCoordinateAxis::Y:
+                        return size2_t(voldim.x, voldim.z);
+                    case CartesianCoordinateAxis::Z:
+                        return size2_t(voldim.x, voldim.y);
+                }
+            }();
+
+            auto res = cache.getTypedUnused<T>(imgdim);
+            auto sliceImage = res.first;
+            auto layerrep = res.second;
+            auto layerdata = layerrep->getDataTyped();
+
+            switch (util::extent<T, 0>::value) {
+                case 0:  // util::extent<T, 0>::value returns zero for non-glm types
+                case 1:
+                    layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Red,
+                                               ImageChannel::Red, ImageChannel::One}});
+                    break;
+                case 2:
+                    layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
+                                               ImageChannel::Zero, ImageChannel::One}});
+                    break;
+                case 3:
+                    layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
+                                               ImageChannel::Blue, ImageChannel::One}});
+                    break;
+                default:
+                case 4:
+                    layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
+                                               ImageChannel::Blue, ImageChannel::Alpha}});
+            }
+
+            size_t offsetVolume;
+            size_t offsetImage;
+            switch (axis) {
+                case CartesianCoordinateAxis::X: {
+                    util::IndexMapper3D vm(voldim);
+                    util::IndexMapper2D im(imgdim);
+                    auto x = glm::clamp(slice, size_t{0}, voldim.x - 1);
+                    for (size_t z = 0; z < voldim.z; z++) {
+                        for (size_t y = 0; y < voldim.y; y++) {
+                            offsetVolume = vm(x, y, z);
+                            offsetImage = im(z, y);
+                            layerdata[offsetImage] = voldata[offsetVolume];
+                        }
+                    }
+                    break;
+                }
+                case CartesianCoordinateAxis::Y: {
+                    auto y = glm::clamp(slice, size_t{0}, voldim.y - 1);
+                    const size_t dataSize = voldim.x;
+                    const size_t initialStartPos = y * voldim.x;
+                    for (size_t j = 0; j < voldim.z; j++) {
+                        offsetVolume = (j * voldim.x * voldim.y) + initialStartPos;
+                        offsetImage = j * voldim.x;
+                        std::copy(voldata + offsetVolume, voldata + offsetVolume + dataSize,
+                                  layerdata + offsetImage);
+                    }
+                    break;
+                }
+                case CartesianCoordinateAxis::Z: {
+                    auto z = glm::clamp(slice, size_t{0}, voldim.z - 1);
+                    const size_t dataSize = voldim.x * voldim.y;
+                    const size_t initialStartPos = z * voldim.x * voldim.y;
+
+                    std::copy(voldata + initialStartPos, voldata + initialStartPos + dataSize,
+                              layerdata);
+                    break;
+                }
+            }
+            cache.add(sliceImage);
+            return sliceImage;
+        });
+}
+
+}  // namespace
+
 const ProcessorInfo VolumeSlice::processorInfo_{
     "org.inviwo.VolumeSlice",  // Class identifier
     "Volume Slice Extracter",  // Display name
@@ -51,7 +148,7 @@ const ProcessorInfo VolumeSlice::processorInfo_{
 const ProcessorInfo VolumeSlice::getProcessorInfo() const { return processorInfo_; }
 
 VolumeSlice::VolumeSlice()
-    : Processor()
+    : PoolProcessor()
     , inport_("inputVolume")
     , outport_("outputImage", DataVec4UInt8::get(), false)
     , sliceAlongAxis_("sliceAxis", "Slice along axis",
@@ -135,98 +232,47 @@ void VolumeSlice::process() {
             break;
     }
 
-    auto image =
-        vol->getRepresentation<VolumeRAM>()
-            ->dispatch<std::shared_ptr<Image>, dispatching::filter::All>(
-                [axis = static_cast<CartesianCoordinateAxis>(sliceAlongAxis_.get()),
-                 slice = static_cast<size_t>(sliceNumber_.get() - 1),
-                 &cache = imageCache_](const auto vrprecision) {
-                    using T = util::PrecisionValueType<decltype(vrprecision)>;
-
-                    const T* voldata = vrprecision->getDataTyped();
-                    const auto voldim = vrprecision->getDimensions();
-
-                    const auto imgdim = [&]() {
-                        switch (axis) {
-                            default:
-                                return size2_t(voldim.z, voldim.y);
-                            case CartesianCoordinateAxis::X:
-                                return size2_t(voldim.z, voldim.y);
-                            case CartesianCoordinateAxis::Y:
-                                return size2_t(voldim.x, voldim.z);
-                            case CartesianCoordinateAxis::Z:
-                                return size2_t(voldim.x, voldim.y);
-                        }
-                    }();
-
-                    auto res = cache.getTypedUnused<T>(imgdim);
-                    auto sliceImage = res.first;
-                    auto layerrep = res.second;
-                    auto layerdata = layerrep->getDataTyped();
-
-                    switch (util::extent<T, 0>::value) {
-                        case 0:  // util::extent<T, 0>::value returns zero for non-glm types
-                        case 1:
-                            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Red,
-                                                       ImageChannel::Red, ImageChannel::One}});
-                            break;
-                        case 2:
-                            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
-                                                       ImageChannel::Zero, ImageChannel::One}});
-                            break;
-                        case 3:
-                            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
-                                                       ImageChannel::Blue, ImageChannel::One}});
-                            break;
-                        default:
-                        case 4:
-                            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
-                                                       ImageChannel::Blue, ImageChannel::Alpha}});
-                    }
+    const auto axis = static_cast<CartesianCoordinateAxis>(sliceAlongAxis_.get());
+    const auto slice = static_cast<size_t>(sliceNumber_.get() - 1);
 
-                    size_t offsetVolume;
-                    size_t offsetImage;
-                    switch (axis) {
-                        case CartesianCoordinateAxis::X: {
-                            util::IndexMapper3D vm(voldim);
-                            util::IndexMapper2D im(imgdim);
-                            auto x = glm::clamp(slice, size_t{0}, voldim.x - 1);
-                            for (size_t z = 0; z < voldim.z; z++) {
-                                for (size_t y = 0; y < voldim.y; y++) {
-                                    offsetVolume = vm(x, y, z);
-                                    offsetImage = im(z, y);
-                                    layerdata[offsetImage] = voldata[offsetVolume];
-                                }
-                            }
-                            break;
-                        }
-                        case CartesianCoordinateAxis::Y: {
-                            auto y = glm::clamp(slice, size_t{0}, voldim.y - 1);
-                            const size_t dataSize = voldim.x;
-                            const size_t initialStartPos = y * voldim.x;
-                            for (size_t j = 0; j < voldim.z; j++) {
-                                offsetVolume = (j * voldim.x * voldim.y) + initialStartPos;
-                                offsetImage = j * voldim.x;
-                                std::copy(voldata + offsetVolume, voldata + offsetVolume + dataSize,
-                                          layerdata + offsetImage);
-                            }
-                            break;
-                        }
-                        case CartesianCoordinateAxis::Z: {
-                            auto z = glm::clamp(slice, size_t{0}, voldim.z - 1);
-                            const size_t dataSize = voldim.x * voldim.y;
-                            const size_t initialStartPos = z * voldim.x * voldim.y;
-
-                            std::copy(voldata + initialStartPos,
-                                      voldata + initialStartPos + dataSize, layerdata);
-                            break;
-                        }
-                    }
-                    cache.add(sliceImage);
-                    return sliceImage;
-                });
+    // For bricked volumes only load the bricks intersecting the slice. Since that might take a
+    // while it is done in the background, meanwhile a slice of the best available level of the
+    // volume pyramid is shown if some other processor has built one. The pyramid is never built
+    // here, building it would read every brick of the volume.
+    if (auto bricked = util::getBrickedRepresentation(*vol)) {
+        if (!pyramid_ || pyramid_->getVolume() != vol) pyramid_ = VolumePyramid::get(vol);
+
+        if (auto best = pyramid_->getBestAvailable(1)) {
+            const auto index = static_cast<size_t>(axis);
+            const auto coarse = best->second->getRepresentation<VolumeRAM>();
+            const auto coarseSlice = slice * coarse->getDimensions()[index] / dims[index];
+            outport_.setData(extractSlice(*coarse, axis, coarseSlice, imageCache_));
+        } else {
+            outport_.clear();
+        }
+
+        dispatchOne(
+            [vol, bricked, axis, slice]() {
+                const auto index = static_cast<size_t>(axis);
+                size3_t offset{0};
+                size3_t extent{bricked->getDimensions()};
+                offset[index] = std::min(slice, extent[index] - 1);
+                extent[index] = 1;
+                ImageReuseCache cache;
+                return extractSlice(*bricked->getRegion(offset, extent), axis, 0, cache);
+            },
+            [this](std::shared_ptr<Image> image) {
+                imageCache_.add(image);
+                outport_.setData(image);
+                newResults();
+            });
+        return;
+    }
 
-    outport_.setData(image);
+    // A slice of an earlier bricked volume might still be computed, it should not replace this one
+    stopJobs();
+    pyramid_.reset();
+    outport_.setData(extractSlice(*vol->getRepresentation<VolumeRAM>(), axis, slice, imageCache_));
 }
 
 void VolumeSlice::eventShiftSlice(Event* event) {
@@ -58,27 +58,53 @@ VolumeSubsample::VolumeSubsample()
 }
 
 void VolumeSubsample::process() {
-    const size3_t factors =
-        glm::min(static_cast<size3_t>(glm::max(subSampleFactors_.get(), ivec3(1))),
-                 inport_.getData()->getDimensions());
+    auto volume = inport_.getData();
+    const size3_t factors = glm::min(
+        static_cast<size3_t>(glm::max(subSampleFactors_.get(), ivec3(1))), volume->getDimensions());
 
-    if (enabled_ && factors != size3_t(1, 1, 1)) {
+    if (!enabled_ || factors == size3_t(1, 1, 1)) {
+        outport_.setData(volume);
+        return;
+    }
+
+    // Power of two factors correspond to a level of the volume pyramid, which is only built once.
+    // The levels are built from each other and integer formats would be rounded at every level,
+    // hence only floating point volumes use the pyramid to match the single pass result.
+    const bool usePyramid = volume->getDataFormat()->getNumericType() == NumericType::Float;
+    if (!usePyramid) {
+        pyramid_.reset();
+    } else if (!pyramid_ || pyramid_->getVolume() != volume) {
+        pyramid_ = VolumePyramid::get(volume);
+    }
+    if (auto level = usePyramid ? pyramid_->findLevel(factors) : std::nullopt) {
+        if (pyramid_->isAvailable(*level)) {
+            outport_.setData(pyramid_->getLevel(*level));
+            return;
+        }
         outport_.clear();
-        dispatchOne([volume = inport_.getData(),
-                     f = subSampleFactors_.get()]() { return subsample(volume, f); },
-                    [this](std::shared_ptr<Volume> result) {
-                        outport_.setData(result);
-                        newResults();
-                    });
-    } else {
-        outport_.setData(inport_.getData());
+        dispatchOne(
+            [pyramid = pyramid_, l = *level](pool::Stop stop, pool::Progress progress) {
+                return pyramid->getLevel(l, stop, progress);
+            },
+            [this](std::shared_ptr<const Volume> result) {
+                outport_.setData(result);
+                newResults();
+            });
+        return;
     }
+
+    outport_.clear();
+    dispatchOne([volume, factors]() { return subsample(volume, factors); },
+                [this](std::shared_ptr<Volume> result) {
+                    outport_.setData(result);
+                    newResults();
+                });
 }
 
 std::shared_ptr<Volume> VolumeSubsample::subsample(std::shared_ptr<const Volume> volume,
                                                    size3_t f) {
-    auto vol = volume->getRepresentation<VolumeRAM>();
-    auto sample = std::make_shared<Volume>(util::volumeSubSample(vol, f));
+    auto vol = volume->getSharedRepresentation<VolumeRAM>();
+    auto sample = std::make_shared<Volume>(util::volumeSubSample(vol.get(), f));
     sample->copyMetaDataFrom(*volume);
     sample->dataMap_ = volume->dataMap_;
     sample->setModelMatrix(volume->getModelMatrix());
@@ -0,0 +1,157 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <modules/base/algorithm/dataminmax.h>
+
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+namespace {
+
+InviwoApplication* app = nullptr;
+
+// The previous implementation, a serial std::accumulate with a branch per component
+template <typename ValueType>
+std::pair<dvec4, dvec4> referenceMinMax(const ValueType* data, size_t size,
+                                        IgnoreSpecialValues ignore) {
+    using Res = std::pair<ValueType, ValueType>;
+    Res minmax{DataFormat<ValueType>::max(), DataFormat<ValueType>::lowest()};
+
+    const auto plain = [](const Res& mm, const ValueType& v) -> Res {
+        return {glm::min(mm.first, v), glm::max(mm.second, v)};
+    };
+    const auto finite = [](const Res& mm, const auto& v) -> Res {
+        Res res(mm);
+        for (size_t i = 0; i < util::flat_extent<ValueType>::value; ++i) {
+            if (util::isfinite(util::glmcomp(v, i))) {
+                util::glmcomp(res.first, i) =
+                    std::min(util::glmcomp(mm.first, i), util::glmcomp(v, i));
+                util::glmcomp(res.second, i) =
+                    std::max(util::glmcomp(mm.second, i), util::glmcomp(v, i));
+            }
+        }
+        return res;
+    };
+
+    if constexpr (util::is_floating_point<ValueType>::value) {
+        if (ignore == IgnoreSpecialValues::Yes) {
+            minmax = std::accumulate(data, data + size, minmax, finite);
+            return {util::glm_convert<dvec4>(minmax.first),
+                    util::glm_convert<dvec4>(minmax.second)};
+        }
+    }
+    minmax = std::accumulate(data, data + size, minmax, plain);
+    return {util::glm_convert<dvec4>(minmax.first), util::glm_convert<dvec4>(minmax.second)};
+}
+
+template <typename ValueType>
+std::vector<ValueType> makeData(size_t size) {
+    using T = typename util::value_type<ValueType>::type;
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0.0, 100.0);
+    std::vector<ValueType> data(size);
+    for (auto& v : data) {
+        for (size_t i = 0; i < util::flat_extent<ValueType>::value; ++i) {
+            util::glmcomp(v, i) = static_cast<T>(dist(gen));
+        }
+    }
+    return data;
+}
+
+template <typename ValueType, IgnoreSpecialValues Ignore>
+void Reference(benchmark::State& state) {
+    const auto data = makeData<ValueType>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(referenceMinMax(data.data(), data.size(), Ignore));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(ValueType));
+}
+
+template <typename ValueType, IgnoreSpecialValues Ignore>
+void DataMinMax(benchmark::State& state) {
+    const auto data = makeData<ValueType>(static_cast<size_t>(state.range(0)));
+    app->getSystemSettings().poolSize_.set(static_cast<size_t>(state.range(1)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(util::dataMinMax(data.data(), data.size(), Ignore));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(ValueType));
+    state.counters["Threads"] = static_cast<double>(app->getPoolSize() + 1);
+}
+
+void args(benchmark::internal::Benchmark* b) {
+    for (long size : {1L << 16, 1L << 20, 1L << 24}) {
+        for (long threads : {0L, 3L, 7L}) b->Args({size, threads});
+    }
+}
+
+}  // namespace
+
+constexpr auto No = IgnoreSpecialValues::No;
+constexpr auto Yes = IgnoreSpecialValues::Yes;
+
+BENCHMARK_TEMPLATE(Reference, unsigned char, No)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(DataMinMax, unsigned char, No)->Apply(args);
+BENCHMARK_TEMPLATE(Reference, int, No)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(DataMinMax, int, No)->Apply(args);
+BENCHMARK_TEMPLATE(Reference, float, No)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(DataMinMax, float, No)->Apply(args);
+BENCHMARK_TEMPLATE(Reference, float, Yes)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(DataMinMax, float, Yes)->Apply(args);
+BENCHMARK_TEMPLATE(Reference, vec3, Yes)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(DataMinMax, vec3, Yes)->Apply(args);
+BENCHMARK_TEMPLATE(Reference, dvec4, No)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(DataMinMax, dvec4, No)->Apply(args);
+BENCHMARK_TEMPLATE(Reference, f16, Yes)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(DataMinMax, f16, Yes)->Apply(args);
+
+int main(int argc, char** argv) {
+    InviwoApplication inviwoApp("bm-dataminmax");
+    app = &inviwoApp;
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
+
+#include <warn/pop>
@@ -0,0 +1,187 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <modules/base/datastructures/kdtree.h>
+#include <modules/base/datastructures/flatkdtree.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+namespace {
+
+InviwoApplication* app = nullptr;
+
+std::vector<vec3> makePoints(size_t size, unsigned int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::vector<vec3> points(size);
+    for (auto& p : points) p = vec3{dist(gen), dist(gen), dist(gen)};
+    return points;
+}
+
+constexpr size_t numQueries = 1 << 16;
+constexpr size_t k = 8;
+
+void BuildOld(benchmark::State& state) {
+    const auto points = makePoints(static_cast<size_t>(state.range(0)), 0);
+    for (auto _ : state) {
+        K3DTree<size_t, float> tree;
+        for (size_t i = 0; i < points.size(); ++i) tree.insert(points[i], i);
+        benchmark::DoNotOptimize(tree.getRoot());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BuildNew(benchmark::State& state) {
+    const auto points = makePoints(static_cast<size_t>(state.range(0)), 0);
+    app->getSystemSettings().poolSize_.set(static_cast<size_t>(state.range(1)));
+    for (auto _ : state) {
+        FlatKDTree<3> tree(points);
+        benchmark::DoNotOptimize(tree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["Threads"] = static_cast<double>(app->getPoolSize() + 1);
+}
+
+void NearestOld(benchmark::State& state) {
+    const auto points = makePoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = makePoints(numQueries, 1);
+    K3DTree<size_t, float> tree;
+    for (size_t i = 0; i < points.size(); ++i) tree.insert(points[i], i);
+
+    for (auto _ : state) {
+        for (auto& q : queries) benchmark::DoNotOptimize(tree.findNearest(q));
+    }
+    state.SetItemsProcessed(state.iterations() * numQueries);
+}
+
+void NearestNew(benchmark::State& state) {
+    const auto points = makePoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = makePoints(numQueries, 1);
+    const FlatKDTree<3> tree(points);
+    app->getSystemSettings().poolSize_.set(static_cast<size_t>(state.range(1)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.nearest(queries));
+    }
+    state.SetItemsProcessed(state.iterations() * numQueries);
+    state.counters["Threads"] = static_cast<double>(app->getPoolSize() + 1);
+}
+
+void KNearestOld(benchmark::State& state) {
+    const auto points = makePoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = makePoints(numQueries, 1);
+    K3DTree<size_t, float> tree;
+    for (size_t i = 0; i < points.size(); ++i) tree.insert(points[i], i);
+
+    for (auto _ : state) {
+        for (auto& q : queries) benchmark::DoNotOptimize(tree.findNNearest(q, k));
+    }
+    state.SetItemsProcessed(state.iterations() * numQueries);
+}
+
+void KNearestNew(benchmark::State& state) {
+    const auto points = makePoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = makePoints(numQueries, 1);
+    const FlatKDTree<3> tree(points);
+    app->getSystemSettings().poolSize_.set(static_cast<size_t>(state.range(1)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.kNearest(queries, k));
+    }
+    state.SetItemsProcessed(state.iterations() * numQueries);
+    state.counters["Threads"] = static_cast<double>(app->getPoolSize() + 1);
+}
+
+void RadiusOld(benchmark::State& state) {
+    const auto points = makePoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = makePoints(numQueries, 1);
+    K3DTree<size_t, float> tree;
+    for (size_t i = 0; i < points.size(); ++i) tree.insert(points[i], i);
+
+    for (auto _ : state) {
+        for (auto& q : queries) benchmark::DoNotOptimize(tree.findCloseTo(q, 0.02f));
+    }
+    state.SetItemsProcessed(state.iterations() * numQueries);
+}
+
+void RadiusNew(benchmark::State& state) {
+    const auto points = makePoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = makePoints(numQueries, 1);
+    const FlatKDTree<3> tree(points);
+    app->getSystemSettings().poolSize_.set(static_cast<size_t>(state.range(1)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.withinRadius(queries, 0.02f));
+    }
+    state.SetItemsProcessed(state.iterations() * numQueries);
+    state.counters["Threads"] = static_cast<double>(app->getPoolSize() + 1);
+}
+
+void args(benchmark::internal::Benchmark* b) {
+    for (long size : {1L << 12, 1L << 16, 1L << 20}) {
+        for (long threads : {0L, 3L, 7L}) b->Args({size, threads});
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BuildOld)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BuildNew)->Apply(args);
+BENCHMARK(NearestOld)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(NearestNew)->Apply(args);
+BENCHMARK(KNearestOld)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(KNearestNew)->Apply(args);
+BENCHMARK(RadiusOld)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(RadiusNew)->Apply(args);
+
+int main(int argc, char** argv) {
+    InviwoApplication inviwoApp("bm-kdtree");
+    app = &inviwoApp;
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
+
+#include <warn/pop>
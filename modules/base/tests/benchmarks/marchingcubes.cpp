@@ -32,6 +32,7 @@
 #endif
 
 #include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
 #include <modules/base/algorithm/volume/volumegeneration.h>
 
 #include <modules/base/algorithm/volume/marchingcubes.h>
@@ -46,6 +47,8 @@
 
 using namespace inviwo;
 
+static InviwoApplication* app = nullptr;
+
 static void SphereOld(benchmark::State& state) {
     auto v = std::shared_ptr<Volume>(
         util::makeSphericalVolume(size3_t{static_cast<size_t>(state.range(0))}));
@@ -65,6 +68,8 @@ static void SphereNew(benchmark::State& state) {
     auto v = std::shared_ptr<Volume>(
         util::makeSphericalVolume(size3_t{static_cast<size_t>(state.range(0))}));
 
+    app->getSystemSettings().poolSize_.set(static_cast<size_t>(state.range(1)));
+
     for (auto _ : state) {
         auto mesh = util::marchingCubesOpt(v, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false);
         state.counters["Vertices"] = static_cast<double>(mesh->getBuffer(0)->getSize());
@@ -74,6 +79,7 @@ static void SphereNew(benchmark::State& state) {
     }
     state.counters["Voxels"] =
         static_cast<double>(state.range(0) * state.range(0) * state.range(0));
+    state.counters["Threads"] = static_cast<double>(app->getPoolSize() + 1);
 }
 
 static void RippleOld(benchmark::State& state) {
@@ -95,6 +101,8 @@ static void RippleNew(benchmark::State& state) {
     auto v = std::shared_ptr<Volume>(
         util::makeRippleVolume(size3_t{static_cast<size_t>(state.range(0))}));
 
+    app->getSystemSettings().poolSize_.set(static_cast<size_t>(state.range(1)));
+
     for (auto _ : state) {
         auto mesh = util::marchingCubesOpt(v, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false);
         state.counters["Vertices"] = static_cast<double>(mesh->getBuffer(0)->getSize());
@@ -104,6 +112,7 @@ static void RippleNew(benchmark::State& state) {
     }
     state.counters["Voxels"] =
         static_cast<double>(state.range(0) * state.range(0) * state.range(0));
+    state.counters["Threads"] = static_cast<double>(app->getPoolSize() + 1);
 }
 
 static void MiniOld(benchmark::State& state) {
@@ -125,6 +134,8 @@ static void MiniNew(benchmark::State& state) {
     auto v = std::shared_ptr<Volume>(
         util::makeSingleVoxelVolume(size3_t{static_cast<size_t>(state.range(0))}));
 
+    app->getSystemSettings().poolSize_.set(static_cast<size_t>(state.range(1)));
+
     for (auto _ : state) {
         auto mesh = util::marchingCubesOpt(v, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false);
         state.counters["Vertices"] = static_cast<double>(mesh->getBuffer(0)->getSize());
@@ -134,23 +145,28 @@ static void MiniNew(benchmark::State& state) {
     }
     state.counters["Voxels"] =
         static_cast<double>(state.range(0) * state.range(0) * state.range(0));
+    state.counters["Threads"] = static_cast<double>(app->getPoolSize() + 1);
+}
+
+static void args(benchmark::internal::Benchmark* b) {
+    for (long size : {32L, 64L, 128L, 256L, 512L}) {
+        for (long threads : {0L, 3L, 7L}) b->Args({size, threads});
+    }
 }
 
 BENCHMARK(SphereOld)->RangeMultiplier(2)->Range(8, 8 << 5);
-BENCHMARK(SphereNew)->RangeMultiplier(2)->Range(8, 8 << 6);
+BENCHMARK(SphereNew)->Apply(args);
 
 BENCHMARK(RippleOld)->RangeMultiplier(2)->Range(8, 8 << 4);
-BENCHMARK(RippleNew)->RangeMultiplier(2)->Range(8, 8 << 5);
-
-// BENCHMARK(MiniOld)->RangeMultiplier(2)->Range(8, 8 << 5);
-// BENCHMARK(MiniNew)->RangeMultiplier(2)->Range(8, 8 << 5);
-
-// BENCHMARK(MiniOld)->Arg(3);
-// BENCHMARK(MiniNew)->Arg(3);
+BENCHMARK(RippleNew)->Apply(args);
 
-// BENCHMARK(SphereNew)->Arg(5);
+// A single voxel in a large volume, almost all blocks are skipped
+BENCHMARK(MiniOld)->RangeMultiplier(2)->Range(8, 8 << 4);
+BENCHMARK(MiniNew)->Apply(args);
 
 int main(int argc, char** argv) {
+    InviwoApplication inviwoApp("bm-marchingcubes");
+    app = &inviwoApp;
 
     benchmark::Initialize(&argc, argv);
     benchmark::RunSpecifiedBenchmarks();
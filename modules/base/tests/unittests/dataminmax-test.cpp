@@ -0,0 +1,94 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/algorithm/dataminmax.h>
+
+#include <limits>
+#include <vector>
+
+namespace inviwo {
+
+TEST(DataMinMax, Scalar) {
+    std::vector<int> data(100003);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<int>(i % 1000) - 300;
+    data[77777] = -5000;
+    data[12] = 7000;
+    const auto minmax = util::dataMinMax(data.data(), data.size());
+    EXPECT_EQ(minmax.first, dvec4(-5000.0, 0.0, 0.0, 0.0));
+    EXPECT_EQ(minmax.second, dvec4(7000.0, 0.0, 0.0, 0.0));
+}
+
+TEST(DataMinMax, Vector) {
+    // more elements than a chunk to exercise the parallel reduction
+    std::vector<vec3> data(200001, vec3{1.0f, 2.0f, 3.0f});
+    data[5] = vec3{-1.0f, 20.0f, 3.0f};
+    data[150000] = vec3{1.0f, -2.0f, 30.0f};
+    const auto minmax = util::dataMinMax(data.data(), data.size());
+    EXPECT_EQ(minmax.first, dvec4(-1.0, -2.0, 3.0, 0.0));
+    EXPECT_EQ(minmax.second, dvec4(1.0, 20.0, 30.0, 0.0));
+}
+
+TEST(DataMinMax, SpecialValues) {
+    const auto inf = std::numeric_limits<float>::infinity();
+    const auto nan = std::numeric_limits<float>::quiet_NaN();
+    std::vector<vec2> data(1001, vec2{0.5f, 0.5f});
+    data[3] = vec2{inf, nan};
+    data[4] = vec2{nan, -inf};
+    data[1000] = vec2{-1.0f, 2.0f};
+
+    const auto ignored = util::dataMinMax(data.data(), data.size(), IgnoreSpecialValues::Yes);
+    EXPECT_EQ(ignored.first, dvec4(-1.0, 0.5, 0.0, 0.0));
+    EXPECT_EQ(ignored.second, dvec4(0.5, 2.0, 0.0, 0.0));
+
+    const auto all = util::dataMinMax(data.data(), data.size(), IgnoreSpecialValues::No);
+    EXPECT_EQ(all.first, dvec4(-1.0, -inf, 0.0, 0.0));
+    EXPECT_EQ(all.second, dvec4(inf, 2.0, 0.0, 0.0));
+}
+
+TEST(DataMinMax, Half) {
+    std::vector<f16vec2> data(5000, f16vec2{f16{1.0f}, f16{2.0f}});
+    data[4999] = f16vec2{f16{-3.5f}, f16{std::numeric_limits<float>::infinity()}};
+    const auto minmax = util::dataMinMax(data.data(), data.size(), IgnoreSpecialValues::Yes);
+    EXPECT_EQ(minmax.first, dvec4(-3.5, 2.0, 0.0, 0.0));
+    EXPECT_EQ(minmax.second, dvec4(1.0, 2.0, 0.0, 0.0));
+}
+
+TEST(DataMinMax, Empty) {
+    const std::vector<unsigned char> data;
+    const auto minmax = util::dataMinMax(data.data(), data.size());
+    EXPECT_EQ(minmax.first.x, 255.0);
+    EXPECT_EQ(minmax.second.x, 0.0);
+}
+
+}  // namespace inviwo
@@ -33,6 +33,10 @@
 #include <warn/pop>
 
 #include <modules/base/datastructures/kdtree.h>
+#include <modules/base/datastructures/flatkdtree.h>
+
+#include <algorithm>
+#include <random>
 
 namespace inviwo {
 
@@ -133,4 +137,87 @@ TEST(KDTreeTests, findNClosests) {
     EXPECT_EQ(n100.size(), 100);
 }
 
-}  // namespace inviwo
\ No newline at end of file
+namespace {
+
+std::vector<vec3> randomPoints(size_t size, std::mt19937& gen) {
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::vector<vec3> points(size);
+    for (auto& p : points) p = vec3{dist(gen), dist(gen), dist(gen)};
+    return points;
+}
+
+// All points sorted by distance to pos, and index for equal distances
+std::vector<size_t> bruteForce(const std::vector<vec3>& points, const vec3& pos) {
+    std::vector<std::pair<float, size_t>> dists;
+    for (size_t i = 0; i < points.size(); ++i) {
+        dists.emplace_back(glm::distance2(points[i], pos), i);
+    }
+    std::sort(dists.begin(), dists.end());
+    std::vector<size_t> res;
+    for (auto& d : dists) res.push_back(d.second);
+    return res;
+}
+
+}  // namespace
+
+TEST(FlatKDTreeTests, empty) {
+    FlatKDTree<3> tree(std::vector<vec3>{});
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.nearest(vec3{0.0f}), FlatKDTree<3>::npos);
+    EXPECT_TRUE(tree.kNearest(vec3{0.0f}, 4).empty());
+    EXPECT_TRUE(tree.withinRadius(vec3{0.0f}, 1.0f).empty());
+}
+
+TEST(FlatKDTreeTests, balanced) {
+    std::mt19937 gen(0);
+    const auto points = randomPoints(1000, gen);
+    FlatKDTree<3> tree(points, 8);
+    EXPECT_EQ(tree.size(), points.size());
+    // 1000 / 2^7 = 7.8 points per leaf
+    EXPECT_EQ(tree.depth(), 7);
+}
+
+TEST(FlatKDTreeTests, queries) {
+    std::mt19937 gen(0);
+    const auto points = randomPoints(2000, gen);
+    const auto queries = randomPoints(100, gen);
+
+    for (size_t leafSize : {1u, 3u, 8u, 32u}) {
+        FlatKDTree<3> tree(points, leafSize);
+
+        const auto nearest = tree.nearest(queries);
+        const auto knn = tree.kNearest(queries, 10);
+        const auto close = tree.withinRadius(queries, 0.1f);
+        ASSERT_EQ(knn.size(), queries.size() * 10);
+
+        for (size_t i = 0; i < queries.size(); ++i) {
+            const auto expected = bruteForce(points, queries[i]);
+            EXPECT_EQ(nearest[i], expected.front());
+            EXPECT_EQ(tree.nearest(queries[i]), expected.front());
+            EXPECT_TRUE(std::equal(knn.begin() + i * 10, knn.begin() + (i + 1) * 10,
+                                   expected.begin()));
+
+            std::vector<size_t> inside;
+            for (auto j : expected) {
+                if (glm::distance2(points[j], queries[i]) <= 0.1f * 0.1f) inside.push_back(j);
+            }
+            auto found = close[i];
+            std::sort(found.begin(), found.end());
+            std::sort(inside.begin(), inside.end());
+            EXPECT_EQ(found, inside);
+        }
+    }
+}
+
+TEST(FlatKDTreeTests, duplicates) {
+    // Many equal coordinates, all medians are ties
+    std::vector<vec3> points;
+    for (int i = 0; i < 500; ++i) points.emplace_back(i % 3, i % 5, 0);
+    FlatKDTree<3> tree(points, 2);
+
+    EXPECT_EQ(tree.nearest(vec3{1.1f, 2.1f, 0.0f}), bruteForce(points, vec3{1, 2, 0}).front());
+    EXPECT_EQ(tree.withinRadius(vec3{1.0f, 2.0f, 0.0f}, 0.5f).size(), 500 / 15);
+    EXPECT_EQ(tree.kNearest(vec3{0.0f}, 1000).size(), points.size());
+}
+
+}  // namespace inviwo
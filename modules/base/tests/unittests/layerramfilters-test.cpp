@@ -0,0 +1,222 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/algorithm/image/layerramfilters.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace inviwo {
+
+namespace {
+
+// A layer with a smooth but non separable pattern, large enough to be split into several blocks
+std::shared_ptr<LayerRAMPrecision<vec4>> testLayer(size2_t dims = size2_t(67, 301)) {
+    auto layer = std::make_shared<LayerRAMPrecision<vec4>>(dims);
+    auto data = layer->getDataTyped();
+    for (size_t y = 0; y < dims.y; ++y) {
+        for (size_t x = 0; x < dims.x; ++x) {
+            const float fx = static_cast<float>(x);
+            const float fy = static_cast<float>(y);
+            data[y * dims.x + x] = vec4{std::sin(0.3f * fx + 0.1f * fy), std::cos(0.05f * fx * fy),
+                                        0.01f * fx, 0.5f + 0.001f * fy};
+        }
+    }
+    return layer;
+}
+
+vec4 at(const LayerRAMPrecision<vec4>& layer, ivec2 pos) {
+    const auto dims = ivec2(layer.getDimensions());
+    pos = glm::clamp(pos, ivec2(0), dims - 1);
+    return layer.getDataTyped()[pos.y * dims.x + pos.x];
+}
+
+void expectNear(const vec4& a, const vec4& b) {
+    for (int c = 0; c < 4; ++c) EXPECT_NEAR(a[c], b[c], 1e-6f) << "component " << c;
+}
+
+}  // namespace
+
+TEST(LayerRAMFilters, ToRGBA) {
+    LayerRAMPrecision<glm::u8vec2> layer(size2_t(3, 2));
+    std::fill_n(layer.getDataTyped(), 6, glm::u8vec2{255, 51});
+
+    const auto rgba = util::layerToRGBA(layer);
+    ASSERT_EQ(rgba->getDimensions(), size2_t(3, 2));
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_EQ(rgba->getDataTyped()[i], vec4(1.0f, 0.2f, 0.0f, 1.0f));
+    }
+}
+
+TEST(LayerRAMFilters, SeparableConvolution) {
+    const auto layer = testLayer();
+    const std::vector<float> kernel{0.1f, 0.2f, 0.4f, 0.2f, 0.1f};
+    const auto res = util::layerSeparableConvolution(*layer, kernel);
+
+    const auto dims = ivec2(layer->getDimensions());
+    for (int y = 0; y < dims.y; ++y) {
+        for (int x = 0; x < dims.x; ++x) {
+            vec4 ref{0.0f};
+            for (int j = -2; j <= 2; ++j) {
+                for (int i = -2; i <= 2; ++i) {
+                    ref += kernel[i + 2] * kernel[j + 2] * at(*layer, ivec2(x + i, y + j));
+                }
+            }
+            const auto val = at(*res, ivec2(x, y));
+            for (int c = 0; c < 4; ++c) ASSERT_NEAR(val[c], ref[c], 1e-5f) << x << ", " << y;
+        }
+    }
+
+    EXPECT_THROW(util::layerSeparableConvolution(*layer, {0.5f, 0.5f}), Exception);
+}
+
+TEST(LayerRAMFilters, LowPassKeepsConstant) {
+    LayerRAMPrecision<float> layer(size2_t(20, 10));
+    std::fill_n(layer.getDataTyped(), 200, 0.25f);
+
+    for (const auto& res :
+         {util::layerLowPass(layer, 5), util::layerGaussianLowPass(layer, 2.0f)}) {
+        for (size_t i = 0; i < 200; ++i) {
+            EXPECT_NEAR(res->getDataTyped()[i].r, 0.25f, 1e-6f);
+            EXPECT_NEAR(res->getDataTyped()[i].a, 1.0f, 1e-6f);
+        }
+    }
+}
+
+TEST(LayerRAMFilters, HighPass) {
+    const auto layer = testLayer(size2_t(30, 20));
+    const auto res = util::layerHighPass(*layer, 3, false);
+    const auto sharp = util::layerHighPass(*layer, 3, true);
+
+    for (int y = 0; y < 20; ++y) {
+        for (int x = 0; x < 30; ++x) {
+            vec3 sum{0.0f};
+            for (int j = -1; j <= 1; ++j) {
+                for (int i = -1; i <= 1; ++i) {
+                    if (i != 0 || j != 0) sum += vec3(at(*layer, ivec2(x + i, y + j)));
+                }
+            }
+            const vec4 p = at(*layer, ivec2(x, y));
+            const vec3 avg = sum / 8.0f;
+            const vec3 ref = (vec3(p) - avg + 1.0f) * 0.5f;
+            const vec3 refSharp = 2.0f * vec3(p) - avg;
+            for (int c = 0; c < 3; ++c) {
+                ASSERT_NEAR(at(*res, ivec2(x, y))[c], ref[c], 1e-5f);
+                ASSERT_NEAR(at(*sharp, ivec2(x, y))[c], refSharp[c], 1e-5f);
+            }
+            ASSERT_EQ(at(*res, ivec2(x, y)).a, p.a);
+        }
+    }
+}
+
+TEST(LayerRAMFilters, Gradient) {
+    LayerRAMPrecision<vec2> layer(size2_t(8, 4));
+    for (size_t y = 0; y < 4; ++y) {
+        for (size_t x = 0; x < 8; ++x) {
+            layer.getDataTyped()[y * 8 + x] = vec2{0.0f, 2.0f * x + 3.0f * y};
+        }
+    }
+    const auto grad = util::layerGradient(layer, 1, false);
+    const auto renormalized = util::layerGradient(layer, 1, true);
+    EXPECT_EQ(grad->getSwizzleMask()[2], ImageChannel::Zero);
+
+    // Interior pixels see the full central difference, border pixels half of it
+    EXPECT_EQ(grad->getDataTyped()[1 * 8 + 3], vec2(2.0f, 3.0f));
+    EXPECT_EQ(grad->getDataTyped()[0], vec2(1.0f, 1.5f));
+    // Renormalization scales both axes by the width, as the shader does, also for non-square input
+    EXPECT_EQ(renormalized->getDataTyped()[1 * 8 + 3], vec2(16.0f, 24.0f));
+
+    EXPECT_THROW(util::layerGradient(layer, 4, false), Exception);
+}
+
+TEST(LayerRAMFilters, GrayscaleAndBinary) {
+    LayerRAMPrecision<vec4> layer(size2_t(2, 1));
+    layer.getDataTyped()[0] = vec4{1.0f, 0.0f, 0.0f, 0.5f};
+    layer.getDataTyped()[1] = vec4{0.2f, 1.0f, 1.0f, 1.0f};
+
+    const auto gray = util::layerGrayscale(layer, LuminanceModel::Perceived);
+    EXPECT_NEAR(gray->getDataTyped()[0].g, 0.299f, 1e-6f);
+    EXPECT_EQ(gray->getDataTyped()[0].a, 0.5f);
+    const auto green = util::layerGrayscale(layer, LuminanceModel::GreenOnly);
+    EXPECT_EQ(green->getDataTyped()[1], vec4(1.0f));
+
+    const auto binary = util::layerBinary(layer, 0.5f);
+    EXPECT_EQ(binary->getDataTyped()[0], vec4(1.0f));
+    EXPECT_EQ(binary->getDataTyped()[1], vec4(0.0f, 0.0f, 0.0f, 1.0f));
+}
+
+TEST(LayerRAMFilters, Mix) {
+    LayerRAMPrecision<vec4> a(size2_t(1, 1));
+    LayerRAMPrecision<vec4> b(size2_t(1, 1));
+    a.getDataTyped()[0] = vec4{0.2f, 0.6f, 1.0f, 1.0f};
+    b.getDataTyped()[0] = vec4{0.4f, 0.5f, 2.0f, 0.5f};
+
+    const auto get = [&](ImageBlendMode mode, bool clamp = false) {
+        return util::layerMix(a, b, mode, 0.25f, clamp)->getDataTyped()[0];
+    };
+    EXPECT_EQ(get(ImageBlendMode::Mix), glm::mix(a.getDataTyped()[0], b.getDataTyped()[0], 0.25f));
+    expectNear(get(ImageBlendMode::Addition), vec4(0.6f, 1.1f, 3.0f, 1.0f));
+    expectNear(get(ImageBlendMode::Addition, true), vec4(0.6f, 1.0f, 1.0f, 1.0f));
+    EXPECT_EQ(get(ImageBlendMode::DarkenOnly), vec4(0.2f, 0.5f, 1.0f, 1.0f));
+    expectNear(get(ImageBlendMode::Over), vec4(0.3f, 0.55f, 1.5f, 1.0f));
+
+    const auto overlay = get(ImageBlendMode::Overlay);
+    EXPECT_NEAR(overlay.r, 2.0f * 0.2f * 0.4f, 1e-6f);
+    EXPECT_NEAR(overlay.g, 1.0f - 2.0f * 0.4f * 0.5f, 1e-6f);
+
+    LayerRAMPrecision<vec4> c(size2_t(2, 1));
+    EXPECT_THROW(util::layerMix(a, c, ImageBlendMode::Mix, 0.5f), Exception);
+}
+
+TEST(LayerRAMFilters, Resample) {
+    const auto layer = testLayer(size2_t(16, 8));
+
+    const auto same = util::layerResample(*layer, size2_t(16, 8));
+    for (size_t i = 0; i < 16 * 8; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            ASSERT_NEAR(same->getDataTyped()[i][c], layer->getDataTyped()[i][c], 1e-6f);
+        }
+    }
+
+    const auto half = util::layerResample(*layer, size2_t(8, 4));
+    expectNear(at(*half, {1, 1}), 0.25f * (at(*layer, {2, 2}) + at(*layer, {3, 2}) +
+                                           at(*layer, {2, 3}) + at(*layer, {3, 3})));
+
+    const auto nearest =
+        util::layerResample(*layer, size2_t(32, 16), InterpolationType::Nearest);
+    EXPECT_EQ(at(*nearest, {5, 9}), at(*layer, {2, 4}));
+}
+
+}  // namespace inviwo
@@ -33,6 +33,7 @@
 #include <warn/pop>
 
 #include <cmath>
+#include <map>
 #include <inviwo/core/common/inviwo.h>
 #include <modules/base/algorithm/volume/volumegeneration.h>
 
@@ -335,4 +336,34 @@ TEST(Marchingcubes, sphere) {
     */
 }
 
+TEST(Marchingcubes, closed) {
+    // Large enough to be split into several slabs, the vertices on the slab boundaries have to be
+    // shared to get a closed surface
+    auto v = std::shared_ptr<Volume>(util::makeSphericalVolume(size3_t{40}));
+    auto mesh = util::marchingCubesOpt(v, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false);
+
+    auto& pos = getBufferData<vec3>(*mesh, 0);
+    auto& ind = getBufferIndexData(*mesh, 0);
+    ASSERT_FALSE(ind.empty());
+
+    auto order = [](auto& a, auto& b) {
+        return std::lexicographical_compare(glm::value_ptr(a), glm::value_ptr(a) + 3,
+                                            glm::value_ptr(b), glm::value_ptr(b) + 3);
+    };
+    std::vector<vec3> spos(pos);
+    std::sort(spos.begin(), spos.end(), order);
+    EXPECT_EQ(spos.end(), std::adjacent_find(spos.begin(), spos.end())) << "duplicated vertex";
+
+    // every edge of a closed surface is shared by exactly two triangles
+    std::map<std::pair<uint32_t, uint32_t>, int> edges;
+    for (size_t i = 0; i < ind.size(); i += 3) {
+        for (size_t j = 0; j < 3; ++j) {
+            const auto a = ind[i + j];
+            const auto b = ind[i + (j + 1) % 3];
+            ++edges[{std::min(a, b), std::max(a, b)}];
+        }
+    }
+    EXPECT_TRUE(std::all_of(edges.begin(), edges.end(), [](auto& e) { return e.second == 2; }));
+}
+
 }  // namespace inviwo
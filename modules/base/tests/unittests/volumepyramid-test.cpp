@@ -0,0 +1,172 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/algorithm/volume/volumepyramid.h>
+#include <modules/base/algorithm/volume/volumeramsubsample.h>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumebricked.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/rawvolumeramloader.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <numeric>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<VolumeRAMPrecision<float>> createRAM(const size3_t& dims) {
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(dims);
+    auto data = ram->getDataTyped();
+    std::iota(data, data + glm::compMul(dims), 0.0f);
+    return ram;
+}
+
+void expectEqual(const VolumeRAM& expected, const VolumeRAM& result) {
+    ASSERT_EQ(expected.getDimensions(), result.getDimensions());
+    const auto size = glm::compMul(expected.getDimensions());
+    const auto a = static_cast<const float*>(expected.getData());
+    const auto b = static_cast<const float*>(result.getData());
+    for (size_t i = 0; i < size; ++i) {
+        ASSERT_EQ(a[i], b[i]) << "at index " << i;
+    }
+}
+
+}  // namespace
+
+TEST(VolumePyramid, Levels) {
+    auto volume = std::make_shared<Volume>(createRAM(size3_t{64, 40, 1}));
+    auto pyramid = VolumePyramid::get(volume);
+
+    ASSERT_EQ(size_t{3}, pyramid->getNumberOfLevels());
+    EXPECT_EQ(size3_t(32, 20, 1), pyramid->getDimensions(1));
+    EXPECT_EQ(size3_t(16, 10, 1), pyramid->getDimensions(2));
+    EXPECT_EQ(size3_t(2, 2, 1), pyramid->getFactors(2));
+
+    EXPECT_EQ(size_t{2}, pyramid->findLevel(size3_t{4, 4, 1}));
+    EXPECT_EQ(std::nullopt, pyramid->findLevel(size3_t{4, 2, 1}));
+    EXPECT_EQ(std::nullopt, pyramid->findLevel(size3_t{8, 8, 1}));
+
+    EXPECT_EQ(pyramid, VolumePyramid::get(volume));
+}
+
+TEST(VolumePyramid, Build) {
+    auto volume = std::make_shared<Volume>(createRAM(size3_t{64, 40, 1}));
+    auto pyramid = VolumePyramid::get(volume);
+
+    EXPECT_TRUE(pyramid->isAvailable(0));
+    EXPECT_FALSE(pyramid->isAvailable(1));
+    auto best = pyramid->getBestAvailable(2);
+    ASSERT_TRUE(best);
+    EXPECT_EQ(size_t{0}, best->first);
+    EXPECT_EQ(volume, best->second);
+
+    float lastProgress = 0.0f;
+    auto level = pyramid->getLevel(2, [&](float progress) {
+        EXPECT_GE(progress, lastProgress);
+        lastProgress = progress;
+    });
+    EXPECT_EQ(1.0f, lastProgress);
+    EXPECT_TRUE(pyramid->isAvailable(1));
+    EXPECT_TRUE(pyramid->isAvailable(2));
+    EXPECT_EQ(level, pyramid->getLevel(2));
+    EXPECT_EQ(volume->getModelMatrix(), level->getModelMatrix());
+
+    const auto expected =
+        util::volumeSubSample(volume->getRepresentation<VolumeRAM>(), size3_t{4, 4, 1});
+    expectEqual(*expected, *level->getRepresentation<VolumeRAM>());
+
+    best = pyramid->getBestAvailable(1);
+    ASSERT_TRUE(best);
+    EXPECT_EQ(size_t{1}, best->first);
+}
+
+TEST(VolumePyramid, Stop) {
+    auto volume = std::make_shared<Volume>(createRAM(size3_t{64, 40, 1}));
+    auto pyramid = VolumePyramid::get(volume);
+
+    EXPECT_EQ(nullptr, pyramid->getLevel(2, []() { return true; }));
+    EXPECT_FALSE(pyramid->isAvailable(1));
+
+    // A stopped level is built by the next call
+    ASSERT_TRUE(pyramid->getLevel(2, []() { return false; }));
+    EXPECT_TRUE(pyramid->isAvailable(2));
+}
+
+TEST(VolumePyramid, DoesNotKeepVolumeAlive) {
+    auto volume = std::make_shared<Volume>(createRAM(size3_t{64, 40, 1}));
+    std::weak_ptr<Volume> weak = volume;
+    auto pyramid = VolumePyramid::get(volume);
+
+    volume.reset();
+    EXPECT_TRUE(weak.expired());
+    EXPECT_EQ(nullptr, pyramid->getVolume());
+    EXPECT_FALSE(pyramid->isAvailable(0));
+    EXPECT_THROW(pyramid->getLevel(1), Exception);
+}
+
+TEST(VolumePyramid, Bricked) {
+    const size3_t dims{37, 21, 13};
+    const auto file = (std::filesystem::temp_directory_path() / "volumepyramid-test.raw").string();
+    const auto ram = createRAM(dims);
+    {
+        auto out = filesystem::ofstream(file, std::ios::out | std::ios::binary);
+        out.write(static_cast<const char*>(ram->getData()), glm::compMul(dims) * sizeof(float));
+    }
+
+    auto volume = std::make_shared<Volume>(dims, DataFloat32::get());
+    auto disk = std::make_shared<VolumeDisk>(file, dims, DataFloat32::get());
+    volume->addRepresentation(disk);
+    // Use small bricks such that the level is built from many, partially filled, blocks
+    volume->addRepresentation(std::make_shared<VolumeBricked>(
+        std::make_shared<RawVolumeRAMLoader>(file, 0, true), *disk, size3_t{8}));
+
+    auto pyramid = VolumePyramid::get(volume);
+    EXPECT_FALSE(pyramid->isAvailable(0));
+    EXPECT_FALSE(pyramid->getBestAvailable(1));
+
+    const auto level = pyramid->getLevel(1);
+    const auto expected = util::volumeSubSample(ram.get(), size3_t{2});
+    expectEqual(*expected, *level->getRepresentation<VolumeRAM>());
+    EXPECT_FALSE(volume->hasRepresentation<VolumeRAM>());
+
+    std::remove(file.c_str());
+}
+
+}  // namespace inviwo
@@ -36,6 +36,8 @@
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/util/indexmapper.h>
 
+#include <random>
+
 namespace inviwo {
 
 TEST(VolumeVoronoi, Voronoi_NoSeedPoints_ThrowsException) {
@@ -248,4 +250,42 @@ TEST(VolumeVoronoi, Voronoi_ThreeSeedPoints_PartitionsVolumeInThree) {
     }
 }
 
+TEST(VolumeVoronoi, KDTreeAndBruteForce_RandomSeedPoints_GiveSameResult) {
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> pos(0.0f, 8.0f);
+    std::uniform_real_distribution<float> weight(0.0f, 1.5f);
+
+    std::vector<std::pair<uint32_t, vec3>> seedPoints;
+    std::vector<float> weights;
+    for (uint32_t i = 0; i < 200; ++i) {
+        seedPoints.push_back({i + 1, vec3{pos(gen), pos(gen), pos(gen)}});
+        weights.push_back(weight(gen));
+    }
+    // Seed points on the voxel grid give many equal distances
+    for (uint32_t i = 0; i < 50; ++i) {
+        seedPoints.push_back({i + 201, vec3(gen() % 8, gen() % 8, gen() % 8)});
+        weights.push_back(static_cast<float>(gen() % 2));
+    }
+
+    const auto dimensions = size3_t{16, 12, 10};
+    const mat4 indexToModel{vec4{0.5, 0.0, 0.0, 0.0}, vec4{0.0, 0.75, 0.0, 0.0},
+                            vec4{0.0, 0.1, 0.8, 0.0}, vec4{0.0, 0.0, 0.0, 1.0}};
+
+    const auto getData = [](const std::shared_ptr<Volume>& volume) {
+        const auto ram = dynamic_cast<const VolumeRAMPrecision<unsigned short>*>(
+            volume->getRepresentation<VolumeRAM>());
+        const auto data = ram->getDataTyped();
+        return std::vector<unsigned short>(data, data + glm::compMul(ram->getDimensions()));
+    };
+
+    for (bool weighted : {false, true}) {
+        const auto bruteForce =
+            util::voronoiSegmentation(dimensions, indexToModel, seedPoints, weights, weighted,
+                                      VoronoiAlgorithm::BruteForce);
+        const auto kdTree = util::voronoiSegmentation(dimensions, indexToModel, seedPoints,
+                                                      weights, weighted, VoronoiAlgorithm::KDTree);
+        EXPECT_EQ(getData(bruteForce), getData(kdTree)) << "weighted: " << weighted;
+    }
+}
+
 }  // namespace inviwo
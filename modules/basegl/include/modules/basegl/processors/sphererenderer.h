@@ -79,7 +79,7 @@ public:
 
             if (properties.isModified() || brushLinkPort_.isChanged() ||
                 util::contains(inport_.getChangedOutports(), port)) {
-                const auto& selection = brushLinkPort_.getSelectedIndices();
+                const auto& selection = brushLinkPort_.getSelectedBitSet();
 
                 indices.clear();
                 if (auto res = mesh.findBuffer(BufferType::IndexAttrib);
@@ -31,7 +31,9 @@
 
 #include <modules/brushingandlinking/brushingandlinkingmoduledefine.h>
 #include <modules/brushingandlinking/datastructures/indexlist.h>
+#include <modules/brushingandlinking/datastructures/indexsetcache.h>
 #include <inviwo/core/properties/invalidationlevel.h>
+#include <inviwo/core/datastructures/bitset.h>
 
 #include <unordered_set>
 
@@ -65,24 +67,38 @@ public:
 
     bool isColumnSelected(size_t column) const;
 
+    void setSelected(const BrushingAndLinkingInport* src, const BitSet& idx);
     void setSelected(const BrushingAndLinkingInport* src, const std::unordered_set<size_t>& idx);
     void clearSelected();
 
+    void setFiltered(const BrushingAndLinkingInport* src, const BitSet& idx);
     void setFiltered(const BrushingAndLinkingInport* src, const std::unordered_set<size_t>& idx);
     void clearFiltered();
 
+    void setSelectedColumn(const BrushingAndLinkingInport* src, const BitSet& columnIndices);
     void setSelectedColumn(const BrushingAndLinkingInport* src,
                            const std::unordered_set<size_t>& columnIndices);
     void clearColumns();
 
+    /*
+     * The indices as std::unordered_set, converted from the BitSets when they have changed.
+     * Prefer the BitSet versions below.
+     */
     const std::unordered_set<size_t>& getSelectedIndices() const;
     const std::unordered_set<size_t>& getFilteredIndices() const;
     const std::unordered_set<size_t>& getSelectedColumns() const;
 
+    const BitSet& getSelectedBitSet() const;
+    const BitSet& getFilteredBitSet() const;
+    const BitSet& getSelectedColumnsBitSet() const;
+
 private:
-    std::unordered_set<size_t> selected_;
-    std::unordered_set<size_t> selectedColumns_;
+    BitSet selected_;
+    BitSet selectedColumns_;
     IndexList filtered_;  // Use IndexList to be able to remove filtered rows on port disconnection
+    IndexSetCache selectedCache_;
+    IndexSetCache selectedColumnsCache_;
+    IndexSetCache filteredCache_;
     std::shared_ptr<std::function<void()>> onFilteringChangeCallback_;
 
     Processor* owner_;  // Non-owning reference
@@ -92,7 +108,7 @@ private:
 inline bool BrushingAndLinkingManager::isFiltered(size_t idx) const { return filtered_.has(idx); }
 
 inline bool BrushingAndLinkingManager::isSelected(size_t idx) const {
-    return selected_.find(idx) != selected_.end();
+    return selected_.contains(idx);
 }
 
 }  // namespace inviwo
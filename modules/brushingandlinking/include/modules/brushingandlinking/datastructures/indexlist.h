@@ -31,6 +31,7 @@
 
 #include <modules/brushingandlinking/brushingandlinkingmoduledefine.h>
 #include <inviwo/core/util/dispatcher.h>
+#include <inviwo/core/datastructures/bitset.h>
 
 #include <unordered_map>
 #include <unordered_set>
@@ -39,6 +40,12 @@ namespace inviwo {
 class BrushingAndLinkingInport;
 class BrushingAndLinkingManager;
 
+/**
+ * \class IndexList
+ * \brief The union of the indices set by a number of sources, each identified by its inport.
+ * The indices are stored as BitSets, which are compact for large selections and make the union
+ * fast.
+ */
 class IVW_MODULE_BRUSHINGANDLINKING_API IndexList {
 public:
     IndexList() = default;
@@ -46,22 +53,22 @@ public:
     size_t getSize() const;
     bool has(size_t idx) const;
 
-    void set(const BrushingAndLinkingInport *src, const std::unordered_set<size_t> &incices);
+    void set(const BrushingAndLinkingInport *src, BitSet indices);
+    void set(const BrushingAndLinkingInport *src, const std::unordered_set<size_t> &indices);
     void remove(const BrushingAndLinkingInport *src);
 
     std::shared_ptr<std::function<void()>> onChange(std::function<void()> V);
 
     void update();
     void clear();
-    const std::unordered_set<size_t> &getIndices() const { return indices_; }
+    const BitSet &getIndices() const { return indices_; }
 
 private:
-    std::unordered_map<const BrushingAndLinkingInport *, std::unordered_set<size_t>>
-        indicesBySource_;
-    std::unordered_set<size_t> indices_;
+    std::unordered_map<const BrushingAndLinkingInport *, BitSet> indicesBySource_;
+    BitSet indices_;
     Dispatcher<void()> onUpdate_;
 };
 
-inline bool IndexList::has(size_t idx) const { return indices_.find(idx) != indices_.end(); }
+inline bool IndexList::has(size_t idx) const { return indices_.contains(idx); }
 
 }  // namespace inviwo
@@ -0,0 +1,77 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/brushingandlinking/brushingandlinkingmoduledefine.h>
+#include <inviwo/core/datastructures/bitset.h>
+
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+
+namespace inviwo {
+
+/**
+ * \class IndexSetCache
+ * \brief A std::unordered_set copy of a BitSet, only rebuilt when the BitSet has changed.
+ * Keeps the std::unordered_set based getters of the brushing and linking manager, ports and events
+ * working on top of the BitSets they store. The owner of the BitSet has to call invalidate()
+ * whenever it modifies the BitSet. get() can be called concurrently, the rebuild is guarded by a
+ * mutex.
+ */
+class IndexSetCache {
+public:
+    IndexSetCache() = default;
+    IndexSetCache(const IndexSetCache&) : IndexSetCache() {}
+    IndexSetCache& operator=(const IndexSetCache&) {
+        invalidate();
+        return *this;
+    }
+    ~IndexSetCache() = default;
+
+    void invalidate() { ++generation_; }
+
+    const std::unordered_set<size_t>& get(const BitSet& indices) const {
+        std::scoped_lock lock{mutex_};
+        if (const size_t generation = generation_; built_ != generation) {
+            set_ = std::unordered_set<size_t>(indices.begin(), indices.end());
+            built_ = generation;
+        }
+        return set_;
+    }
+
+private:
+    std::atomic<size_t> generation_{1};
+    mutable size_t built_{0};
+    mutable std::mutex mutex_;
+    mutable std::unordered_set<size_t> set_;
+};
+
+}  // namespace inviwo
@@ -32,6 +32,8 @@
 #include <modules/brushingandlinking/brushingandlinkingmoduledefine.h>
 #include <inviwo/core/interaction/events/event.h>
 #include <inviwo/core/util/constexprhash.h>
+#include <inviwo/core/datastructures/bitset.h>
+#include <modules/brushingandlinking/datastructures/indexsetcache.h>
 
 #include <unordered_set>
 
@@ -43,15 +45,19 @@ class BrushingAndLinkingInport;
  */
 class IVW_MODULE_BRUSHINGANDLINKING_API BrushingAndLinkingEvent : public Event {
 public:
-    BrushingAndLinkingEvent(const BrushingAndLinkingInport* src,
-                            const std::unordered_set<size_t>& indices);
+    BrushingAndLinkingEvent(const BrushingAndLinkingInport* src, const BitSet& indices);
     virtual ~BrushingAndLinkingEvent() = default;
 
     virtual BrushingAndLinkingEvent* clone() const override;
 
     const BrushingAndLinkingInport* getSource() const;
 
+    /*
+     * The indices as std::unordered_set, converted from the BitSet on first use.
+     * Prefer getBitSet.
+     */
     const std::unordered_set<size_t>& getIndices() const;
+    const BitSet& getBitSet() const;
 
     virtual uint64_t hash() const override;
     static constexpr uint64_t chash() {
@@ -65,7 +71,8 @@ protected:
 
 private:
     const BrushingAndLinkingInport* source_;
-    const std::unordered_set<size_t>& indices_;
+    const BitSet& indices_;
+    IndexSetCache indicesSet_;
 };
 
 }  // namespace inviwo
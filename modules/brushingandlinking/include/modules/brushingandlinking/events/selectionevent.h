@@ -41,7 +41,7 @@ namespace inviwo {
  */
 class IVW_MODULE_BRUSHINGANDLINKING_API SelectionEvent : public BrushingAndLinkingEvent {
 public:
-    SelectionEvent(const BrushingAndLinkingInport* src, const std::unordered_set<size_t>& indices);
+    SelectionEvent(const BrushingAndLinkingInport* src, const BitSet& indices);
     virtual ~SelectionEvent() = default;
 
     virtual void print(std::ostream& os) const override;
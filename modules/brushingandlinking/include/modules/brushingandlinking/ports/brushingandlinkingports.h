@@ -36,10 +36,12 @@
 #include <inviwo/core/ports/port.h>
 #include <modules/brushingandlinking/brushingandlinkingmanager.h>
 #include <modules/brushingandlinking/brushingandlinkingmoduledefine.h>
+#include <modules/brushingandlinking/datastructures/indexsetcache.h>
 #include <modules/brushingandlinking/events/filteringevent.h>
 #include <modules/brushingandlinking/events/selectionevent.h>
 #include <modules/brushingandlinking/events/columnselectionevent.h>
 #include <inviwo/core/datastructures/datatraits.h>
+#include <inviwo/core/datastructures/bitset.h>
 
 namespace inviwo {
 
@@ -49,10 +51,13 @@ public:
     BrushingAndLinkingInport(std::string identifier);
     virtual ~BrushingAndLinkingInport() = default;
 
+    void sendFilterEvent(const BitSet &indices);
     void sendFilterEvent(const std::unordered_set<size_t> &indices);
 
+    void sendSelectionEvent(const BitSet &indices);
     void sendSelectionEvent(const std::unordered_set<size_t> &indices);
 
+    void sendColumnSelectionEvent(const BitSet &indices);
     void sendColumnSelectionEvent(const std::unordered_set<size_t> &indices);
 
     bool isFiltered(size_t idx) const;
@@ -64,11 +69,19 @@ public:
     const std::unordered_set<size_t> &getFilteredIndices() const;
     const std::unordered_set<size_t> &getSelectedColumns() const;
 
+    const BitSet &getSelectedBitSet() const;
+    const BitSet &getFilteredBitSet() const;
+    const BitSet &getSelectedColumnsBitSet() const;
+
     virtual std::string getClassIdentifier() const override;
 
-    std::unordered_set<size_t> filterCache_;
-    std::unordered_set<size_t> selectionCache_;
-    std::unordered_set<size_t> selectionColumnCache_;
+private:
+    BitSet filterCache_;
+    BitSet selectionCache_;
+    BitSet selectionColumnCache_;
+    IndexSetCache filterSetCache_;
+    IndexSetCache selectionSetCache_;
+    IndexSetCache selectionColumnSetCache_;
 };
 
 class IVW_MODULE_BRUSHINGANDLINKING_API BrushingAndLinkingOutport
@@ -111,7 +124,7 @@ inline bool BrushingAndLinkingInport::isFiltered(size_t idx) const {
     if (isConnected()) {
         return getData()->isFiltered(idx);
     } else {
-        return filterCache_.find(idx) != filterCache_.end();
+        return filterCache_.contains(idx);
     }
 }
 
@@ -119,7 +132,7 @@ inline bool BrushingAndLinkingInport::isSelected(size_t idx) const {
     if (isConnected()) {
         return getData()->isSelected(idx);
     } else {
-        return selectionCache_.find(idx) != selectionCache_.end();
+        return selectionCache_.contains(idx);
     }
 }
 
@@ -42,8 +42,10 @@ BrushingAndLinkingManager::BrushingAndLinkingManager(Processor* p,
             op->onDisconnect([=]() { filtered_.update(); });
         }
     }
-    onFilteringChangeCallback_ =
-        filtered_.onChange([p, validationLevel]() { p->invalidate(validationLevel); });
+    onFilteringChangeCallback_ = filtered_.onChange([this, p, validationLevel]() {
+        filteredCache_.invalidate();
+        p->invalidate(validationLevel);
+    });
 }
 
 BrushingAndLinkingManager::~BrushingAndLinkingManager() {}
@@ -57,20 +59,32 @@ void BrushingAndLinkingManager::remove(const BrushingAndLinkingInport* src) {
 }
 
 bool BrushingAndLinkingManager::isColumnSelected(size_t idx) const {
-    return selectedColumns_.find(idx) != selectedColumns_.end();
+    return selectedColumns_.contains(idx);
 }
 
 void BrushingAndLinkingManager::setSelected(const BrushingAndLinkingInport*,
-                                            const std::unordered_set<size_t>& indices) {
+                                            const BitSet& indices) {
     selected_ = indices;
+    selectedCache_.invalidate();
     owner_->invalidate(invalidationLevel_);
 }
 
+void BrushingAndLinkingManager::setSelected(const BrushingAndLinkingInport* src,
+                                            const std::unordered_set<size_t>& indices) {
+    setSelected(src, BitSet(indices.begin(), indices.end()));
+}
+
 void BrushingAndLinkingManager::clearSelected() {
     selected_.clear();
+    selectedCache_.invalidate();
     owner_->invalidate(invalidationLevel_);
 }
 
+void BrushingAndLinkingManager::setFiltered(const BrushingAndLinkingInport* src,
+                                            const BitSet& indices) {
+    filtered_.set(src, indices);
+}
+
 void BrushingAndLinkingManager::setFiltered(const BrushingAndLinkingInport* src,
                                             const std::unordered_set<size_t>& indices) {
     filtered_.set(src, indices);
@@ -79,25 +93,42 @@ void BrushingAndLinkingManager::setFiltered(const BrushingAndLinkingInport* src,
 void BrushingAndLinkingManager::clearFiltered() { filtered_.clear(); }
 
 void BrushingAndLinkingManager::setSelectedColumn(const BrushingAndLinkingInport*,
-                                                  const std::unordered_set<size_t>& indices) {
+                                                  const BitSet& indices) {
     selectedColumns_ = indices;
+    selectedColumnsCache_.invalidate();
     owner_->invalidate(invalidationLevel_);
 }
 
+void BrushingAndLinkingManager::setSelectedColumn(const BrushingAndLinkingInport* src,
+                                                  const std::unordered_set<size_t>& indices) {
+    setSelectedColumn(src, BitSet(indices.begin(), indices.end()));
+}
+
 void BrushingAndLinkingManager::clearColumns() {
     selected_.clear();
+    selectedCache_.invalidate();
     owner_->invalidate(invalidationLevel_);
 }
 
 const std::unordered_set<size_t>& BrushingAndLinkingManager::getSelectedIndices() const {
-    return selected_;
+    return selectedCache_.get(selected_);
 }
 
 const std::unordered_set<size_t>& BrushingAndLinkingManager::getFilteredIndices() const {
-    return filtered_.getIndices();
+    return filteredCache_.get(filtered_.getIndices());
 }
 
 const std::unordered_set<size_t>& BrushingAndLinkingManager::getSelectedColumns() const {
+    return selectedColumnsCache_.get(selectedColumns_);
+}
+
+const BitSet& BrushingAndLinkingManager::getSelectedBitSet() const { return selected_; }
+
+const BitSet& BrushingAndLinkingManager::getFilteredBitSet() const {
+    return filtered_.getIndices();
+}
+
+const BitSet& BrushingAndLinkingManager::getSelectedColumnsBitSet() const {
     return selectedColumns_;
 }
 
@@ -34,10 +34,14 @@ namespace inviwo {
 
 size_t IndexList::getSize() const { return indices_.size(); }
 
+void IndexList::set(const BrushingAndLinkingInport* src, BitSet indices) {
+    indicesBySource_[src] = std::move(indices);
+    update();
+}
+
 void IndexList::set(const BrushingAndLinkingInport* src,
                     const std::unordered_set<size_t>& indices) {
-    indicesBySource_[src] = indices;
-    update();
+    set(src, BitSet(indices.begin(), indices.end()));
 }
 
 void IndexList::remove(const BrushingAndLinkingInport* src) {
@@ -52,15 +56,14 @@ std::shared_ptr<std::function<void()>> IndexList::onChange(std::function<void()>
 void IndexList::update() {
     indices_.clear();
 
-    using T =
-        std::unordered_map<const BrushingAndLinkingInport*, std::unordered_set<size_t>>::value_type;
+    using T = std::unordered_map<const BrushingAndLinkingInport*, BitSet>::value_type;
     util::map_erase_remove_if(indicesBySource_, [](const T& p) {
         return !p.first->isConnected() ||
                p.second.empty();  // remove if port is disconnected or if the set is empty
     });
 
-    for (auto p : indicesBySource_) {
-        indices_.insert(p.second.begin(), p.second.end());
+    for (const auto& p : indicesBySource_) {
+        indices_ |= p.second;
     }
     onUpdate_.invoke();
 }
@@ -35,11 +35,12 @@
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <iterator>
 
 namespace inviwo {
 
 BrushingAndLinkingEvent::BrushingAndLinkingEvent(const BrushingAndLinkingInport* src,
-                                                 const std::unordered_set<size_t>& indices)
+                                                 const BitSet& indices)
     : source_(src), indices_(indices) {}
 
 BrushingAndLinkingEvent* BrushingAndLinkingEvent::clone() const {
@@ -50,7 +51,11 @@ const inviwo::BrushingAndLinkingInport* BrushingAndLinkingEvent::getSource() con
     return source_;
 }
 
-const std::unordered_set<size_t>& BrushingAndLinkingEvent::getIndices() const { return indices_; }
+const std::unordered_set<size_t>& BrushingAndLinkingEvent::getIndices() const {
+    return indicesSet_.get(indices_);
+}
+
+const BitSet& BrushingAndLinkingEvent::getBitSet() const { return indices_; }
 
 uint64_t BrushingAndLinkingEvent::hash() const { return chash(); }
 
@@ -61,13 +66,13 @@ void BrushingAndLinkingEvent::print(std::ostream& os) const {
 void BrushingAndLinkingEvent::printEvent(const std::string& eventType, std::ostream& os) const {
     using namespace std::string_literals;
 
-    std::vector<size_t> indices(indices_.begin(), indices_.end());
-    std::sort(indices.begin(), indices.end());
+    // The BitSet iterates in ascending order, only the first few indices are needed.
     const std::string indicesStr = [&]() -> std::string {
-        if (indices.empty()) return "none"s;
-        std::string str = joinString(indices.begin(),
-                                     indices.begin() + std::min<size_t>(indices.size(), 10), ", ");
-        str.append(fmt::format("{} ({})", (indices_.size() > 10) ? "..." : "", indices.size()));
+        if (indices_.empty()) return "none"s;
+        const auto size = indices_.size();
+        std::string str = joinString(indices_.begin(),
+                                     std::next(indices_.begin(), std::min<size_t>(size, 10)), ", ");
+        str.append(fmt::format("{} ({})", (size > 10) ? "..." : "", size));
         return str;
     }();
 
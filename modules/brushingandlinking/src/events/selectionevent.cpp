@@ -32,7 +32,7 @@
 namespace inviwo {
 
 SelectionEvent::SelectionEvent(const BrushingAndLinkingInport* src,
-                               const std::unordered_set<size_t>& indices)
+                               const BitSet& indices)
     : BrushingAndLinkingEvent(src, indices) {}
 
 void SelectionEvent::print(std::ostream& os) const { printEvent("SelectionEvent", os); }
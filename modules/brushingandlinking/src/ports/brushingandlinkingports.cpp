@@ -41,44 +41,60 @@ BrushingAndLinkingInport::BrushingAndLinkingInport(std::string identifier)
     });
 }
 
-void BrushingAndLinkingInport::sendFilterEvent(const std::unordered_set<size_t> &indices) {
+void BrushingAndLinkingInport::sendFilterEvent(const BitSet &indices) {
     if (filterCache_.size() == 0 && indices.size() == 0) return;
     filterCache_ = indices;
+    filterSetCache_.invalidate();
     FilteringEvent event(this, filterCache_);
     propagateEvent(&event, nullptr);
 }
 
-void BrushingAndLinkingInport::sendSelectionEvent(const std::unordered_set<size_t> &indices) {
+void BrushingAndLinkingInport::sendFilterEvent(const std::unordered_set<size_t> &indices) {
+    sendFilterEvent(BitSet(indices.begin(), indices.end()));
+}
+
+void BrushingAndLinkingInport::sendSelectionEvent(const BitSet &indices) {
     bool noRemoteSelections = false;
     if (isConnected() && hasData()) {
-        noRemoteSelections = getData()->getSelectedIndices().empty();
+        noRemoteSelections = getData()->getSelectedBitSet().empty();
     }
     if (selectionCache_.empty() && indices.empty() && noRemoteSelections) {
         return;
     }
     selectionCache_ = indices;
+    selectionSetCache_.invalidate();
     SelectionEvent event(this, selectionCache_);
     propagateEvent(&event, nullptr);
 }
 
-void BrushingAndLinkingInport::sendColumnSelectionEvent(const std::unordered_set<size_t> &indices) {
+void BrushingAndLinkingInport::sendSelectionEvent(const std::unordered_set<size_t> &indices) {
+    sendSelectionEvent(BitSet(indices.begin(), indices.end()));
+}
+
+void BrushingAndLinkingInport::sendColumnSelectionEvent(const BitSet &indices) {
     bool noRemoteSelections = false;
     if (isConnected() && hasData()) {
-        noRemoteSelections = getData()->getSelectedColumns().empty();
+        noRemoteSelections = getData()->getSelectedColumnsBitSet().empty();
     }
     if (selectionColumnCache_.empty() && indices.empty() && noRemoteSelections) {
         return;
     }
     selectionColumnCache_ = indices;
+    selectionColumnSetCache_.invalidate();
     ColumnSelectionEvent event(this, selectionColumnCache_);
     propagateEvent(&event, nullptr);
 }
 
+void BrushingAndLinkingInport::sendColumnSelectionEvent(
+    const std::unordered_set<size_t> &indices) {
+    sendColumnSelectionEvent(BitSet(indices.begin(), indices.end()));
+}
+
 bool BrushingAndLinkingInport::isColumnSelected(size_t idx) const {
     if (isConnected()) {
         return getData()->isColumnSelected(idx);
     } else {
-        return selectionColumnCache_.find(idx) != selectionColumnCache_.end();
+        return selectionColumnCache_.contains(idx);
     }
 }
 
@@ -86,7 +102,7 @@ const std::unordered_set<size_t> &BrushingAndLinkingInport::getSelectedIndices()
     if (isConnected()) {
         return getData()->getSelectedIndices();
     } else {
-        return selectionCache_;
+        return selectionSetCache_.get(selectionCache_);
     }
 }
 
@@ -94,13 +110,37 @@ const std::unordered_set<size_t> &BrushingAndLinkingInport::getFilteredIndices()
     if (isConnected()) {
         return getData()->getFilteredIndices();
     } else {
-        return filterCache_;
+        return filterSetCache_.get(filterCache_);
     }
 }
 
 const std::unordered_set<size_t> &BrushingAndLinkingInport::getSelectedColumns() const {
     if (isConnected()) {
         return getData()->getSelectedColumns();
+    } else {
+        return selectionColumnSetCache_.get(selectionColumnCache_);
+    }
+}
+
+const BitSet &BrushingAndLinkingInport::getSelectedBitSet() const {
+    if (isConnected()) {
+        return getData()->getSelectedBitSet();
+    } else {
+        return selectionCache_;
+    }
+}
+
+const BitSet &BrushingAndLinkingInport::getFilteredBitSet() const {
+    if (isConnected()) {
+        return getData()->getFilteredBitSet();
+    } else {
+        return filterCache_;
+    }
+}
+
+const BitSet &BrushingAndLinkingInport::getSelectedColumnsBitSet() const {
+    if (isConnected()) {
+        return getData()->getSelectedColumnsBitSet();
     } else {
         return selectionColumnCache_;
     }
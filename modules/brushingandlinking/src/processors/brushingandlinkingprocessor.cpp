@@ -66,13 +66,13 @@ void BrushingAndLinkingProcessor::process() { outport_.setData(manager_); }
 void BrushingAndLinkingProcessor::invokeEvent(Event* event) {
     if (auto brushingEvent = dynamic_cast<BrushingAndLinkingEvent*>(event)) {
         if (dynamic_cast<FilteringEvent*>(event)) {
-            manager_->setFiltered(brushingEvent->getSource(), brushingEvent->getIndices());
+            manager_->setFiltered(brushingEvent->getSource(), brushingEvent->getBitSet());
             event->markAsUsed();
         } else if (dynamic_cast<SelectionEvent*>(event)) {
-            manager_->setSelected(brushingEvent->getSource(), brushingEvent->getIndices());
+            manager_->setSelected(brushingEvent->getSource(), brushingEvent->getBitSet());
             event->markAsUsed();
         } else if (dynamic_cast<ColumnSelectionEvent*>(event)) {
-            manager_->setSelectedColumn(brushingEvent->getSource(), brushingEvent->getIndices());
+            manager_->setSelectedColumn(brushingEvent->getSource(), brushingEvent->getBitSet());
             event->markAsUsed();
         }
     }
@@ -37,6 +37,8 @@
 #include <inviwo/core/io/datareaderexception.h>
 #include <inviwo/dataframe/datastructures/dataframe.h>
 
+#include <string_view>
+
 namespace inviwo {
 
 /**
@@ -59,6 +61,9 @@ public:
  * \brief A reader for comma separated value (CSV) files with customizable delimiters.
  * The default delimiter is ',' and headers are included. Floating point values are stored as
  * float32.
+ *
+ * Files are memory mapped and split into chunks at record boundaries, which are parsed in
+ * parallel directly into the column buffers. The column types are derived from the first 50 rows.
  */
 class IVW_MODULE_DATAFRAME_API CSVReader : public DataReaderType<DataFrame> {
 public:
@@ -105,6 +110,8 @@ public:
     std::shared_ptr<DataFrame> readData(std::istream& stream) const;
 
 private:
+    std::shared_ptr<DataFrame> parse(std::string_view data) const;
+
     std::string delimiters_;
     bool firstRowHeader_;
     bool doublePrecision_;
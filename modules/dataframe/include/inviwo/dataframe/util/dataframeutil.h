@@ -37,6 +37,8 @@
 #include <inviwo/dataframe/datastructures/dataframe.h>
 #include <inviwo/core/util/zip.h>
 
+#include <optional>
+
 namespace inviwo {
 
 namespace dataframe {
@@ -76,6 +78,38 @@ std::shared_ptr<DataFrame> IVW_MODULE_DATAFRAME_API appendColumns(const DataFram
 std::shared_ptr<DataFrame> IVW_MODULE_DATAFRAME_API appendRows(const DataFrame& top,
                                                                const DataFrame& bottom,
                                                                bool matchByName = false);
+/**
+ * \brief algorithms for matching the rows of two DataFrames in a join
+ * \see findMatchingRows
+ */
+enum class JoinAlgorithm {
+    Auto,       ///< Direct for small key ranges, SortMerge for sorted keys, Hash otherwise
+    Direct,     ///< Table indexed by key value, for a single integral or categorical key column
+    SortMerge,  ///< Sort the keys of both DataFrames, if not already sorted, and merge them
+    Hash        ///< Hash table of the keys of the right DataFrame probed with the left keys
+};
+
+/**
+ * \brief for each row in DataFrame \p left find the first row in DataFrame \p right with matching
+ * keys. This is used by innerJoin and leftJoin. Both the build and the probe phase run in parallel.
+ *
+ * Categorical columns are matched by their values, the right column is mapped onto the category
+ * ids of the left one. Direct and SortMerge require a single key column with scalar values, for
+ * other keys \p algorithm is ignored and Hash is used.
+ *
+ * @param left
+ * @param right
+ * @param keyColumns  headers of the columns used as keys
+ * @param algorithm   algorithm used to match the keys
+ * @return for each row in \p left the first matching row in \p right, std::nullopt if none
+ * @throws Exception if a key column does not exist in either \p left or \p right or if the
+ * column types do not match
+ */
+std::vector<std::optional<size_t>> IVW_MODULE_DATAFRAME_API
+findMatchingRows(const DataFrame& left, const DataFrame& right,
+                 const std::vector<std::string>& keyColumns,
+                 JoinAlgorithm algorithm = JoinAlgorithm::Auto);
+
 ///@{
 /**
  * \brief create a new DataFrame by using an inner join of DataFrame \p left and DataFrame \p right.
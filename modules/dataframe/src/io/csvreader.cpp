@@ -26,16 +26,28 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *
  *********************************************************************************/
-
 #include <inviwo/dataframe/io/csvreader.h>
 
 #include <inviwo/dataframe/datastructures/column.h>
 #include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/core/io/mappedfile.h>
 #include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/parallel.h>
+#include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/stringconversion.h>
 
 #include <fstream>
 #include <algorithm>
+#include <array>
+#include <charconv>
+#include <cerrno>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
 
 namespace inviwo {
 
@@ -59,39 +71,25 @@ void CSVReader::setFirstRowHeader(bool hasHeader) { firstRowHeader_ = hasHeader;
 void CSVReader::setEnableDoublePrecision(bool doubleprec) { doublePrecision_ = doubleprec; }
 
 std::shared_ptr<DataFrame> CSVReader::readData(const std::string& fileName) {
-    auto file = filesystem::ifstream(fileName);
-
-    if (!file.is_open()) {
-        throw FileException(std::string("CSVReader: Could not open file \"" + fileName + "\"."),
-                            IVW_CONTEXT);
+    size_t len = 0;
+    {
+        auto file = filesystem::ifstream(fileName, std::ios::in | std::ios::binary);
+        if (!file.is_open()) {
+            throw FileException(std::string("CSVReader: Could not open file \"" + fileName + "\"."),
+                                IVW_CONTEXT);
+        }
+        file.seekg(0, std::ios::end);
+        len = static_cast<size_t>(file.tellg());
     }
-    file.seekg(0, std::ios::end);
-    std::streampos len = file.tellg();
-    file.seekg(0, std::ios::beg);
 
-    if (len == std::streampos(0)) {
+    if (len == 0) {
         throw CSVDataReaderException("Empty file, no data", IVW_CONTEXT);
     }
 
-    return readData(file);
+    const MappedFile mapped(fileName, 0, len);
+    return parse(std::string_view(static_cast<const char*>(mapped.data()), mapped.size()));
 }
 
-namespace detail {
-
-bool isLineBreak(const char ch, std::istream& stream) {
-    if (ch == '\r') {
-        // consume potential LF (\n) following CR (\r)
-        if (stream.peek() == '\n') {
-            stream.get();
-        }
-        return true;
-    } else {
-        return (ch == '\n');
-    }
-}
-
-}  // namespace detail
-
 std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
     // Skip BOM if it exists. Added by for example Excel when saving csv files.
     filesystem::skipByteOrderMark(stream);
@@ -100,160 +98,472 @@ std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
         throw CSVDataReaderException("Input stream in a bad state", IVW_CONTEXT);
     }
 
-    // create a string stream from input stream for buffering
-    std::stringstream in;
-    in << stream.rdbuf();
-    if (in.fail()) {
+    std::string buffer;
+    std::array<char, 1 << 16> block;
+    while (stream.read(block.data(), block.size()) || stream.gcount() > 0) {
+        buffer.append(block.data(), static_cast<size_t>(stream.gcount()));
+    }
+    if (buffer.empty()) {
         throw CSVDataReaderException("No data", IVW_CONTEXT);
     }
+    return parse(buffer);
+}
+
+namespace {
+
+enum class Terminator { Delimiter, LineBreak, End };
+
+struct Field {
+    std::string_view value;
+    Terminator terminator;
+    bool hasCR;  //< The value contains a line break with a '\r', which has to be normalized
+};
+
+enum class RowStatus { Row, Empty, End };
+
+/**
+ * Errors are collected per chunk and only reported once the chunk is known to start at a record
+ * boundary. Line numbers are relative to the start of the parsed range.
+ */
+struct ParseError {
+    enum class Type { UnmatchedQuotes, ColumnCount, DataTypeMismatch };
+    Type type;
+    size_t line;
+    size_t fields = 0;
+    size_t column = 0;
+    std::string value{};
+};
+
+std::string toString(const Field& field) {
+    if (!field.hasCR) return std::string{field.value};
+
+    // line breaks enclosed in a field are stored as '\n'
+    std::string str;
+    str.reserve(field.value.size());
+    for (size_t i = 0; i < field.value.size(); ++i) {
+        if (field.value[i] == '\r') {
+            str += '\n';
+            if (i + 1 < field.value.size() && field.value[i + 1] == '\n') ++i;
+        } else {
+            str += field.value[i];
+        }
+    }
+    return str;
+}
+
+class Tokenizer {
+public:
+    Tokenizer(std::string_view data, std::string_view delimiters) : data_{data} {
+        for (auto ch : delimiters) {
+            special_[static_cast<unsigned char>(ch)] = true;
+        }
+        special_[static_cast<unsigned char>('"')] = true;
+        special_[static_cast<unsigned char>('\r')] = true;
+        special_[static_cast<unsigned char>('\n')] = true;
+    }
 
-    // current line
-    size_t lineNumber = 1u;
+    std::string_view data() const { return data_; }
 
-    // extract exactly one field from the current stream position, the bool return value indicates
-    // whether a line break was detected following the field
-    auto extractField = [&in, &lineNumber, delims = delimiters_]() -> std::pair<std::string, bool> {
-        std::string value;
+    /**
+     * Extract exactly one field starting at \p pos. \p pos is advanced past the field and its
+     * terminating delimiter or line break, \p lines is increased by the number of consumed line
+     * breaks. A delimiter or line break terminates the field unless it is enclosed by quotes, i.e.
+     * if there are no quotes in the field or an even count and the previous character was a quote.
+     * @throws ParseError if a quote is not matched before the end of the data.
+     */
+    Field field(size_t& pos, size_t& lines) const {
+        const size_t begin = pos;
         size_t quoteCount = 0;
         size_t quoteBeginLine = 0;
-        char prev = 0;
+        bool hasCR = false;
 
-        char ch;
-        while (in.get(ch) && in.good()) {
-            bool linebreak = detail::isLineBreak(ch, in);
-            if (linebreak) {
-                ++lineNumber;  // increase line counter
-                // ensure that ch is equal to '\n'
-                ch = '\n';
-                // consume line break, if inside quotes
-                if ((quoteCount & 1) != 0) {
-                    value += ch;
-                    prev = ch;
-                    continue;
-                }
+        for (size_t p = pos; p < data_.size();) {
+            const char ch = data_[p];
+            if (!special_[static_cast<unsigned char>(ch)]) {
+                ++p;
+                continue;
             }
-            if (ch == '"') {  // found a quote
-                if (quoteCount == 0) quoteBeginLine = lineNumber;
+            const size_t at = p++;
+            if (ch == '"') {
+                if (quoteCount == 0) quoteBeginLine = lines;
                 ++quoteCount;
-            } else if (util::contains(delims, ch) || linebreak) {
-                // found a delimiter/newline, ensure that it isn't enclosed by quotes,
-                // i.e. a quote count of 0 or an even count of quotes if the previous
-                // character was a quote
-                if ((quoteCount == 0) || ((prev == '"') && ((quoteCount & 1) == 0))) {
-                    return {value, linebreak};
-                }
+                continue;
             }
-            prev = ch;
-            value += ch;
+            const bool linebreak = ch == '\r' || ch == '\n';
+            if (linebreak) {
+                // consume potential LF (\n) following CR (\r)
+                if (ch == '\r' && p < data_.size() && data_[p] == '\n') ++p;
+                ++lines;
+            }
+            if ((quoteCount & 1) == 0 &&
+                (quoteCount == 0 || (at > begin && data_[at - 1] == '"'))) {
+                pos = p;
+                return {data_.substr(begin, at - begin),
+                        linebreak ? Terminator::LineBreak : Terminator::Delimiter, hasCR};
+            }
+            hasCR |= ch == '\r';
         }
-        if (((quoteCount & 1) != 0) && in.eof()) {
-            throw CSVDataReaderException("Unmatched quotes (starting in line " +
-                                         std::to_string(quoteBeginLine) + ")");
+
+        if ((quoteCount & 1) != 0) {
+            throw ParseError{ParseError::Type::UnmatchedQuotes, quoteBeginLine};
         }
-        return {trim(value), false};
-    };
-
-    // extract one row from the current stream position, the bool return value indicates whether
-    // the end-of-file was detected
-    auto extractRow = [&in, extractField,
-                       &lineNumber](size_t maxColCount = std::numeric_limits<size_t>::max())
-        -> std::pair<std::vector<std::string>, bool> {
-        auto val = extractField();
-        if (in.eof() && val.first.empty()) {
-            // reached end of file, no more data
-            return {{}, true};
-        } else if (val.first.empty() && val.second) {
-            // empty line, ignore
-            return {{}, false};
+        pos = data_.size();
+        return {util::trim(data_.substr(begin)), Terminator::End, hasCR};
+    }
+
+    /**
+     * Extract one row starting at \p pos. Lines without any data are reported as RowStatus::Empty,
+     * the end of the data as RowStatus::End.
+     */
+    RowStatus row(size_t& pos, size_t& lines, std::vector<Field>& fields) const {
+        fields.clear();
+        auto val = field(pos, lines);
+        if (val.terminator == Terminator::End && val.value.empty()) {
+            return RowStatus::End;
+        } else if (val.terminator == Terminator::LineBreak && val.value.empty()) {
+            return RowStatus::Empty;
         }
-        std::vector<std::string> values;
-        values.push_back(val.first);
-        while (!val.second && !in.eof()) {
-            val = extractField();
-            values.push_back(val.first);
+        fields.push_back(val);
+        while (val.terminator == Terminator::Delimiter) {
+            val = field(pos, lines);
+            fields.push_back(val);
         }
-        // ignore last field _if_ it is empty and would be inserted in the maxColCount+1 column
-        if (values.back().empty() && (values.size() - 1 == maxColCount)) {
-            values.resize(values.size() - 1);
-        } else if ((values.size() != maxColCount) &&
-                   (maxColCount != std::numeric_limits<size_t>::max())) {
-            // mismatch in the number of columns
-            throw CSVDataReaderException("Column counts do not match (line " +
-                                         std::to_string(lineNumber) + ": " +
-                                         std::to_string(values.size()) + " fields; DataFrame has " +
-                                         std::to_string(maxColCount) + " columns)");
+        return RowStatus::Row;
+    }
+
+    /**
+     * The position following the next line break at or after \p pos. This is a record boundary
+     * unless the line break is enclosed by quotes.
+     */
+    size_t nextLine(size_t pos) const {
+        pos = std::min(data_.find_first_of("\r\n", pos), data_.size());
+        if (pos < data_.size()) {
+            if (data_[pos] == '\r' && pos + 1 < data_.size() && data_[pos + 1] == '\n') ++pos;
+            ++pos;
         }
-        return {values, false};
-    };
+        return pos;
+    }
 
-    std::vector<std::string> headers;
-    size_t maxColCount = std::numeric_limits<size_t>::max();
-    if (firstRowHeader_) {
-        // read headers
-        auto row = extractRow();
-        if (row.second || row.first.empty()) {
-            throw CSVDataReaderException("Empty file, column headers not found");
+private:
+    std::string_view data_;
+    std::array<bool, 256> special_{};
+};
+
+/**
+ * Ignore the last field _if_ it is empty and would be inserted in the columns+1 column.
+ * @throws ParseError if the number of fields does not match \p columns
+ */
+void checkColumnCount(std::vector<Field>& fields, size_t columns, size_t line) {
+    if (fields.back().value.empty() && fields.size() - 1 == columns) {
+        fields.pop_back();
+    } else if (fields.size() != columns) {
+        throw ParseError{ParseError::Type::ColumnCount, line, fields.size()};
+    }
+}
+
+std::string_view trimNumber(std::string_view str) {
+    str = util::trim(str);
+    if (str.size() > 1 && str[0] == '+' && str[1] != '-') str.remove_prefix(1);
+    return str;
+}
+
+// Like the stream extraction used by Column::add, trailing characters are ignored. Empty fields
+// become zero while malformed values are an error.
+bool parseValue(std::string_view str, int& dest) {
+    if (str.empty()) {
+        dest = 0;  // no special value indicating missing data for integral types
+        return true;
+    }
+    str = trimNumber(str);
+    const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), dest);
+    return ec == std::errc{};
+}
+
+// Malformed floating point values are stored as NaN
+template <typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
+bool parseValue(std::string_view str, T& dest) {
+    str = trimNumber(str);
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), dest);
+    if (ec != std::errc{}) dest = std::numeric_limits<T>::quiet_NaN();
+#else
+    // No floating point support in std::from_chars, strtod needs a null terminated string
+    std::array<char, 64> buffer;
+    std::string large;
+    const char* cstr = buffer.data();
+    if (str.size() < buffer.size()) {
+        std::copy(str.begin(), str.end(), buffer.begin());
+        buffer[str.size()] = '\0';
+    } else {
+        large = str;
+        cstr = large.c_str();
+    }
+    char* end = nullptr;
+    errno = 0;
+    if constexpr (std::is_same_v<T, float>) {
+        dest = std::strtof(cstr, &end);
+    } else {
+        dest = std::strtod(cstr, &end);
+    }
+    if (end == cstr || errno == ERANGE) {
+        dest = std::numeric_limits<T>::quiet_NaN();
+    }
+#endif
+    return true;
+}
+
+/**
+ * Categorical values of one chunk, ids refer to the local list of unique values in order of
+ * their first occurrence.
+ */
+struct Categories {
+    void add(const Field& field) {
+        auto value = field.value;
+        if (field.hasCR) value = storage.emplace_back(toString(field));
+
+        auto [it, inserted] = lookup.try_emplace(value, static_cast<std::uint32_t>(values.size()));
+        if (inserted) values.push_back(value);
+        ids.push_back(it->second);
+    }
+
+    std::vector<std::uint32_t> ids;
+    std::vector<std::string_view> values;
+    std::unordered_map<std::string_view, std::uint32_t> lookup;
+    std::deque<std::string> storage;  //< normalized values, which do not exist in the input
+};
+
+using ColumnData =
+    std::variant<std::vector<int>, std::vector<float>, std::vector<double>, Categories>;
+
+ColumnData makeColumnData(const Column& column) {
+    if (dynamic_cast<const CategoricalColumn*>(&column)) {
+        return Categories{};
+    } else if (dynamic_cast<const TemplateColumn<int>*>(&column)) {
+        return std::vector<int>{};
+    } else if (dynamic_cast<const TemplateColumn<float>*>(&column)) {
+        return std::vector<float>{};
+    } else if (dynamic_cast<const TemplateColumn<double>*>(&column)) {
+        return std::vector<double>{};
+    }
+    throw CSVDataReaderException("Unsupported column type for column '" + column.getHeader() + "'",
+                                 IVW_CONTEXT_CUSTOM("CSVReader"));
+}
+
+struct Chunk {
+    size_t begin;      //< first byte of the chunk, assumed to be a record boundary
+    size_t end;        //< records starting at or after end belong to the next chunk
+    size_t stop = 0;   //< end of the last parsed record, i.e. the begin of the next chunk
+    size_t lines = 0;  //< number of consumed line breaks
+    std::optional<ParseError> error;
+    std::vector<ColumnData> columns;
+};
+
+void parseChunk(const Tokenizer& tokenizer, const std::vector<ColumnData>& prototypes,
+                Chunk& chunk) {
+    chunk.lines = 0;
+    chunk.error.reset();
+    chunk.columns = prototypes;
+
+    size_t pos = chunk.begin;
+    std::vector<Field> fields;
+    try {
+        while (pos < chunk.end) {
+            const auto line = chunk.lines;
+            const auto status = tokenizer.row(pos, chunk.lines, fields);
+            if (status == RowStatus::End) break;
+            if (status == RowStatus::Empty) continue;
+
+            checkColumnCount(fields, prototypes.size(), line);
+            // Do not add empty rows, i.e. rows with only delimiters (,,,,) or newline
+            if (std::all_of(fields.begin(), fields.end(),
+                            [](const Field& f) { return f.value.empty(); })) {
+                continue;
+            }
+
+            for (size_t col = 0; col < fields.size(); ++col) {
+                std::visit(
+                    [&](auto& data) {
+                        using D = std::decay_t<decltype(data)>;
+                        if constexpr (std::is_same_v<D, Categories>) {
+                            data.add(fields[col]);
+                        } else {
+                            typename D::value_type value;
+                            if (!parseValue(fields[col].value, value)) {
+                                throw ParseError{ParseError::Type::DataTypeMismatch, line, 0, col,
+                                                 toString(fields[col])};
+                            }
+                            data.push_back(value);
+                        }
+                    },
+                    chunk.columns[col]);
+            }
         }
-        headers = row.first;
-        maxColCount = headers.size();
+    } catch (const ParseError& e) {
+        chunk.error = e;
+    }
+    chunk.stop = pos;
+}
+
+[[noreturn]] void throwError(const ParseError& error, size_t firstLine, size_t columns) {
+    const auto line = std::to_string(firstLine + error.line);
+    switch (error.type) {
+        case ParseError::Type::UnmatchedQuotes:
+            throw CSVDataReaderException("Unmatched quotes (starting in line " + line + ")",
+                                         IVW_CONTEXT_CUSTOM("CSVReader"));
+        case ParseError::Type::ColumnCount:
+            throw CSVDataReaderException(
+                "Column counts do not match (line " + line + ": " + std::to_string(error.fields) +
+                    " fields; DataFrame has " + std::to_string(columns) + " columns)",
+                IVW_CONTEXT_CUSTOM("CSVReader"));
+        case ParseError::Type::DataTypeMismatch:
+        default:
+            throw DataTypeMismatch("Data type mismatch for column " +
+                                       std::to_string(error.column + 1) + " (line " + line +
+                                       "): cannot convert \"" + error.value + "\"",
+                                   IVW_CONTEXT_CUSTOM("CSVReader"));
     }
+}
 
+// Records are parsed in chunks of this size in parallel
+constexpr size_t chunkSize = size_t{4} << 20;
+
+}  // namespace
+
+std::shared_ptr<DataFrame> CSVReader::parse(std::string_view data) const {
+    // Skip BOM if it exists. Added by for example Excel when saving csv files.
+    if (data.substr(0, 3) == "\xEF\xBB\xBF") data.remove_prefix(3);
+
+    const Tokenizer tokenizer{data, delimiters_};
+    size_t pos = 0;
+    size_t lines = 0;
+    std::vector<Field> fields;
+
+    std::vector<std::string> headers;
+    size_t maxColCount = std::numeric_limits<size_t>::max();
     std::vector<std::vector<std::string>> exampleRows;
-    std::vector<size_t> exampleLineNumbers;  // line numbers matching the example rows
-    std::streampos streamPos = in.tellg();
-    for (auto exampleRow = 0u; exampleRow < 50u; ++exampleRow) {
-        size_t currentLine = lineNumber;
-        auto row = extractRow(maxColCount);
-        if (row.second) {
-            // reached end-of-file
-            if (exampleRow == 0) {
-                throw CSVDataReaderException("Empty file, no data");
+    try {
+        if (firstRowHeader_) {
+            if (tokenizer.row(pos, lines, fields) != RowStatus::Row) {
+                throw CSVDataReaderException("Empty file, column headers not found", IVW_CONTEXT);
             }
-            in.clear();  // clear eof-bit
-            break;
-        } else if (!row.first.empty()) {  // ignore empty lines
-            exampleRows.emplace_back(row.first);
-            exampleLineNumbers.emplace_back(currentLine);
+            headers = util::transform(fields, [](const Field& f) { return toString(f); });
+            maxColCount = headers.size();
         }
-    }
 
-    // Rewind to start position
-    in.seekg(streamPos, std::ios::beg);
+        // Use the first rows as a sample to determine the column types.
+        size_t samplePos = pos;
+        size_t sampleLines = lines;
+        for (auto exampleRow = 0u; exampleRow < 50u; ++exampleRow) {
+            const auto line = sampleLines;
+            const auto status = tokenizer.row(samplePos, sampleLines, fields);
+            if (status == RowStatus::End) break;
+            if (status == RowStatus::Empty) continue;
+
+            if (firstRowHeader_) {
+                checkColumnCount(fields, maxColCount, line);
+            } else if (exampleRows.empty()) {
+                // the first row determines the column count if there is no header
+                maxColCount = fields.size();
+            } else if (fields.size() != maxColCount) {
+                throw ParseError{ParseError::Type::ColumnCount, line, fields.size()};
+            }
+            exampleRows.push_back(
+                util::transform(fields, [](const Field& f) { return toString(f); }));
+        }
+    } catch (const ParseError& e) {
+        throwError(e, 1, maxColCount);
+    }
+    if (exampleRows.empty()) {
+        throw CSVDataReaderException("Empty file, no data", IVW_CONTEXT);
+    }
     if (!firstRowHeader_) {
         // assign default column headers
-        for (size_t i = 0; i < exampleRows.front().size(); ++i) {
+        for (size_t i = 0; i < maxColCount; ++i) {
             headers.push_back(std::string("Column ") + std::to_string(i + 1));
         }
-        // update column count
-        maxColCount = headers.size();
     }
 
-    // figure out column types
-    // but check for correct column counts first
-    for (size_t i = 0; i < exampleRows.size(); ++i) {
-        if (exampleRows[i].size() != maxColCount) {
-            throw CSVDataReaderException(
-                "Column counts do not match (line " + std::to_string(exampleLineNumbers[i]) + ": " +
-                std::to_string(exampleRows[i].size()) + " fields; DataFrame has " +
-                std::to_string(maxColCount) + " columns)");
-        }
+    auto dataFrame = createDataFrame(exampleRows, headers, doublePrecision_);
+
+    std::vector<ColumnData> prototypes;
+    for (size_t col = 1; col < dataFrame->getNumberOfColumns(); ++col) {
+        prototypes.push_back(makeColumnData(*dataFrame->getColumn(col)));
+    }
+
+    // Split the data into chunks at line breaks and parse them in parallel. A line break might be
+    // enclosed by quotes though. Every chunk therefore reports where its last record ended, and a
+    // chunk that did not start there is parsed again from the correct position.
+    std::vector<Chunk> chunks;
+    for (size_t begin = pos; begin < data.size() || chunks.empty();) {
+        const size_t end = tokenizer.nextLine(std::min(begin + chunkSize, data.size()));
+        chunks.push_back(Chunk{begin, end, begin, 0, std::nullopt, {}});
+        begin = end;
     }
+    util::parallelFor(
+        size_t{0}, chunks.size(), [&](size_t i) { parseChunk(tokenizer, prototypes, chunks[i]); },
+        1);
 
-    auto dataFrame = createDataFrame(exampleRows, headers);
-
-    size_t rowIndex = firstRowHeader_ ? 1 : 0;
-    auto row = extractRow(maxColCount);
-    while (!row.second) {
-        // Do not add empty rows, i.e. rows with only delimiters (,,,,) or newline
-        if (std::any_of(std::begin(row.first), std::end(row.first),
-                        [](const auto& a) { return !a.empty(); })) {
-            // May throw DataTypeMismatch, but do not catch it here since it indicates
-            // that the DataFrame is in an invalid state
-            dataFrame->addRow(row.first);
+    size_t line = 1 + lines;
+    size_t expected = pos;
+    size_t rows = 0;
+    for (auto& chunk : chunks) {
+        if (chunk.begin != expected) {
+            chunk.begin = expected;
+            chunk.end = std::max(chunk.end, expected);
+            parseChunk(tokenizer, prototypes, chunk);
         }
-        row = extractRow(maxColCount);
-        ++rowIndex;
+        if (chunk.error) throwError(*chunk.error, line, prototypes.size());
+
+        line += chunk.lines;
+        expected = chunk.stop;
+        rows += std::visit(
+            [](const auto& data) -> size_t {
+                if constexpr (std::is_same_v<std::decay_t<decltype(data)>, Categories>) {
+                    return data.ids.size();
+                } else {
+                    return data.size();
+                }
+            },
+            chunk.columns.front());
+    }
+
+    // Move the parsed values into the columns in chunk order
+    for (size_t col = 0; col < prototypes.size(); ++col) {
+        auto column = dataFrame->getColumn(col + 1);
+        std::visit(
+            [&](const auto& prototype) {
+                using D = std::decay_t<decltype(prototype)>;
+                if constexpr (std::is_same_v<D, Categories>) {
+                    auto catCol = static_cast<CategoricalColumn*>(column.get());
+                    auto& dest = catCol->getTypedBuffer()
+                                     ->getEditableRAMRepresentation()
+                                     ->getDataContainer();
+                    dest.reserve(rows);
+                    for (auto& chunk : chunks) {
+                        auto& src = std::get<Categories>(chunk.columns[col]);
+                        const auto ids = util::transform(src.values, [&](std::string_view value) {
+                            return catCol->addCategory(std::string{value});
+                        });
+                        for (auto id : src.ids) dest.push_back(ids[id]);
+                        src = Categories{};
+                    }
+                } else {
+                    using T = typename D::value_type;
+                    auto typedCol = static_cast<TemplateColumn<T>*>(column.get());
+                    auto& dest = typedCol->getTypedBuffer()
+                                     ->getEditableRAMRepresentation()
+                                     ->getDataContainer();
+                    dest.reserve(rows);
+                    for (auto& chunk : chunks) {
+                        auto& src = std::get<D>(chunk.columns[col]);
+                        dest.insert(dest.end(), src.begin(), src.end());
+                        D{}.swap(src);
+                    }
+                }
+            },
+            prototypes[col]);
     }
+
     dataFrame->updateIndexBuffer();
     return dataFrame;
 }
@@ -32,10 +32,21 @@
 #include <inviwo/core/util/document.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/assertion.h>
+#include <inviwo/core/util/parallel.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <optional>
+#include <string_view>
+#include <unordered_map>
 
 namespace inviwo {
 
@@ -191,97 +202,293 @@ void columnCheck(const DataFrame& left, const DataFrame& right,
     }
 }
 
+constexpr size_t noMatch = std::numeric_limits<size_t>::max();
+
 /**
- * \brief for each row in leftCol return a list of matching row indices in rightCol
+ * \brief the key buffers of a key column. The right ids of categorical columns are mapped onto the
+ * category ids of the left column, categories missing in left are mapped to the number of left
+ * categories.
  */
-template <bool firstMatchOnly = false>
-std::vector<std::vector<size_t>> getMatchingRows(std::shared_ptr<const Column> leftCol,
-                                                 std::shared_ptr<const Column> rightCol) {
-    std::vector<std::vector<size_t>> rows(leftCol->getSize());
-
-    if (auto catCol1 = dynamic_cast<const CategoricalColumn*>(leftCol.get())) {
-        // need to match values of categorical columns instead of indices stored in buffer
-        auto catCol2 = dynamic_cast<const CategoricalColumn*>(rightCol.get());
+struct KeyBuffers {
+    const BufferRAM* left;
+    const BufferRAM* right;
+    std::shared_ptr<BufferRAM> mapped;
+};
+
+KeyBuffers getKeyBuffers(const Column& leftCol, const Column& rightCol) {
+    KeyBuffers keys{leftCol.getBuffer()->getRepresentation<BufferRAM>(),
+                    rightCol.getBuffer()->getRepresentation<BufferRAM>(), nullptr};
+
+    if (auto catCol1 = dynamic_cast<const CategoricalColumn*>(&leftCol)) {
+        auto catCol2 = dynamic_cast<const CategoricalColumn*>(&rightCol);
         IVW_ASSERT(catCol2, "right column is not categorical");
 
-        auto valuesRight = catCol2->getValues();
-        for (auto&& [i, key] : util::enumerate(catCol1->getValues())) {
-            // find all matching rows in right column
-            std::vector<size_t> matches;
-            for (auto&& [r, value] : util::enumerate(valuesRight)) {
-                if (key == value) {
-                    matches.emplace_back(r);
-                    if constexpr (firstMatchOnly) break;
-                }
-            }
-            rows[i] = std::move(matches);
+        std::unordered_map<std::string_view, std::uint32_t> ids;
+        for (auto&& [id, category] : util::enumerate(catCol1->getCategories())) {
+            ids.emplace(category, static_cast<std::uint32_t>(id));
         }
-    } else {
-        leftCol->getBuffer()->getRepresentation<BufferRAM>()->dispatch<void>(
-            [rightBuffer = rightCol->getBuffer(), &rows](auto typedBuf) {
-                using ValueType = util::PrecisionValueType<decltype(typedBuf)>;
+        const auto missing = static_cast<std::uint32_t>(ids.size());
+        const auto categoryMap = util::transform(catCol2->getCategories(), [&](const auto& cat) {
+            auto it = ids.find(cat);
+            return it != ids.end() ? it->second : missing;
+        });
 
-                const auto& left = typedBuf->getDataContainer();
-                const auto& right = static_cast<const BufferRAMPrecision<ValueType>*>(
-                                        rightBuffer->getRepresentation<BufferRAM>())
-                                        ->getDataContainer();
-
-                for (auto&& [i, key] : util::enumerate(left)) {
-                    // find all matching rows in right
-                    std::vector<size_t> matches;
-                    for (auto&& [r, value] : util::enumerate(right)) {
-                        if (key == value) {
-                            matches.emplace_back(r);
-                            if constexpr (firstMatchOnly) break;
-                        }
-                    }
-                    rows[i] = std::move(matches);
-                }
-            });
+        const auto& rightIds =
+            static_cast<const BufferRAMPrecision<std::uint32_t>*>(keys.right)->getDataContainer();
+        std::vector<std::uint32_t> mappedIds(rightIds.size());
+        util::parallelFor(size_t{0}, rightIds.size(),
+                          [&](size_t i) { mappedIds[i] = categoryMap[rightIds[i]]; });
+
+        keys.mapped = std::make_shared<BufferRAMPrecision<std::uint32_t>>(std::move(mappedIds));
+        keys.right = keys.mapped.get();
     }
-    return rows;
+    return keys;
 }
 
-std::vector<std::vector<size_t>> getMatchingRows(const DataFrame& left, const DataFrame& right,
-                                                 const std::vector<std::string>& keyColumns) {
-    auto indexCol1 = left.getColumn(keyColumns.front());
-    auto indexCol2 = right.getColumn(keyColumns.front());
-
-    auto rows = detail::getMatchingRows(indexCol1, indexCol2);
-    // narrow down row selection by filtering with remaining keys
-    for (auto keyColName : util::as_range(keyColumns.begin() + 1, keyColumns.end())) {
-        auto leftCol = left.getColumn(keyColName);
-        auto rightCol = right.getColumn(keyColName);
-
-        if (auto catCol1 = dynamic_cast<const CategoricalColumn*>(leftCol.get())) {
-            auto catCol2 = dynamic_cast<const CategoricalColumn*>(rightCol.get());
-            IVW_ASSERT(catCol2, "right column is not categorical");
-
-            auto valuesLeft = catCol1->getValues();
-            auto valuesRight = catCol2->getValues();
-            for (auto&& [i, rowMatches] : util::enumerate(rows)) {
-                util::erase_remove_if(rowMatches, [key = valuesLeft[i], &valuesRight](auto row) {
-                    return key != valuesRight[row];
-                });
+template <typename T>
+const std::vector<T>& getKeys(const BufferRAM* buffer) {
+    return static_cast<const BufferRAMPrecision<T>*>(buffer)->getDataContainer();
+}
+
+template <typename T>
+constexpr bool isScalarKey() {
+    return std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+}
+
+/**
+ * Direct join, a table with the first right row of each key in [min, min + range)
+ */
+template <typename T>
+void directJoin(const std::vector<T>& left, const std::vector<T>& right, T min, size_t range,
+                std::vector<std::optional<size_t>>& rows) {
+    const auto index = [min](T key) {
+        return static_cast<size_t>(static_cast<std::uint64_t>(key) -
+                                   static_cast<std::uint64_t>(min));
+    };
+
+    std::vector<std::atomic<size_t>> table(range);
+    util::parallelFor(size_t{0}, range,
+                      [&](size_t i) { table[i].store(noMatch, std::memory_order_relaxed); });
+
+    util::parallelFor(size_t{0}, right.size(), [&](size_t r) {
+        auto& first = table[index(right[r])];
+        auto current = first.load(std::memory_order_relaxed);
+        while (r < current && !first.compare_exchange_weak(current, r, std::memory_order_relaxed)) {
+        }
+    });
+
+    util::parallelFor(size_t{0}, left.size(), [&](size_t l) {
+        if (left[l] < min) return;
+        const auto i = index(left[l]);
+        if (i >= range) return;
+        if (const auto r = table[i].load(std::memory_order_relaxed); r != noMatch) rows[l] = r;
+    });
+}
+
+/**
+ * Sort the keys, skipping NaNs, as pairs of value and row. Ties are ordered by row.
+ */
+template <typename T>
+std::vector<std::pair<T, size_t>> sortKeys(const std::vector<T>& data) {
+    std::vector<std::pair<T, size_t>> keys;
+    keys.reserve(data.size());
+    bool sorted = true;
+    for (size_t i = 0; i < data.size(); ++i) {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (std::isnan(data[i])) continue;
+        }
+        if (!keys.empty() && data[i] < keys.back().first) sorted = false;
+        keys.emplace_back(data[i], i);
+    }
+    if (sorted) return keys;
+
+    // Sort chunks in parallel, then merge pairs of chunks in parallel until there is only one
+    const size_t chunk = std::max(size_t{1} << 16, keys.size() / 64);
+    const size_t nChunks = (keys.size() + chunk - 1) / chunk;
+    util::parallelFor(
+        size_t{0}, nChunks,
+        [&](size_t i) {
+            std::sort(keys.begin() + i * chunk,
+                      keys.begin() + std::min((i + 1) * chunk, keys.size()));
+        },
+        1);
+    for (size_t width = chunk; width < keys.size(); width *= 2) {
+        util::parallelFor(
+            size_t{0}, (keys.size() + 2 * width - 1) / (2 * width),
+            [&](size_t i) {
+                const auto first = i * 2 * width;
+                const auto middle = std::min(first + width, keys.size());
+                const auto last = std::min(first + 2 * width, keys.size());
+                std::inplace_merge(keys.begin() + first, keys.begin() + middle,
+                                   keys.begin() + last);
+            },
+            1);
+    }
+    return keys;
+}
+
+template <typename T>
+void sortMergeJoin(const std::vector<T>& left, const std::vector<T>& right,
+                   std::vector<std::optional<size_t>>& rows) {
+    std::vector<std::pair<T, size_t>> sortedLeft;
+    std::vector<std::pair<T, size_t>> sortedRight;
+    util::parallelFor(
+        size_t{0}, size_t{2},
+        [&](size_t i) {
+            if (i == 0) {
+                sortedLeft = sortKeys(left);
+            } else {
+                sortedRight = sortKeys(right);
             }
+        },
+        1);
+
+    // Merge chunks of the left keys in parallel, each starting at the first right key not less
+    // than the first key of the chunk. Since ties are ordered by row it is the first right row.
+    const auto less = [](const std::pair<T, size_t>& a, const T& b) { return a.first < b; };
+    util::parallelFor(size_t{0}, sortedLeft.size(), [&](size_t begin, size_t end) {
+        auto it = std::lower_bound(sortedRight.begin(), sortedRight.end(),
+                                   sortedLeft[begin].first, less);
+        for (size_t i = begin; i < end && it != sortedRight.end(); ++i) {
+            const auto& [key, row] = sortedLeft[i];
+            while (it != sortedRight.end() && it->first < key) ++it;
+            if (it != sortedRight.end() && it->first == key) rows[row] = it->second;
+        }
+    });
+}
+
+constexpr std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+template <typename T>
+std::uint64_t hashKey(std::uint64_t seed, const T& value) {
+    for (size_t i = 0; i < util::flat_extent<T>::value; ++i) {
+        const auto& comp = util::glmcomp(value, i);
+        using C = std::decay_t<decltype(comp)>;
+        std::uint64_t bits;
+        if constexpr (util::is_floating_point<C>::value) {
+            // -0.0 and 0.0 compare equal and should have the same hash
+            const double d = static_cast<double>(comp) == 0.0 ? 0.0 : static_cast<double>(comp);
+            std::memcpy(&bits, &d, sizeof(double));
         } else {
-            leftCol->getBuffer()->getRepresentation<BufferRAM>()->dispatch<void>(
-                [&rows, rightBuffer = rightCol->getBuffer()](auto typedBuf) {
-                    using ValueType = util::PrecisionValueType<decltype(typedBuf)>;
+            bits = static_cast<std::uint64_t>(comp);
+        }
+        seed = mix(seed + 0x9e3779b97f4a7c15ull + bits);
+    }
+    return seed;
+}
+
+/**
+ * Hash join for any number of key columns. The rows of right are inserted into a chained hash
+ * table using a lock free push, probing keeps the lowest matching row of each chain.
+ */
+void hashJoin(const std::vector<KeyBuffers>& keys, size_t leftSize, size_t rightSize,
+              std::vector<std::optional<size_t>>& rows) {
+    std::vector<std::uint64_t> leftHashes(leftSize, 0);
+    std::vector<std::uint64_t> rightHashes(rightSize, 0);
+    std::vector<std::function<bool(size_t, size_t)>> equal;
+
+    for (const auto& key : keys) {
+        key.left->dispatch<void>([&](auto typedBuf) {
+            using ValueType = util::PrecisionValueType<decltype(typedBuf)>;
+            const auto& leftKeys = getKeys<ValueType>(key.left);
+            const auto& rightKeys = getKeys<ValueType>(key.right);
+
+            util::parallelFor(size_t{0}, leftSize, [&](size_t l) {
+                leftHashes[l] = hashKey(leftHashes[l], leftKeys[l]);
+            });
+            util::parallelFor(size_t{0}, rightSize, [&](size_t r) {
+                rightHashes[r] = hashKey(rightHashes[r], rightKeys[r]);
+            });
+            equal.emplace_back([&leftKeys, &rightKeys](size_t l, size_t r) {
+                return leftKeys[l] == rightKeys[r];
+            });
+        });
+    }
 
-                    const auto& left = typedBuf->getDataContainer();
-                    const auto& right = static_cast<const BufferRAMPrecision<ValueType>*>(
-                                            rightBuffer->getRepresentation<BufferRAM>())
-                                            ->getDataContainer();
+    size_t buckets = 1;
+    while (buckets < 2 * rightSize) buckets *= 2;
+    const auto mask = buckets - 1;
+
+    std::vector<std::atomic<size_t>> heads(buckets);
+    std::vector<size_t> next(rightSize, noMatch);
+    util::parallelFor(size_t{0}, buckets,
+                      [&](size_t i) { heads[i].store(noMatch, std::memory_order_relaxed); });
+    util::parallelFor(size_t{0}, rightSize, [&](size_t r) {
+        auto& head = heads[rightHashes[r] & mask];
+        next[r] = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(next[r], r, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+        }
+    });
+
+    util::parallelFor(size_t{0}, leftSize, [&](size_t l) {
+        const auto hash = leftHashes[l];
+        size_t match = noMatch;
+        for (auto r = heads[hash & mask].load(std::memory_order_acquire); r != noMatch;
+             r = next[r]) {
+            if (r < match && rightHashes[r] == hash &&
+                std::all_of(equal.begin(), equal.end(), [&](auto& eq) { return eq(l, r); })) {
+                match = r;
+            }
+        }
+        if (match != noMatch) rows[l] = match;
+    });
+}
 
-                    for (auto&& [i, rowMatches] : util::enumerate(rows)) {
-                        util::erase_remove_if(rowMatches, [key = left[i], &right](auto row) {
-                            return key != right[row];
-                        });
+std::vector<std::optional<size_t>> getMatchingRows(const DataFrame& left, const DataFrame& right,
+                                                   const std::vector<std::string>& keyColumns,
+                                                   JoinAlgorithm algorithm) {
+    const auto leftSize = left.getColumn(keyColumns.front())->getSize();
+    const auto rightSize = right.getColumn(keyColumns.front())->getSize();
+    std::vector<std::optional<size_t>> rows(leftSize);
+    if (leftSize == 0 || rightSize == 0) return rows;
+
+    const auto keys = util::transform(keyColumns, [&](const std::string& header) {
+        return getKeyBuffers(*left.getColumn(header), *right.getColumn(header));
+    });
+
+    if (keys.size() == 1 && algorithm != JoinAlgorithm::Hash) {
+        const bool done = keys.front().left->dispatch<bool>([&](auto typedBuf) {
+            using ValueType = util::PrecisionValueType<decltype(typedBuf)>;
+            if constexpr (isScalarKey<ValueType>()) {
+                const auto& leftKeys = getKeys<ValueType>(keys.front().left);
+                const auto& rightKeys = getKeys<ValueType>(keys.front().right);
+
+                if constexpr (std::is_integral_v<ValueType>) {
+                    if (algorithm == JoinAlgorithm::Auto || algorithm == JoinAlgorithm::Direct) {
+                        const auto [min, max] =
+                            std::minmax_element(rightKeys.begin(), rightKeys.end());
+                        const auto range = static_cast<std::uint64_t>(*max) -
+                                           static_cast<std::uint64_t>(*min) + 1;
+                        // Only use a table if it is not much larger than the data
+                        if (range != 0 && range <= 4 * (leftSize + rightSize)) {
+                            directJoin(leftKeys, rightKeys, *min, static_cast<size_t>(range),
+                                       rows);
+                            return true;
+                        }
                     }
-                });
-        }
+                }
+                if (algorithm == JoinAlgorithm::SortMerge ||
+                    (algorithm == JoinAlgorithm::Auto &&
+                     std::is_sorted(leftKeys.begin(), leftKeys.end()) &&
+                     std::is_sorted(rightKeys.begin(), rightKeys.end()))) {
+                    sortMergeJoin(leftKeys, rightKeys, rows);
+                    return true;
+                }
+            }
+            return false;
+        });
+        if (done) return rows;
     }
+
+    hashJoin(keys, leftSize, rightSize, rows);
     return rows;
 }
 
@@ -349,31 +556,20 @@ void addColumns(std::shared_ptr<DataFrame> dst, const DataFrame& srcDataFrame,
 
 }  // namespace detail
 
-std::shared_ptr<DataFrame> innerJoin(const DataFrame& left, const DataFrame& right,
-                                     const std::string& keyColumn) {
-    detail::columnCheck(left, right, {keyColumn}, "dataframe::innerJoin");
-
-    auto indexCol1 = left.getColumn(keyColumn);
-    auto indexCol2 = right.getColumn(keyColumn);
-
-    std::vector<size_t> rowsLeft;
-    std::vector<size_t> rowsRight;
-    for (auto&& [i, rowIndices] :
-         util::enumerate(detail::getMatchingRows<true>(indexCol1, indexCol2))) {
-        if (!rowIndices.empty()) {
-            rowsLeft.push_back(i);
-            rowsRight.push_back(rowIndices.front());
-        }
+std::vector<std::optional<size_t>> findMatchingRows(const DataFrame& left, const DataFrame& right,
+                                                    const std::vector<std::string>& keyColumns,
+                                                    JoinAlgorithm algorithm) {
+    if (keyColumns.empty()) {
+        throw Exception("no key columns given", IVW_CONTEXT_CUSTOM("dataframe::findMatchingRows"));
     }
+    detail::columnCheck(left, right, keyColumns, "dataframe::findMatchingRows");
 
-    IVW_ASSERT(rowsLeft.size() == rowsRight.size(), "incorrect number of matching row indices");
-
-    auto dataframe = std::make_shared<DataFrame>();
-    detail::addColumns(dataframe, left, rowsLeft, {keyColumn}, false);
-    detail::addColumns(dataframe, right, rowsRight, {keyColumn}, true);
+    return detail::getMatchingRows(left, right, keyColumns, algorithm);
+}
 
-    dataframe->updateIndexBuffer();
-    return dataframe;
+std::shared_ptr<DataFrame> innerJoin(const DataFrame& left, const DataFrame& right,
+                                     const std::string& keyColumn) {
+    return innerJoin(left, right, std::vector<std::string>{keyColumn});
 }
 
 std::shared_ptr<DataFrame> innerJoin(const DataFrame& left, const DataFrame& right,
@@ -386,11 +582,11 @@ std::shared_ptr<DataFrame> innerJoin(const DataFrame& left, const DataFrame& rig
 
     std::vector<size_t> rowsLeft;
     std::vector<size_t> rowsRight;
-    for (auto&& [i, rowIndices] :
-         util::enumerate(detail::getMatchingRows(left, right, keyColumns))) {
-        if (!rowIndices.empty()) {
+    for (auto&& [i, match] : util::enumerate(
+             detail::getMatchingRows(left, right, keyColumns, JoinAlgorithm::Auto))) {
+        if (match) {
             rowsLeft.push_back(i);
-            rowsRight.push_back(rowIndices.front());
+            rowsRight.push_back(*match);
         }
     }
 
@@ -406,28 +602,7 @@ std::shared_ptr<DataFrame> innerJoin(const DataFrame& left, const DataFrame& rig
 
 std::shared_ptr<DataFrame> leftJoin(const DataFrame& left, const DataFrame& right,
                                     const std::string& keyColumn) {
-    detail::columnCheck(left, right, {keyColumn}, "dataframe::leftJoin");
-
-    auto indexCol1 = left.getColumn(keyColumn);
-    auto indexCol2 = right.getColumn(keyColumn);
-
-    auto rows = util::transform(detail::getMatchingRows<true>(indexCol1, indexCol2),
-                                [](const std::vector<size_t>& rowIndices) -> std::optional<size_t> {
-                                    if (rowIndices.empty()) {
-                                        return {};
-                                    } else {
-                                        return rowIndices.front();
-                                    }
-                                });
-
-    IVW_ASSERT(indexCol1->getSize() == rows.size(), "incorrect number of matching row indices");
-
-    auto dataframe = std::make_shared<DataFrame>();
-    detail::addColumns(dataframe, left, {keyColumn}, false);
-    detail::addColumns(dataframe, right, rows, {keyColumn}, true);
-
-    dataframe->updateIndexBuffer();
-    return dataframe;
+    return leftJoin(left, right, std::vector<std::string>{keyColumn});
 }
 
 std::shared_ptr<DataFrame> leftJoin(const DataFrame& left, const DataFrame& right,
@@ -438,14 +613,10 @@ std::shared_ptr<DataFrame> leftJoin(const DataFrame& left, const DataFrame& righ
 
     detail::columnCheck(left, right, keyColumns, "dataframe::leftJoin");
 
-    auto rows = util::transform(detail::getMatchingRows(left, right, keyColumns),
-                                [](const std::vector<size_t>& rowIndices) -> std::optional<size_t> {
-                                    if (rowIndices.empty()) {
-                                        return {};
-                                    } else {
-                                        return rowIndices.front();
-                                    }
-                                });
+    auto rows = detail::getMatchingRows(left, right, keyColumns, JoinAlgorithm::Auto);
+
+    IVW_ASSERT(left.getColumn(keyColumns.front())->getSize() == rows.size(),
+               "incorrect number of matching row indices");
 
     auto dataframe = std::make_shared<DataFrame>();
     detail::addColumns(dataframe, left, keyColumns, false);
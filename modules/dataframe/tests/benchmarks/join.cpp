@@ -0,0 +1,176 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/util/dataframeutil.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+namespace {
+
+InviwoApplication* app = nullptr;
+
+enum class Keys { Dense, Sorted, Sparse };
+
+/*
+ * Two DataFrames with an int "key" and a float "value" column where about half of the left keys
+ * have a match in right.
+ *   Dense:  shuffled keys in [0, 2 * size), selects the Direct join
+ *   Sorted: sorted keys with a large stride, selects the SortMerge join
+ *   Sparse: shuffled keys with a large stride, selects the Hash join
+ */
+std::pair<DataFrame, DataFrame> makeFrames(size_t size, Keys keys) {
+    std::mt19937 gen(42);
+    const int stride = keys == Keys::Dense ? 1 : 1009;
+
+    std::vector<int> leftKeys(size);
+    std::vector<int> rightKeys(size);
+    for (size_t i = 0; i < size; ++i) {
+        leftKeys[i] = static_cast<int>(i) * stride;
+        rightKeys[i] = static_cast<int>(i + size / 2) * stride;
+    }
+    if (keys != Keys::Sorted) {
+        std::shuffle(leftKeys.begin(), leftKeys.end(), gen);
+        std::shuffle(rightKeys.begin(), rightKeys.end(), gen);
+    }
+
+    std::pair<DataFrame, DataFrame> frames;
+    frames.first.addColumnFromBuffer("key", util::makeBuffer(std::move(leftKeys)));
+    frames.first.addColumnFromBuffer("value", util::makeBuffer(std::vector<float>(size, 1.0f)));
+    frames.first.updateIndexBuffer();
+    frames.second.addColumnFromBuffer("key", util::makeBuffer(std::move(rightKeys)));
+    frames.second.addColumnFromBuffer("value2", util::makeBuffer(std::vector<float>(size, 2.0f)));
+    frames.second.updateIndexBuffer();
+    return frames;
+}
+
+// The previous implementation, a nested loop over the left and right keys
+std::vector<std::optional<size_t>> referenceMatchingRows(const DataFrame& left,
+                                                         const DataFrame& right) {
+    const auto& leftKeys = static_cast<const BufferRAMPrecision<int>*>(
+                               left.getColumn("key")->getBuffer()->getRepresentation<BufferRAM>())
+                               ->getDataContainer();
+    const auto& rightKeys = static_cast<const BufferRAMPrecision<int>*>(
+                                right.getColumn("key")->getBuffer()->getRepresentation<BufferRAM>())
+                                ->getDataContainer();
+
+    std::vector<std::optional<size_t>> rows(leftKeys.size());
+    for (size_t i = 0; i < leftKeys.size(); ++i) {
+        for (size_t r = 0; r < rightKeys.size(); ++r) {
+            if (leftKeys[i] == rightKeys[r]) {
+                rows[i] = r;
+                break;
+            }
+        }
+    }
+    return rows;
+}
+
+template <Keys K>
+void Reference(benchmark::State& state) {
+    const auto [left, right] = makeFrames(static_cast<size_t>(state.range(0)), K);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(referenceMatchingRows(left, right));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <Keys K, dataframe::JoinAlgorithm Algorithm>
+void MatchingRows(benchmark::State& state) {
+    const auto [left, right] = makeFrames(static_cast<size_t>(state.range(0)), K);
+    app->getSystemSettings().poolSize_.set(static_cast<size_t>(state.range(1)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dataframe::findMatchingRows(left, right, {"key"}, Algorithm));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["Threads"] = static_cast<double>(app->getPoolSize() + 1);
+}
+
+template <Keys K>
+void InnerJoin(benchmark::State& state) {
+    const auto [left, right] = makeFrames(static_cast<size_t>(state.range(0)), K);
+    app->getSystemSettings().poolSize_.set(static_cast<size_t>(state.range(1)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dataframe::innerJoin(left, right, "key"));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["Threads"] = static_cast<double>(app->getPoolSize() + 1);
+}
+
+void args(benchmark::internal::Benchmark* b) {
+    for (long size : {1L << 16, 1L << 20}) {
+        for (long threads : {0L, 3L, 7L}) b->Args({size, threads});
+    }
+}
+
+}  // namespace
+
+constexpr auto Auto = dataframe::JoinAlgorithm::Auto;
+constexpr auto SortMerge = dataframe::JoinAlgorithm::SortMerge;
+constexpr auto Hash = dataframe::JoinAlgorithm::Hash;
+
+BENCHMARK_TEMPLATE(Reference, Keys::Dense)->Arg(1 << 14);
+BENCHMARK_TEMPLATE(MatchingRows, Keys::Dense, Auto)->Apply(args);
+BENCHMARK_TEMPLATE(MatchingRows, Keys::Dense, SortMerge)->Apply(args);
+BENCHMARK_TEMPLATE(MatchingRows, Keys::Dense, Hash)->Apply(args);
+BENCHMARK_TEMPLATE(MatchingRows, Keys::Sorted, Auto)->Apply(args);
+BENCHMARK_TEMPLATE(MatchingRows, Keys::Sorted, Hash)->Apply(args);
+BENCHMARK_TEMPLATE(MatchingRows, Keys::Sparse, Auto)->Apply(args);
+BENCHMARK_TEMPLATE(MatchingRows, Keys::Sparse, SortMerge)->Apply(args);
+BENCHMARK_TEMPLATE(InnerJoin, Keys::Sparse)->Apply(args);
+
+int main(int argc, char** argv) {
+    InviwoApplication inviwoApp("bm-join");
+    app = &inviwoApp;
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
+
+#include <warn/pop>
@@ -35,6 +35,7 @@
 #include <inviwo/core/io/tempfilehandle.h>
 #include <inviwo/dataframe/io/csvreader.h>
 
+#include <cstdio>
 #include <sstream>
 
 namespace inviwo {
@@ -53,6 +54,31 @@ TEST(CSVnoData, file) {
     EXPECT_THROW(reader.readData(tmpFile.getFileName()), inviwo::CSVDataReaderException);
 }
 
+TEST(CSVdata, file) {
+    // large enough to be split into several chunks, with line breaks enclosed in quotes
+    std::string data = "Index,Text,Value\n";
+    const size_t rows = 300000;
+    for (size_t i = 0; i < rows; ++i) {
+        data += std::to_string(i) + ",\"line\r\nbreak " + std::to_string(i % 3) + "\"," +
+                std::to_string(i % 1000) + ".5\n";
+    }
+    util::TempFileHandle tmpFile("", ".csv");
+    std::fwrite(data.data(), 1, data.size(), tmpFile.getHandle());
+    std::fflush(tmpFile.getHandle());
+
+    CSVReader reader;
+    auto dataframe = reader.readData(tmpFile.getFileName());
+    ASSERT_EQ(4, dataframe->getNumberOfColumns()) << "column count does not match";
+    ASSERT_EQ(rows, dataframe->getNumberOfRows()) << "row count does not match";
+    for (size_t i : {size_t{0}, rows / 2, rows - 1}) {
+        EXPECT_EQ(std::to_string(i), dataframe->getColumn(1)->get(i, false)->toString());
+        EXPECT_EQ("\"line\nbreak " + std::to_string(i % 3) + "\"",
+                  dataframe->getColumn(2)->get(i, true)->toString());
+        EXPECT_EQ(std::to_string(i % 1000) + ".5",
+                  dataframe->getColumn(3)->get(i, false)->toString());
+    }
+}
+
 TEST(CSVdata, numRows) {
     // test for correct row count
     std::istringstream ss("1\n2\n3\n4\n\5\n6");
@@ -217,6 +243,34 @@ TEST(CSVdata, byteOrderMark) {
     EXPECT_EQ("1", value) << "Column 1";
 }
 
+TEST(CSVdata, doublePrecision) {
+    std::istringstream ss("1.5,2\n3.25,4");
+
+    CSVReader reader;
+    reader.setFirstRowHeader(false);
+    reader.setEnableDoublePrecision(true);
+    auto dataframe = reader.readData(ss);
+
+    ASSERT_EQ(3, dataframe->getNumberOfColumns()) << "column count does not match";
+    EXPECT_EQ(DataFormatId::Float64,
+              dataframe->getColumn(1)->getBuffer()->getDataFormat()->getId());
+    EXPECT_EQ(DataFormatId::Int32, dataframe->getColumn(2)->getBuffer()->getDataFormat()->getId());
+}
+
+TEST(CSVdata, typeMismatch) {
+    // column types are derived from the first rows, later values have to match
+    std::string data;
+    for (int i = 0; i < 100; ++i) {
+        data += std::to_string(i) + "\n";
+    }
+    std::istringstream ss(data + "abc\n");
+
+    CSVReader reader;
+    reader.setFirstRowHeader(false);
+
+    EXPECT_THROW(reader.readData(ss), DataTypeMismatch);
+}
+
 TEST(CSVheader, withHeader) {
     const std::string data = "1,2,3\n4,5,6";
     std::istringstream ss("First Col,Second Col,Third Col\n" + data);
@@ -36,8 +36,9 @@
 
 #include <inviwo/testutil/configurablegtesteventlistener.h>
 
-#include <inviwo/core/datastructures/representationutil.h>
-#include <inviwo/core/datastructures/representationfactorymanager.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/common/coremodulesharedlibrary.h>
+#include <inviwo/core/util/logcentral.h>
 
 #include <warn/push>
 #include <warn/ignore/all>
@@ -45,8 +46,15 @@
 #include <warn/pop>
 
 int main(int argc, char** argv) {
-    inviwo::RepresentationFactoryManager rfm;
-    inviwo::util::registerCoreRepresentations(rfm);
+    inviwo::LogCentral::init();
+
+    // The application provides the thread pool used by util::parallelFor, e.g. in the joins
+    inviwo::InviwoApplication app(argc, argv, "Inviwo-Unittests-DataFrame");
+    {
+        std::vector<std::unique_ptr<inviwo::InviwoModuleFactoryObject>> modules;
+        modules.emplace_back(inviwo::createInviwoCore());
+        app.registerModules(std::move(modules));
+    }
 
     int ret = -1;
     {
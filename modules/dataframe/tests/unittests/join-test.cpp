@@ -42,6 +42,12 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <optional>
+#include <random>
+
 namespace inviwo {
 
 namespace {
@@ -385,4 +391,104 @@ TEST(LeftJoin, MultipleKeyColumns) {
                                {4.0f, 3.0f, 0.0f, 0.0f, 5.0f, 0.0f, 6.0f, 7.0f});
 }
 
+namespace {
+
+constexpr std::array<dataframe::JoinAlgorithm, 4> algorithms{
+    dataframe::JoinAlgorithm::Auto, dataframe::JoinAlgorithm::Direct,
+    dataframe::JoinAlgorithm::SortMerge, dataframe::JoinAlgorithm::Hash};
+
+}  // namespace
+
+TEST(FindMatchingRows, Algorithms) {
+    DataFrame left;
+    left.addColumnFromBuffer("int", util::makeBuffer(std::vector<int>{5, 3, 9, 3, 7, -2}));
+    left.updateIndexBuffer();
+
+    DataFrame right;
+    right.addColumnFromBuffer("int", util::makeBuffer(std::vector<int>{3, 7, 3, 11, 5}));
+    right.updateIndexBuffer();
+
+    const std::vector<std::optional<size_t>> expected{4, 0, std::nullopt, 0, 1, std::nullopt};
+    for (auto algorithm : algorithms) {
+        EXPECT_EQ(expected, dataframe::findMatchingRows(left, right, {"int"}, algorithm))
+            << "first matching rows differ for algorithm " << static_cast<int>(algorithm);
+    }
+}
+
+TEST(FindMatchingRows, FloatKeys) {
+    const auto nan = std::numeric_limits<float>::quiet_NaN();
+
+    DataFrame left;
+    left.addColumnFromBuffer("float", util::makeBuffer(std::vector<float>{1.5f, nan, -0.0f, 2.0f}));
+    left.updateIndexBuffer();
+
+    DataFrame right;
+    right.addColumnFromBuffer("float", util::makeBuffer(std::vector<float>{0.0f, nan, 2.0f, 1.5f}));
+    right.updateIndexBuffer();
+
+    const std::vector<std::optional<size_t>> expected{3, std::nullopt, 0, 2};
+    for (auto algorithm : algorithms) {
+        EXPECT_EQ(expected, dataframe::findMatchingRows(left, right, {"float"}, algorithm))
+            << "first matching rows differ for algorithm " << static_cast<int>(algorithm);
+    }
+}
+
+TEST(FindMatchingRows, CategoricalKeys) {
+    DataFrame left;
+    left.addCategoricalColumn("cat", {"b", "a", "x"});
+    left.updateIndexBuffer();
+
+    DataFrame right;
+    right.addCategoricalColumn("cat", {"a", "c", "b", "a"});
+    right.updateIndexBuffer();
+
+    const std::vector<std::optional<size_t>> expected{2, 0, std::nullopt};
+    for (auto algorithm : algorithms) {
+        EXPECT_EQ(expected, dataframe::findMatchingRows(left, right, {"cat"}, algorithm))
+            << "first matching rows differ for algorithm " << static_cast<int>(algorithm);
+    }
+}
+
+TEST(FindMatchingRows, ManyDuplicateKeys) {
+    // More keys than the sort chunk size (2^16), such that the chunks are sorted and merged in
+    // parallel and the hash table is built in parallel. Every key occurs several times.
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(-30'000, 30'000);
+    std::vector<int> leftKeys(200'000);
+    std::vector<int> rightKeys(150'000);
+    std::generate(leftKeys.begin(), leftKeys.end(), [&]() { return dist(gen); });
+    std::generate(rightKeys.begin(), rightKeys.end(), [&]() { return dist(gen) / 2; });
+
+    // The same keys as floats, which are never joined directly
+    const auto toFloat = [](const std::vector<int>& keys) {
+        std::vector<float> result(keys.size());
+        std::transform(keys.begin(), keys.end(), result.begin(), [](int v) { return v * 0.5f; });
+        return result;
+    };
+
+    DataFrame left;
+    left.addColumn("float", toFloat(leftKeys));
+    left.addColumn("int", std::move(leftKeys));
+    left.updateIndexBuffer();
+
+    DataFrame right;
+    right.addColumn("float", toFloat(rightKeys));
+    right.addColumn("int", std::move(rightKeys));
+    right.updateIndexBuffer();
+
+    const auto expected =
+        dataframe::findMatchingRows(left, right, {"int"}, dataframe::JoinAlgorithm::Direct);
+    ASSERT_EQ(size_t{200'000}, expected.size());
+    EXPECT_TRUE(std::any_of(expected.begin(), expected.end(), [](auto& row) { return row; }));
+    EXPECT_TRUE(std::any_of(expected.begin(), expected.end(), [](auto& row) { return !row; }));
+
+    for (auto algorithm : {dataframe::JoinAlgorithm::SortMerge, dataframe::JoinAlgorithm::Hash}) {
+        EXPECT_EQ(expected, dataframe::findMatchingRows(left, right, {"int"}, algorithm))
+            << "first matching rows differ for algorithm " << static_cast<int>(algorithm);
+        EXPECT_EQ(expected, dataframe::findMatchingRows(left, right, {"float"}, algorithm))
+            << "first matching rows of float keys differ for algorithm "
+            << static_cast<int>(algorithm);
+    }
+}
+
 }  // namespace inviwo
@@ -32,6 +32,7 @@
 #include <warn/push>
 #include <warn/ignore/shadow>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 #include <pybind11/stl_bind.h>
 #include <warn/pop>
@@ -48,6 +49,8 @@
 
 #include <fmt/format.h>
 
+#include <vector>
+
 namespace py = pybind11;
 
 namespace inviwo {
@@ -65,6 +68,20 @@ struct DataFrameAddColumnReg {
               },
               py::arg("header"), py::arg("size") = 0);
 
+        // Registered before the std::vector overload, NumPy arrays are copied straight into the
+        // column instead of being converted element by element through Python objects.
+        d.def(fmt::format("add{}Column", classname).c_str(),
+              [](DataFrame& d, std::string header,
+                 py::array_t<T, py::array::c_style | py::array::forcecast> data) {
+                  if (data.ndim() != 1) {
+                      throw py::value_error(
+                          fmt::format("Expected a 1D array, got {} dimensions", data.ndim()));
+                  }
+                  std::vector<T> values(data.data(), data.data() + data.size());
+                  return d.addColumn(std::move(header), std::move(values));
+              },
+              py::arg("header"), py::arg("data"));
+
         d.def(fmt::format("add{}Column", classname).c_str(),
               [](DataFrame& d, std::string header, std::vector<T> data) {
                   return d.addColumn(std::move(header), std::move(data));
@@ -30,6 +30,7 @@
 
 #include <inviwo/dataframeqt/dataframeqtmoduledefine.h>
 #include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/bitset.h>
 #include <modules/qtwidgets/processors/processorwidgetqt.h>
 #include <inviwo/core/processors/processorobserver.h>
 #include <inviwo/core/util/dispatcher.h>
@@ -61,8 +62,7 @@ public:
                       bool categoryIndices = false);
     void setIndexColumnVisible(bool visible);
 
-    void updateSelection(const std::unordered_set<size_t>& columns,
-                         const std::unordered_set<size_t>& rows);
+    void updateSelection(const BitSet& columns, const BitSet& rows);
 
     CallbackHandle setColumnSelectionChangedCallback(std::function<SelectionChangedFunc> callback);
     CallbackHandle setRowSelectionChangedCallback(std::function<SelectionChangedFunc> callback);
@@ -30,6 +30,7 @@
 
 #include <inviwo/dataframeqt/dataframeqtmoduledefine.h>
 #include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/bitset.h>
 
 #include <warn/push>
 #include <warn/ignore/all>
@@ -61,15 +62,15 @@ public:
     void setIndexColumnVisible(bool visible);
     bool isIndexColumnVisible() const;
 
-    void selectColumns(const std::unordered_set<size_t>& columns);
-    void selectRows(const std::unordered_set<size_t>& rows);
+    void selectColumns(const BitSet& columns);
+    void selectRows(const BitSet& rows);
 
 signals:
     void columnSelectionChanged(const std::unordered_set<size_t>& columns);
     void rowSelectionChanged(const std::unordered_set<size_t>& rows);
 
 private:
-    QStringList generateHeaders(const std::unordered_set<size_t>& selectedCols = {}) const;
+    QStringList generateHeaders(const BitSet& selectedCols = {}) const;
 
     bool indexVisible_ = false;
     bool vectorsIntoCols_ = false;
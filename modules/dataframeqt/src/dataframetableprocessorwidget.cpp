@@ -94,8 +94,7 @@ void DataFrameTableProcessorWidget::setIndexColumnVisible(bool visible) {
     tableview_->setIndexColumnVisible(visible);
 }
 
-void DataFrameTableProcessorWidget::updateSelection(const std::unordered_set<size_t>& columns,
-                                                    const std::unordered_set<size_t>& rows) {
+void DataFrameTableProcessorWidget::updateSelection(const BitSet& columns, const BitSet& rows) {
     tableview_->selectColumns(columns);
     tableview_->selectRows(rows);
 }
@@ -89,11 +89,11 @@ void DataFrameTable::process() {
         if (inport_.isChanged() || vectorCompAsColumn_.isModified() ||
             showCategoryIndices_.isModified()) {
             w->setDataFrame(inport_.getData(), vectorCompAsColumn_, showCategoryIndices_);
-            w->updateSelection(brushLinkPort_.getSelectedColumns(),
-                               brushLinkPort_.getSelectedIndices());
+            w->updateSelection(brushLinkPort_.getSelectedColumnsBitSet(),
+                               brushLinkPort_.getSelectedBitSet());
         } else if (brushLinkPort_.isChanged()) {
-            w->updateSelection(brushLinkPort_.getSelectedColumns(),
-                               brushLinkPort_.getSelectedIndices());
+            w->updateSelection(brushLinkPort_.getSelectedColumnsBitSet(),
+                               brushLinkPort_.getSelectedBitSet());
         }
     }
 }
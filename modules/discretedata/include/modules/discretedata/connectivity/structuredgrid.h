@@ -32,6 +32,8 @@
 #include <modules/discretedata/connectivity/connectivity.h>
 #include <modules/discretedata/util.h>
 
+#include <array>
+
 namespace inviwo {
 namespace discretedata {
 
@@ -39,6 +41,9 @@ class ElementIterator;
 
 /**
  * \brief A curvilinear grid in nD
+ * The number of dimensions is only known at runtime. Use StructuredGridN if it is known at
+ * compile time, it does all index computations on the stack and can traverse all cells without
+ * going through getConnections.
  * @author Anke Friederici and Tino Weinkauf
  */
 class IVW_MODULE_DISCRETEDATA_API StructuredGrid : public Connectivity {
@@ -57,6 +62,11 @@ public:
 
     virtual CellType getCellType(GridPrimitive dim, ind index) const override;
 
+    /**
+     * \brief Get the connected elements, see Connectivity::getConnections
+     * Same level connections and the cells of a vertex are appended to result, the vertices of a
+     * cell replace its content. Apart from growing result, no memory is allocated.
+     */
     virtual void getConnections(std::vector<ind>& result, ind index, GridPrimitive from,
                                 GridPrimitive to, bool positions = false) const override;
 
@@ -67,7 +77,208 @@ public:
 
 protected:
     std::vector<ind> numCellsPerDimension_;
+    //! Number of vertices in each dimension, one more than the number of cells
+    std::vector<ind> numVerticesPerDimension_;
+    //! Difference in linear vertex index between neighbors along each dimension
+    std::vector<ind> vertexStrides_;
 };
 
+/**
+ * \brief A curvilinear grid with a fixed number of dimensions
+ * Behaves like a StructuredGrid with N dimensions, but all index computations use std::array
+ * instead of std::vector. The corners of a cell can be queried without a result vector, and
+ * forEachCell walks a range of cells while updating the corners incrementally.
+ *
+ * The corners of a cell are ordered like in StructuredGrid::getConnections, bit d of the corner
+ * number is set if the corner is offset by one along dimension d.
+ */
+template <ind N>
+class StructuredGridN : public StructuredGrid {
+public:
+    static_assert(N > 0, "A structured grid needs at least one dimension");
+    static constexpr ind numCorners = ind{1} << N;
+    using Index = std::array<ind, N>;
+    using Corners = std::array<ind, numCorners>;
+
+    /**
+     * \brief Create an N dimensional grid
+     * @param numCellsPerDim Number of cells in each dimension
+     */
+    explicit StructuredGridN(const Index& numCellsPerDim);
+    virtual ~StructuredGridN() = default;
+
+    virtual void getConnections(std::vector<ind>& result, ind index, GridPrimitive from,
+                                GridPrimitive to, bool positions = false) const override;
+
+    //! nD index of the cell with the given linear index
+    Index cellIndex(ind cell) const;
+    //! nD index of the vertex with the given linear index
+    Index vertexIndex(ind vertex) const;
+
+    //! Linear index of the lower corner vertex of a cell
+    ind lowerCorner(ind cell) const;
+    //! Linear indices of all corner vertices of a cell
+    Corners getCellVertices(ind cell) const;
+
+    /**
+     * \brief Call func(cell, corners) for all cells in [begin, end)
+     * The corners are updated incrementally from cell to cell, no division is needed except for
+     * the first cell. The ranges can be run in parallel, e.g. with util::parallelFor.
+     */
+    template <typename Func>
+    void forEachCell(ind begin, ind end, Func&& func) const;
+
+    //! Call func(cell, corners) for all cells of the grid
+    template <typename Func>
+    void forEachCell(Func&& func) const {
+        forEachCell(0, numGridPrimitives_[N], std::forward<Func>(func));
+    }
+
+private:
+    static std::vector<ind> toVector(const Index& index) {
+        return std::vector<ind>(index.begin(), index.end());
+    }
+
+    Index cells_;
+    Index verts_;
+    Index cellStrides_;
+    Index vertStrides_;
+    Corners cornerOffsets_;
+};
+
+using StructuredGrid2D = StructuredGridN<2>;
+using StructuredGrid3D = StructuredGridN<3>;
+
+template <ind N>
+StructuredGridN<N>::StructuredGridN(const Index& numCellsPerDim)
+    : StructuredGrid(static_cast<GridPrimitive>(N), toVector(numCellsPerDim))
+    , cells_{numCellsPerDim} {
+    ind cellStride = 1;
+    ind vertStride = 1;
+    for (ind d = 0; d < N; ++d) {
+        verts_[d] = cells_[d] + 1;
+        cellStrides_[d] = cellStride;
+        vertStrides_[d] = vertStride;
+        cellStride *= cells_[d];
+        vertStride *= verts_[d];
+    }
+    for (ind i = 0; i < numCorners; ++i) {
+        cornerOffsets_[i] = 0;
+        for (ind d = 0; d < N; ++d) {
+            if (i & (ind{1} << d)) cornerOffsets_[i] += vertStrides_[d];
+        }
+    }
+}
+
+template <ind N>
+auto StructuredGridN<N>::cellIndex(ind cell) const -> Index {
+    Index index;
+    for (ind d = 0; d < N; ++d) {
+        index[d] = cell % cells_[d];
+        cell /= cells_[d];
+    }
+    return index;
+}
+
+template <ind N>
+auto StructuredGridN<N>::vertexIndex(ind vertex) const -> Index {
+    Index index;
+    for (ind d = 0; d < N; ++d) {
+        index[d] = vertex % verts_[d];
+        vertex /= verts_[d];
+    }
+    return index;
+}
+
+template <ind N>
+ind StructuredGridN<N>::lowerCorner(ind cell) const {
+    ind vertex = 0;
+    for (ind d = 0; d < N; ++d) {
+        vertex += (cell % cells_[d]) * vertStrides_[d];
+        cell /= cells_[d];
+    }
+    return vertex;
+}
+
+template <ind N>
+auto StructuredGridN<N>::getCellVertices(ind cell) const -> Corners {
+    const ind base = lowerCorner(cell);
+    Corners corners;
+    for (ind i = 0; i < numCorners; ++i) corners[i] = base + cornerOffsets_[i];
+    return corners;
+}
+
+template <ind N>
+template <typename Func>
+void StructuredGridN<N>::forEachCell(ind begin, ind end, Func&& func) const {
+    if (begin >= end) return;
+
+    Index index = cellIndex(begin);
+    ind base = lowerCorner(begin);
+    Corners corners;
+    for (ind cell = begin; cell < end; ++cell) {
+        for (ind i = 0; i < numCorners; ++i) corners[i] = base + cornerOffsets_[i];
+        func(cell, static_cast<const Corners&>(corners));
+
+        // Step to the next cell. At the end of a row the vertex index skips the last vertex of
+        // the row, and so on for the higher dimensions.
+        ++base;
+        for (ind d = 0; d < N - 1 && ++index[d] == cells_[d]; ++d) {
+            index[d] = 0;
+            base += vertStrides_[d + 1] - cells_[d] * vertStrides_[d];
+        }
+    }
+}
+
+template <ind N>
+void StructuredGridN<N>::getConnections(std::vector<ind>& result, ind idxLin, GridPrimitive from,
+                                        GridPrimitive to, bool positions) const {
+    constexpr auto cellPrimitive = static_cast<GridPrimitive>(N);
+
+    if (from == cellPrimitive && to == GridPrimitive::Vertex) {
+        const auto corners = getCellVertices(idxLin);
+        result.assign(corners.begin(), corners.end());
+        return;
+    }
+
+    if (from == GridPrimitive::Vertex && to == cellPrimitive) {
+        const Index vertex = vertexIndex(idxLin);
+        // The vertex is the lower corner of the cell with the same index, the other cells are
+        // found by stepping back along each dimension.
+        ind cell = 0;
+        for (ind d = 0; d < N; ++d) cell += vertex[d] * cellStrides_[d];
+        for (ind i = 0; i < numCorners; ++i) {
+            ind neighbor = cell;
+            bool inside = true;
+            for (ind d = 0; d < N && inside; ++d) {
+                if (i & (ind{1} << d)) {
+                    inside = vertex[d] > 0;
+                    neighbor -= cellStrides_[d];
+                } else {
+                    inside = vertex[d] < cells_[d];
+                }
+            }
+            if (inside) result.push_back(neighbor);
+        }
+        return;
+    }
+
+    if (from == to && (from == cellPrimitive || from == GridPrimitive::Vertex)) {
+        const auto& size = from == cellPrimitive ? cells_ : verts_;
+        ind index = idxLin;
+        ind stride = 1;
+        for (ind d = 0; d < N; ++d) {
+            const ind coord = index % size[d];
+            index /= size[d];
+            if (coord > 0) result.push_back(idxLin - stride);
+            if (coord < size[d] - 1) result.push_back(idxLin + stride);
+            stride *= size[d];
+        }
+        return;
+    }
+
+    StructuredGrid::getConnections(result, idxLin, from, to, positions);
+}
+
 }  // namespace discretedata
 }  // namespace inviwo
@@ -36,9 +36,9 @@ namespace discretedata {
 ConnectionRange::ConnectionRange(ind fromIndex, GridPrimitive fromDim, GridPrimitive toDim,
                                  const Connectivity* parent)
     : parent_(parent), toDimension_(toDim) {
-    std::vector<ind>* neigh = new std::vector<ind>();
+    auto neigh = std::make_shared<std::vector<ind>>();
     parent_->getConnections(*neigh, fromIndex, fromDim, toDim);
-    connections_ = std::shared_ptr<const std::vector<ind>>(neigh);
+    connections_ = std::move(neigh);
 }
 
 ConnectionIterator operator+(ind offset, ConnectionIterator& iter) {
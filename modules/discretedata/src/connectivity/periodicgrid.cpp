@@ -69,13 +69,8 @@ void PeriodicGrid::getConnections(std::vector<ind>& result, ind idxLin, GridPrim
     }
 
     if (from == to && from == GridPrimitive::Vertex) {
-        std::vector<ind> vertDims;
-        for (ind dim : numCellsPerDimension_) {
-            vertDims.push_back(dim + 1);
-        }
-
         // In this variant, the last vertex is the same as the first within each dimension.
-        sameLevelConnection(result, idxLin, vertDims);
+        sameLevelConnection(result, idxLin, numVerticesPerDimension_);
         return;
     }
 
@@ -86,12 +81,7 @@ void PeriodicGrid::getConnections(std::vector<ind>& result, ind idxLin, GridPrim
         result.resize(numCorners);
 
         // Vertex Strides - how much to add to the linear index to go forward by 1 in each dimension
-        std::vector<ind> VStrides(numDimensions);
-        ind dimProduct(1);
-        for (ind dim(0); dim < numDimensions; dim++) {
-            VStrides[dim] = dimProduct;
-            dimProduct *= (numCellsPerDimension_[dim] + 1);
-        }
+        const auto& VStrides = vertexStrides_;
         // Linear Index to nD Cell Index.
         std::vector<ind> cellIndex = StructuredGrid::indexFromLinear(idxLin, numCellsPerDimension_);
 
@@ -123,12 +113,7 @@ void PeriodicGrid::getConnections(std::vector<ind>& result, ind idxLin, GridPrim
     }
 
     if (from == GridPrimitive::Vertex && to == gridDimension_) {
-        // Compute dimensions for vertices
-        std::vector<ind> vertDims;
-        for (ind dim : numCellsPerDimension_) {
-            vertDims.push_back(dim + 1);
-        }
-
+        const auto& vertDims = numVerticesPerDimension_;
         const ind NumDimensions = vertDims.size();
 
         // Linear Index to nD Vertex Index.
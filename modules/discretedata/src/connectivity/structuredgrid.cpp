@@ -42,12 +42,13 @@ StructuredGrid::StructuredGrid(GridPrimitive gridDimension, const std::vector<in
                "GridPrimitive need to be at least Edge for a structured grid");
     IVW_ASSERT(static_cast<ind>(numCellsPerDim.size()) == static_cast<ind>(gridDimension),
                "Grid dimension should match cell dimension.");
-    numCellsPerDimension_ = std::vector<ind>(numCellsPerDim);
 
     ind numCells = 1;
     ind numVerts = 1;
     for (ind dim = static_cast<ind>(GridPrimitive::Vertex); dim < static_cast<ind>(gridDimension);
          ++dim) {
+        vertexStrides_.push_back(numVerts);
+        numVerticesPerDimension_.push_back(numCellsPerDimension_[dim] + 1);
         numCells *= numCellsPerDimension_[dim];
         numVerts *= numCellsPerDimension_[dim] + 1;
     }
@@ -68,12 +69,14 @@ std::vector<ind> StructuredGrid::indexFromLinear(ind idxLin, const std::vector<i
 
 void StructuredGrid::sameLevelConnection(std::vector<ind>& result, const ind idxLin,
                                          const std::vector<ind>& size) {
-    std::vector<ind> index = indexFromLinear(idxLin, size);
-
+    ind remainder = idxLin;
     ind dimensionProduct = 1;
     for (size_t dim = 0; dim < size.size(); ++dim) {
-        if (index[dim] > 0) result.push_back(idxLin - dimensionProduct);
-        if (index[dim] < size[dim] - 1) result.push_back(idxLin + dimensionProduct);
+        const ind index = remainder % size[dim];
+        remainder /= size[dim];
+
+        if (index > 0) result.push_back(idxLin - dimensionProduct);
+        if (index < size[dim] - 1) result.push_back(idxLin + dimensionProduct);
 
         dimensionProduct *= size[dim];
     }
@@ -87,94 +90,57 @@ void StructuredGrid::getConnections(std::vector<ind>& result, ind idxLin, GridPr
     }
 
     if (from == to && from == GridPrimitive::Vertex) {
-        std::vector<ind> vertDims;
-        for (ind dim : numCellsPerDimension_) {
-            vertDims.push_back(dim + 1);
-        }
-
-        return sameLevelConnection(result, idxLin, vertDims);
+        return sameLevelConnection(result, idxLin, numVerticesPerDimension_);
     }
 
-    if (from == gridDimension_ && to == GridPrimitive::Vertex) {
-        // Prepare corners
-        const ind numDimensions = numCellsPerDimension_.size();
-        const ind numCorners = ind(1) << numDimensions;
-        result.resize(numCorners);
-
-        // Vertex Strides - how much to add to the linear index to go forward by 1 in each dimension
-        std::vector<ind> vStrides(numDimensions);
-        ind dimProduct(1);
-        for (ind dim(0); dim < numDimensions; dim++) {
-            vStrides[dim] = dimProduct;
-            dimProduct *= (numCellsPerDimension_[dim] + 1);
-        }
-
-        // Linear Index to nD Cell Index.
-        ind idxRemainder = idxLin;
-        std::vector<ind> cellIndex(numDimensions, -1);
-        for (ind dim(0); dim < numDimensions; dim++) {
-            cellIndex[dim] = idxRemainder % numCellsPerDimension_[dim];
-            idxRemainder = (ind)(idxRemainder / numCellsPerDimension_[dim]);
-        }
+    const ind numDimensions = numCellsPerDimension_.size();
+    const ind numCorners = ind(1) << numDimensions;
 
+    if (from == gridDimension_ && to == GridPrimitive::Vertex) {
         // The given cell index is also the index of its lower-left-front corner vertex
         // Let's compute the linear index for this vertex
-        ind lowerLeftFrontVertexLinearIndex = cellIndex[0];
-        for (ind dim(1); dim < numDimensions; dim++) {
-            lowerLeftFrontVertexLinearIndex += cellIndex[dim] * vStrides[dim];
+        ind idxRemainder = idxLin;
+        ind lowerLeftFrontVertexLinearIndex = 0;
+        for (ind dim(0); dim < numDimensions; dim++) {
+            lowerLeftFrontVertexLinearIndex +=
+                (idxRemainder % numCellsPerDimension_[dim]) * vertexStrides_[dim];
+            idxRemainder /= numCellsPerDimension_[dim];
         }
 
-        result[0] = lowerLeftFrontVertexLinearIndex;
-        for (ind i(1); i < numCorners; i++) {
+        result.resize(numCorners);
+        for (ind i(0); i < numCorners; i++) {
             // Base is the lower-left-front corner.
             result[i] = lowerLeftFrontVertexLinearIndex;
 
             // Add strides to the lower-left-front corner.
             for (ind d(0); d < numDimensions; d++) {
-                if (i & (ind(1) << d)) result[i] += vStrides[d];
+                if (i & (ind(1) << d)) result[i] += vertexStrides_[d];
             }
         }
         return;
     }
 
     if (from == GridPrimitive::Vertex && to == gridDimension_) {
-        // Compute dimensions for vertices
-        std::vector<ind> vertDims;
-        for (ind dim : numCellsPerDimension_) {
-            vertDims.push_back(dim + 1);
-        }
-
-        const ind numDimensions = vertDims.size();
-
-        // Linear Index to nD Vertex Index.
-        std::vector<ind> vertexIndex = indexFromLinear(idxLin, vertDims);
-
-        // Prepare neighbors
-        const ind maxNeighbors = ind(1) << numDimensions;
-        result.reserve(maxNeighbors);
-
-        // Compute neighbors
-        std::vector<ind> currentNeighbor;
-        for (ind i(0); i < maxNeighbors; i++) {
+        // Compute neighbors. The nD vertex index is recomputed for each neighbor instead of
+        // storing it in a temporary vector.
+        for (ind i(0); i < numCorners; i++) {
             // Base index is the vertex index.
             // The same cell index is the upper-right one of the neighbors.
-            currentNeighbor = vertexIndex;
-
-            // Generate new neighbor index
-            for (ind d(0); d < numDimensions; d++) {
-                if (i & (ind(1) << d)) currentNeighbor[d]--;
-            }
-
-            // Is it in the allowed range? And compute linear index while checking.
             bool bOk(true);
+            ind idxRemainder = idxLin;
             ind currentNeighborLinearIndex(0);
             ind dimensionProduct(1);
             for (ind d(0); bOk && d < numDimensions; d++) {
-                if (currentNeighbor[d] < 0 || currentNeighbor[d] >= numCellsPerDimension_[d]) {
+                ind currentNeighbor = idxRemainder % numVerticesPerDimension_[d];
+                idxRemainder /= numVerticesPerDimension_[d];
+                if (i & (ind(1) << d)) currentNeighbor--;
+
+                // Is it in the allowed range? And compute linear index while checking.
+                if (currentNeighbor < 0 || currentNeighbor >= numCellsPerDimension_[d]) {
                     bOk = false;
                 }
 
-                currentNeighborLinearIndex += currentNeighbor[d] * dimensionProduct;
+                currentNeighborLinearIndex += currentNeighbor * dimensionProduct;
                 dimensionProduct *= numCellsPerDimension_[d];
             }
 
@@ -0,0 +1,182 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <modules/discretedata/connectivity/structuredgrid.h>
+#include <modules/discretedata/connectivity/elementiterator.h>
+#include <modules/discretedata/connectivity/connectioniterator.h>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <type_traits>
+#include <vector>
+
+using namespace inviwo::discretedata;
+
+namespace {
+
+// Side length of the grid in cells, the same in all dimensions.
+template <ind N>
+std::array<ind, N> gridSize(const benchmark::State& state) {
+    std::array<ind, N> size;
+    size.fill(static_cast<ind>(state.range(0)));
+    return size;
+}
+
+template <ind N>
+void setCounters(benchmark::State& state, const Connectivity& grid) {
+    state.SetItemsProcessed(state.iterations() *
+                            grid.getNumElements(static_cast<GridPrimitive>(N)));
+}
+
+// Cell to vertex through ElementIterator and ConnectionRange.
+template <ind N>
+void CellVerticesIterator(benchmark::State& state) {
+    const auto size = gridSize<N>(state);
+    const StructuredGrid grid(static_cast<GridPrimitive>(N),
+                              std::vector<ind>(size.begin(), size.end()));
+    for (auto _ : state) {
+        ind sum = 0;
+        for (ElementIterator cell : grid.all(static_cast<GridPrimitive>(N))) {
+            for (ElementIterator vert : cell.connection(GridPrimitive::Vertex)) {
+                sum += vert.getIndex();
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    setCounters<N>(state, grid);
+}
+
+// Cell to vertex with getConnections and a reused result vector.
+template <typename Grid, ind N>
+void CellVerticesConnections(benchmark::State& state) {
+    const auto size = gridSize<N>(state);
+    const Grid grid = [&]() {
+        if constexpr (std::is_same_v<Grid, StructuredGrid>) {
+            return Grid(static_cast<GridPrimitive>(N), std::vector<ind>(size.begin(), size.end()));
+        } else {
+            return Grid(size);
+        }
+    }();
+    const auto numCells = grid.getNumElements(static_cast<GridPrimitive>(N));
+    std::vector<ind> corners;
+    for (auto _ : state) {
+        ind sum = 0;
+        for (ind cell = 0; cell < numCells; ++cell) {
+            grid.getConnections(corners, cell, static_cast<GridPrimitive>(N),
+                                GridPrimitive::Vertex);
+            for (auto v : corners) sum += v;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    setCounters<N>(state, grid);
+}
+
+// Cell to vertex with the corners returned on the stack.
+template <ind N>
+void CellVerticesArray(benchmark::State& state) {
+    const StructuredGridN<N> grid(gridSize<N>(state));
+    const auto numCells = grid.getNumElements(static_cast<GridPrimitive>(N));
+    for (auto _ : state) {
+        ind sum = 0;
+        for (ind cell = 0; cell < numCells; ++cell) {
+            for (auto v : grid.getCellVertices(cell)) sum += v;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    setCounters<N>(state, grid);
+}
+
+// Cell to vertex with the incremental traversal.
+template <ind N>
+void CellVerticesForEach(benchmark::State& state) {
+    const StructuredGridN<N> grid(gridSize<N>(state));
+    for (auto _ : state) {
+        ind sum = 0;
+        grid.forEachCell([&](ind, const auto& corners) {
+            for (auto v : corners) sum += v;
+        });
+        benchmark::DoNotOptimize(sum);
+    }
+    setCounters<N>(state, grid);
+}
+
+// Vertex to cell with getConnections and a reused result vector.
+template <typename Grid, ind N>
+void VertexCells(benchmark::State& state) {
+    const auto size = gridSize<N>(state);
+    const Grid grid = [&]() {
+        if constexpr (std::is_same_v<Grid, StructuredGrid>) {
+            return Grid(static_cast<GridPrimitive>(N), std::vector<ind>(size.begin(), size.end()));
+        } else {
+            return Grid(size);
+        }
+    }();
+    const auto numVerts = grid.getNumElements(GridPrimitive::Vertex);
+    std::vector<ind> cells;
+    for (auto _ : state) {
+        ind sum = 0;
+        for (ind vertex = 0; vertex < numVerts; ++vertex) {
+            cells.clear();
+            grid.getConnections(cells, vertex, GridPrimitive::Vertex,
+                                static_cast<GridPrimitive>(N));
+            for (auto c : cells) sum += c;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numVerts);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(CellVerticesIterator, 2)->Arg(1024);
+BENCHMARK_TEMPLATE(CellVerticesConnections, StructuredGrid, 2)->Arg(1024);
+BENCHMARK_TEMPLATE(CellVerticesConnections, StructuredGrid2D, 2)->Arg(1024);
+BENCHMARK_TEMPLATE(CellVerticesArray, 2)->Arg(1024);
+BENCHMARK_TEMPLATE(CellVerticesForEach, 2)->Arg(1024);
+BENCHMARK_TEMPLATE(VertexCells, StructuredGrid, 2)->Arg(1024);
+BENCHMARK_TEMPLATE(VertexCells, StructuredGrid2D, 2)->Arg(1024);
+
+BENCHMARK_TEMPLATE(CellVerticesIterator, 3)->Arg(128);
+BENCHMARK_TEMPLATE(CellVerticesConnections, StructuredGrid, 3)->Arg(128);
+BENCHMARK_TEMPLATE(CellVerticesConnections, StructuredGrid3D, 3)->Arg(128);
+BENCHMARK_TEMPLATE(CellVerticesArray, 3)->Arg(128);
+BENCHMARK_TEMPLATE(CellVerticesForEach, 3)->Arg(128);
+BENCHMARK_TEMPLATE(VertexCells, StructuredGrid, 3)->Arg(128);
+BENCHMARK_TEMPLATE(VertexCells, StructuredGrid3D, 3)->Arg(128);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
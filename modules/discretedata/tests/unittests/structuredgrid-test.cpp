@@ -0,0 +1,150 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/discretedata/connectivity/structuredgrid.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace inviwo {
+namespace discretedata {
+
+namespace {
+
+// Corners of a cell computed from its nD index, independent of the grid implementation.
+template <ind N>
+std::vector<ind> referenceCorners(const std::array<ind, N>& cells, ind cell) {
+    std::array<ind, N> index;
+    for (ind d = 0; d < N; ++d) {
+        index[d] = cell % cells[d];
+        cell /= cells[d];
+    }
+    std::vector<ind> corners;
+    for (ind i = 0; i < (ind{1} << N); ++i) {
+        ind vertex = 0;
+        ind stride = 1;
+        for (ind d = 0; d < N; ++d) {
+            vertex += (index[d] + ((i >> d) & 1)) * stride;
+            stride *= cells[d] + 1;
+        }
+        corners.push_back(vertex);
+    }
+    return corners;
+}
+
+template <ind N>
+void testConnections(const std::array<ind, N>& cells) {
+    const auto cellPrimitive = static_cast<GridPrimitive>(N);
+    const StructuredGridN<N> fixed(cells);
+    const StructuredGrid dynamic(cellPrimitive, std::vector<ind>(cells.begin(), cells.end()));
+
+    ASSERT_EQ(dynamic.getNumElements(cellPrimitive), fixed.getNumElements(cellPrimitive));
+    ASSERT_EQ(dynamic.getNumElements(GridPrimitive::Vertex),
+              fixed.getNumElements(GridPrimitive::Vertex));
+
+    std::vector<ind> a;
+    std::vector<ind> b;
+    const auto compare = [&](ind index, GridPrimitive from, GridPrimitive to) {
+        a.clear();
+        b.clear();
+        fixed.getConnections(a, index, from, to);
+        dynamic.getConnections(b, index, from, to);
+        EXPECT_EQ(a, b) << "index " << index;
+        return a;
+    };
+
+    for (ind cell = 0; cell < fixed.getNumElements(cellPrimitive); ++cell) {
+        const auto corners = compare(cell, cellPrimitive, GridPrimitive::Vertex);
+        EXPECT_EQ(referenceCorners<N>(cells, cell), corners);
+        const auto array = fixed.getCellVertices(cell);
+        EXPECT_TRUE(std::equal(array.begin(), array.end(), corners.begin(), corners.end()));
+
+        compare(cell, cellPrimitive, cellPrimitive);
+
+        // Every corner has to list the cell among its cells.
+        for (auto vertex : corners) {
+            const auto vertexCells = compare(vertex, GridPrimitive::Vertex, cellPrimitive);
+            EXPECT_NE(std::find(vertexCells.begin(), vertexCells.end(), cell),
+                      vertexCells.end());
+        }
+    }
+    for (ind vertex = 0; vertex < fixed.getNumElements(GridPrimitive::Vertex); ++vertex) {
+        compare(vertex, GridPrimitive::Vertex, GridPrimitive::Vertex);
+        compare(vertex, GridPrimitive::Vertex, cellPrimitive);
+    }
+}
+
+template <ind N>
+void testForEachCell(const std::array<ind, N>& cells) {
+    const StructuredGridN<N> grid(cells);
+    const auto numCells = grid.getNumElements(static_cast<GridPrimitive>(N));
+
+    ind expected = 0;
+    grid.forEachCell([&](ind cell, const auto& corners) {
+        EXPECT_EQ(expected++, cell);
+        EXPECT_EQ(grid.getCellVertices(cell), corners);
+    });
+    EXPECT_EQ(numCells, expected);
+
+    // Ranges starting in the middle of a row.
+    for (ind begin : {ind{1}, numCells / 3, numCells - 1}) {
+        expected = begin;
+        grid.forEachCell(begin, numCells, [&](ind cell, const auto& corners) {
+            EXPECT_EQ(expected++, cell);
+            EXPECT_EQ(grid.getCellVertices(cell), corners);
+        });
+        EXPECT_EQ(numCells, expected);
+    }
+}
+
+}  // namespace
+
+TEST(StructuredGrid, Connections1D) { testConnections<1>({7}); }
+TEST(StructuredGrid, Connections2D) { testConnections<2>({4, 5}); }
+TEST(StructuredGrid, Connections3D) { testConnections<3>({3, 4, 5}); }
+TEST(StructuredGrid, Connections4D) { testConnections<4>({2, 3, 2, 3}); }
+
+TEST(StructuredGrid, ForEachCell2D) { testForEachCell<2>({5, 7}); }
+TEST(StructuredGrid, ForEachCell3D) { testForEachCell<3>({4, 3, 5}); }
+
+TEST(StructuredGrid, Index) {
+    const StructuredGrid3D grid({3, 4, 5});
+    EXPECT_EQ((StructuredGrid3D::Index{2, 1, 3}), grid.cellIndex(2 + 3 * (1 + 4 * 3)));
+    EXPECT_EQ((StructuredGrid3D::Index{3, 1, 2}), grid.vertexIndex(3 + 4 * (1 + 5 * 2)));
+    EXPECT_EQ(1 + 4 * (2 + 5 * 3), grid.lowerCorner(1 + 3 * (2 + 4 * 3)));
+}
+
+}  // namespace discretedata
+}  // namespace inviwo
@@ -0,0 +1,135 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/hdf5/hdf5moduledefine.h>
+#include <modules/hdf5/datastructures/hdf5handle.h>
+#include <inviwo/core/datastructures/diskrepresentation.h>
+#include <inviwo/core/datastructures/volume/volumerepresentation.h>
+#include <inviwo/core/datastructures/volume/volumeregionloader.h>
+#include <inviwo/core/util/glmvec.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <H5Cpp.h>
+#include <warn/pop>
+
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+namespace hdf5 {
+
+namespace detail {
+
+/**
+ * Block boundaries along one axis of a selection, in selected elements. The selected elements
+ * in [begin, end) are at start + i * stride in the dataset, and a new block starts whenever they
+ * cross a chunk boundary of the dataset. The result starts with begin and ends with end.
+ */
+IVW_MODULE_HDF5_API std::vector<size_t> blockBounds(size_t begin, size_t end, hsize_t start,
+                                                    hsize_t stride, hsize_t chunk);
+
+}  // namespace detail
+
+/**
+ * \brief Loads a hyperslab of a HDF5 dataset into a VolumeRAM on demand.
+ *
+ * The loader only stores the file name, the dataset path, and the selection. No data is read
+ * until a VolumeRAM is requested from the VolumeDisk. The selection is then read in blocks that
+ * are aligned to the chunks of the dataset, hence each chunk is read and decompressed once, and
+ * the blocks are copied into the volume in parallel. All calls into HDF5 hold libraryMutex().
+ *
+ * The loader implements VolumeRegionLoader, hence a large dataset can be accessed as a
+ * VolumeBricked that only reads the bricks that are used.
+ */
+class IVW_MODULE_HDF5_API VolumeLoader : public DiskRepresentationLoader<VolumeRepresentation>,
+                                         public VolumeRegionLoader {
+public:
+    /**
+     * @param dataset the dataset to read from, the file name and path are taken from it.
+     * @param selection one selection per dimension of the dataset in HDF5 (row major) order, i.e.
+     * the last one is the fastest changing. At most three of them may select more than one element.
+     * @throw Exception if the selection does not match the dataset.
+     */
+    VolumeLoader(const H5::DataSet& dataset, std::vector<Handle::Selection> selection);
+    virtual VolumeLoader* clone() const override;
+    virtual ~VolumeLoader() = default;
+
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
+        const VolumeRepresentation& src) const override;
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
+                                      const VolumeRepresentation& src) const override;
+    virtual std::shared_ptr<VolumeRAM> loadRegion(const VolumeRepresentation& src, size3_t offset,
+                                                  size3_t extent) const override;
+
+    /**
+     * Dimensions of the selected volume in Inviwo (column major) order.
+     */
+    size3_t getDimensions() const;
+
+    /**
+     * Estimate the data range from at most maxSamples voxels of the selection, picked on a regular
+     * grid. Values that are not sampled might fall outside of the returned range.
+     */
+    dvec2 sampleDataRange(const H5::DataSet& dataset, const DataFormatBase* format,
+                          size_t maxSamples = size_t{1} << 18) const;
+
+    /**
+     * Look for a data range in the attributes of the dataset, "actual_range" and "valid_range"
+     * with two values, or pairs of "actual_min"/"actual_max", "valid_min"/"valid_max", and
+     * "min"/"max".
+     */
+    static std::optional<dvec2> getDataRangeFromAttributes(const H5::DataSet& dataset);
+
+private:
+    void read(void* dest, const DataFormatBase* format, size3_t offset, size3_t extent) const;
+
+    std::string filename_;
+    std::string path_;
+    std::vector<hsize_t> start_;
+    std::vector<hsize_t> stride_;
+    std::vector<hsize_t> chunk_;  //!< empty for datasets that are not chunked
+    /**
+     * The volume is stored in row major order as well, memory axis 2 is x. For each memory axis
+     * the selected dimension of the dataset, or -1 if the axis has size one.
+     */
+    std::array<int, 3> axes_;
+    size3_t counts_;  //!< size of each memory axis
+};
+
+}  // namespace hdf5
+
+}  // namespace inviwo
@@ -31,11 +31,11 @@
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/formatdispatching.h>
 #include <inviwo/core/util/raiiutils.h>
-#include <inviwo/core/datastructures/volume/volumeramprecision.h>
-
-#include <modules/base/algorithm/dataminmax.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <modules/hdf5/datastructures/hdf5volumeloader.h>
 
 #include <algorithm>
+#include <mutex>
 
 namespace inviwo {
 
@@ -126,23 +126,11 @@ std::shared_ptr<Volume> Handle::getVolumeAtPathAsType(const Path& path,
                                                       std::vector<Selection> selection,
                                                       const DataFormatBase* type) const {
 
+    std::scoped_lock lock{libraryMutex()};
+
     auto dataset = data_.openDataSet(path);
     ::inviwo::util::OnScopeExit closedataset{[&]() { dataset.close(); }};
 
-    const H5::DataSpace dataSpace = dataset.getSpace();
-    const size_t rank = dataSpace.getSimpleExtentNdims();
-    if (selection.size() != rank) {
-        throw Exception("Selection not of the same rank as the data", IVW_CONTEXT);
-    }
-
-    std::vector<hsize_t> dataDimensions(rank);
-    dataSpace.getSimpleExtentDims(dataDimensions.data());
-    const hsize_t dataSize = dataSpace.getSelectNpoints();
-
-    std::vector<hsize_t> start(rank);
-    std::vector<hsize_t> count(rank);
-    std::vector<hsize_t> stride(rank);
-
     /*
      * Column major, i.e. the FIRST listed dimension is the fasted changing
      * Inviwo, OpenGL, matlab, Fortran
@@ -155,70 +143,26 @@ std::shared_ptr<Volume> Handle::getVolumeAtPathAsType(const Path& path,
      */
     std::reverse(selection.begin(), selection.end());
 
-    size3_t volumeDimensions(1);
-    int resRank = 0;
-    std::vector<hsize_t> memoryDimensions{1, 1, 1};
-
-    for (size_t i = 0; i < rank; ++i) {
-        start[i] = selection[i].start;
-        count[i] =
-            static_cast<hsize_t>((selection[i].end - selection[i].start) / selection[i].stride);
-        stride[i] = selection[i].stride;
-
-        if (count[i] > 1) {
-            if (resRank > 2) throw Exception("Invalid selection, resulting rank > 3", IVW_CONTEXT);
-            memoryDimensions[resRank] = count[i];
-            volumeDimensions[resRank] = count[i];
-            resRank++;
-        }
-    }
-
-    dataSpace.selectHyperslab(H5S_SELECT_SET, count.data(), start.data(), stride.data(), nullptr);
-
-    H5::DataSpace memorySpace(3, memoryDimensions.data());
-    memorySpace.selectAll();
-
-    hsize_t selectionSize = memorySpace.getSelectNpoints();
-
-    LogInfo("Data rank: " << rank << " dims " << joinString(dataDimensions, " x ") << " size "
-                          << dataSize << " selection " << dataSpace.getSelectNpoints()
-                          << " memory size " << memorySpace.getSelectNpoints() << " memory dim "
-                          << volumeDimensions);
-
+    // Nothing is read here, the loader reads the selection once a VolumeRAM is requested.
+    auto loader = std::make_unique<VolumeLoader>(dataset, std::move(selection));
+    const auto volumeDimensions = loader->getDimensions();
     const DataFormatBase* format = type ? type : util::getDataFormatFromDataSet(dataset);
 
-    // Reverse back the Column major
-    std::reverse(&volumeDimensions[0], &volumeDimensions[0] + volumeDimensions.length());
-    auto volumeram = createVolumeRAM(volumeDimensions, format);
-
-    auto minmax = volumeram->dispatch<std::pair<dvec4, dvec4>, dispatching::filter::Scalars>(
-        [&](auto vrprecision) {
-            using ValueType = ::inviwo::util::PrecisionValueType<decltype(vrprecision)>;
+    const auto attributeRange = VolumeLoader::getDataRangeFromAttributes(dataset);
+    const auto dataRange =
+        attributeRange ? *attributeRange : loader->sampleDataRange(dataset, format);
 
-            ValueType* data = vrprecision->getDataTyped();
+    LogInfo("HDF volume type: " << format->getString() << " dimensions " << volumeDimensions
+                                << (attributeRange ? " data range: " : " sampled data range: ")
+                                << dataRange << " file: " << dataset.getFileName());
 
-            try {
-                dataset.read(data, TypeMap<ValueType>::getType(), memorySpace, dataSpace);
-            } catch (H5::DataSetIException& e) {
-                throw Exception("HDF: unable to read data: " + e.getDetailMsg(), IVW_CONTEXT);
-            }
+    auto disk = std::make_shared<VolumeDisk>(dataset.getFileName(), volumeDimensions, format);
+    disk->setLoader(loader.release());
 
-            auto res = ::inviwo::util::dataMinMax(data, selectionSize);
-
-            LogInfo("Read HDF volume type: " << DataFormat<ValueType>::str()
-                                             << " data range: " << res.first << ", " << res.second
-                                             << " file: " << dataset.getFileName());
-
-            return res;
-        });
-
-    auto volume = std::make_shared<Volume>(volumeDimensions, format);
-    volume->dataMap_.dataRange.x = glm::compMin(minmax.first);
-    volume->dataMap_.dataRange.y = glm::compMax(minmax.second);
+    auto volume = std::make_shared<Volume>(disk);
+    volume->dataMap_.dataRange = dataRange;
     volume->dataMap_.valueRange = volume->dataMap_.dataRange;
 
-    volume->addRepresentation(volumeram);
-
     return volume;
 }
 
@@ -0,0 +1,317 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/hdf5/datastructures/hdf5volumeloader.h>
+#include <modules/hdf5/hdf5types.h>
+#include <modules/hdf5/hdf5utils.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/parallel.h>
+#include <inviwo/core/util/raiiutils.h>
+
+#include <modules/base/algorithm/dataminmax.h>
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <mutex>
+#include <utility>
+
+namespace inviwo {
+
+namespace hdf5 {
+
+namespace {
+
+struct MemoryType {
+    template <typename Result, typename Format>
+    H5::PredType operator()() {
+        return TypeMap<typename Format::type>::getType();
+    }
+};
+
+H5::PredType memoryType(const DataFormatBase* format) {
+    return dispatching::dispatch<H5::PredType, dispatching::filter::Scalars>(format->getId(),
+                                                                             MemoryType{});
+}
+
+template <typename F>
+void withLibrary(F&& f) {
+    std::scoped_lock lock{libraryMutex()};
+    try {
+        f();
+    } catch (const H5::Exception& e) {
+        throw Exception("HDF: unable to read data: " + e.getDetailMsg(),
+                        IVW_CONTEXT_CUSTOM("hdf5::VolumeLoader"));
+    }
+}
+
+}  // namespace
+
+std::vector<size_t> detail::blockBounds(size_t begin, size_t end, hsize_t start, hsize_t stride,
+                                        hsize_t chunk) {
+    std::vector<size_t> bounds{begin};
+    for (size_t i = begin + 1; i < end; ++i) {
+        if ((start + i * stride) / chunk != (start + (i - 1) * stride) / chunk) {
+            bounds.push_back(i);
+        }
+    }
+    bounds.push_back(end);
+    return bounds;
+}
+
+VolumeLoader::VolumeLoader(const H5::DataSet& dataset, std::vector<Handle::Selection> selection)
+    : axes_{-1, -1, -1}, counts_{1} {
+    std::scoped_lock lock{libraryMutex()};
+
+    filename_ = dataset.getFileName();
+    path_ = dataset.getObjName();
+
+    const auto rank = static_cast<size_t>(dataset.getSpace().getSimpleExtentNdims());
+    if (selection.size() != rank) {
+        throw Exception("Selection not of the same rank as the data", IVW_CONTEXT);
+    }
+
+    size_t resRank = 0;
+    for (size_t i = 0; i < rank; ++i) {
+        start_.push_back(selection[i].start);
+        stride_.push_back(selection[i].stride);
+        const auto count = (selection[i].end - selection[i].start) / selection[i].stride;
+        if (count > 1) {
+            if (resRank > 2) throw Exception("Invalid selection, resulting rank > 3", IVW_CONTEXT);
+            axes_[resRank] = static_cast<int>(i);
+            counts_[resRank] = count;
+            ++resRank;
+        }
+    }
+
+    const auto plist = dataset.getCreatePlist();
+    if (plist.getLayout() == H5D_CHUNKED) {
+        chunk_.resize(rank);
+        plist.getChunk(static_cast<int>(rank), chunk_.data());
+    }
+}
+
+VolumeLoader* VolumeLoader::clone() const { return new VolumeLoader(*this); }
+
+size3_t VolumeLoader::getDimensions() const { return {counts_[2], counts_[1], counts_[0]}; }
+
+std::shared_ptr<VolumeRepresentation> VolumeLoader::createRepresentation(
+    const VolumeRepresentation& src) const {
+    if (src.getDimensions() != getDimensions()) {
+        throw Exception("The dimensions do not match the selection", IVW_CONTEXT);
+    }
+    auto volumeRAM = createVolumeRAM(src.getDimensions(), src.getDataFormat(), nullptr,
+                                     src.getSwizzleMask(), src.getInterpolation(),
+                                     src.getWrapping());
+    read(volumeRAM->getData(), src.getDataFormat(), size3_t{0}, counts_);
+    return volumeRAM;
+}
+
+void VolumeLoader::updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
+                                        const VolumeRepresentation& src) const {
+    if (src.getDimensions() != getDimensions()) {
+        throw Exception("The dimensions do not match the selection", IVW_CONTEXT);
+    }
+    auto volumeDst = std::static_pointer_cast<VolumeRAM>(dest);
+    if (src.getDimensions() != volumeDst->getDimensions()) {
+        volumeDst->setDimensions(src.getDimensions());
+    }
+    read(volumeDst->getData(), src.getDataFormat(), size3_t{0}, counts_);
+
+    volumeDst->setSwizzleMask(src.getSwizzleMask());
+    volumeDst->setInterpolation(src.getInterpolation());
+    volumeDst->setWrapping(src.getWrapping());
+}
+
+std::shared_ptr<VolumeRAM> VolumeLoader::loadRegion(const VolumeRepresentation& src,
+                                                    size3_t offset, size3_t extent) const {
+    auto region = createVolumeRAM(extent, src.getDataFormat(), nullptr, src.getSwizzleMask(),
+                                  src.getInterpolation(), src.getWrapping());
+    // Inviwo is column major, HDF5 row major
+    read(region->getData(), src.getDataFormat(), size3_t{offset.z, offset.y, offset.x},
+         size3_t{extent.z, extent.y, extent.x});
+    return region;
+}
+
+void VolumeLoader::read(void* dest, const DataFormatBase* format, size3_t offset,
+                        size3_t extent) const {
+    if (glm::compMul(extent) == 0) return;
+    const auto elementSize = format->getSize();
+
+    // Chunked datasets are read in blocks of whole chunks along the two slowest axes and of the
+    // full extent along the fastest axis, hence every chunk is decompressed once. Contiguous
+    // datasets are read in slabs of about 16 MB.
+    std::vector<size_t> b0;
+    std::vector<size_t> b1;
+    if (!chunk_.empty()) {
+        const auto axisBounds = [&](size_t j) -> std::vector<size_t> {
+            if (axes_[j] < 0) return {offset[j], offset[j] + extent[j]};
+            const auto d = static_cast<size_t>(axes_[j]);
+            return detail::blockBounds(offset[j], offset[j] + extent[j], start_[d], stride_[d],
+                                       chunk_[d]);
+        };
+        b0 = axisBounds(0);
+        b1 = axisBounds(1);
+    } else {
+        const auto slabSize = std::max(size_t{1}, (size_t{16} << 20) /
+                                                      (extent[1] * extent[2] * elementSize));
+        for (size_t i = offset[0]; i < offset[0] + extent[0]; i += slabSize) b0.push_back(i);
+        b0.push_back(offset[0] + extent[0]);
+        b1 = {offset[1], offset[1] + extent[1]};
+    }
+
+    std::optional<H5::H5File> file;
+    std::optional<H5::DataSet> dataset;
+    std::optional<H5::PredType> type;
+    ::inviwo::util::OnScopeExit close{[&]() {
+        std::scoped_lock lock{libraryMutex()};
+        type.reset();
+        dataset.reset();
+        file.reset();
+    }};
+    withLibrary([&]() {
+        file.emplace(filename_, H5F_ACC_RDONLY);
+        dataset.emplace(file->openDataSet(path_));
+        type.emplace(memoryType(format));
+    });
+
+    const auto readBlock = [&](size3_t blockOffset, size3_t blockExtent, void* data) {
+        std::vector<hsize_t> start{start_};
+        std::vector<hsize_t> count(start_.size(), 1);
+        for (size_t j = 0; j < 3; ++j) {
+            if (axes_[j] < 0) continue;
+            const auto d = static_cast<size_t>(axes_[j]);
+            start[d] += blockOffset[j] * stride_[d];
+            count[d] = blockExtent[j];
+        }
+        withLibrary([&]() {
+            auto fileSpace = dataset->getSpace();
+            fileSpace.selectHyperslab(H5S_SELECT_SET, count.data(), start.data(), stride_.data());
+            const hsize_t size = glm::compMul(blockExtent);
+            H5::DataSpace memorySpace(1, &size);
+            dataset->read(data, *type, memorySpace, fileSpace);
+        });
+    };
+
+    // HDF5 has to be called serially, copying the blocks into place can be done in parallel with
+    // reading the next ones. Blocks that span the two fastest axes are read in place.
+    const auto dst = static_cast<char*>(dest);
+    const auto rowSize = extent[2] * elementSize;
+    const auto n1 = b1.size() - 1;
+    ::inviwo::util::parallelFor(size_t{0}, (b0.size() - 1) * n1, [&](size_t block) {
+        const size3_t blockOffset{b0[block / n1], b1[block % n1], offset[2]};
+        const size3_t blockExtent{b0[block / n1 + 1] - blockOffset[0],
+                                  b1[block % n1 + 1] - blockOffset[1], extent[2]};
+        const auto firstRow =
+            (blockOffset[0] - offset[0]) * extent[1] + (blockOffset[1] - offset[1]);
+
+        if (n1 == 1) {
+            readBlock(blockOffset, blockExtent, dst + firstRow * rowSize);
+            return;
+        }
+
+        std::vector<char> buffer(glm::compMul(blockExtent) * elementSize);
+        readBlock(blockOffset, blockExtent, buffer.data());
+        for (size_t i = 0; i < blockExtent[0]; ++i) {
+            std::memcpy(dst + (firstRow + i * extent[1]) * rowSize,
+                        buffer.data() + i * blockExtent[1] * rowSize, blockExtent[1] * rowSize);
+        }
+    }, 1);
+}
+
+dvec2 VolumeLoader::sampleDataRange(const H5::DataSet& dataset, const DataFormatBase* format,
+                                    size_t maxSamples) const {
+    const auto samples = [&](size_t step) { return (counts_ + size3_t{step - 1}) / step; };
+    size_t step = 1;
+    while (glm::compMul(samples(step)) > std::max(size_t{1}, maxSamples)) ++step;
+    const auto sampleCounts = samples(step);
+
+    std::vector<hsize_t> count(start_.size(), 1);
+    std::vector<hsize_t> stride{stride_};
+    for (size_t j = 0; j < 3; ++j) {
+        if (axes_[j] < 0) continue;
+        const auto d = static_cast<size_t>(axes_[j]);
+        count[d] = sampleCounts[j];
+        stride[d] *= step;
+    }
+
+    auto volumeRAM = createVolumeRAM(size3_t{sampleCounts[2], sampleCounts[1], sampleCounts[0]},
+                                     format, nullptr);
+    withLibrary([&]() {
+        auto fileSpace = dataset.getSpace();
+        fileSpace.selectHyperslab(H5S_SELECT_SET, count.data(), start_.data(), stride.data());
+        const hsize_t size = glm::compMul(sampleCounts);
+        H5::DataSpace memorySpace(1, &size);
+        dataset.read(volumeRAM->getData(), memoryType(format), memorySpace, fileSpace);
+    });
+
+    const auto minmax = volumeRAM->dispatch<std::pair<dvec4, dvec4>, dispatching::filter::Scalars>(
+        [](auto vrprecision) {
+            return ::inviwo::util::dataMinMax(vrprecision->getDataTyped(),
+                                              glm::compMul(vrprecision->getDimensions()));
+        });
+    return {glm::compMin(minmax.first), glm::compMax(minmax.second)};
+}
+
+std::optional<dvec2> VolumeLoader::getDataRangeFromAttributes(const H5::DataSet& dataset) {
+    std::scoped_lock lock{libraryMutex()};
+
+    const auto readValues = [&](const char* name, size_t size) -> std::vector<double> {
+        if (!dataset.attrExists(name)) return {};
+        const auto attribute = dataset.openAttribute(name);
+        const auto typeClass = attribute.getTypeClass();
+        if (typeClass != H5T_INTEGER && typeClass != H5T_FLOAT) return {};
+        if (static_cast<size_t>(attribute.getSpace().getSimpleExtentNpoints()) != size) return {};
+        std::vector<double> values(size);
+        attribute.read(H5::PredType::NATIVE_DOUBLE, values.data());
+        return values;
+    };
+
+    try {
+        for (auto name : {"actual_range", "valid_range"}) {
+            const auto range = readValues(name, 2);
+            if (!range.empty() && range[0] <= range[1]) return dvec2{range[0], range[1]};
+        }
+        for (const auto& [minName, maxName] : {std::pair{"actual_min", "actual_max"},
+                                               std::pair{"valid_min", "valid_max"},
+                                               std::pair{"min", "max"}}) {
+            const auto min = readValues(minName, 1);
+            const auto max = readValues(maxName, 1);
+            if (!min.empty() && !max.empty() && min[0] <= max[0]) return dvec2{min[0], max[0]};
+        }
+    } catch (const H5::Exception&) {
+        // Attributes we can not read are ignored, the range is sampled instead
+    }
+    return std::nullopt;
+}
+
+}  // namespace hdf5
+
+}  // namespace inviwo
@@ -72,6 +72,11 @@ VolumeInfos getVolumeInfo(const H5::DataSet& ds, const Path& path) {
     return paths;
 }
 
+std::recursive_mutex& libraryMutex() {
+    static std::recursive_mutex mutex;
+    return mutex;
+}
+
 bool isOfType(const H5::Group& grp, const std::string& type) {
     bool result = false;
     try {
@@ -35,6 +35,7 @@
 #include <functional>
 #include <numeric>
 #include <limits>
+#include <mutex>
 
 namespace inviwo {
 
@@ -192,6 +193,7 @@ mat4 HDF5ToVolume::getBasisFromMeta(MetaData meta) {
     mat4 basis(1.0f);
 
     if (inport_.hasData()) {
+        std::scoped_lock lock{libraryMutex()};
         const auto data = inport_.getData();
         H5::DataSet dataset = data->getGroup().openDataSet(meta.path_);
         H5::DataSpace space = dataset.getSpace();
@@ -227,7 +229,10 @@ void HDF5ToVolume::onDataChange() {
     if (inport_.hasData()) {
         const auto data = inport_.getData();
 
-        std::vector<MetaData> metadata = util::getMetaData(data->getGroup());
+        std::vector<MetaData> metadata = [&]() {
+            std::scoped_lock lock{libraryMutex()};
+            return util::getMetaData(data->getGroup());
+        }();
 
         volumeMatches_.clear();
         std::copy_if(metadata.begin(), metadata.end(), std::back_inserter(volumeMatches_),
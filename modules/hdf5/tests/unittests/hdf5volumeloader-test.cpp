@@ -0,0 +1,213 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/hdf5/datastructures/hdf5volumeloader.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+// A 6 x 7 x 9 (z, y, x) float dataset where each value encodes its position, z * 100 + y * 10 + x.
+// The chunks are 4 x 3 x 4, hence the last chunk along each axis is only partially filled.
+struct HDF5File {
+    HDF5File(bool chunked)
+        : path{filesystem::getInviwoUserSettingsPath() + "/hdf5volumeloader-test.h5"} {
+        std::vector<float> data;
+        for (hsize_t z = 0; z < dims[0]; ++z) {
+            for (hsize_t y = 0; y < dims[1]; ++y) {
+                for (hsize_t x = 0; x < dims[2]; ++x) data.push_back(value(x, y, z));
+            }
+        }
+
+        H5::H5File file(path, H5F_ACC_TRUNC);
+        H5::DSetCreatPropList plist;
+        if (chunked) plist.setChunk(3, chunks);
+        auto dataset = file.createDataSet("data", H5::PredType::NATIVE_FLOAT,
+                                          H5::DataSpace(3, dims), plist);
+        dataset.write(data.data(), H5::PredType::NATIVE_FLOAT);
+    }
+    ~HDF5File() { std::remove(path.c_str()); }
+
+    static float value(size_t x, size_t y, size_t z) {
+        return static_cast<float>(z * 100 + y * 10 + x);
+    }
+
+    H5::DataSet open() const { return H5::H5File(path, H5F_ACC_RDONLY).openDataSet("data"); }
+
+    static constexpr hsize_t dims[3] = {6, 7, 9};
+    static constexpr hsize_t chunks[3] = {4, 3, 4};
+    std::string path;
+};
+
+std::vector<hdf5::Handle::Selection> fullSelection() {
+    return {{0, HDF5File::dims[0], 1}, {0, HDF5File::dims[1], 1}, {0, HDF5File::dims[2], 1}};
+}
+
+// z = 0, 2, 4; y = 1, 4; x = 1, 3, 5, 7
+std::vector<hdf5::Handle::Selection> stridedSelection() {
+    return {{0, 6, 2}, {1, 7, 3}, {1, 9, 2}};
+}
+
+template <typename F>
+void expectVoxels(const VolumeRAM& ram, size3_t dims, F expected) {
+    ASSERT_EQ(dims, ram.getDimensions());
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                EXPECT_EQ(expected(x, y, z), ram.getAsDouble(size3_t{x, y, z}))
+                    << "at " << x << ", " << y << ", " << z;
+            }
+        }
+    }
+}
+
+std::shared_ptr<VolumeRAM> readAll(const hdf5::VolumeLoader& loader) {
+    const VolumeDisk disk(loader.getDimensions(), DataFloat32::get());
+    return std::static_pointer_cast<VolumeRAM>(loader.createRepresentation(disk));
+}
+
+dvec2 minMax(const VolumeRAM& ram) {
+    dvec2 range{std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()};
+    const auto dims = ram.getDimensions();
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                const auto v = ram.getAsDouble(size3_t{x, y, z});
+                range = dvec2{std::min(range.x, v), std::max(range.y, v)};
+            }
+        }
+    }
+    return range;
+}
+
+}  // namespace
+
+TEST(HDF5VolumeLoader, BlockBounds) {
+    using hdf5::detail::blockBounds;
+    EXPECT_EQ((std::vector<size_t>{0, 4, 6}), blockBounds(0, 6, 0, 1, 4));
+    EXPECT_EQ((std::vector<size_t>{0, 3, 6, 7}), blockBounds(0, 7, 0, 1, 3));
+    // Elements at 1, 3, 5, 7, 9 in chunks 0, 0, 1, 1, 2
+    EXPECT_EQ((std::vector<size_t>{0, 2, 4, 5}), blockBounds(0, 5, 1, 2, 4));
+    EXPECT_EQ((std::vector<size_t>{2, 4, 5}), blockBounds(2, 5, 1, 2, 4));
+    // A stride larger than the chunks gives one block per element
+    EXPECT_EQ((std::vector<size_t>{0, 1, 2, 3}), blockBounds(0, 3, 0, 5, 4));
+    EXPECT_EQ((std::vector<size_t>{3, 4}), blockBounds(3, 4, 0, 1, 4));
+}
+
+TEST(HDF5VolumeLoader, ReadsFullSelection) {
+    for (bool chunked : {true, false}) {
+        const HDF5File file{chunked};
+        const hdf5::VolumeLoader loader(file.open(), fullSelection());
+        EXPECT_EQ(size3_t(9, 7, 6), loader.getDimensions());
+        expectVoxels(*readAll(loader), size3_t(9, 7, 6), HDF5File::value);
+    }
+}
+
+TEST(HDF5VolumeLoader, ReadsStridedSelection) {
+    for (bool chunked : {true, false}) {
+        const HDF5File file{chunked};
+        const hdf5::VolumeLoader loader(file.open(), stridedSelection());
+        EXPECT_EQ(size3_t(4, 2, 3), loader.getDimensions());
+        expectVoxels(*readAll(loader), size3_t(4, 2, 3), [](size_t x, size_t y, size_t z) {
+            return HDF5File::value(1 + 2 * x, 1 + 3 * y, 2 * z);
+        });
+    }
+}
+
+TEST(HDF5VolumeLoader, ReadsSlice) {
+    const HDF5File file{true};
+    const hdf5::VolumeLoader loader(file.open(), {{5, 6, 1}, {0, 7, 1}, {0, 9, 1}});
+    EXPECT_EQ(size3_t(9, 7, 1), loader.getDimensions());
+    expectVoxels(*readAll(loader), size3_t(9, 7, 1),
+                 [](size_t x, size_t y, size_t) { return HDF5File::value(x, y, 5); });
+}
+
+TEST(HDF5VolumeLoader, LoadsRegionsStraddlingChunks) {
+    const HDF5File file{true};
+    const hdf5::VolumeLoader loader(file.open(), fullSelection());
+    const VolumeDisk disk(loader.getDimensions(), DataFloat32::get());
+
+    // Crosses chunk boundaries along all axes and ends in the partial edge chunks
+    const size3_t offset{2, 1, 3};
+    const size3_t extent{7, 6, 3};
+    expectVoxels(*loader.loadRegion(disk, offset, extent), extent,
+                 [&](size_t x, size_t y, size_t z) {
+                     return HDF5File::value(offset.x + x, offset.y + y, offset.z + z);
+                 });
+
+    // Within a single partial edge chunk
+    expectVoxels(*loader.loadRegion(disk, size3_t{8, 6, 4}, size3_t{1, 1, 2}), size3_t{1, 1, 2},
+                 [](size_t x, size_t y, size_t z) { return HDF5File::value(8 + x, 6 + y, 4 + z); });
+}
+
+TEST(HDF5VolumeLoader, LoadsStridedRegions) {
+    const HDF5File file{true};
+    const hdf5::VolumeLoader loader(file.open(), stridedSelection());
+    const VolumeDisk disk(loader.getDimensions(), DataFloat32::get());
+
+    const size3_t offset{1, 1, 1};
+    const size3_t extent{3, 1, 2};
+    expectVoxels(*loader.loadRegion(disk, offset, extent), extent,
+                 [&](size_t x, size_t y, size_t z) {
+                     return HDF5File::value(1 + 2 * (offset.x + x), 1 + 3 * (offset.y + y),
+                                            2 * (offset.z + z));
+                 });
+}
+
+TEST(HDF5VolumeLoader, SampledDataRangeMatchesFullRead) {
+    const HDF5File file{true};
+    for (const auto& selection : {fullSelection(), stridedSelection()}) {
+        const auto dataset = file.open();
+        const hdf5::VolumeLoader loader(dataset, selection);
+        const auto range = minMax(*readAll(loader));
+
+        // Enough samples to cover every voxel
+        EXPECT_EQ(range, loader.sampleDataRange(dataset, DataFloat32::get()));
+
+        // A few samples on a grid starting at the first voxel stay within the full range
+        const auto sampled = loader.sampleDataRange(dataset, DataFloat32::get(), 8);
+        EXPECT_EQ(range.x, sampled.x);
+        EXPECT_LE(sampled.y, range.y);
+    }
+}
+
+}  // namespace inviwo
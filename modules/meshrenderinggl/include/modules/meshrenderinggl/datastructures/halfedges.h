@@ -36,10 +36,12 @@
 
 #include <inviwo/core/util/transformiterator.h>
 #include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/util/zip.h>
 
 #include <vector>
-#include <unordered_map>
 #include <optional>
+#include <limits>
+#include <stdexcept>
 
 namespace inviwo {
 
@@ -62,6 +64,10 @@ namespace inviwo {
  *     ╱ ▼────e0─────▶ ╲ ╱
  *   v0────────────────v1
  *
+ * The half edges of face f are 3f, 3f+1 and 3f+2. Twins are found by bucketing the half edges
+ * by their start vertex (a counting sort) and searching the sorted bucket of the end vertex.
+ * Hence construction is linear in the number of half edges apart from sorting the small
+ * per vertex buckets, and the search for twins runs in parallel.
  */
 
 class IVW_MODULE_MESHRENDERINGGL_API HalfEdges {
@@ -135,6 +141,11 @@ public:
 private:
     friend EdgeIter;
 
+    void addTriangles(const Mesh::MeshInfo& info, const IndexBuffer& indexBuffer);
+    void linkEdges();
+
+    static constexpr std::uint32_t noEdge = std::numeric_limits<std::uint32_t>::max();
+
     /**
      * \brief A single half edge
      */
@@ -164,38 +175,46 @@ private:
     };
 
     std::vector<HalfEdge> edges_;
-    std::unordered_map<std::uint32_t, std::uint32_t> vertexToEdge_;
-    std::unordered_map<std::uint32_t, std::uint32_t> faceToEdge_;
+    /**
+     * \brief First half edge starting at each vertex, indexed by vertex. noEdge for vertices
+     * that are not part of any face.
+     */
+    std::vector<std::uint32_t> vertexToEdge_;
+    /**
+     * \brief First half edge of each vertex that is part of a face, in vertex order.
+     */
+    std::vector<std::uint32_t> vertexEdges_;
 };
 
 inline auto HalfEdges::faceToEdge(std::uint32_t faceIndex) const -> EdgeIter {
-    return {this, faceToEdge_.at(faceIndex)};
+    if (std::size_t{faceIndex} * 3 >= edges_.size()) {
+        throw std::out_of_range("HalfEdges: face index out of range");
+    }
+    return {this, faceIndex * 3};
 }
 
 inline auto HalfEdges::vertexToEdge(std::uint32_t vertexIndex) const -> EdgeIter {
-    return {this, vertexToEdge_.at(vertexIndex)};
+    const auto edge = vertexToEdge_.at(vertexIndex);
+    if (edge == noEdge) {
+        throw std::out_of_range("HalfEdges: vertex is not part of any face");
+    }
+    return {this, edge};
 }
 
 inline auto HalfEdges::faces() const {
-    const auto transform =
-        [this](
-            const std::unordered_map<std::uint32_t, std::uint32_t>::value_type& item) -> EdgeIter {
-        return {this, item.second};
-    };
+    const auto transform = [this](std::uint32_t edge) -> EdgeIter { return {this, edge}; };
+    const auto edges =
+        util::make_sequence<std::uint32_t>(0, static_cast<std::uint32_t>(edges_.size()), 3);
 
-    return util::as_range(util::makeTransformIterator(transform, faceToEdge_.begin()),
-                          util::makeTransformIterator(transform, faceToEdge_.end()));
+    return util::as_range(util::makeTransformIterator(transform, edges.begin()),
+                          util::makeTransformIterator(transform, edges.end()));
 }
 
 inline auto HalfEdges::vertices() const {
-    const auto transform =
-        [this](
-            const std::unordered_map<std::uint32_t, std::uint32_t>::value_type& item) -> EdgeIter {
-        return {this, item.second};
-    };
+    const auto transform = [this](std::uint32_t edge) -> EdgeIter { return {this, edge}; };
 
-    return util::as_range(util::makeTransformIterator(transform, vertexToEdge_.begin()),
-                          util::makeTransformIterator(transform, vertexToEdge_.end()));
+    return util::as_range(util::makeTransformIterator(transform, vertexEdges_.begin()),
+                          util::makeTransformIterator(transform, vertexEdges_.end()));
 }
 
 inline std::uint32_t HalfEdges::EdgeIter::vertex() const {
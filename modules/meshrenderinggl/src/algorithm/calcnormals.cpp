@@ -33,14 +33,53 @@
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <inviwo/core/datastructures/buffer/bufferram.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/parallel.h>
 
 #include <modules/base/algorithm/meshutils.h>
 
+#include <cmath>
+#include <limits>
+#include <numeric>
+
 namespace inviwo {
 
 namespace meshutil {
 using Mode = CalculateMeshNormalsMode;
 
+namespace {
+
+/**
+ * The weighted normal of the triangle (p, q, r) at the corner p. Returns a zero vector for
+ * degenerated triangles.
+ */
+dvec3 cornerNormal(const dvec3& p, const dvec3& q, const dvec3& r, Mode mode) {
+    const dvec3 a = q - p;
+    const dvec3 b = r - p;
+    const dvec3 n = glm::cross(a, b);
+    const double l = glm::length(n);
+    if (l < std::numeric_limits<float>::epsilon()) {
+        // degenerated triangle
+        return dvec3{0.0};
+    }
+
+    switch (mode) {
+        case Mode::WeightArea:
+            // area = norm of cross product
+            return n;
+        case Mode::WeightAngle:
+            // the angle between the edges at p
+            return n * (std::atan2(l, glm::dot(a, b)) / l);
+        case Mode::WeightNMax:
+            // sin(angle) / (|a| |b|) normalized by the area, sin(angle) = l / (|a| |b|)
+            return n / (glm::dot(a, a) * glm::dot(b, b));
+        case Mode::NoWeighting:
+        default:
+            return n / l;
+    }
+}
+
+}  // namespace
+
 void calculateMeshNormals(Mesh& mesh, CalculateMeshNormalsMode mode) {
     if (mode == Mode::PassThrough) {
         return;
@@ -59,81 +98,56 @@ void calculateMeshNormals(Mesh& mesh, CalculateMeshNormalsMode mode) {
     }
 
     auto vertices = positions->getRepresentation<BufferRAM>();
-    std::vector<vec3> normals(vertices->getSize(), vec3(0.0f));
+    const auto nVertices = vertices->getSize();
 
-    // loop over index buffers
+    // gather the triangles of all index buffers
+    std::vector<glm::u32vec3> triangles;
     for (auto [meshInfo, buffer] : mesh.getIndexBuffers()) {
         if (meshInfo.dt != DrawType::Triangles) continue;
+        triangles.reserve(triangles.size() + buffer->getSize() / 3);
+        meshutil::forEachTriangle(meshInfo, *buffer,
+                                  [&](std::uint32_t i0, std::uint32_t i1, std::uint32_t i2) {
+                                      if (i0 >= nVertices || i1 >= nVertices || i2 >= nVertices) {
+                                          throw Exception(
+                                              "Index buffer refers to missing vertices",
+                                              IVW_CONTEXT_CUSTOM("meshutil::calculateMeshNormals"));
+                                      }
+                                      triangles.emplace_back(i0, i1, i2);
+                                  });
+    }
 
-        vertices->dispatch<void, dispatching::filter::Floats>(
-            [&, mi = meshInfo, buf = buffer](auto ram) {
-                const auto& vert = ram->getDataContainer();
-
-                meshutil::forEachTriangle(mi, *buf, [&](auto i0, auto i1, auto i2) {
-                    const auto v0 = util::glm_convert<dvec3>(vert[i0]);
-                    const auto v1 = util::glm_convert<dvec3>(vert[i1]);
-                    const auto v2 = util::glm_convert<dvec3>(vert[i2]);
-
-                    const dvec3 n = cross(v1 - v0, v2 - v0);
-                    double l = glm::length(n);
-                    if (l < std::numeric_limits<float>::epsilon()) {
-                        // degenerated triangle
-                        return;
-                    }
-                    // weighting factor
-                    double weightA;
-                    double weightB;
-                    double weightC;
-                    switch (mode) {
-                        case Mode::WeightArea:
-                            // area = norm of cross product
-                            weightA = 1;
-                            weightB = 1;
-                            weightC = 1;
-                            break;
-                        case Mode::WeightAngle: {
-                            // based on the angle between the edges
-                            const dvec3 e0 = glm::normalize(v1 - v2);
-                            const dvec3 e1 = glm::normalize(v2 - v0);
-                            const dvec3 e2 = glm::normalize(v1 - v0);
-                            weightA = acos(dot(e1, e2)) / l;
-                            weightB = acos(dot(e0, e2)) / l;
-                            weightC = acos(dot(e0, e1)) / l;
-                            break;
-                        }
-                        case Mode::WeightNMax: {
-                            const auto edge = [](auto a, auto b) {
-                                auto e = a - b;
-                                auto l = glm::length(e);
-                                return std::make_pair(e / l, l);
-                            };
-                            const auto [e0, l0] = edge(v1, v2);
-                            const auto [e1, l1] = edge(v2, v0);
-                            const auto [e2, l2] = edge(v1, v0);
-                            weightA = sin(acos(dot(e1, e2))) / (l * l1 * l2);
-                            weightB = sin(acos(dot(e0, e2))) / (l * l0 * l2);
-                            weightC = sin(acos(dot(e0, e1))) / (l * l0 * l1);
-                            break;
-                        }
-                        case Mode::NoWeighting:
-                        default:
-                            weightA = 1.0 / l;
-                            weightB = 1.0 / l;
-                            weightC = 1.0 / l;
-                    }
-                    // add it to the vertices
-                    normals[i0] += vec3(n * weightA);
-                    normals[i1] += vec3(n * weightB);
-                    normals[i2] += vec3(n * weightC);
-                });
-            });
+    // Bucket the triangle corners (3 * triangle + corner) by vertex. Then every vertex sums up
+    // its own corners, which avoids concurrent writes and keeps the summation order, and hence
+    // the result, independent of the number of threads.
+    std::vector<std::uint32_t> offsets(nVertices + 1, 0);
+    for (const auto& triangle : triangles) {
+        for (int i = 0; i < 3; ++i) ++offsets[triangle[i] + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<std::uint32_t> corners(triangles.size() * 3);
+    {
+        auto pos = offsets;
+        for (std::uint32_t t = 0; t < static_cast<std::uint32_t>(triangles.size()); ++t) {
+            for (std::uint32_t i = 0; i < 3; ++i) corners[pos[triangles[t][i]]++] = 3 * t + i;
+        }
     }
 
-    // normalize normals
-    std::transform(normals.begin(), normals.end(), normals.begin(), [](auto n) {
-        const auto l = glm::length(n);
-        if (l < std::numeric_limits<float>::epsilon()) return n;
-        return n / l;
+    std::vector<vec3> normals(nVertices, vec3(0.0f));
+    vertices->dispatch<void, dispatching::filter::Floats>([&](auto ram) {
+        const auto& vert = ram->getDataContainer();
+        const auto pos = [&](std::uint32_t i) { return util::glm_convert<dvec3>(vert[i]); };
+
+        util::parallelFor(0, nVertices, [&](size_t v) {
+            dvec3 sum{0.0};
+            for (auto c = offsets[v]; c < offsets[v + 1]; ++c) {
+                const auto& triangle = triangles[corners[c] / 3];
+                const auto i = corners[c] % 3;
+                sum += cornerNormal(pos(triangle[i]), pos(triangle[(i + 1) % 3]),
+                                    pos(triangle[(i + 2) % 3]), mode);
+            }
+            const auto l = glm::length(sum);
+            normals[v] = l < std::numeric_limits<float>::epsilon() ? vec3(sum) : vec3(sum / l);
+        });
     });
 
     auto bufferRAM = std::make_shared<BufferRAMPrecision<vec3>>(std::move(normals));
@@ -29,88 +29,85 @@
 
 #include <modules/meshrenderinggl/datastructures/halfedges.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/parallel.h>
 #include <modules/base/algorithm/meshutils.h>
 
-#include <iostream>
+#include <algorithm>
+#include <iterator>
+#include <numeric>
 
 namespace inviwo {
 
 HalfEdges::HalfEdges(Mesh::MeshInfo info, const IndexBuffer& indexBuffer) {
-    // map to fill in the opposite direction
-    // (start_vertex, end_vertex) -> edge_index
-    std::map<std::pair<std::uint32_t, std::uint32_t>, std::uint32_t> edgeMap;
+    addTriangles(info, indexBuffer);
+    linkEdges();
+}
+
+HalfEdges::HalfEdges(const Mesh& mesh) {
+    for (auto [info, indexBuffer] : mesh.getIndexBuffers()) {
+        if (info.dt != DrawType::Triangles) continue;
+        addTriangles(info, *indexBuffer);
+    }
+    linkEdges();
+}
 
-    std::uint32_t face = 0;
+void HalfEdges::addTriangles(const Mesh::MeshInfo& info, const IndexBuffer& indexBuffer) {
+    edges_.reserve(edges_.size() + indexBuffer.getSize());
     meshutil::forEachTriangle(info, indexBuffer,
                               [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
                                   // a-b, b-c, c-a
                                   const auto count = static_cast<std::uint32_t>(edges_.size());
+                                  const auto face = count / 3;
                                   edges_.push_back(HalfEdge{a, face, count + 1, count + 2});
-                                  edgeMap.try_emplace({a, b}, count + 0);
-                                  vertexToEdge_.try_emplace(a, count + 0);
-
                                   edges_.push_back(HalfEdge{b, face, count + 2, count + 0});
-                                  edgeMap.try_emplace({b, c}, count + 1);
-                                  vertexToEdge_.try_emplace(b, count + 1);
-
                                   edges_.push_back(HalfEdge{c, face, count + 0, count + 1});
-                                  edgeMap.try_emplace({c, a}, count + 2);
-                                  vertexToEdge_.try_emplace(c, count + 2);
-
-                                  faceToEdge_.try_emplace(face, count);
-
-                                  ++face;
                               });
+}
 
-    for (auto& edge : edges_) {
-        const auto a = edge.vertex;
-        const auto b = edges_[edge.next].vertex;
-
-        auto it = edgeMap.find(std::pair{b, a});
-        if (it != edgeMap.end()) {
-            edge.twin = it->second;
+void HalfEdges::linkEdges() {
+    const auto nEdges = static_cast<std::uint32_t>(edges_.size());
+    std::size_t nVertices = 0;
+    for (const auto& edge : edges_) nVertices = std::max(nVertices, std::size_t{edge.vertex} + 1);
+
+    // Bucket the half edges by start vertex, offsets[v] is the first slot of the bucket of v.
+    std::vector<std::uint32_t> offsets(nVertices + 1, 0);
+    for (const auto& edge : edges_) ++offsets[edge.vertex + 1];
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    // Each slot holds (end vertex << 32 | edge index), buckets are filled in edge order.
+    std::vector<std::uint64_t> buckets(nEdges);
+    vertexToEdge_.assign(nVertices, noEdge);
+    {
+        auto pos = offsets;
+        for (std::uint32_t i = 0; i < nEdges; ++i) {
+            const auto start = edges_[i].vertex;
+            const auto end = edges_[edges_[i].next].vertex;
+            if (pos[start] == offsets[start]) vertexToEdge_[start] = i;
+            buckets[pos[start]++] = (std::uint64_t{end} << 32) | i;
         }
     }
-}
 
-HalfEdges::HalfEdges(const Mesh& mesh) {
+    vertexEdges_.clear();
+    std::copy_if(vertexToEdge_.begin(), vertexToEdge_.end(), std::back_inserter(vertexEdges_),
+                 [](std::uint32_t edge) { return edge != noEdge; });
 
-    std::map<std::pair<std::uint32_t, std::uint32_t>, std::uint32_t> edgeMap;
-    std::uint32_t face = 0;
+    // Sort each bucket by end vertex, ties stay in edge order
+    util::parallelFor(0, nVertices, [&](std::size_t v) {
+        std::sort(buckets.begin() + offsets[v], buckets.begin() + offsets[v + 1]);
+    });
 
-    for (auto [info, indexBuffer] : mesh.getIndexBuffers()) {
-        if (info.dt != DrawType::Triangles) continue;
-        meshutil::forEachTriangle(info, *indexBuffer,
-                                  [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
-                                      // a-b, b-c, c-a
-                                      const auto count = static_cast<std::uint32_t>(edges_.size());
-                                      edges_.push_back(HalfEdge{a, face, count + 1, count + 2});
-                                      edgeMap.try_emplace({a, b}, count + 0);
-                                      vertexToEdge_.try_emplace(a, count + 0);
-
-                                      edges_.push_back(HalfEdge{b, face, count + 2, count + 0});
-                                      edgeMap.try_emplace({b, c}, count + 1);
-                                      vertexToEdge_.try_emplace(b, count + 1);
-
-                                      edges_.push_back(HalfEdge{c, face, count + 0, count + 1});
-                                      edgeMap.try_emplace({c, a}, count + 2);
-                                      vertexToEdge_.try_emplace(c, count + 2);
-
-                                      faceToEdge_.try_emplace(face, count);
-
-                                      ++face;
-                                  });
-    }
-
-    for (auto& edge : edges_) {
+    // The twin of a->b is the first b->a half edge. Every edge only writes its own twin.
+    util::parallelFor(0, nEdges, [&](std::size_t i) {
+        auto& edge = edges_[i];
         const auto a = edge.vertex;
         const auto b = edges_[edge.next].vertex;
-
-        auto it = edgeMap.find(std::pair{b, a});
-        if (it != edgeMap.end()) {
-            edge.twin = it->second;
+        const auto begin = buckets.begin() + offsets[b];
+        const auto end = buckets.begin() + offsets[b + 1];
+        const auto it = std::lower_bound(begin, end, std::uint64_t{a} << 32);
+        if (it != end && static_cast<std::uint32_t>(*it >> 32) == a) {
+            edge.twin = static_cast<std::uint32_t>(*it);
         }
-    }
+    });
 }
 
 IndexBuffer HalfEdges::createIndexBuffer() const {
@@ -0,0 +1,158 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/settings/systemsettings.h>
+
+#include <modules/meshrenderinggl/datastructures/halfedges.h>
+#include <modules/meshrenderinggl/algorithm/calcnormals.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+static InviwoApplication* app = nullptr;
+
+// A rippled grid of size x size quads, two triangles per quad.
+static std::shared_ptr<Mesh> makeGrid(size_t size) {
+    std::vector<vec3> positions;
+    positions.reserve((size + 1) * (size + 1));
+    for (size_t y = 0; y <= size; ++y) {
+        for (size_t x = 0; x <= size; ++x) {
+            const auto p = vec2{static_cast<float>(x), static_cast<float>(y)} /
+                           static_cast<float>(size);
+            positions.emplace_back(p, 0.1f * std::sin(20.0f * glm::length(p)));
+        }
+    }
+    std::vector<std::uint32_t> indices;
+    indices.reserve(size * size * 6);
+    const auto index = [&](size_t x, size_t y) {
+        return static_cast<std::uint32_t>(y * (size + 1) + x);
+    };
+    for (size_t y = 0; y < size; ++y) {
+        for (size_t x = 0; x < size; ++x) {
+            indices.insert(indices.end(), {index(x, y), index(x + 1, y), index(x, y + 1)});
+            indices.insert(indices.end(),
+                           {index(x + 1, y), index(x + 1, y + 1), index(x, y + 1)});
+        }
+    }
+
+    auto mesh = std::make_shared<Mesh>();
+    mesh->addBuffer(BufferType::PositionAttrib,
+                    std::make_shared<Buffer<vec3>>(
+                        std::make_shared<BufferRAMPrecision<vec3>>(std::move(positions))));
+    mesh->addIndices(Mesh::MeshInfo{DrawType::Triangles, ConnectivityType::None},
+                     std::make_shared<IndexBuffer>(
+                         std::make_shared<IndexBufferRAM>(std::move(indices))));
+    return mesh;
+}
+
+static void HalfEdgesBuild(benchmark::State& state) {
+    const auto mesh = makeGrid(static_cast<size_t>(state.range(0)));
+
+    app->getSystemSettings().poolSize_.set(static_cast<size_t>(state.range(1)));
+
+    for (auto _ : state) {
+        HalfEdges edges{*mesh};
+        benchmark::DoNotOptimize(edges);
+        benchmark::ClobberMemory();
+    }
+    state.counters["Triangles"] = static_cast<double>(2 * state.range(0) * state.range(0));
+    state.counters["Threads"] = static_cast<double>(app->getPoolSize() + 1);
+}
+
+static void HalfEdgesAdjacency(benchmark::State& state) {
+    const auto mesh = makeGrid(static_cast<size_t>(state.range(0)));
+
+    const HalfEdges edges{*mesh};
+    for (auto _ : state) {
+        auto indices = edges.createIndexBufferWithAdjacency();
+        benchmark::DoNotOptimize(indices);
+        benchmark::ClobberMemory();
+    }
+    state.counters["Triangles"] = static_cast<double>(2 * state.range(0) * state.range(0));
+}
+
+static void CalcNormals(benchmark::State& state) {
+    const auto mesh = makeGrid(static_cast<size_t>(state.range(0)));
+    const auto mode = static_cast<meshutil::CalculateMeshNormalsMode>(state.range(2));
+
+    app->getSystemSettings().poolSize_.set(static_cast<size_t>(state.range(1)));
+
+    for (auto _ : state) {
+        meshutil::calculateMeshNormals(*mesh, mode);
+        benchmark::ClobberMemory();
+    }
+    state.counters["Triangles"] = static_cast<double>(2 * state.range(0) * state.range(0));
+    state.counters["Threads"] = static_cast<double>(app->getPoolSize() + 1);
+}
+
+static void args(benchmark::internal::Benchmark* b) {
+    for (long size : {64L, 256L, 1024L, 2048L}) {
+        for (long threads : {0L, 3L, 7L}) b->Args({size, threads});
+    }
+}
+
+static void normalArgs(benchmark::internal::Benchmark* b) {
+    using Mode = meshutil::CalculateMeshNormalsMode;
+    for (auto mode : {Mode::WeightArea, Mode::WeightAngle, Mode::WeightNMax}) {
+        for (long size : {256L, 1024L, 2048L}) {
+            for (long threads : {0L, 3L, 7L}) b->Args({size, threads, static_cast<long>(mode)});
+        }
+    }
+}
+
+BENCHMARK(HalfEdgesBuild)->Apply(args)->Unit(benchmark::kMillisecond);
+BENCHMARK(HalfEdgesAdjacency)->RangeMultiplier(4)->Range(64, 2048)->Unit(benchmark::kMillisecond);
+BENCHMARK(CalcNormals)->Apply(normalArgs)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    InviwoApplication inviwoApp("bm-meshalgorithms");
+    app = &inviwoApp;
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
+
+#include <warn/pop>
@@ -0,0 +1,119 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/meshrenderinggl/algorithm/calcnormals.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+
+namespace inviwo {
+
+namespace {
+
+/*
+ * Unit cube, vertex index = x + 2y + 4z. Each side is split into two triangles along one of
+ * its diagonals, hence every corner has one or two triangles per adjacent side.
+ */
+std::shared_ptr<Mesh> createCube() {
+    std::vector<vec3> positions;
+    for (int i = 0; i < 8; ++i) {
+        positions.emplace_back(i & 1 ? 1.0f : 0.0f, i & 2 ? 1.0f : 0.0f, i & 4 ? 1.0f : 0.0f);
+    }
+    std::vector<std::uint32_t> indices{0, 2, 3, 0, 3, 1,   // z = 0
+                                       4, 5, 7, 4, 7, 6,   // z = 1
+                                       0, 1, 5, 0, 5, 4,   // y = 0
+                                       2, 6, 7, 2, 7, 3,   // y = 1
+                                       0, 4, 6, 0, 6, 2,   // x = 0
+                                       1, 3, 7, 1, 7, 5};  // x = 1
+
+    auto mesh = std::make_shared<Mesh>();
+    mesh->addBuffer(BufferType::PositionAttrib,
+                    std::make_shared<Buffer<vec3>>(
+                        std::make_shared<BufferRAMPrecision<vec3>>(std::move(positions))));
+    mesh->addIndices(Mesh::MeshInfo{DrawType::Triangles, ConnectivityType::None},
+                     std::make_shared<IndexBuffer>(
+                         std::make_shared<IndexBufferRAM>(std::move(indices))));
+    return mesh;
+}
+
+}  // namespace
+
+TEST(CalcNormals, cubeAngleWeighting) {
+    auto mesh = createCube();
+    meshutil::calculateMeshNormals(*mesh, meshutil::CalculateMeshNormalsMode::WeightAngle);
+
+    const auto positions =
+        mesh->getBuffer(BufferType::PositionAttrib)->getRepresentation<BufferRAM>();
+    const auto normals = mesh->getBuffer(BufferType::NormalAttrib);
+    ASSERT_NE(normals, nullptr);
+    const auto normalsRAM = normals->getRepresentation<BufferRAM>();
+    ASSERT_EQ(normalsRAM->getSize(), 8);
+
+    // The angle weighting does not depend on the triangulation, all corners are symmetric
+    for (size_t i = 0; i < 8; ++i) {
+        const auto expected = glm::normalize(positions->getAsDVec3(i) - dvec3{0.5});
+        const auto normal = normalsRAM->getAsDVec3(i);
+        EXPECT_NEAR(glm::distance(expected, normal), 0.0, 1e-6) << "vertex " << i;
+    }
+}
+
+TEST(CalcNormals, cubeModes) {
+    using Mode = meshutil::CalculateMeshNormalsMode;
+    for (auto mode : {Mode::NoWeighting, Mode::WeightArea, Mode::WeightAngle, Mode::WeightNMax}) {
+        auto mesh = createCube();
+        meshutil::calculateMeshNormals(*mesh, mode);
+        const auto positions =
+            mesh->getBuffer(BufferType::PositionAttrib)->getRepresentation<BufferRAM>();
+        const auto normals =
+            mesh->getBuffer(BufferType::NormalAttrib)->getRepresentation<BufferRAM>();
+
+        for (size_t i = 0; i < 8; ++i) {
+            const auto outwards = positions->getAsDVec3(i) - dvec3{0.5};
+            const auto normal = normals->getAsDVec3(i);
+            EXPECT_NEAR(glm::length(normal), 1.0, 1e-6) << "vertex " << i;
+            // Each normal points away from the center into the octant of its corner
+            for (int c = 0; c < 3; ++c) {
+                EXPECT_GT(normal[c] * outwards[c], 0.0) << "vertex " << i;
+            }
+        }
+    }
+}
+
+TEST(CalcNormals, passThrough) {
+    auto mesh = createCube();
+    meshutil::calculateMeshNormals(*mesh, meshutil::CalculateMeshNormalsMode::PassThrough);
+    EXPECT_EQ(mesh->getBuffer(BufferType::NormalAttrib), nullptr);
+}
+
+}  // namespace inviwo
@@ -331,4 +331,37 @@ TEST(HalfEdges, indexbufferAdjacency) {
     }
 }
 
+TEST(HalfEdges, closedCube) {
+    // Unit cube, vertex index = x + 2y + 4z, all faces oriented outwards
+    IndexBuffer cube{};
+    auto indices = cube.getEditableRAMRepresentation();
+    for (std::uint32_t i : {0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6, 0, 1, 5, 0, 5, 4,
+                            2, 6, 7, 2, 7, 3, 0, 4, 6, 0, 6, 2, 1, 3, 7, 1, 7, 5}) {
+        indices->add(i);
+    }
+
+    HalfEdges edges(Mesh::MeshInfo{DrawType::Triangles, ConnectivityType::None}, cube);
+
+    EXPECT_EQ(std::distance(edges.faces().begin(), edges.faces().end()), 12);
+    EXPECT_EQ(std::distance(edges.vertices().begin(), edges.vertices().end()), 8);
+
+    for (auto face : edges.faces()) {
+        auto edge = face;
+        do {
+            const auto twin = edge.twin();
+            ASSERT_TRUE(twin);
+            EXPECT_NE(twin->face(), edge.face());
+            EXPECT_EQ(twin->vertex(), edge.next().vertex());
+            EXPECT_EQ(twin->next().vertex(), edge.vertex());
+            EXPECT_EQ(*twin->twin(), edge);
+        } while (++edge != face);
+    }
+
+    for (std::uint32_t v = 0; v < 8; ++v) {
+        EXPECT_EQ(edges.vertexToEdge(v).vertex(), v);
+    }
+    EXPECT_THROW(edges.vertexToEdge(8), std::out_of_range);
+    EXPECT_THROW(edges.faceToEdge(12), std::out_of_range);
+}
+
 }  // namespace inviwo
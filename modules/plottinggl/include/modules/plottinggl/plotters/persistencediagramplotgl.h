@@ -39,6 +39,7 @@
 #include <inviwo/core/interaction/pickingmapper.h>
 #include <inviwo/core/ports/imageport.h>
 #include <inviwo/core/util/dispatcher.h>
+#include <inviwo/core/datastructures/bitset.h>
 
 #include <modules/opengl/texture/textureutils.h>
 #include <modules/opengl/shader/shader.h>
@@ -68,7 +69,7 @@ class IVW_MODULE_PLOTTINGGL_API PersistenceDiagramPlotGL {
 public:
     using ToolTipFunc = void(PickingEvent*, size_t);
     using ToolTipCallbackHandle = std::shared_ptr<std::function<ToolTipFunc>>;
-    using SelectionFunc = void(const std::unordered_set<size_t>&);
+    using SelectionFunc = void(const BitSet&);
     using SelectionCallbackHandle = std::shared_ptr<std::function<SelectionFunc>>;
 
     class Properties : public CompositeProperty {
@@ -144,7 +145,7 @@ public:
 
     void setIndexColumn(std::shared_ptr<const TemplateColumn<uint32_t>> indexcol);
 
-    void setSelectedIndices(const std::unordered_set<size_t>& indices);
+    void setSelectedIndices(const BitSet& indices);
 
     ToolTipCallbackHandle addToolTipCallback(std::function<ToolTipFunc> callback);
     SelectionCallbackHandle addSelectionChangedCallback(std::function<SelectionFunc> callback);
@@ -177,7 +178,7 @@ protected:
     std::array<AxisRenderer, 2> axisRenderers_;
 
     PickingMapper picking_;
-    std::unordered_set<size_t> selectedIndices_;
+    BitSet selectedIndices_;
     std::set<uint32_t> hoveredIndices_;
 
     Processor* processor_;
@@ -36,6 +36,7 @@
 #include <inviwo/core/properties/transferfunctionproperty.h>
 #include <inviwo/core/ports/imageport.h>
 #include <inviwo/core/util/dispatcher.h>
+#include <inviwo/core/datastructures/bitset.h>
 
 #include <modules/base/algorithm/dataminmax.h>
 #include <modules/basegl/properties/stipplingproperty.h>
@@ -144,7 +145,7 @@ public:
     void setRadiusData(std::shared_ptr<const BufferBase> buffer);
     void setIndexColumn(std::shared_ptr<const TemplateColumn<uint32_t>> indexcol);
 
-    void setSelectedIndices(const std::unordered_set<size_t>& indices);
+    void setSelectedIndices(const BitSet& indices);
 
     ToolTipCallbackHandle addToolTipCallback(std::function<ToolTipFunc> callback);
     SelectionCallbackHandle addSelectionChangedCallback(std::function<SelectionFunc> callback);
@@ -656,7 +656,7 @@ void ParallelCoordinates::linePicked(PickingEvent* p) {
 
         auto id = p->getPickedId();
 
-        auto selection = brushingAndLinking_.getSelectedIndices();
+        auto selection = brushingAndLinking_.getSelectedBitSet();
         if (brushingAndLinking_.isSelected(indexCol[id])) {
             selection.erase(indexCol[id]);
         } else {
@@ -700,7 +700,7 @@ void ParallelCoordinates::axisPicked(PickingEvent* p, size_t pickedID, PickType
         glm::length2(p->getDeltaPressedPosition()) < 0.01 && pt != PickType::Lower &&
         pt != PickType::Upper && !isDragging_) {
 
-        auto selection = brushingAndLinking_.getSelectedColumns();
+        auto selection = brushingAndLinking_.getSelectedColumnsBitSet();
         if (brushingAndLinking_.isColumnSelected(pickedID)) {
             selection.erase(pickedID);
         } else if (axisSelection_.get() == AxisSelection::Multiple) {
@@ -719,7 +719,7 @@ void ParallelCoordinates::axisPicked(PickingEvent* p, size_t pickedID, PickType
 
         axes_[pickedID].pcp->invertRange.set(!axes_[pickedID].pcp->invertRange);
         // undo spurious axis selection caused by the single click event prior to the double click
-        auto selection = brushingAndLinking_.getSelectedColumns();
+        auto selection = brushingAndLinking_.getSelectedColumnsBitSet();
         if (brushingAndLinking_.isColumnSelected(pickedID)) {
             selection.erase(pickedID);
         } else {
@@ -802,7 +802,7 @@ void ParallelCoordinates::updateBrushing() {
         }
     }
 
-    std::unordered_set<size_t> brushedID;
+    BitSet brushedID;
     for (size_t i = 0; i < nRows; ++i) {
         if (brushed[i]) brushedID.insert(indexCol[i]);
     }
@@ -75,7 +75,7 @@ ScatterPlotProcessor::ScatterPlotProcessor()
     selectionChangedCallBack_ =
         scatterPlot_.addSelectionChangedCallback([this](const std::vector<bool>& selected) {
             if (brushingPort_.isConnected()) {
-                std::unordered_set<size_t> selectedIndices;
+                BitSet selectedIndices;
                 auto iCol = dataFramePort_.getData()->getIndexColumn();
                 auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
                 for (size_t i = 0; i < selected.size(); ++i) {
@@ -89,7 +89,7 @@ ScatterPlotProcessor::ScatterPlotProcessor()
     filteringChangedCallBack_ =
         scatterPlot_.addFilteringChangedCallback([this](const std::vector<bool>& filtered) {
             if (brushingPort_.isConnected()) {
-                std::unordered_set<size_t> filteredIndices;
+                BitSet filteredIndices;
                 auto iCol = dataFramePort_.getData()->getIndexColumn();
                 auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
                 for (size_t i = 0; i < filtered.size(); ++i) {
@@ -133,7 +133,7 @@ void ScatterPlotProcessor::process() {
 
     if (brushingPort_.isConnected()) {
         if (brushingPort_.isChanged()) {
-            scatterPlot_.setSelectedIndices(brushingPort_.getSelectedIndices());
+            scatterPlot_.setSelectedIndices(brushingPort_.getSelectedBitSet());
         }
 
         auto dfSize = dataframe->getNumberOfRows();
@@ -141,7 +141,7 @@ void ScatterPlotProcessor::process() {
         auto iCol = dataframe->getIndexColumn();
         auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
 
-        auto brushedIndicies = brushingPort_.getFilteredIndices();
+        const auto& brushedIndicies = brushingPort_.getFilteredBitSet();
         IndexBuffer indicies;
         auto& vec = indicies.getEditableRAMRepresentation()->getDataContainer();
         vec.reserve(dfSize - brushedIndicies.size());
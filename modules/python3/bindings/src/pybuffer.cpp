@@ -50,6 +50,9 @@
 
 #include <fmt/format.h>
 
+#include <cstring>
+#include <vector>
+
 namespace inviwo {
 
 struct BufferRAMHelper {
@@ -66,9 +69,10 @@ struct BufferRAMHelper {
                  py::arg("usage") = BufferUsage::Static)
             .def(py::init([](py::array data, BufferUsage usage) {
                      pyutil::checkDataFormat<1>(DataFormat::get(), data.shape(0), data);
+                     const auto src = pyutil::toDenseArray(data);
+                     const auto begin = static_cast<const T *>(src.data());
                      auto ram = std::make_shared<BufferRAMPrecision<T, BufferTarget::Data>>(
-                         data.shape(0), usage);
-                     memcpy(ram->getData(), data.data(0), data.nbytes());
+                         std::vector<T>(begin, begin + src.shape(0)), usage);
                      return new Buffer<T, BufferTarget::Data>(ram);
                  }),
                  py::arg("data"), py::arg("usage") = BufferUsage::Static);
@@ -80,9 +84,10 @@ struct BufferRAMHelper {
             .def(py::init<size_t, BufferUsage>())
             .def(py::init([](py::array data, BufferUsage usage) {
                      pyutil::checkDataFormat<1>(DataFormat::get(), data.shape(0), data);
+                     const auto src = pyutil::toDenseArray(data);
+                     const auto begin = static_cast<const T *>(src.data());
                      auto ram = std::make_shared<BufferRAMPrecision<T, BufferTarget::Index>>(
-                         data.shape(0), usage);
-                     memcpy(ram->getData(), data.data(0), data.nbytes());
+                         std::vector<T>(begin, begin + src.shape(0)), usage);
                      return new Buffer<T, BufferTarget::Index>(ram);
                  }),
                  py::arg("data"), py::arg("usage") = BufferUsage::Static);
@@ -131,25 +136,13 @@ void exposeBuffer(pybind11::module &m) {
         .def("clone", [](BufferBase &self) { return self.clone(); })
         .def_property("size", &BufferBase::getSize, &BufferBase::setSize)
         .def_property("data",
-                      [&](BufferBase *buffer) -> py::array {
-                          auto df = buffer->getDataFormat();
-                          std::vector<size_t> shape = {buffer->getSize()};
-                          std::vector<size_t> strides = {df->getSize()};
-
-                          if (df->getComponents() > 1) {
-                              shape.push_back(df->getComponents());
-                              strides.push_back(df->getSize() / df->getComponents());
-                          }
-
-                          auto data = buffer->getEditableRepresentation<BufferRAM>()->getData();
-                          return py::array(pyutil::toNumPyFormat(df), shape, strides, data,
-                                           py::cast<>(1));
-                      },
+                      [](BufferBase *buffer) { return pyutil::getBufferData(*buffer); },
                       [](BufferBase *buffer, py::array data) {
                           auto rep = buffer->getEditableRepresentation<BufferRAM>();
                           pyutil::checkDataFormat<1>(rep->getDataFormat(), rep->getSize(), data);
 
-                          memcpy(rep->getData(), data.data(0), data.nbytes());
+                          const auto src = pyutil::toDenseArray(data);
+                          std::memmove(rep->getData(), src.data(), src.nbytes());
                       })
         .def("__repr__", [](const BufferBase &self) {
             return fmt::format("<Buffer: target = {} usage = {} format = {} size = {}>",
@@ -150,27 +150,12 @@ void exposeImage(py::module& m) {
              })
         .def_property(
             "data",
-            [&](Layer* layer) -> py::array {
-                auto df = layer->getDataFormat();
-                auto dims = layer->getDimensions();
-
-                std::vector<size_t> shape = {dims.x, dims.y};
-                std::vector<size_t> strides = {df->getSize(), df->getSize() * dims.x};
-
-                if (df->getComponents() > 1) {
-                    shape.push_back(df->getComponents());
-                    strides.push_back(df->getSize() / df->getComponents());
-                }
-
-                auto data = layer->getEditableRepresentation<LayerRAM>()->getData();
-                return py::array(pyutil::toNumPyFormat(df), shape, strides, data, py::cast<>(1));
-            },
-            [](Layer* layer, py::array data) {
-                auto rep = layer->getEditableRepresentation<LayerRAM>();
-                pyutil::checkDataFormat<2>(rep->getDataFormat(), rep->getDimensions(), data);
-
-                memcpy(rep->getData(), data.data(0), data.nbytes());
-            })
+            [](Layer* layer) { return pyutil::getLayerData(*layer); },
+            [](Layer* layer, py::array data) { pyutil::setLayerData(*layer, data); })
+        .def(
+            "setData",
+            [](Layer& self, py::array data, bool copy) { pyutil::setLayerData(self, data, copy); },
+            py::arg("data"), py::arg("copy") = true)
         .def("__repr__", [](const Layer& self) {
             return fmt::format(
                 "<Layer:\n  type = {}\n  format = {}\n  dimensions = {}\n  swizzlemask = {}>",
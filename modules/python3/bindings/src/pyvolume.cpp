@@ -74,28 +74,14 @@ void exposeVolume(pybind11::module &m) {
         .def_readwrite("dataMap", &Volume::dataMap_)
         .def_property(
             "data",
-            [&](Volume *volume) -> py::array {
-                auto df = volume->getDataFormat();
-                auto dims = volume->getDimensions();
-
-                std::vector<size_t> shape = {dims.x, dims.y, dims.z};
-                std::vector<size_t> strides = {df->getSize(), df->getSize() * dims.x,
-                                               df->getSize() * dims.x * dims.y};
-
-                if (df->getComponents() > 1) {
-                    shape.push_back(df->getComponents());
-                    strides.push_back(df->getSize() / df->getComponents());
-                }
-
-                auto data = volume->getEditableRepresentation<VolumeRAM>()->getData();
-                return py::array(pyutil::toNumPyFormat(df), shape, strides, data, py::cast<>(1));
+            [](Volume *volume) { return pyutil::getVolumeData(*volume); },
+            [](Volume *volume, py::array data) { pyutil::setVolumeData(*volume, data); })
+        .def(
+            "setData",
+            [](Volume &self, py::array data, bool copy) {
+                pyutil::setVolumeData(self, data, copy);
             },
-            [](Volume *volume, py::array data) {
-                auto rep = volume->getEditableRepresentation<VolumeRAM>();
-                pyutil::checkDataFormat<3>(rep->getDataFormat(), rep->getDimensions(), data);
-
-                memcpy(rep->getData(), data.data(0), data.nbytes());
-            })
+            py::arg("data"), py::arg("copy") = true)
         .def("__repr__", [](const Volume &volume) {
             std::ostringstream oss;
             oss << "<Volume:\n  dimensions = " << volume.getDimensions()
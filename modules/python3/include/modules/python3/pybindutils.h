@@ -56,10 +56,88 @@ namespace pyutil {
 
 IVW_MODULE_PYTHON3_API pybind11::dtype toNumPyFormat(const DataFormatBase *df);
 IVW_MODULE_PYTHON3_API const DataFormatBase *getDataFormat(size_t components, pybind11::array &arr);
+
+/**
+ * Check if a RAM representation can use the memory of arr directly, i.e. if the array is writable,
+ * aligned, in native byte order, and C contiguous. Other arrays are copied in C order.
+ */
+IVW_MODULE_PYTHON3_API bool canShareMemory(const pybind11::array &arr);
+
+/**
+ * Returns arr if it is aligned and C contiguous, otherwise a C ordered copy of arr. The result can
+ * be copied with memcpy.
+ */
+IVW_MODULE_PYTHON3_API pybind11::array toDenseArray(pybind11::array &arr);
+
+/**
+ * Returns an owner that keeps arr alive, to be used with representations viewing the data of arr.
+ * The owner may be released from any thread. Without the GIL, arr is released later on the Python
+ * thread instead of waiting for the GIL.
+ */
+IVW_MODULE_PYTHON3_API std::shared_ptr<void> keepAlive(const pybind11::array &arr);
+
+/**
+ * Create a Buffer from a NumPy array. The data is copied once, straight into the buffer.
+ */
 IVW_MODULE_PYTHON3_API std::unique_ptr<BufferBase> createBuffer(pybind11::array &arr);
+
+/**
+ * Create a Layer from a NumPy array. If possible the layer will use the memory of the array
+ * without copying it and keep the array alive, changes to the array are then seen by the layer.
+ * @see canShareMemory
+ */
 IVW_MODULE_PYTHON3_API std::unique_ptr<Layer> createLayer(pybind11::array &arr);
+
+/**
+ * Create a Volume from a NumPy array. If possible the volume will use the memory of the array
+ * without copying it and keep the array alive, changes to the array are then seen by the volume.
+ * @see canShareMemory
+ */
 IVW_MODULE_PYTHON3_API std::unique_ptr<Volume> createVolume(pybind11::array &arr);
 
+/**
+ * Get an array viewing the RAM representation of buffer, indexed by [i] or [i, component]. Changes
+ * to the array are seen by the buffer. The array keeps the representation alive, but resizing the
+ * buffer invalidates it.
+ */
+IVW_MODULE_PYTHON3_API pybind11::array getBufferData(BufferBase &buffer);
+
+/**
+ * Get an array viewing the RAM representation of layer, indexed by [x, y] or [x, y, component].
+ * Changes to the array are seen by the layer. The array keeps the representation alive, hence it
+ * stays valid even if the representation is replaced, e.g. by setLayerData.
+ */
+IVW_MODULE_PYTHON3_API pybind11::array getLayerData(Layer &layer);
+
+/**
+ * Get an array viewing the RAM representation of volume, indexed by [x, y, z] or
+ * [x, y, z, component]. Changes to the array are seen by the volume. The array keeps the
+ * representation alive, hence it stays valid even if the representation is replaced, e.g. by
+ * setVolumeData.
+ */
+IVW_MODULE_PYTHON3_API pybind11::array getVolumeData(Volume &volume);
+
+/**
+ * Copy arr into the RAM representation of layer, all other representations are invalidated. The
+ * format and dimensions of arr have to match the layer. Nothing is copied if arr is a view of the
+ * representation with its layout, as returned by getLayerData.
+ * If copy is false the layer instead uses the memory of arr if possible and keeps the array alive,
+ * changes to the array are then seen by the layer. All other representations are then removed.
+ * @see canShareMemory
+ */
+IVW_MODULE_PYTHON3_API void setLayerData(Layer &layer, pybind11::array &arr, bool copy = true);
+
+/**
+ * Copy arr into the RAM representation of volume, all other representations are invalidated. The
+ * format and dimensions of arr have to match the volume. Nothing is copied if arr is a view of the
+ * representation with its layout, as returned by getVolumeData.
+ * If copy is false the volume instead uses the memory of arr if possible and keeps the array
+ * alive, changes to the array are then seen by the volume. All other representations are then
+ * removed.
+ * @see canShareMemory
+ */
+IVW_MODULE_PYTHON3_API void setVolumeData(Volume &volume, pybind11::array &arr, bool copy = true);
+
 template <int Dim>
 void checkDataFormat(const DataFormatBase *format, const Vector<Dim, size_t> &dim,
                      const pybind11::array &data) {
@@ -48,6 +48,11 @@
 
 #include <inviwo/core/util/stdextensions.h>
 
+#include <cstring>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 namespace inviwo {
 
 namespace pyutil {
@@ -90,44 +95,242 @@ const DataFormatBase *getDataFormat(size_t components, pybind11::array &arr) {
     return format;
 }
 
+namespace {
+
+bool isAligned(const pybind11::array &arr) {
+    return (arr.flags() & pybind11::detail::npy_api::NPY_ARRAY_ALIGNED_) != 0;
+}
+
+// The representations use the memory of arr in C order, i.e. as NumPy's row major layout
+bool isCContiguous(const pybind11::array &arr) {
+    return (arr.flags() & pybind11::detail::npy_api::NPY_ARRAY_C_CONTIGUOUS_) != 0;
+}
+
+/*
+ * The shape and strides, in bytes, of the data of a RAM representation as seen from NumPy, i.e.
+ * indexed by [x, y, (z), (component)]
+ */
+struct Layout {
+    std::vector<size_t> shape;
+    std::vector<size_t> strides;
+};
+
+template <typename Dims>
+Layout getLayout(const DataFormatBase *df, const Dims &dims) {
+    Layout layout;
+    size_t stride = df->getSize();
+    for (size_t i = 0; i < util::extent<Dims>::value; ++i) {
+        layout.shape.push_back(util::glmcomp(dims, i));
+        layout.strides.push_back(stride);
+        stride *= util::glmcomp(dims, i);
+    }
+    if (df->getComponents() > 1) {
+        layout.shape.push_back(df->getComponents());
+        layout.strides.push_back(df->getSize() / df->getComponents());
+    }
+    return layout;
+}
+
+bool hasLayout(const pybind11::array &arr, const Layout &layout) {
+    if (static_cast<size_t>(arr.ndim()) != layout.shape.size()) return false;
+    for (size_t i = 0; i < layout.shape.size(); ++i) {
+        if (arr.shape(i) != static_cast<pybind11::ssize_t>(layout.shape[i]) ||
+            arr.strides(i) != static_cast<pybind11::ssize_t>(layout.strides[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+std::unique_ptr<T[]> copyOf(pybind11::array &arr) {
+    const auto src = toDenseArray(arr);
+    // default initialized, the data is overwritten right away
+    std::unique_ptr<T[]> data(new T[src.size() * src.itemsize() / sizeof(T)]);
+    std::memcpy(data.get(), src.data(), src.nbytes());
+    return data;
+}
+
+/*
+ * Arrays kept alive by representations can be released on any thread, like a pool thread running
+ * a background job. Waiting for the GIL there could block the thread for as long as the Python
+ * thread runs a script, hence such arrays are released later on the Python thread instead.
+ */
+class DeferredRelease {
+public:
+    static DeferredRelease &instance() {
+        static DeferredRelease deferred;
+        return deferred;
+    }
+
+    void add(pybind11::object *obj) {
+        std::scoped_lock lock{mutex_};
+        pending_.push_back(obj);
+        // Py_AddPendingCall does not need the GIL, it fails if its queue is full, then we retry
+        // with the next object or release them in the next call to keepAlive.
+        if (!scheduled_) scheduled_ = Py_AddPendingCall(&DeferredRelease::release, nullptr) == 0;
+    }
+
+    // Has to be called with the GIL held
+    void releaseAll() {
+        std::vector<pybind11::object *> objects;
+        {
+            std::scoped_lock lock{mutex_};
+            std::swap(objects, pending_);
+            scheduled_ = false;
+        }
+        for (auto obj : objects) delete obj;
+    }
+
+private:
+    static int release(void *) {
+        instance().releaseAll();
+        return 0;
+    }
+
+    std::mutex mutex_;
+    std::vector<pybind11::object *> pending_;
+    bool scheduled_ = false;
+};
+
+}  // namespace
+
+pybind11::array toDenseArray(pybind11::array &arr) {
+    if (isAligned(arr) && isCContiguous(arr)) return arr;
+    auto copy = pybind11::array::ensure(
+        arr, static_cast<int>(pybind11::array::c_style) |
+                 static_cast<int>(pybind11::detail::npy_api::NPY_ARRAY_ALIGNED_));
+    if (!copy) throw pybind11::value_error("Could not make a contiguous copy of the given array");
+    return copy;
+}
+
+bool canShareMemory(const pybind11::array &arr) {
+    return arr.size() > 0 && arr.writeable() && isAligned(arr) &&
+           arr.dtype().attr("isnative").cast<bool>() && isCContiguous(arr);
+}
+
+std::shared_ptr<void> keepAlive(const pybind11::array &arr) {
+    DeferredRelease::instance().releaseAll();
+    return std::shared_ptr<void>(new pybind11::object(arr), [](void *ptr) {
+        auto obj = static_cast<pybind11::object *>(ptr);
+        if (!Py_IsInitialized()) {
+            obj->release();  // The interpreter is gone, there is nothing left to release
+            delete obj;
+        } else if (PyGILState_Check()) {
+            delete obj;
+        } else {
+            DeferredRelease::instance().add(obj);
+        }
+    });
+}
+
 struct BufferFromArrayDispatcher {
     using type = std::unique_ptr<BufferBase>;
 
     template <typename Result, typename T>
     std::unique_ptr<BufferBase> operator()(pybind11::array &arr) {
         using Type = typename T::type;
-        auto buf = std::make_unique<Buffer<Type>>(arr.shape(0));
-        memcpy(buf->getEditableRAMRepresentation()->getData(), arr.data(0), arr.nbytes());
-        return buf;
+        const auto src = toDenseArray(arr);
+        const auto data = static_cast<const Type *>(src.data());
+        return std::make_unique<Buffer<Type>>(std::make_shared<BufferRAMPrecision<Type>>(
+            std::vector<Type>(data, data + src.shape(0))));
     }
 };
 
-struct LayerFromArrayDispatcher {
-    using type = std::unique_ptr<Layer>;
+struct LayerRAMFromArrayDispatcher {
+    using type = std::shared_ptr<LayerRAM>;
 
     template <typename Result, typename T>
-    std::unique_ptr<Layer> operator()(pybind11::array &arr) {
+    std::shared_ptr<LayerRAM> operator()(pybind11::array &arr, bool copy, LayerType layerType,
+                                         const SwizzleMask &swizzleMask,
+                                         InterpolationType interpolation,
+                                         const Wrapping2D &wrapping) {
         using Type = typename T::type;
         size2_t dims(arr.shape(0), arr.shape(1));
-        auto layerRAM = std::make_shared<LayerRAMPrecision<Type>>(dims);
-        memcpy(layerRAM->getData(), arr.data(0), arr.nbytes());
-        return std::make_unique<Layer>(layerRAM);
+        if (!copy && canShareMemory(arr)) {
+            return std::make_shared<LayerRAMPrecision<Type>>(
+                keepAlive(arr), static_cast<Type *>(arr.mutable_data()), dims, layerType,
+                swizzleMask, interpolation, wrapping);
+        }
+        return std::make_shared<LayerRAMPrecision<Type>>(
+            copyOf<Type>(arr).release(), dims, layerType, swizzleMask, interpolation, wrapping);
     }
 };
 
-struct VolumeFromArrayDispatcher {
-    using type = std::unique_ptr<Volume>;
+struct VolumeRAMFromArrayDispatcher {
+    using type = std::shared_ptr<VolumeRAM>;
 
     template <typename Result, typename T>
-    std::unique_ptr<Volume> operator()(pybind11::array &arr) {
+    std::shared_ptr<VolumeRAM> operator()(pybind11::array &arr, bool copy,
+                                          const SwizzleMask &swizzleMask,
+                                          InterpolationType interpolation,
+                                          const Wrapping3D &wrapping) {
         using Type = typename T::type;
         size3_t dims(arr.shape(0), arr.shape(1), arr.shape(2));
-        auto volumeRAM = std::make_shared<VolumeRAMPrecision<Type>>(dims);
-        memcpy(volumeRAM->getData(), arr.data(0), arr.nbytes());
-        return std::make_unique<Volume>(volumeRAM);
+        if (!copy && canShareMemory(arr)) {
+            return std::make_shared<VolumeRAMPrecision<Type>>(
+                keepAlive(arr), static_cast<Type *>(arr.mutable_data()), dims, swizzleMask,
+                interpolation, wrapping);
+        }
+        return std::make_shared<VolumeRAMPrecision<Type>>(copyOf<Type>(arr).release(), dims,
+                                                          swizzleMask, interpolation, wrapping);
     }
 };
 
+namespace {
+
+/*
+ * A view of the data of the RAM representation of data. The array holds the representation, hence
+ * the memory stays valid, and the MemoryManager does not evict it, as long as the array or any
+ * view of it exists, even if the representation is removed from data.
+ */
+template <typename Repr, typename DataType>
+pybind11::array getData(DataType &data) {
+    data.template getEditableRepresentation<Repr>();
+    std::shared_ptr<void> rep =
+        std::const_pointer_cast<Repr>(data.template getSharedRepresentation<Repr>());
+    auto ram = static_cast<Repr *>(rep.get());
+    const auto df = ram->getDataFormat();
+    const auto layout = [&]() {
+        if constexpr (std::is_same_v<Repr, BufferRAM>) {
+            return getLayout(df, ram->getSize());
+        } else {
+            return getLayout(df, ram->getDimensions());
+        }
+    }();
+    auto ptr = ram->getData();
+    pybind11::capsule base(new std::shared_ptr<void>(std::move(rep)), [](void *owner) {
+        delete static_cast<std::shared_ptr<void> *>(owner);
+    });
+    return pybind11::array(toNumPyFormat(df), layout.shape, layout.strides, ptr, base);
+}
+
+/*
+ * Copy arr into the existing RAM representation of data if possible, otherwise replace all
+ * representations with the one returned by create. Views returned by getData hold on to the
+ * representation they view, hence replacing it does not leave them dangling.
+ */
+template <typename Repr, typename DataType, typename Create>
+void setData(DataType &data, pybind11::array &arr, bool copy, Create create) {
+    if (data.template hasRepresentation<Repr>() && (copy || !canShareMemory(arr))) {
+        auto rep = data.template getEditableRepresentation<Repr>();
+        // arr is exactly a view of the representation, i.e. data.data, there is nothing to copy
+        if (arr.data() == rep->getData() &&
+            hasLayout(arr, getLayout(rep->getDataFormat(), rep->getDimensions()))) {
+            return;
+        }
+        // arr might be another view of the representation, hence the ranges can overlap
+        const auto src = toDenseArray(arr);
+        std::memmove(rep->getData(), src.data(), src.nbytes());
+        return;
+    }
+    auto ram = create(arr, copy);
+    data.clearRepresentations();
+    data.addRepresentation(ram);
+}
+
+}  // namespace
+
 std::unique_ptr<BufferBase> createBuffer(pybind11::array &arr) {
     auto ndim = arr.ndim();
     ivwAssert(ndim == 1 || ndim == 2, "ndims must be either 1 or 2");
@@ -141,18 +344,48 @@ std::unique_ptr<Layer> createLayer(pybind11::array &arr) {
     auto ndim = arr.ndim();
     ivwAssert(ndim == 2 || ndim == 3, "Ndims must be either 2 or 3");
     auto df = pyutil::getDataFormat(ndim == 2 ? 1 : arr.shape(2), arr);
-    LayerFromArrayDispatcher dispatcher;
-    return dispatching::dispatch<std::unique_ptr<Layer>, dispatching::filter::All>(df->getId(),
-                                                                                   dispatcher, arr);
+    LayerRAMFromArrayDispatcher dispatcher;
+    return std::make_unique<Layer>(
+        dispatching::dispatch<std::shared_ptr<LayerRAM>, dispatching::filter::All>(
+            df->getId(), dispatcher, arr, false, LayerType::Color, swizzlemasks::rgba,
+            InterpolationType::Linear, wrapping2d::clampAll));
 }
 
 std::unique_ptr<Volume> createVolume(pybind11::array &arr) {
     auto ndim = arr.ndim();
     ivwAssert(ndim == 3 || ndim == 4, "Ndims must be either 3 or 4");
     auto df = pyutil::getDataFormat(ndim == 3 ? 1 : arr.shape(3), arr);
-    VolumeFromArrayDispatcher dispatcher;
-    return dispatching::dispatch<std::unique_ptr<Volume>, dispatching::filter::All>(
-        df->getId(), dispatcher, arr);
+    VolumeRAMFromArrayDispatcher dispatcher;
+    return std::make_unique<Volume>(
+        dispatching::dispatch<std::shared_ptr<VolumeRAM>, dispatching::filter::All>(
+            df->getId(), dispatcher, arr, false, swizzlemasks::rgba, InterpolationType::Linear,
+            wrapping3d::clampAll));
+}
+
+pybind11::array getBufferData(BufferBase &buffer) { return getData<BufferRAM>(buffer); }
+
+pybind11::array getLayerData(Layer &layer) { return getData<LayerRAM>(layer); }
+
+pybind11::array getVolumeData(Volume &volume) { return getData<VolumeRAM>(volume); }
+
+void setLayerData(Layer &layer, pybind11::array &arr, bool copy) {
+    checkDataFormat<2>(layer.getDataFormat(), layer.getDimensions(), arr);
+    setData<LayerRAM>(layer, arr, copy, [&](pybind11::array &src, bool copySrc) {
+        LayerRAMFromArrayDispatcher dispatcher;
+        return dispatching::dispatch<std::shared_ptr<LayerRAM>, dispatching::filter::All>(
+            layer.getDataFormat()->getId(), dispatcher, src, copySrc, layer.getLayerType(),
+            layer.getSwizzleMask(), layer.getInterpolation(), layer.getWrapping());
+    });
+}
+
+void setVolumeData(Volume &volume, pybind11::array &arr, bool copy) {
+    checkDataFormat<3>(volume.getDataFormat(), volume.getDimensions(), arr);
+    setData<VolumeRAM>(volume, arr, copy, [&](pybind11::array &src, bool copySrc) {
+        VolumeRAMFromArrayDispatcher dispatcher;
+        return dispatching::dispatch<std::shared_ptr<VolumeRAM>, dispatching::filter::All>(
+            volume.getDataFormat()->getId(), dispatcher, src, copySrc, volume.getSwizzleMask(),
+            volume.getInterpolation(), volume.getWrapping());
+    });
 }
 
 }  // namespace pyutil
@@ -57,6 +57,8 @@
 
 #include <glm/gtc/epsilon.hpp>
 
+#include <thread>
+
 namespace inviwo {
 
 namespace {
@@ -247,4 +249,141 @@ const static std::vector<std::string> dtypes = {{"float16"}, {"float32"}, {"floa
 
 INSTANTIATE_TEST_SUITE_P(DefaultTypes, DTypeTest, ::testing::ValuesIn(dtypes));
 
+namespace {
+template <typename F>
+void runWithArray(const std::string& source, F test) {
+    PythonScript s;
+    s.setSource("import numpy as np\n" + source);
+    bool status = false;
+    s.run([&](pybind11::dict dict) {
+        ASSERT_TRUE(dict.contains("a"));
+        auto arr = pybind11::cast<pybind11::array>(dict["a"]);
+        test(arr);
+        status = true;
+    });
+    EXPECT_TRUE(status);
+}
+}  // namespace
+
+TEST(NumPyMemory, LayerSharesWritableArray) {
+    runWithArray("a = np.arange(8, dtype=np.float32).reshape((2, 4))\n", [](pybind11::array& arr) {
+        auto layer = pyutil::createLayer(arr);
+        const auto ram = layer->getRepresentation<LayerRAM>();
+        EXPECT_EQ(arr.data(), ram->getData());
+        EXPECT_EQ(size2_t(2, 4), ram->getDimensions());
+    });
+}
+
+TEST(NumPyMemory, VolumeSharesWritableArray) {
+    runWithArray("a = np.arange(8, dtype=np.int16).reshape((2, 2, 2))\n", [](pybind11::array& arr) {
+        auto volume = pyutil::createVolume(arr);
+        const auto ram = volume->getRepresentation<VolumeRAM>();
+        EXPECT_EQ(arr.data(), ram->getData());
+    });
+}
+
+TEST(NumPyMemory, StridedArrayIsCopied) {
+    runWithArray(
+        "a = np.arange(8, dtype=np.float32).reshape((2, 4))[:, ::2]\n",
+        [](pybind11::array& arr) {
+            auto layer = pyutil::createLayer(arr);
+            const auto ram =
+                static_cast<const LayerRAMPrecision<float>*>(layer->getRepresentation<LayerRAM>());
+            EXPECT_NE(arr.data(), ram->getData());
+            const auto data = ram->getDataTyped();
+            EXPECT_EQ(0.0f, data[0]);
+            EXPECT_EQ(2.0f, data[1]);
+            EXPECT_EQ(4.0f, data[2]);
+            EXPECT_EQ(6.0f, data[3]);
+        });
+}
+
+TEST(NumPyMemory, ReadOnlyArrayIsCopied) {
+    runWithArray(
+        "a = np.arange(8, dtype=np.uint8).reshape((2, 2, 2))\na.flags.writeable = False\n",
+        [](pybind11::array& arr) {
+            auto volume = pyutil::createVolume(arr);
+            const auto ram = static_cast<const VolumeRAMPrecision<unsigned char>*>(
+                volume->getRepresentation<VolumeRAM>());
+            EXPECT_NE(arr.data(), ram->getData());
+            const auto data = ram->getDataTyped();
+            for (unsigned char i = 0; i < 8; ++i) EXPECT_EQ(i, data[i]);
+        });
+}
+
+TEST(NumPyMemory, FortranOrderedArrayIsCopied) {
+    runWithArray(
+        "a = np.asfortranarray(np.arange(8, dtype=np.float32).reshape((2, 4)))\n",
+        [](pybind11::array& arr) {
+            auto layer = pyutil::createLayer(arr);
+            const auto ram =
+                static_cast<const LayerRAMPrecision<float>*>(layer->getRepresentation<LayerRAM>());
+            EXPECT_NE(arr.data(), ram->getData());
+            const auto data = ram->getDataTyped();
+            for (int i = 0; i < 8; ++i) EXPECT_EQ(static_cast<float>(i), data[i]);
+        });
+}
+
+TEST(NumPyMemory, SetDataCopiesUnlessAsked) {
+    runWithArray("a = np.arange(8, dtype=np.int32).reshape((2, 2, 2))\n", [](pybind11::array& arr) {
+        Volume volume(size3_t(2), DataFormat<int>::get());
+        pyutil::setVolumeData(volume, arr);
+        EXPECT_NE(arr.data(), volume.getRepresentation<VolumeRAM>()->getData());
+        EXPECT_EQ(7, volume.getRepresentation<VolumeRAM>()->getAsDouble(size3_t(1)));
+
+        pyutil::setVolumeData(volume, arr, false);
+        EXPECT_EQ(arr.data(), volume.getRepresentation<VolumeRAM>()->getData());
+    });
+}
+
+TEST(NumPyMemory, SetDataWritesIntoTheRepresentation) {
+    runWithArray("a = np.arange(8, dtype=np.float32).reshape((2, 4))\n", [](pybind11::array& arr) {
+        Layer layer(size2_t(2, 4), DataFormat<float>::get());
+        auto view = pyutil::getLayerData(layer);
+        const auto data = view.data();
+
+        pyutil::setLayerData(layer, arr);
+        EXPECT_EQ(data, layer.getRepresentation<LayerRAM>()->getData());
+        EXPECT_EQ(7.0f, static_cast<const float*>(view.data())[7]);
+
+        // Assigning the view itself does not change anything
+        pyutil::setLayerData(layer, view);
+        EXPECT_EQ(data, layer.getRepresentation<LayerRAM>()->getData());
+        for (int i = 0; i < 8; ++i) {
+            EXPECT_EQ(static_cast<float>(i), static_cast<const float*>(view.data())[i]);
+        }
+    });
+}
+
+TEST(NumPyMemory, ViewKeepsReplacedRepresentationAlive) {
+    runWithArray("a = np.arange(8, dtype=np.int32).reshape((2, 2, 2))\n", [](pybind11::array& arr) {
+        Volume volume(size3_t(2), DataFormat<int>::get());
+        pyutil::setVolumeData(volume, arr);
+        auto view = pyutil::getVolumeData(volume);
+        std::weak_ptr<const VolumeRAM> old = volume.getSharedRepresentation<VolumeRAM>();
+
+        pyutil::setVolumeData(volume, arr, false);
+        EXPECT_EQ(arr.data(), volume.getRepresentation<VolumeRAM>()->getData());
+        ASSERT_FALSE(old.expired());
+        EXPECT_EQ(view.data(), old.lock()->getData());
+        for (int i = 0; i < 8; ++i) EXPECT_EQ(i, static_cast<const int*>(view.data())[i]);
+
+        view = pybind11::array{};
+        EXPECT_TRUE(old.expired());
+    });
+}
+
+TEST(NumPyMemory, ArrayIsReleasedWithoutWaitingForTheGIL) {
+    runWithArray("a = np.arange(8, dtype=np.float32).reshape((2, 4))\n", [](pybind11::array& arr) {
+        const auto refs = arr.ref_count();
+        auto layer = pyutil::createLayer(arr);
+        EXPECT_EQ(refs + 1, arr.ref_count());
+
+        // This thread holds the GIL, the other thread must not wait for it
+        std::thread([layer = std::move(layer)]() mutable { layer.reset(); }).join();
+        pyutil::keepAlive(arr).reset();
+        EXPECT_EQ(refs, arr.ref_count());
+    });
+}
+
 }  // namespace inviwo
@@ -62,6 +62,7 @@ public:
     IntegralLine& front() { return lines_.front(); }
 
     size_t size() const;
+    void reserve(size_t size);
 
     IntegralLine& operator[](size_t idx);
     const IntegralLine& operator[](size_t idx) const;
@@ -35,8 +35,16 @@
 #include <inviwo/core/util/bufferutils.h>
 #include <modules/vectorfieldvisualization/properties/integrallineproperties.h>
 #include <modules/vectorfieldvisualization/datastructures/integralline.h>
-
+#include <modules/vectorfieldvisualization/datastructures/integrallineset.h>
+#include <inviwo/core/util/parallel.h>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 namespace inviwo {
 
@@ -69,6 +77,23 @@ public:
 
     Result traceFrom(const SpatialVector& pIn) const;
 
+    /**
+     * Trace a line from each of the seeds in parallel using util::parallelFor and append the lines
+     * with more than one point to lines. The lines are appended in seed order, independent of the
+     * scheduling, and get the index startIndex + the position of their seed.
+     * @param seeds container of seed points convertible to SpatialVector
+     * @param startIndex index of the first seed
+     * @param lines the set to append the lines to
+     * @param stop optional stop token, for example a pool::Stop. Once it is true the remaining
+     * seeds are skipped and nothing is appended.
+     * @param progress optional callback, called with the number of traced seeds and the total
+     * number of seeds. The calls are serialized.
+     */
+    template <typename Seeds, typename Stop = util::detail::NoStop>
+    void traceFrom(const Seeds& seeds, size_t startIndex, IntegralLineSet& lines,
+                   const Stop& stop = Stop{},
+                   const std::function<void(size_t, size_t)>& progress = nullptr) const;
+
     void addMetaDataSampler(const std::string& name, std::shared_ptr<const Sampler> sampler);
 
     const DataHomogenouSpatialMatrixrix& getSeedTransformationMatrix() const;
@@ -76,15 +101,35 @@ public:
 private:
     inline SpatialVector seedTransform(const SpatialVector& seed) const;
 
-    std::pair<SpatialVector, DataVector> step(const SpatialVector& oldPos,
-                                              const double stepSize) const;
+    static DataVector normalize(const DataVector& v);
+    SpatialVector move(const SpatialVector& pos, DataVector v, double stepSize) const;
 
-    bool addPoint(IntegralLine& line, const SpatialVector& pos) const;
-    bool addPoint(IntegralLine& line, const SpatialVector& pos,
-                  const DataVector& worldVelocity) const;
+    /**
+     * Sample sampler at all positions, with a single sampleBatch call if the sampler supports it.
+     */
+    static void sample(const Sampler& sampler, util::span<const SpatialVector> positions,
+                       util::span<DataVector> result);
 
-    IntegralLine::TerminationReason integrate(size_t steps, SpatialVector pos, IntegralLine& line,
-                                              bool fwd) const;
+    /**
+     * Trace a line from each of the seeds, given in the space of the sampler. The lines are
+     * integrated in lockstep, each integration stage samples all active lines at once.
+     */
+    void trace(util::span<const SpatialVector> seeds, util::span<Result> results) const;
+
+    /**
+     * Append a point with the given velocity to each of the lines, and sample the meta data at
+     * the points.
+     */
+    void addPoints(util::span<Result> results, const std::vector<size_t>& lines,
+                   const std::vector<SpatialVector>& positions,
+                   const std::vector<DataVector>& velocities) const;
+
+    /**
+     * Integrate the lines for at most steps steps from the positions and set their termination
+     * reason for the direction.
+     */
+    void integrate(size_t steps, util::span<Result> results, std::vector<size_t> lines,
+                   std::vector<SpatialVector> positions, bool fwd) const;
 
     IntegralLineProperties::IntegrationScheme integrationScheme_;
 
@@ -118,48 +163,52 @@ typename IntegralLineTracer<SpatialSampler, TimeDependent>::Result
 IntegralLineTracer<SpatialSampler, TimeDependent>::traceFrom(const SpatialVector& pIn) const {
     const SpatialVector p = seedTransform(pIn);
     Result res;
-    IntegralLine& line = res.line;
+    trace({&p, 1}, {&res, 1});
+    return res;
+}
 
-    const auto [stepsBWD, stepsFWD] = [dir = dir_, steps = steps_,
-                                       &line]() -> std::pair<size_t, size_t> {
-        switch (dir) {
-            case inviwo::IntegralLineProperties::Direction::FWD:
-                line.setBackwardTerminationReason(IntegralLine::TerminationReason::StartPoint);
-                return {1, steps + 1};
-            case inviwo::IntegralLineProperties::Direction::BWD:
-                line.setForwardTerminationReason(IntegralLine::TerminationReason::StartPoint);
-                return {steps + 1, 1};
-            default:
-            case inviwo::IntegralLineProperties::Direction::BOTH: {
-                return {steps / 2 + 1, steps - (steps / 2) + 1};
+template <typename SpatialSampler, bool TimeDependent>
+template <typename Seeds, typename Stop>
+void IntegralLineTracer<SpatialSampler, TimeDependent>::traceFrom(
+    const Seeds& seeds, size_t startIndex, IntegralLineSet& lines, const Stop& stop,
+    const std::function<void(size_t, size_t)>& progress) const {
+
+    const size_t nSeeds = seeds.size();
+    std::vector<IntegralLine> traced(nSeeds);
+    std::mutex progressMutex;
+    size_t finished = 0;
+
+    // The seeds of a chunk are traced together to sample them in batches. The cost of a line
+    // varies a lot with its length, hence the chunks are still kept small to balance the load.
+    util::parallelFor(
+        size_t{0}, nSeeds,
+        [&](size_t begin, size_t end) {
+            std::vector<SpatialVector> chunkSeeds;
+            chunkSeeds.reserve(end - begin);
+            for (size_t i = begin; i < end; ++i) {
+                chunkSeeds.push_back(seedTransform(SpatialVector(seeds[i])));
             }
-        }
-    }();
-
-    line.getPositions().reserve(steps_ + 2);
-    line.getMetaData<dvec3>("velocity", true).reserve(steps_ + 2);
-
-    if constexpr (TimeDependent) {
-        line.getMetaData<double>("timestamp", true).reserve(steps_ + 2);
-    }
-
-    for (auto& m : metaSamplers_) {
-        line.getMetaData<typename Sampler::ReturnType>(m.first, true).reserve(steps_ + 2);
-    }
-
-    if (!addPoint(line, p)) {
-        return res;  // Zero velocity at seed point
-    }
+            std::vector<Result> results(end - begin);
+            trace(chunkSeeds, results);
+            for (size_t i = begin; i < end; ++i) {
+                traced[i] = std::move(results[i - begin].line);
+            }
+            if (progress) {
+                std::scoped_lock lock{progressMutex};
+                finished += end - begin;
+                progress(finished, nSeeds);
+            }
+        },
+        std::clamp<size_t>(nSeeds / 256, 1, 64), stop);
 
-    line.setBackwardTerminationReason(integrate(stepsBWD, p, line, false));
+    if (static_cast<bool>(stop)) return;
 
-    if (line.getPositions().size() > 1) {
-        line.reverse();
-        res.seedIndex = line.getPositions().size() - 1;
+    lines.reserve(lines.size() + nSeeds);
+    for (size_t i = 0; i < nSeeds; ++i) {
+        if (traced[i].getPositions().size() > 1) {
+            lines.push_back(std::move(traced[i]), startIndex + i);
+        }
     }
-
-    line.setForwardTerminationReason(integrate(stepsFWD, p, line, true));
-    return res;
 }
 
 template <typename SpatialSampler, bool TimeDependent>
@@ -190,95 +239,225 @@ IntegralLineTracer<SpatialSampler, TimeDependent>::seedTransform(const SpatialVe
 }
 
 template <typename SpatialSampler, bool TimeDependent>
-std::pair<typename IntegralLineTracer<SpatialSampler, TimeDependent>::SpatialVector,
-          typename IntegralLineTracer<SpatialSampler, TimeDependent>::DataVector>
-IntegralLineTracer<SpatialSampler, TimeDependent>::step(const SpatialVector& oldPos,
-                                                        const double stepSize) const {
-    auto normalize = [](const auto v) {
-        auto l = glm::length(v);
-        if (l == 0) return v;
-        return v / l;
-    };
+typename IntegralLineTracer<SpatialSampler, TimeDependent>::DataVector
+IntegralLineTracer<SpatialSampler, TimeDependent>::normalize(const DataVector& v) {
+    auto l = glm::length(v);
+    if (l == 0) return v;
+    return v / l;
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+typename IntegralLineTracer<SpatialSampler, TimeDependent>::SpatialVector
+IntegralLineTracer<SpatialSampler, TimeDependent>::move(const SpatialVector& pos, DataVector v,
+                                                        double stepSize) const {
+    if (normalizeSamples_) {
+        v = normalize(v);
+    }
+    auto offset = (invBasis_ * (v * stepSize));
+    if constexpr (TimeDependent) {
+        return pos + SpatialVector(offset, stepSize);
+    } else {
+        return pos + offset;
+    }
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+void IntegralLineTracer<SpatialSampler, TimeDependent>::sample(
+    const Sampler& sampler, util::span<const SpatialVector> positions,
+    util::span<DataVector> result) {
+    if constexpr (!TimeDependent && std::is_same_v<typename Sampler::ReturnType, DataVector>) {
+        sampler.sampleBatch(positions, result);
+    } else {
+        for (size_t i = 0; i < positions.size(); ++i) {
+            result[i] = sampler.sample(positions[i]);
+        }
+    }
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+void IntegralLineTracer<SpatialSampler, TimeDependent>::trace(
+    util::span<const SpatialVector> seeds, util::span<Result> results) const {
 
-    auto move = [&](const auto& pos, auto v, const auto stepsize) {
-        if (normalizeSamples_) {
-            v = normalize(v);
+    const auto [stepsBWD, stepsFWD] = [dir = dir_, steps = steps_]() -> std::pair<size_t, size_t> {
+        switch (dir) {
+            case inviwo::IntegralLineProperties::Direction::FWD:
+                return {1, steps + 1};
+            case inviwo::IntegralLineProperties::Direction::BWD:
+                return {steps + 1, 1};
+            default:
+            case inviwo::IntegralLineProperties::Direction::BOTH: {
+                return {steps / 2 + 1, steps - (steps / 2) + 1};
+            }
         }
-        auto offset = (invBasis_ * (v * stepsize));
+    }();
+
+    for (auto& res : results) {
+        IntegralLine& line = res.line;
+        if (dir_ == IntegralLineProperties::Direction::FWD) {
+            line.setBackwardTerminationReason(IntegralLine::TerminationReason::StartPoint);
+        } else if (dir_ == IntegralLineProperties::Direction::BWD) {
+            line.setForwardTerminationReason(IntegralLine::TerminationReason::StartPoint);
+        }
+
+        line.getPositions().reserve(steps_ + 2);
+        line.getMetaData<dvec3>("velocity", true).reserve(steps_ + 2);
+
         if constexpr (TimeDependent) {
-            return pos + SpatialVector(offset, stepsize);
-        } else {
-            return pos + offset;
+            line.getMetaData<double>("timestamp", true).reserve(steps_ + 2);
         }
-    };
 
-    auto k1 = sampler_->sample(oldPos);
-
-    switch (integrationScheme_) {
-        case inviwo::IntegralLineProperties::IntegrationScheme::Euler:
-            return {move(oldPos, k1, stepSize), k1};
-        default:
-            [[fallthrough]];
-        case inviwo::IntegralLineProperties::IntegrationScheme::RK4: {
-            const auto k2 = sampler_->sample(move(oldPos, k1, stepSize / 2));
-            const auto k3 = sampler_->sample(move(oldPos, k2, stepSize / 2));
-            const auto k4 = sampler_->sample(move(oldPos, k3, stepSize));
-            const auto&& K = [n = normalizeSamples_, normalize, &k1, &k2, &k3, &k4]() {
-                if (n) {
-                    return normalize(k1 + k2 + k2 + k3 + k3 + k4);
-                } else {
-                    return (k1 + k2 + k2 + k3 + k3 + k4) * (1.0 / 6.0);
-                }
-            };
-            return {move(oldPos, K(), stepSize), k1};
+        for (auto& m : metaSamplers_) {
+            line.getMetaData<typename Sampler::ReturnType>(m.first, true).reserve(steps_ + 2);
         }
     }
-}
 
-template <typename SpatialSampler, bool TimeDependent>
-bool IntegralLineTracer<SpatialSampler, TimeDependent>::addPoint(IntegralLine& line,
-                                                                 const SpatialVector& pos) const {
-    return addPoint(line, pos, sampler_->sample(pos));
-}
+    std::vector<DataVector> velocities(seeds.size());
+    sample(*sampler_, seeds, velocities);
+
+    // Lines with zero velocity at the seed point are left empty
+    std::vector<size_t> lines;
+    std::vector<SpatialVector> positions;
+    for (size_t i = 0; i < seeds.size(); ++i) {
+        if (glm::length(velocities[i]) >= std::numeric_limits<double>::epsilon()) {
+            velocities[lines.size()] = velocities[i];
+            lines.push_back(i);
+            positions.push_back(seeds[i]);
+        }
+    }
+    velocities.resize(lines.size());
+    addPoints(results, lines, positions, velocities);
 
-template <typename SpatialSampler, bool TimeDependent>
-bool IntegralLineTracer<SpatialSampler, TimeDependent>::addPoint(
-    IntegralLine& line, const SpatialVector& pos, const DataVector& worldVelocity) const {
+    integrate(stepsBWD, results, lines, positions, false);
 
-    if (glm::length(worldVelocity) < std::numeric_limits<double>::epsilon()) {
-        return false;
+    for (auto i : lines) {
+        IntegralLine& line = results[i].line;
+        if (line.getPositions().size() > 1) {
+            line.reverse();
+            results[i].seedIndex = line.getPositions().size() - 1;
+        }
     }
 
-    line.getPositions().emplace_back(util::glm_convert<dvec3>(pos));
-    line.getMetaData<dvec3>("velocity").emplace_back(util::glm_convert<dvec3>(worldVelocity));
+    integrate(stepsFWD, results, std::move(lines), std::move(positions), true);
+}
 
-    if constexpr (TimeDependent) {
-        line.getMetaData<double>("timestamp").emplace_back(pos[Sampler::SpatialDimensions - 1]);
+template <typename SpatialSampler, bool TimeDependent>
+void IntegralLineTracer<SpatialSampler, TimeDependent>::addPoints(
+    util::span<Result> results, const std::vector<size_t>& lines,
+    const std::vector<SpatialVector>& positions, const std::vector<DataVector>& velocities) const {
+
+    for (size_t i = 0; i < lines.size(); ++i) {
+        IntegralLine& line = results[lines[i]].line;
+        line.getPositions().emplace_back(util::glm_convert<dvec3>(positions[i]));
+        line.getMetaData<dvec3>("velocity").emplace_back(util::glm_convert<dvec3>(velocities[i]));
+
+        if constexpr (TimeDependent) {
+            line.getMetaData<double>("timestamp")
+                .emplace_back(positions[i][Sampler::SpatialDimensions - 1]);
+        }
     }
 
+    std::vector<DataVector> values(lines.size());
     for (auto& m : metaSamplers_) {
-        line.getMetaData<typename Sampler::ReturnType>(m.first).emplace_back(
-            util::glm_convert<dvec3>(m.second->sample(pos)));
+        sample(*m.second, positions, values);
+        for (size_t i = 0; i < lines.size(); ++i) {
+            IntegralLine& line = results[lines[i]].line;
+            line.getMetaData<typename Sampler::ReturnType>(m.first).emplace_back(
+                util::glm_convert<dvec3>(values[i]));
+        }
     }
-    return true;
 }
 
 template <typename SpatialSampler, bool TimeDependent>
-IntegralLine::TerminationReason IntegralLineTracer<SpatialSampler, TimeDependent>::integrate(
-    size_t steps, SpatialVector pos, IntegralLine& line, bool fwd) const {
-    if (steps == 0) return IntegralLine::TerminationReason::StartPoint;
-    for (size_t i = 0; i < steps; i++) {
-        if (!sampler_->withinBounds(pos)) {
-            return IntegralLine::TerminationReason::OutOfBounds;
+void IntegralLineTracer<SpatialSampler, TimeDependent>::integrate(
+    size_t steps, util::span<Result> results, std::vector<size_t> lines,
+    std::vector<SpatialVector> positions, bool fwd) const {
+
+    const auto terminate = [&](size_t i, IntegralLine::TerminationReason reason) {
+        if (fwd) {
+            results[i].line.setForwardTerminationReason(reason);
+        } else {
+            results[i].line.setBackwardTerminationReason(reason);
         }
-        auto res = step(pos, stepSize_ * (fwd ? 1.0 : -1.0));
-        pos = res.first;
+    };
 
-        if (!addPoint(line, pos, res.second)) {
-            return IntegralLine::TerminationReason::ZeroVelocity;
+    if (steps == 0) {
+        for (auto i : lines) terminate(i, IntegralLine::TerminationReason::StartPoint);
+        return;
+    }
+
+    const double stepSize = stepSize_ * (fwd ? 1.0 : -1.0);
+    std::vector<SpatialVector> stage;
+    std::vector<SpatialVector> next;
+    std::vector<DataVector> k1;
+    std::vector<DataVector> k2;
+    std::vector<DataVector> k3;
+    std::vector<DataVector> k4;
+
+    for (size_t step = 0; step < steps && !lines.empty(); ++step) {
+        size_t n = 0;
+        for (size_t i = 0; i < lines.size(); ++i) {
+            if (sampler_->withinBounds(positions[i])) {
+                lines[n] = lines[i];
+                positions[n] = positions[i];
+                ++n;
+            } else {
+                terminate(lines[i], IntegralLine::TerminationReason::OutOfBounds);
+            }
+        }
+        lines.resize(n);
+        positions.resize(n);
+        stage.resize(n);
+        next.resize(n);
+        k1.resize(n);
+
+        sample(*sampler_, positions, k1);
+
+        switch (integrationScheme_) {
+            case inviwo::IntegralLineProperties::IntegrationScheme::Euler:
+                for (size_t i = 0; i < n; ++i) next[i] = move(positions[i], k1[i], stepSize);
+                break;
+            default:
+                [[fallthrough]];
+            case inviwo::IntegralLineProperties::IntegrationScheme::RK4: {
+                k2.resize(n);
+                k3.resize(n);
+                k4.resize(n);
+                for (size_t i = 0; i < n; ++i) stage[i] = move(positions[i], k1[i], stepSize / 2);
+                sample(*sampler_, stage, k2);
+                for (size_t i = 0; i < n; ++i) stage[i] = move(positions[i], k2[i], stepSize / 2);
+                sample(*sampler_, stage, k3);
+                for (size_t i = 0; i < n; ++i) stage[i] = move(positions[i], k3[i], stepSize);
+                sample(*sampler_, stage, k4);
+                for (size_t i = 0; i < n; ++i) {
+                    const auto K = k1[i] + k2[i] + k2[i] + k3[i] + k3[i] + k4[i];
+                    next[i] = move(positions[i], normalizeSamples_ ? normalize(K) : K * (1.0 / 6.0),
+                                   stepSize);
+                }
+                break;
+            }
+        }
+
+        // The velocity at the start of the step is stored with the new point, a line with zero
+        // velocity ends without the new point
+        n = 0;
+        for (size_t i = 0; i < lines.size(); ++i) {
+            if (glm::length(k1[i]) < std::numeric_limits<double>::epsilon()) {
+                terminate(lines[i], IntegralLine::TerminationReason::ZeroVelocity);
+            } else {
+                lines[n] = lines[i];
+                positions[n] = next[i];
+                k1[n] = k1[i];
+                ++n;
+            }
         }
+        lines.resize(n);
+        positions.resize(n);
+        k1.resize(n);
+
+        addPoints(results, lines, positions, k1);
     }
-    return IntegralLine::TerminationReason::Steps;
+
+    for (auto i : lines) terminate(i, IntegralLine::TerminationReason::Steps);
 }
 
 using StreamLine2DTracer = IntegralLineTracer<SpatialSampler<2, 2, double>>;
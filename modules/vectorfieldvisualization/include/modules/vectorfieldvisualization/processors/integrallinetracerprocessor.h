@@ -30,7 +30,7 @@
 #pragma once
 
 #include <modules/vectorfieldvisualization/vectorfieldvisualizationmoduledefine.h>
-#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/processors/processortraits.h>
 #include <inviwo/core/properties/ordinalproperty.h>
 #include <inviwo/core/properties/compositeproperty.h>
@@ -38,7 +38,6 @@
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/ports/imageport.h>
 #include <inviwo/core/util/utilities.h>
-#include <inviwo/core/util/foreach.h>
 #include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
 #include <modules/vectorfieldvisualization/integrallinetracer.h>
 #include <modules/vectorfieldvisualization/ports/seedpointsport.h>
@@ -46,7 +45,7 @@
 namespace inviwo {
 
 template <typename Tracer>
-class IntegralLineTracerProcessor : public Processor {
+class IntegralLineTracerProcessor : public PoolProcessor {
 public:
     IntegralLineTracerProcessor();
     virtual ~IntegralLineTracerProcessor();
@@ -71,7 +70,8 @@ private:
 
 template <typename Tracer>
 IntegralLineTracerProcessor<Tracer>::IntegralLineTracerProcessor()
-    : sampler_("sampler")
+    : PoolProcessor()
+    , sampler_("sampler")
     , seeds_("seeds")
     , annotationSamplers_("annotationSamplers")
     , lines_("lines")
@@ -102,8 +102,6 @@ IntegralLineTracerProcessor<Tracer>::~IntegralLineTracerProcessor() {}
 template <typename Tracer>
 void IntegralLineTracerProcessor<Tracer>::process() {
     auto sampler = sampler_.getData();
-    auto lines =
-        std::make_shared<IntegralLineSet>(sampler->getModelMatrix(), sampler->getWorldMatrix());
 
     Tracer tracer(sampler, properties_);
 
@@ -113,28 +111,39 @@ void IntegralLineTracerProcessor<Tracer>::process() {
         tracer.addMetaDataSampler(key, meta.second);
     }
 
-    std::mutex mutex;
-    size_t startID = 0;
-    for (const auto& seeds : seeds_) {
-        util::forEachParallel(*seeds, [&](const auto& p, size_t i) {
-            IntegralLine line = tracer.traceFrom(p);
-            auto size = line.getPositions().size();
-            if (size > 1) {
-                std::lock_guard<std::mutex> lock(mutex);
-                lines->push_back(std::move(line), startID + i);
-            }
-        });
-        startID += seeds->size();
-    }
-
-    if (calculateCurvature_) {
-        util::curvature(*lines);
-    }
-    if (calculateTortuosity_) {
-        util::tortuosity(*lines);
-    }
-
-    lines_.setData(lines);
+    const auto calc = [tracer, sampler, seeds = seeds_.getVectorData(),
+                       curvature = calculateCurvature_.get(),
+                       tortuosity = calculateTortuosity_.get()](
+                          pool::Stop stop,
+                          pool::Progress progress) -> std::shared_ptr<IntegralLineSet> {
+        auto lines =
+            std::make_shared<IntegralLineSet>(sampler->getModelMatrix(), sampler->getWorldMatrix());
+
+        size_t total = 0;
+        for (const auto& s : seeds) total += s->size();
+
+        size_t startID = 0;
+        for (const auto& s : seeds) {
+            tracer.traceFrom(*s, startID, *lines, stop,
+                             [&](size_t traced, size_t) { progress(startID + traced, total); });
+            if (stop) return nullptr;
+            startID += s->size();
+        }
+
+        if (curvature) {
+            util::curvature(*lines);
+        }
+        if (tortuosity) {
+            util::tortuosity(*lines);
+        }
+        return lines;
+    };
+
+    lines_.clear();
+    dispatchOne(calc, [this](std::shared_ptr<IntegralLineSet> result) {
+        lines_.setData(result);
+        newResults();
+    });
 }
 
 using StreamLines2D = IntegralLineTracerProcessor<StreamLine2DTracer>;
@@ -49,6 +49,8 @@ std::vector<IntegralLine>::iterator IntegralLineSet::end() { return lines_.end()
 
 size_t IntegralLineSet::size() const { return lines_.size(); }
 
+void IntegralLineSet::reserve(size_t size) { lines_.reserve(size); }
+
 IntegralLine& IntegralLineSet::operator[](size_t idx) { return lines_[idx]; }
 
 const IntegralLine& IntegralLineSet::operator[](size_t idx) const { return lines_[idx]; }
@@ -75,12 +77,12 @@ void IntegralLineSet::push_back(IntegralLine&& line, SetIndex updateIndex) {
     if (updateIndex == SetIndex::Yes) {
         line.setIndex(lines_.size());
     }
-    lines_.push_back(line);
+    lines_.push_back(std::move(line));
 }
 
 void IntegralLineSet::push_back(IntegralLine&& line, size_t idx) {
     line.setIndex(idx);
-    lines_.push_back(line);
+    lines_.push_back(std::move(line));
 }
 
 }  // namespace inviwo
@@ -36,9 +36,7 @@
 #include <inviwo/core/util/zip.h>
 #include <modules/vectorfieldvisualization/integrallinetracer.h>
 
-#ifdef IVW_USE_OPENMP
-#include <omp.h>
-#endif
+#include <algorithm>
 
 namespace inviwo {
 
@@ -149,26 +147,17 @@ void PathLinesDeprecated::process() {
 
     auto lines = std::make_shared<IntegralLineSet>(sampler->getModelMatrix());
     std::vector<BasicMesh::Vertex> vertices;
-    size_t startID = 0;
     for (const auto& seeds : seedPoints_) {
-
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-        for (long long j = 0; j < static_cast<long long>(seeds->size()); j++) {
-            const auto& p = (*seeds)[j];
-            vec4 P = m * vec4(p, 1.0f);
-            IntegralLine line = tracer.traceFrom(vec4(vec3(P), pathLineProperties_.getStartT()));
-            auto size = line.getPositions().size();
-            if (size > 1) {
-#ifdef IVW_USE_OPENMP
-#pragma omp critical
-#endif
-                // lines->push_back(line, startID + j);
-                lines->push_back(line, lines->size());
-            };
+        std::vector<vec4> points(seeds->size());
+        std::transform(seeds->begin(), seeds->end(), points.begin(), [&](const auto& p) {
+            return vec4(vec3(m * vec4(p, 1.0f)), pathLineProperties_.getStartT());
+        });
+        // The lines are numbered consecutively, skipping the seeds that gave no line
+        IntegralLineSet traced(sampler->getModelMatrix());
+        tracer.traceFrom(points, 0, traced);
+        for (auto& line : traced) {
+            lines->push_back(std::move(line), IntegralLineSet::SetIndex::Yes);
         }
-        startID += seeds->size();
     }
 
     for (auto& line : *lines) {
@@ -38,12 +38,12 @@
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/imagesampler.h>
 #include <inviwo/core/util/volumesampler.h>
-#include <inviwo/core/util/foreach.h>
 
 #include <modules/vectorfieldvisualization/processors/integrallinetracerprocessor.h>
 #include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
 #include <modules/vectorfieldvisualization/integrallinetracer.h>
 
+#include <algorithm>
 #include <bitset>
 
 namespace inviwo {
@@ -139,21 +139,13 @@ void StreamLinesDeprecated::process() {
 
     std::vector<BasicMesh::Vertex> vertices;
 
-    std::mutex mutex;
-
     if (useMutliThreading_) {
         size_t startID = 0;
-
         for (const auto &seeds : seedPoints_) {
-            util::forEachParallel(*seeds, [&](const auto &p, size_t i) {
-                vec4 P = m * vec4(p, 1.0f);
-                IntegralLine line = tracer.traceFrom(vec3(P));
-                auto size = line.getPositions().size();
-                if (size > 1) {
-                    std::lock_guard<std::mutex> lock(mutex);
-                    lines->push_back(line, startID + i);
-                };
-            });
+            std::vector<vec3> points(seeds->size());
+            std::transform(seeds->begin(), seeds->end(), points.begin(),
+                           [&](const auto &p) { return vec3(m * vec4(p, 1.0f)); });
+            tracer.traceFrom(points, startID, *lines);
             startID += seeds->size();
         }
     } else {
@@ -161,10 +153,10 @@ void StreamLinesDeprecated::process() {
         for (const auto &seeds : seedPoints_) {
             for (const auto &p : *seeds.get()) {
                 vec4 P = m * vec4(p, 1.0f);
-                IntegralLine line = tracer.traceFrom(vec3(P));
+                IntegralLine line = tracer.traceFrom(vec3(P)).line;
                 auto size = line.getPositions().size();
                 if (size > 1) {
-                    lines->push_back(line, startID);
+                    lines->push_back(std::move(line), startID);
                 }
                 startID++;
             }
@@ -37,6 +37,8 @@
 #include <modules/vectorfieldvisualization/integrallinetracer.h>
 #include <inviwo/core/util/volumesampler.h>
 
+#include <algorithm>
+
 namespace inviwo {
 
 // The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
@@ -148,83 +150,88 @@ void StreamRibbonsDeprecated::process() {
     bool hasColors = colors_.hasData();
     size_t lineId = 0;
 
+    IntegralLineSet lines(sampler->getModelMatrix());
+    size_t startID = 0;
     for (const auto &seeds : seedPoints_) {
-        for (auto &p : (*seeds)) {
-            vec4 P = m * vec4(p, 1.0f);
-            IntegralLine line = tracer.traceFrom(vec3(P));
-
-            auto position = line.getPositions().begin();
-            auto velocity = line.getMetaData<dvec3>("velocity").begin();
-            auto vorticity = line.getMetaData<dvec3>("vorticity").begin();
-
-            auto size = line.getPositions().size();
-            if (size <= 1) continue;
-            auto indexBuffer = mesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::Strip);
-            indexBuffer->getDataContainer().reserve(size);
-
-            vec4 c{0};
-            if (hasColors) {
-                if (lineId >= colors_.getData()->size()) {
-                    LogWarn("The vector of colors is smaller then the vector of seed points");
-                } else {
-                    c = colors_.getData()->at(lineId);
-                }
+        std::vector<vec3> points(seeds->size());
+        std::transform(seeds->begin(), seeds->end(), points.begin(),
+                       [&](const auto &p) { return vec3(m * vec4(p, 1.0f)); });
+        tracer.traceFrom(points, startID, lines);
+        startID += seeds->size();
+    }
+
+    for (const auto &line : lines) {
+        auto position = line.getPositions().begin();
+        auto velocity = line.getMetaData<dvec3>("velocity").begin();
+        auto vorticity = line.getMetaData<dvec3>("vorticity").begin();
+
+        auto size = line.getPositions().size();
+        if (size <= 1) continue;
+        auto indexBuffer = mesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::Strip);
+        indexBuffer->getDataContainer().reserve(size);
+
+        vec4 c{0};
+        if (hasColors) {
+            if (lineId >= colors_.getData()->size()) {
+                LogWarn("The vector of colors is smaller then the vector of seed points");
+            } else {
+                c = colors_.getData()->at(lineId);
             }
-            lineId++;
-
-            for (size_t i = 0; i < size; i++) {
-                auto vort = invBasis * glm::normalize(vec3(*vorticity));
-                auto velo = invBasis * glm::normalize(vec3(*velocity));
-                auto N = glm::normalize(glm::cross(vort, velo));
-                vort *= (0.5f * ribbonWidth_.get());
-                auto velocityMagnitude = glm::length(*velocity);
-                auto vortictyMagnitude = glm::length(*vorticity);
-
-                maxVelocity = std::max(maxVelocity, velocityMagnitude);
-                maxVorticity = std::max(maxVorticity, vortictyMagnitude);
-
-                vec3 p0 = vec3(*position) - vort;
-                vec3 p1 = vec3(*position) + vort;
-
-                float d;
-                switch (coloringMethod_.get()) {
-                    case ColoringMethod::Vorticity:
-                        d = glm::clamp(static_cast<float>(vortictyMagnitude) / velocityScale_.get(),
-                                       0.0f, 1.0f);
-                        c = vec4(tf.sample(dvec2(d, 0.0)));
+        }
+        lineId++;
+
+        for (size_t i = 0; i < size; i++) {
+            auto vort = invBasis * glm::normalize(vec3(*vorticity));
+            auto velo = invBasis * glm::normalize(vec3(*velocity));
+            auto N = glm::normalize(glm::cross(vort, velo));
+            vort *= (0.5f * ribbonWidth_.get());
+            auto velocityMagnitude = glm::length(*velocity);
+            auto vortictyMagnitude = glm::length(*vorticity);
+
+            maxVelocity = std::max(maxVelocity, velocityMagnitude);
+            maxVorticity = std::max(maxVorticity, vortictyMagnitude);
+
+            vec3 p0 = vec3(*position) - vort;
+            vec3 p1 = vec3(*position) + vort;
+
+            float d;
+            switch (coloringMethod_.get()) {
+                case ColoringMethod::Vorticity:
+                    d = glm::clamp(static_cast<float>(vortictyMagnitude) / velocityScale_.get(),
+                                   0.0f, 1.0f);
+                    c = vec4(tf.sample(dvec2(d, 0.0)));
+                    break;
+                case ColoringMethod::ColorPort:
+                    if (hasColors) {
                         break;
-                    case ColoringMethod::ColorPort:
-                        if (hasColors) {
-                            break;
-                        } else {
-                            LogWarn(
-                                "No colors in the color port, using velocity for coloring "
-                                "instead ");
-                            [[fallthrough]];
-                        }
-                    default:
+                    } else {
+                        LogWarn(
+                            "No colors in the color port, using velocity for coloring "
+                            "instead ");
                         [[fallthrough]];
-                    case ColoringMethod::Velocity:
-                        d = glm::clamp(static_cast<float>(velocityMagnitude) / velocityScale_.get(),
-                                       0.0f, 1.0f);
-                        c = vec4(tf.sample(dvec2(d, 0.0)));
-                        break;
-                }
+                    }
+                default:
+                    [[fallthrough]];
+                case ColoringMethod::Velocity:
+                    d = glm::clamp(static_cast<float>(velocityMagnitude) / velocityScale_.get(),
+                                   0.0f, 1.0f);
+                    c = vec4(tf.sample(dvec2(d, 0.0)));
+                    break;
+            }
 
-                indexBuffer->add(static_cast<std::uint32_t>(vertices.size()));
-                indexBuffer->add(static_cast<std::uint32_t>(vertices.size() + 1));
-                vertices.push_back({p0, N, p0, c});
-                vertices.push_back({p1, N, p1, c});
+            indexBuffer->add(static_cast<std::uint32_t>(vertices.size()));
+            indexBuffer->add(static_cast<std::uint32_t>(vertices.size() + 1));
+            vertices.push_back({p0, N, p0, c});
+            vertices.push_back({p1, N, p1, c});
 
-                position++;
-                velocity++;
-                vorticity++;
-            }
+            position++;
+            velocity++;
+            vorticity++;
         }
-
-        maxVelocity_.set(toString(maxVelocity));
-        maxVorticity_.set(toString(maxVorticity));
     }
+
+    maxVelocity_.set(toString(maxVelocity));
+    maxVorticity_.set(toString(maxVorticity));
     mesh->addVertices(vertices);
     mesh_.setData(mesh);
 }
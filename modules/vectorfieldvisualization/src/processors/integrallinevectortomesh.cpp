@@ -32,8 +32,11 @@
 #include <modules/vectorfieldvisualization/processors/3d/streamlines.h>
 #include <inviwo/core/datastructures/geometry/basicmesh.h>
 #include <inviwo/core/network/networklock.h>
-#include <inviwo/core/util/zip.h>
 #include <inviwo/core/util/raiiutils.h>
+#include <inviwo/core/util/parallel.h>
+
+#include <atomic>
+#include <numeric>
 
 namespace inviwo {
 
@@ -294,10 +297,6 @@ void IntegralLineVectorToMesh::process() {
     mesh->setModelMatrix(lines_.getData()->getModelMatrix());
     mesh->setWorldMatrix(lines_.getData()->getWorldMatrix());
 
-    std::vector<BasicMesh::Vertex> vertices;
-
-    vertices.reserve(lines_.getData()->size() * 2000);
-
     auto metaDataKey = colorBy_.get();
 
     const bool constantColor = (metaDataKey == "constant");
@@ -322,137 +321,176 @@ void IntegralLineVectorToMesh::process() {
         }
     }
 
-    double minMetaData = std::numeric_limits<double>::max();
-    double maxMetaData = std::numeric_limits<double>::lowest();
-
-    bool colorWarningOnce = true;
+    const Output output = output_.get();
+    const size_t stride = std::max(size_t{1}, stride_.get());
+    const vec4 selectedColor = selectedColor_.get();
+    const auto colors = colorByPort ? colors_.getData() : nullptr;
+    const float halfWidth = ribbonWidth_.get() / 2.0f;
 
-    Output output = output_.get();
+    // need to keep the two first and two last when using adjacency information
+    const auto keepPoint = [stride](size_t pointIdx, size_t size) {
+        return pointIdx <= 1 || pointIdx + 2 >= size || pointIdx % stride == 0;
+    };
 
-    size_t lineIdx = 0;
     const auto data = lines_.getData();
-    for (auto& line : *data) {
-        util::OnScopeExit incIdx([&lineIdx]() { lineIdx++; });
-        auto size = line.getPositions().size();
-
-        if (size == 0 || isFiltered(line, lineIdx)) continue;
-
-        auto indexBuffer = [&]() -> std::shared_ptr<IndexBufferRAM> {
-            if (output == Output::Lines) {
-                auto ib = mesh->addIndexBuffer(DrawType::Lines, ConnectivityType::StripAdjacency);
-                ib->getDataContainer().reserve(size + 2);
-                return ib;
-            } else if (output == Output::Ribbons) {
-                auto ib = mesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::Strip);
-                ib->getDataContainer().reserve(size * 2);
-                return ib;
+    const size_t nLines = data->size();
+
+    // Every line writes its vertices and indices into its own ranges of one preallocated vertex
+    // vector and one index buffer, that way the lines can be generated in parallel and in input
+    // order. Instead of a strip per line, lines are drawn as separate segments with adjacency and
+    // ribbons as separate triangles, which gives the same primitives as the strips.
+    const auto indexCount = [output](size_t vertexCount) -> size_t {
+        if (vertexCount < 4) return 0;
+        return output == Output::Lines ? 4 * (vertexCount - 3) : 3 * (vertexCount - 2);
+    };
+    std::vector<size_t> offsets(nLines + 1, 0);
+    std::vector<size_t> indexOffsets(nLines + 1, 0);
+    util::parallelFor(size_t{0}, nLines, [&](size_t lineIdx) {
+        const auto& line = (*data)[lineIdx];
+        const auto size = line.getPositions().size();
+        if (size == 0 || isFiltered(line, lineIdx)) return;
+
+        if (output == Output::Ribbons) {
+            offsets[lineIdx + 1] = 2 * size;
+        } else {
+            size_t count = 0;
+            for (size_t pointIdx = 0; pointIdx < size; ++pointIdx) {
+                if (keepPoint(pointIdx, size)) ++count;
+            }
+            offsets[lineIdx + 1] = count;
+        }
+        indexOffsets[lineIdx + 1] = indexCount(offsets[lineIdx + 1]);
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::partial_sum(indexOffsets.begin(), indexOffsets.end(), indexOffsets.begin());
+
+    std::vector<std::uint32_t> indices(indexOffsets.back());
+    std::vector<BasicMesh::Vertex> vertices(offsets.back());
+
+    const dvec2 scaleBy = mdProp ? mdProp->scaleBy_.get() : dvec2{0.0, 1.0};
+    const bool loopTF = mdProp && mdProp->loopTF_.get();
+    const TransferFunction* tf = mdProp ? &mdProp->tf_.get() : nullptr;
+
+    std::atomic<bool> colorOutOfRange{false};
+
+    using MinMax = std::pair<double, double>;
+    const auto generate = [&](size_t lineIdx, MinMax& minMax, auto metaData) {
+        const auto& line = (*data)[lineIdx];
+        const auto first = static_cast<std::uint32_t>(offsets[lineIdx]);
+        const auto count = static_cast<std::uint32_t>(offsets[lineIdx + 1] - offsets[lineIdx]);
+        auto index = indices.begin() + indexOffsets[lineIdx];
+        if (output == Output::Lines) {
+            // The first and last vertex of the line are only used as adjacency
+            for (std::uint32_t i = 1; i + 2 < count; ++i) {
+                *index++ = first + i - 1;
+                *index++ = first + i;
+                *index++ = first + i + 1;
+                *index++ = first + i + 2;
+            }
+        } else {
+            // Every other triangle is flipped to keep the winding of the strip
+            for (std::uint32_t i = 0; i + 2 < count; ++i) {
+                const bool flip = i % 2 == 1;
+                *index++ = first + (flip ? i + 1 : i);
+                *index++ = first + (flip ? i : i + 1);
+                *index++ = first + i + 2;
             }
-            throw Exception("Unsupported output type", IVW_CONTEXT);
-        }();
+        }
+        auto vertex = vertices.begin() + offsets[lineIdx];
 
-        auto coloring = [&, this](auto sample, size_t lineIndex, size_t lineNumber) -> vec4 {
-            if (constantColor || this->isSelected(line, lineIdx)) {
-                return selectedColor_.get();
+        const bool selected = isSelected(line, lineIdx);
+        const auto coloring = [&](const auto& mdValue) -> vec4 {
+            if (constantColor || selected) {
+                return selectedColor;
             }
 
             if (colorByPort) {
-                auto colors = colors_.getData();
-                size_t index = 0;
-                if (colorByPortNumber) {
-                    index = lineNumber;
-                } else if (colorByPortIndex) {
-                    index = lineIndex;
-                }
-
+                size_t index = colorByPortNumber ? lineIdx : line.getIndex();
                 if (index >= colors->size()) {
-                    if (colorWarningOnce) {
-                        colorWarningOnce = false;
-                        LogWarn("Line index for color is out of range");
-                    }
+                    colorOutOfRange = true;
                     index %= colors->size();
                 }
-                return colors->at(index);
+                return (*colors)[index];
             } else {
-                auto& mdValue = get<2>(sample);
                 double md = detail::norm(mdValue);
-                minMetaData = std::min(minMetaData, md);
-                maxMetaData = std::max(maxMetaData, md);
+                minMax.first = std::min(minMax.first, md);
+                minMax.second = std::max(minMax.second, md);
 
-                md -= mdProp->scaleBy_.get().x;
-                md /= mdProp->scaleBy_.get().y - mdProp->scaleBy_.get().x;
-                if (mdProp->loopTF_) {
+                md -= scaleBy.x;
+                md /= scaleBy.y - scaleBy.x;
+                if (loopTF) {
                     md -= std::floor(md);
                 }
-
-                return mdProp->tf_.get().sample(md);
+                return tf->sample(md);
             }
         };
 
-        auto lineLoop = [&coloring, &vertices, &indexBuffer, &lineIdx, this](
-                            const IntegralLine& line, auto mdContainter) {
-            size_t pointIdx = 0;
-            for (auto&& sample : util::zip(line.getPositions(), line.getMetaData<dvec3>("velocity"),
-                                           mdContainter)) {
-                util::OnScopeExit incPointIdx([&pointIdx]() { pointIdx++; });
-                bool first = pointIdx <= 1;
-                bool last = pointIdx >= line.getPositions().size() - 2;
-                // need to keep the two first and two last when using adjendency information
-                if (!first && !last && pointIdx % stride_.get() != 0) {
-                    continue;
-                }
-
-                vec3 pos = get<0>(sample);
-                vec3 vel = get<1>(sample);
+        const auto& positions = line.getPositions();
+        const auto& velocities = line.getMetaData<dvec3>("velocity");
+        const size_t size = positions.size();
 
-                vec4 color = coloring(sample, line.getIndex(), lineIdx);
+        if (output == Output::Lines) {
+            for (size_t pointIdx = 0; pointIdx < size; ++pointIdx) {
+                if (!keepPoint(pointIdx, size)) continue;
 
-                indexBuffer->add(static_cast<std::uint32_t>(vertices.size()));
-                vertices.push_back({pos, glm::normalize(vel), pos, color});
+                const vec3 pos{positions[pointIdx]};
+                const vec3 vel{velocities[pointIdx]};
+                const vec4 color = coloring(metaData(pointIdx));
+                *vertex++ = {pos, glm::normalize(vel), pos, color};
             }
-        };
-
-        auto ribbonLoop = [&coloring, &vertices, &indexBuffer, &lineIdx, this](
-                              const IntegralLine& line, auto mdContainter) {
-            for (auto&& sample : util::zip(line.getPositions(), line.getMetaData<dvec3>("velocity"),
-                                           mdContainter, line.getMetaData<dvec3>("vorticity"))) {
-                vec3 pos = get<0>(sample);
-                vec3 vel = get<1>(sample);
-                vec3 vor = get<3>(sample);
-
-                vec4 color = coloring(sample, line.getIndex(), lineIdx);
-
-                auto N = glm::normalize(glm::cross(vor, vel));
-
-                auto off = glm::normalize(vor) * (ribbonWidth_.get() / 2.0f);
-                auto pos1 = pos - off;
-                auto pos2 = pos + off;
-                indexBuffer->add(static_cast<std::uint32_t>(vertices.size()));
-                vertices.push_back({pos1, N, pos1, color});
-                indexBuffer->add(static_cast<std::uint32_t>(vertices.size()));
-                vertices.push_back({pos2, N, pos2, color});
-            }
-        };
-
-        if (mdProp) {
-            line.getMetaDataBuffer(metaDataKey)
-                ->getRepresentation<BufferRAM>()
-                ->dispatch<void>([&](auto mdBuf) {
-                    if (output == Output::Lines)
-                        lineLoop(line, mdBuf->getDataContainer());
-                    else {
-                        ribbonLoop(line, mdBuf->getDataContainer());
-                    }
-                });
         } else {
-            if (output == Output::Lines)
-                lineLoop(line, std::vector<int>(line.getPositions().size()));
-            else {
-                ribbonLoop(line, std::vector<int>(line.getPositions().size()));
+            const auto& vorticities = line.getMetaData<dvec3>("vorticity");
+            for (size_t pointIdx = 0; pointIdx < size; ++pointIdx) {
+                const vec3 pos{positions[pointIdx]};
+                const vec3 vel{velocities[pointIdx]};
+                const vec3 vor{vorticities[pointIdx]};
+                const vec4 color = coloring(metaData(pointIdx));
+
+                const auto N = glm::normalize(glm::cross(vor, vel));
+                const auto off = glm::normalize(vor) * halfWidth;
+                const auto pos1 = pos - off;
+                const auto pos2 = pos + off;
+                *vertex++ = {pos1, N, pos1, color};
+                *vertex++ = {pos2, N, pos2, color};
             }
         }
+    };
+
+    const auto [minMetaData, maxMetaData] = util::parallelReduce(
+        size_t{0}, nLines,
+        MinMax{std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()},
+        [&](size_t begin, size_t end, MinMax minMax) {
+            for (size_t lineIdx = begin; lineIdx < end; ++lineIdx) {
+                if (offsets[lineIdx + 1] == offsets[lineIdx]) continue;
+                if (mdProp) {
+                    (*data)[lineIdx]
+                        .getMetaDataBuffer(metaDataKey)
+                        ->getRepresentation<BufferRAM>()
+                        ->dispatch<void>([&](auto mdBuf) {
+                            const auto& md = mdBuf->getDataContainer();
+                            generate(lineIdx, minMax, [&md](size_t i) { return md[i]; });
+                        });
+                } else {
+                    generate(lineIdx, minMax, [](size_t) { return 0; });
+                }
+            }
+            return minMax;
+        },
+        [](MinMax a, MinMax b) {
+            return MinMax{std::min(a.first, b.first), std::max(a.second, b.second)};
+        });
+
+    if (colorOutOfRange) {
+        LogWarn("Line index for color is out of range");
     }
 
     mesh->addVertices(vertices);
+    if (!indices.empty()) {
+        auto ib = output == Output::Lines
+                      ? mesh->addIndexBuffer(DrawType::Lines, ConnectivityType::Adjacency)
+                      : mesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::None);
+        ib->getDataContainer() = std::move(indices);
+    }
 
     mesh_.setData(mesh);
     if (mdProp) {
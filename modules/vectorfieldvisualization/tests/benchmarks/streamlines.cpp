@@ -0,0 +1,148 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/settings/systemsettings.h>
+#include <inviwo/core/util/volumesampler.h>
+
+#include <modules/vectorfieldvisualization/integrallinetracer.h>
+#include <modules/vectorfieldvisualization/properties/integrallineproperties.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+static InviwoApplication* app = nullptr;
+
+// A helical vector field around the z axis of a size^3 volume.
+static std::shared_ptr<Volume> makeField(size_t size) {
+    auto ram = std::make_shared<VolumeRAMPrecision<vec3>>(size3_t{size});
+    auto data = ram->getDataTyped();
+    const auto scale = 1.0f / static_cast<float>(size - 1);
+    for (size_t z = 0; z < size; ++z) {
+        for (size_t y = 0; y < size; ++y) {
+            for (size_t x = 0; x < size; ++x) {
+                const auto p = vec3(x, y, z) * scale - vec3{0.5f};
+                data[(z * size + y) * size + x] = vec3{-p.y, p.x, 0.1f + 0.2f * p.z};
+            }
+        }
+    }
+    return std::make_shared<Volume>(ram);
+}
+
+// numSeeds seed points on a regular grid in data space, away from the boundary.
+static std::vector<vec3> makeSeeds(size_t numSeeds) {
+    const auto n = static_cast<size_t>(std::ceil(std::cbrt(static_cast<double>(numSeeds))));
+    std::vector<vec3> seeds;
+    seeds.reserve(numSeeds);
+    for (size_t i = 0; i < numSeeds; ++i) {
+        const auto p = vec3(i % n, (i / n) % n, i / (n * n)) / static_cast<float>(n);
+        seeds.push_back(vec3{0.2f} + 0.6f * p);
+    }
+    return seeds;
+}
+
+static std::shared_ptr<IntegralLineProperties> makeProperties(int steps) {
+    auto properties = std::make_shared<IntegralLineProperties>("properties", "Properties");
+    properties->numberOfSteps_.set(steps);
+    properties->stepSize_.set(0.002f);
+    properties->stepDirection_.set(IntegralLineProperties::Direction::BOTH);
+    properties->integrationScheme_.set(IntegralLineProperties::IntegrationScheme::RK4);
+    return properties;
+}
+
+// Trace one seed at a time with traceFrom(seed), i.e. sampling a single position per call, like
+// the tracer did before the lines of a chunk were traced together.
+static void StreamLines3DSingle(benchmark::State& state) {
+    const auto volume = makeField(64);
+    const auto seeds = makeSeeds(static_cast<size_t>(state.range(0)));
+    const auto properties = makeProperties(200);
+    const StreamLine3DTracer tracer(std::make_shared<VolumeDoubleSampler<3>>(volume), *properties);
+
+    for (auto _ : state) {
+        size_t points = 0;
+        for (const auto& seed : seeds) {
+            points += tracer.traceFrom(dvec3{seed}).line.getPositions().size();
+        }
+        benchmark::DoNotOptimize(points);
+    }
+    state.counters["Seeds"] = static_cast<double>(seeds.size());
+}
+
+// Trace all seeds with traceFrom(seeds, ...), the lines of each chunk are sampled in batches.
+static void StreamLines3D(benchmark::State& state) {
+    const auto volume = makeField(64);
+    const auto seeds = makeSeeds(static_cast<size_t>(state.range(0)));
+    const auto properties = makeProperties(200);
+    const StreamLine3DTracer tracer(std::make_shared<VolumeDoubleSampler<3>>(volume), *properties);
+
+    app->getSystemSettings().poolSize_.set(static_cast<size_t>(state.range(1)));
+
+    for (auto _ : state) {
+        IntegralLineSet lines{mat4{1.0f}};
+        tracer.traceFrom(seeds, 0, lines);
+        benchmark::DoNotOptimize(lines);
+        benchmark::ClobberMemory();
+    }
+    state.counters["Seeds"] = static_cast<double>(seeds.size());
+    state.counters["Threads"] = static_cast<double>(app->getPoolSize() + 1);
+}
+
+static void args(benchmark::internal::Benchmark* b) {
+    for (long seeds : {256L, 4096L}) {
+        for (long threads : {0L, 3L, 7L}) b->Args({seeds, threads});
+    }
+}
+
+BENCHMARK(StreamLines3DSingle)->Arg(256)->Arg(4096)->Unit(benchmark::kMillisecond);
+BENCHMARK(StreamLines3D)->Apply(args)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    InviwoApplication inviwoApp("bm-streamlines");
+    app = &inviwoApp;
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
+
+#include <warn/pop>
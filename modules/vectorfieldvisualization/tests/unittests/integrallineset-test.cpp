@@ -0,0 +1,101 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/vectorfieldvisualization/datastructures/integrallineset.h>
+
+namespace inviwo {
+
+namespace {
+
+IntegralLine makeLine(size_t numPoints) {
+    IntegralLine line;
+    for (size_t i = 0; i < numPoints; ++i) {
+        line.getPositions().emplace_back(static_cast<double>(i), 0.0, 0.0);
+    }
+    line.setIndex(1000);
+    return line;
+}
+
+}  // namespace
+
+TEST(IntegralLineSet, PushBackSetsIndex) {
+    IntegralLineSet lines{mat4{1.0f}};
+    lines.push_back(makeLine(2), IntegralLineSet::SetIndex::Yes);
+    lines.push_back(makeLine(2), IntegralLineSet::SetIndex::No);
+    lines.push_back(makeLine(2), 7);
+    const auto line = makeLine(2);
+    lines.push_back(line, IntegralLineSet::SetIndex::Yes);
+    lines.push_back(line, IntegralLineSet::SetIndex::No);
+    lines.push_back(line, 9);
+
+    ASSERT_EQ(6, lines.size());
+    EXPECT_EQ(0, lines[0].getIndex());
+    EXPECT_EQ(1000, lines[1].getIndex());
+    EXPECT_EQ(7, lines[2].getIndex());
+    EXPECT_EQ(3, lines[3].getIndex());
+    EXPECT_EQ(1000, lines[4].getIndex());
+    EXPECT_EQ(9, lines[5].getIndex());
+    EXPECT_EQ(1000, line.getIndex());
+}
+
+TEST(IntegralLineSet, PushBackRValueMoves) {
+    IntegralLineSet lines{mat4{1.0f}};
+    lines.reserve(2);
+
+    auto first = makeLine(5);
+    const auto* firstData = first.getPositions().data();
+    lines.push_back(std::move(first), IntegralLineSet::SetIndex::Yes);
+
+    auto second = makeLine(5);
+    const auto* secondData = second.getPositions().data();
+    lines.push_back(std::move(second), 3);
+
+    ASSERT_EQ(2, lines.size());
+    EXPECT_EQ(firstData, lines[0].getPositions().data());
+    EXPECT_EQ(secondData, lines[1].getPositions().data());
+    EXPECT_EQ(0, lines[0].getIndex());
+    EXPECT_EQ(3, lines[1].getIndex());
+}
+
+TEST(IntegralLineSet, ReserveKeepsLines) {
+    IntegralLineSet lines{mat4{1.0f}};
+    lines.push_back(makeLine(3), IntegralLineSet::SetIndex::Yes);
+    lines.reserve(100);
+    EXPECT_LE(100, lines.getVector().capacity());
+    ASSERT_EQ(1, lines.size());
+    EXPECT_EQ(3, lines.front().getPositions().size());
+    EXPECT_EQ(0, lines.front().getIndex());
+}
+
+}  // namespace inviwo
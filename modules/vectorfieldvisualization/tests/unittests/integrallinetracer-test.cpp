@@ -0,0 +1,137 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/vectorfieldvisualization/integrallinetracer.h>
+#include <modules/vectorfieldvisualization/properties/integrallineproperties.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/volumesampler.h>
+
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+// A field along x in the lower half of the volume, x < 0.5, and zero in the upper half.
+std::shared_ptr<const Volume> makeField() {
+    const size_t size = 8;
+    auto ram = std::make_shared<VolumeRAMPrecision<vec3>>(size3_t{size});
+    auto data = ram->getDataTyped();
+    for (size_t z = 0; z < size; ++z) {
+        for (size_t y = 0; y < size; ++y) {
+            for (size_t x = 0; x < size; ++x) {
+                const float vy = 0.1f * static_cast<float>(z);
+                data[(z * size + y) * size + x] = x < size / 2 ? vec3{1.0f, vy, 0.0f} : vec3{0.0f};
+            }
+        }
+    }
+    return std::make_shared<Volume>(ram);
+}
+
+StreamLine3DTracer makeTracer() {
+    IntegralLineProperties properties("properties", "Properties");
+    properties.numberOfSteps_.set(20);
+    properties.stepSize_.set(0.01f);
+    properties.stepDirection_.set(IntegralLineProperties::Direction::BOTH);
+    properties.integrationScheme_.set(IntegralLineProperties::IntegrationScheme::RK4);
+    return StreamLine3DTracer(std::make_shared<VolumeDoubleSampler<3>>(makeField()), properties);
+}
+
+// The seeds at x = 0.9 have zero velocity and give no line.
+const std::vector<dvec3> seeds = {{0.1, 0.2, 0.3}, {0.9, 0.5, 0.5}, {0.2, 0.4, 0.5},
+                                  {0.3, 0.6, 0.7}, {0.9, 0.1, 0.2}, {0.15, 0.8, 0.4}};
+
+struct AlwaysStop {
+    explicit operator bool() const { return true; }
+};
+
+}  // namespace
+
+TEST(IntegralLineTracer, TracesSeedsInOrder) {
+    const auto tracer = makeTracer();
+
+    IntegralLineSet lines{mat4{1.0f}};
+    lines.push_back(IntegralLine{}, 42);
+    tracer.traceFrom(seeds, 10, lines);
+
+    const std::vector<size_t> traced = {0, 2, 3, 5};
+    ASSERT_EQ(1 + traced.size(), lines.size());
+    EXPECT_EQ(42, lines[0].getIndex());
+    for (size_t i = 0; i < traced.size(); ++i) {
+        const auto& line = lines[i + 1];
+        EXPECT_EQ(10 + traced[i], line.getIndex());
+
+        const auto expected = tracer.traceFrom(seeds[traced[i]]).line;
+        EXPECT_EQ(expected.getPositions(), line.getPositions()) << "seed " << traced[i];
+        EXPECT_EQ(expected.getMetaData<dvec3>("velocity"), line.getMetaData<dvec3>("velocity"));
+        EXPECT_EQ(expected.getBackwardTerminationReason(), line.getBackwardTerminationReason());
+        EXPECT_EQ(expected.getForwardTerminationReason(), line.getForwardTerminationReason());
+    }
+}
+
+TEST(IntegralLineTracer, ZeroVelocityGivesNoLine) {
+    const auto tracer = makeTracer();
+    EXPECT_TRUE(tracer.traceFrom(seeds[1]).line.getPositions().empty());
+
+    IntegralLineSet lines{mat4{1.0f}};
+    tracer.traceFrom(std::vector<dvec3>{seeds[1], seeds[4]}, 0, lines);
+    EXPECT_EQ(0, lines.size());
+}
+
+TEST(IntegralLineTracer, ReportsProgress) {
+    const auto tracer = makeTracer();
+
+    IntegralLineSet lines{mat4{1.0f}};
+    size_t calls = 0;
+    size_t last = 0;
+    tracer.traceFrom(seeds, 0, lines, util::detail::NoStop{}, [&](size_t traced, size_t total) {
+        EXPECT_EQ(seeds.size(), total);
+        EXPECT_LT(last, traced);
+        last = traced;
+        ++calls;
+    });
+    EXPECT_LT(0, calls);
+    EXPECT_EQ(seeds.size(), last);
+}
+
+TEST(IntegralLineTracer, StopAppendsNothing) {
+    const auto tracer = makeTracer();
+
+    IntegralLineSet lines{mat4{1.0f}};
+    tracer.traceFrom(seeds, 0, lines, AlwaysStop{});
+    EXPECT_EQ(0, lines.size());
+}
+
+}  // namespace inviwo
@@ -32,9 +32,11 @@
 #include <inviwo/volume/volumemoduledefine.h>
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/optionproperty.h>
 #include <inviwo/core/ports/volumeport.h>
 #include <inviwo/core/ports/meshport.h>
 #include <inviwo/dataframe/datastructures/dataframe.h>
+#include <modules/base/algorithm/volume/volumevoronoi.h>
 #include <optional>
 
 namespace inviwo {
@@ -58,6 +60,9 @@ namespace inviwo {
  *
  * ### Properties
  *   * __Weighted voronoi__ Choose whether the weighted version of voronoi should be used or not.
+ *   * __Algorithm__ How the closest seed point is found, by comparing against all seed points or by
+ *                   using a KD-tree of the seed points. Both give the same result, the KD-tree is
+ *                   much faster for more than a few seed points.
  *
  */
 
@@ -77,6 +82,7 @@ private:
     VolumeOutport outport_;
 
     BoolProperty weighted_;
+    TemplateOptionProperty<VoronoiAlgorithm> algorithm_;
 };
 
 }  // namespace inviwo
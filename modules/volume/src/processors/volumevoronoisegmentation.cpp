@@ -47,13 +47,18 @@ VolumeVoronoiSegmentation::VolumeVoronoiSegmentation()
     , volume_("inputVolume")
     , dataFrame_("seedPoints")
     , outport_("outport")
-    , weighted_("weighted", "Weighted voronoi", false) {
+    , weighted_("weighted", "Weighted voronoi", false)
+    , algorithm_("algorithm", "Algorithm",
+                 {{"bruteForce", "Brute Force", VoronoiAlgorithm::BruteForce},
+                  {"kdTree", "KD-Tree", VoronoiAlgorithm::KDTree}},
+                 1) {
 
     addPort(volume_);
     addPort(dataFrame_);
     addPort(outport_);
 
     addProperty(weighted_);
+    addProperty(algorithm_);
 }
 
 void VolumeVoronoiSegmentation::process() {
@@ -111,7 +116,7 @@ void VolumeVoronoiSegmentation::process() {
 
     const auto voronoiVolume = util::voronoiSegmentation(
         volume->getDimensions(), volume->getCoordinateTransformer().getIndexToModelMatrix(),
-        seedPointsWithIndices, radii, weighted_.get());
+        seedPointsWithIndices, radii, weighted_.get(), algorithm_.get());
 
     voronoiVolume->setModelMatrix(volume->getModelMatrix());
     voronoiVolume->setWorldMatrix(volume->getWorldMatrix());
@@ -71,6 +71,7 @@
 #include <inviwo/core/util/commandlineparser.h>
 
 #include <inviwo/core/resourcemanager/resourcemanagerobserver.h>
+#include <inviwo/core/resourcemanager/memorymanager.h>
 
 namespace inviwo {
 
@@ -131,6 +132,7 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
     , clearAllSingeltons_{[]() {
         PickingManager::deleteInstance();
         RenderContext::deleteInstance();
+        MemoryManager::deleteInstance();
     }}
     , resourceManager_{std::make_unique<ResourceManager>()}
     , cameraFactory_{std::make_unique<CameraFactory>()}
@@ -170,6 +172,14 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
         systemSettings_->poolSize_.onChange([this]() { resizePool(systemSettings_->poolSize_); });
     }
 
+    const auto updateEvaluationMode = [this]() {
+        processorNetworkEvaluator_->setEvaluationMode(systemSettings_->parallelEvaluation_.get()
+                                                          ? EvaluationMode::Parallel
+                                                          : EvaluationMode::Serial);
+    };
+    updateEvaluationMode();
+    systemSettings_->parallelEvaluation_.onChange(updateEvaluationMode);
+
     resourceManager_->setEnabled(systemSettings_->enableResourceManager_.get());
     systemSettings_->enableResourceManager_.onChange(
         [this]() { resourceManager_->setEnabled(systemSettings_->enableResourceManager_.get()); });
@@ -189,6 +199,13 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
     init(this);
     RenderContext::init();
     PickingManager::init();
+    MemoryManager::init();
+
+    const auto updateMemoryBudget = [this]() {
+        resourceManager_->setMemoryBudget(systemSettings_->memoryBudget_.get() * 1024 * 1024);
+    };
+    updateMemoryBudget();
+    systemSettings_->memoryBudget_.onChange(updateMemoryBudget);
 
     workspaceManager_->registerFactory(getProcessorFactory());
     workspaceManager_->registerFactory(getMetaDataFactory());
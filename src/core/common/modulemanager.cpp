@@ -36,14 +36,44 @@
 #include <inviwo/core/util/vectoroperations.h>
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/util/capabilities.h>
+#include <inviwo/core/util/parallel.h>
+#include <inviwo/core/util/trace.h>
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/inviwocommondefines.h>
 
 #include <string>
 #include <functional>
+#include <algorithm>
 
 namespace inviwo {
 
+namespace {
+
+/**
+ * Adds the duration of its scope to the registration times and records a matching trace event.
+ */
+class StepTimer {
+public:
+    StepTimer(ModuleManager::Timings& timings, std::string step)
+        : timings_{timings}
+        , step_{std::move(step)}
+        , trace_{"startup", step_}
+        , start_{std::chrono::steady_clock::now()} {}
+    StepTimer(const StepTimer&) = delete;
+    StepTimer& operator=(const StepTimer&) = delete;
+    ~StepTimer() {
+        timings_.emplace_back(std::move(step_), std::chrono::steady_clock::now() - start_);
+    }
+
+private:
+    ModuleManager::Timings& timings_;
+    std::string step_;
+    TraceScope trace_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace
+
 ModuleManager::ModuleManager(InviwoApplication* app)
     : app_{app}
     , protected_{}
@@ -75,6 +105,12 @@ bool ModuleManager::isRuntimeModuleReloadingEnabled() {
 }
 
 void ModuleManager::registerModules(std::vector<std::unique_ptr<InviwoModuleFactoryObject>> mfo) {
+    registrationTimes_.clear();
+    registerFactoryObjects(std::move(mfo));
+}
+
+void ModuleManager::registerFactoryObjects(
+    std::vector<std::unique_ptr<InviwoModuleFactoryObject>> mfo) {
     factoryObjects_.insert(factoryObjects_.end(), std::make_move_iterator(mfo.begin()),
                            std::make_move_iterator(mfo.end()));
 
@@ -86,6 +122,7 @@ void ModuleManager::registerModules(std::vector<std::unique_ptr<InviwoModuleFact
         if (getModuleByIdentifier(obj->name)) continue;  // already loaded
         if (!checkDependencies(*obj)) continue;
         try {
+            StepTimer timer{registrationTimes_, obj->name};
             registerModule(obj->create(app_));
         } catch (const ModuleInitException& e) {
             auto dereg = deregisterDependetModules(e.getModulesToDeregister());
@@ -98,16 +135,32 @@ void ModuleManager::registerModules(std::vector<std::unique_ptr<InviwoModuleFact
     }
 
     app_->postProgress("Loading Capabilities");
-    for (auto& module : modules_) {
-        for (auto& elem : module->getCapabilities()) {
-            elem->retrieveStaticInfo();
-            elem->printInfo();
+    {
+        StepTimer timer{registrationTimes_, "Capabilities"};
+        for (auto& module : modules_) {
+            for (auto& elem : module->getCapabilities()) {
+                elem->retrieveStaticInfo();
+                elem->printInfo();
+            }
         }
     }
 
+    const auto slowest = std::max_element(
+        registrationTimes_.begin(), registrationTimes_.end(),
+        [](const auto& a, const auto& b) { return a.second < b.second; });
+    if (slowest != registrationTimes_.end()) {
+        std::chrono::nanoseconds total{0};
+        for (const auto& step : registrationTimes_) total += step.second;
+        LogInfo("Registered " << modules_.size() << " modules in " << durationToString(total)
+                              << ", slowest step: " << slowest->first << " ("
+                              << durationToString(slowest->second) << ")");
+    }
+
     onModulesDidRegister_.invoke();
 }
 
+auto ModuleManager::getRegistrationTimes() const -> const Timings& { return registrationTimes_; }
+
 std::function<bool(const std::string&)> ModuleManager::getEnabledFilter() {
     // Load enabled modules if file "application_name-enabled-modules.txt" exists,
     // otherwise load all modules
@@ -150,21 +203,36 @@ void ModuleManager::registerModules(RuntimeModuleLoading) {
     // 4. Start observing file if reloadLibrariesWhenChanged
     // 5. Pass module factories to registerModules
 
+    registrationTimes_.clear();
+
     // Find unique files and directories in specified search paths
     auto librarySearchPaths = util::getLibrarySearchPaths();
     std::set<std::string> libraryFiles;
     LibrarySearchDirs searchDirectories{librarySearchPaths};
-    for (auto path : librarySearchPaths) {
-        using namespace inviwo::filesystem;
-        // Make sure that we have an absolute path to avoid duplicates
-        path = cleanupPath(path);
-        try {
-            auto files = getDirectoryContentsRecursively(path, ListMode::Files);
-            auto dirs = getDirectoryContentsRecursively(path, ListMode::Directories);
-            libraryFiles.insert(std::make_move_iterator(files.begin()),
-                                std::make_move_iterator(files.end()));
-            searchDirectories.add(dirs);
-        } catch (FileException&) {  // Invalid path, ignore it
+    {
+        StepTimer timer{registrationTimes_, "Find module libraries"};
+        // The search paths can be large directory trees, scan them concurrently and merge the
+        // results in the order of the search paths.
+        struct Contents {
+            std::vector<std::string> files;
+            std::vector<std::string> dirs;
+        };
+        std::vector<Contents> contents(librarySearchPaths.size());
+        util::parallelFor(0, librarySearchPaths.size(), [&](size_t i) {
+            using namespace inviwo::filesystem;
+            // Make sure that we have an absolute path to avoid duplicates
+            const auto path = cleanupPath(librarySearchPaths[i]);
+            try {
+                contents[i].files = getDirectoryContentsRecursively(path, ListMode::Files);
+                contents[i].dirs = getDirectoryContentsRecursively(path, ListMode::Directories);
+            } catch (FileException&) {  // Invalid path, ignore it
+                contents[i] = Contents{};
+            }
+        });
+        for (auto& content : contents) {
+            libraryFiles.insert(std::make_move_iterator(content.files.begin()),
+                                std::make_move_iterator(content.files.end()));
+            searchDirectories.add(content.dirs);
         }
     }
     // Determines if a library is already loaded into the application
@@ -185,8 +253,10 @@ void ModuleManager::registerModules(RuntimeModuleLoading) {
                isModuleLibraryLoaded(file) || !isEnabled(file);
     });
 
+    const bool useTmpDir =
+        isRuntimeModuleReloadingEnabled() && util::hasAddLibrarySearchDirsFunction();
     const auto tmpDir = [&]() -> std::string {
-        if (isRuntimeModuleReloadingEnabled() && util::hasAddLibrarySearchDirsFunction()) {
+        if (useTmpDir) {
             const auto tmp =
                 filesystem::getInviwoUserSettingsPath() + "/temporary-module-libraries";
             if (!filesystem::directoryExists(tmp)) {
@@ -203,57 +273,69 @@ void ModuleManager::registerModules(RuntimeModuleLoading) {
     auto isLoaded = [loaded = util::getLoadedLibraries()](const auto& path) {
         return util::contains_if(loaded, [&](const auto& lib) { return iCaseCmp(path, lib); });
     };
-    std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
+    // Pairs of {file path, path to load the library from}
+    std::vector<std::pair<std::string, std::string>> libraries;
     for (const auto& filePath : libraryFiles) {
-        const auto tmpPath = [&]() -> std::string {
-            if (isRuntimeModuleReloadingEnabled() && util::hasAddLibrarySearchDirsFunction()) {
-                auto dstPath = tmpDir + "/" + filesystem::getFileNameWithExtension(filePath);
-                if (isLoaded(filePath)) {
-                    // Already loaded modules are loaded from the application dir
-                    dstPath = filePath;
-                    protected_.insert(util::stripModuleFileNameDecoration(filePath));
-                } else if (filesystem::fileModificationTime(filePath) !=
-                           filesystem::fileModificationTime(dstPath)) {
-                    // Load a copy of the file to make sure that we can overwrite the file.
-                    filesystem::copyFile(filePath, dstPath);
-                }
-                return dstPath;
-            } else {
-                return filePath;
+        if (useTmpDir && isLoaded(filePath)) {
+            // Already loaded modules are loaded from the application dir
+            protected_.insert(util::stripModuleFileNameDecoration(filePath));
+            libraries.emplace_back(filePath, filePath);
+        } else if (useTmpDir) {
+            libraries.emplace_back(filePath,
+                                   tmpDir + "/" + filesystem::getFileNameWithExtension(filePath));
+        } else {
+            libraries.emplace_back(filePath, filePath);
+        }
+    }
+    if (useTmpDir) {
+        StepTimer timer{registrationTimes_, "Copy module libraries"};
+        // Load a copy of the file to make sure that we can overwrite the file.
+        util::parallelFor(0, libraries.size(), [&](size_t i) {
+            const auto& [filePath, tmpPath] = libraries[i];
+            if (filePath != tmpPath && filesystem::fileModificationTime(filePath) !=
+                                           filesystem::fileModificationTime(tmpPath)) {
+                filesystem::copyFile(filePath, tmpPath);
             }
-        }();
+        });
+    }
 
-        try {
-            // Load library. Will throw exception if failed to load
-            auto sharedLib = std::make_unique<SharedLibrary>(tmpPath);
-            // Only consider libraries with Inviwo module creation function
-            if (auto moduleFunc = sharedLib->findSymbolTyped<f_getModule>("createModule")) {
-                // Add module factory object
-                modules.emplace_back(moduleFunc());
-                auto moduleName = toLower(modules.back()->name);
-                if (modules.back()->protectedModule == ProtectedModule::on) {
-                    protected_.insert(modules.back()->name);
-                }
-                sharedLibraries_.emplace_back(std::move(sharedLib));
-                if (isRuntimeModuleReloadingEnabled()) {
-                    libraryObserver_.observe(filePath);
+    std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
+    {
+        StepTimer timer{registrationTimes_, "Load module libraries"};
+        // Libraries are loaded serially, their static initializers might not be thread safe
+        for (const auto& [filePath, tmpPath] : libraries) {
+            try {
+                // Load library. Will throw exception if failed to load
+                auto sharedLib = std::make_unique<SharedLibrary>(tmpPath);
+                // Only consider libraries with Inviwo module creation function
+                if (auto moduleFunc = sharedLib->findSymbolTyped<f_getModule>("createModule")) {
+                    // Add module factory object
+                    modules.emplace_back(moduleFunc());
+                    if (modules.back()->protectedModule == ProtectedModule::on) {
+                        protected_.insert(modules.back()->name);
+                    }
+                    sharedLibraries_.emplace_back(std::move(sharedLib));
+                    if (isRuntimeModuleReloadingEnabled()) {
+                        libraryObserver_.observe(filePath);
+                    }
+                } else {
+                    LogInfo("Could not find 'createModule' function needed for creating the "
+                            "module in "
+                            << tmpPath
+                            << ". Make sure that you have compiled the library and exported the "
+                               "function.");
                 }
-            } else {
-                LogInfo(
-                    "Could not find 'createModule' function needed for creating the module in "
-                    << tmpPath
-                    << ". Make sure that you have compiled the library and exported the function.");
+            } catch (const Exception& e) {
+                // Library dependency is probably missing. We silently skip this library.
+                LogInfo("Could not load library: " << filePath << " " << e.getMessage());
             }
-        } catch (const Exception& e) {
-            // Library dependency is probably missing. We silently skip this library.
-            LogInfo("Could not load library: " << filePath << " " << e.getMessage());
         }
     }
 
     auto dependencies = getProtectedDependencies(protected_, modules);
     protected_.insert(dependencies.begin(), dependencies.end());
 
-    registerModules(std::move(modules));
+    registerFactoryObjects(std::move(modules));
 }
 
 void ModuleManager::unregisterModules() {
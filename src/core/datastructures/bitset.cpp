@@ -0,0 +1,437 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/bitset.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <bitset>
+#include <limits>
+#include <string>
+
+namespace inviwo {
+
+namespace {
+
+// Blocks with more values than arrayMax are stored as bitmaps of bitmapWords words
+constexpr size_t arrayMax = 4096;
+constexpr size_t bitmapWords = 1024;
+
+size_t popcount(std::uint64_t word) { return std::bitset<64>(word).count(); }
+
+}  // namespace
+
+BitSet::const_iterator::const_iterator(const std::vector<Container>* containers, size_t container)
+    : containers_{containers}, container_{container}, pos_{0} {
+    seek();
+}
+
+BitSet::const_iterator& BitSet::const_iterator::operator++() {
+    ++pos_;
+    seek();
+    return *this;
+}
+
+BitSet::const_iterator BitSet::const_iterator::operator++(int) {
+    auto i = *this;
+    ++(*this);
+    return i;
+}
+
+// Move to the first value at or after pos_ in container_, or to the end
+void BitSet::const_iterator::seek() {
+    const auto& containers = *containers_;
+    for (; container_ < containers.size(); ++container_, pos_ = 0) {
+        const auto& c = containers[container_];
+        const auto high = static_cast<std::uint32_t>(c.key) << 16;
+        if (c.isBitmap()) {
+            auto word = pos_ / 64;
+            if (word >= bitmapWords) continue;
+            auto bits = c.bitmap[word] & (~std::uint64_t{0} << (pos_ % 64));
+            while (bits == 0 && ++word < bitmapWords) bits = c.bitmap[word];
+            if (bits != 0) {
+                pos_ = word * 64 + detail::countTrailingZeros(bits);
+                value_ = high | static_cast<std::uint32_t>(pos_);
+                return;
+            }
+        } else if (pos_ < c.array.size()) {
+            value_ = high | c.array[pos_];
+            return;
+        }
+    }
+    pos_ = 0;
+}
+
+namespace {
+
+template <typename Container>
+void toBitmap(Container& c) {
+    c.bitmap.assign(bitmapWords, 0);
+    for (auto low : c.array) c.bitmap[low >> 6] |= std::uint64_t{1} << (low & 63);
+    c.cardinality = static_cast<std::uint32_t>(c.array.size());
+    std::vector<std::uint16_t>{}.swap(c.array);
+}
+
+template <typename Container>
+void toArray(Container& c) {
+    std::vector<std::uint16_t> array;
+    array.reserve(c.cardinality);
+    for (size_t i = 0; i < c.bitmap.size(); ++i) {
+        for (auto word = c.bitmap[i]; word != 0; word &= word - 1) {
+            array.push_back(static_cast<std::uint16_t>(i * 64 + detail::countTrailingZeros(word)));
+        }
+    }
+    c.array = std::move(array);
+    std::vector<std::uint64_t>{}.swap(c.bitmap);
+}
+
+template <typename Container>
+void recount(Container& c) {
+    size_t count = 0;
+    for (auto word : c.bitmap) count += popcount(word);
+    c.cardinality = static_cast<std::uint32_t>(count);
+}
+
+// Keep the representation canonical: a bitmap if and only if there are more than 4096 values
+template <typename Container>
+void normalize(Container& c) {
+    if (c.isBitmap()) {
+        if (c.cardinality <= arrayMax) toArray(c);
+    } else {
+        c.cardinality = static_cast<std::uint32_t>(c.array.size());
+        if (c.cardinality > arrayMax) toBitmap(c);
+    }
+}
+
+template <typename Container>
+bool test(const Container& c, std::uint16_t low) {
+    if (c.isBitmap()) return (c.bitmap[low >> 6] >> (low & 63)) & 1;
+    return std::binary_search(c.array.begin(), c.array.end(), low);
+}
+
+template <typename Containers>
+auto findContainer(Containers& containers, std::uint16_t key) {
+    return std::lower_bound(containers.begin(), containers.end(), key,
+                            [](const auto& c, std::uint16_t k) { return c.key < k; });
+}
+
+}  // namespace
+
+BitSet::BitSet(std::initializer_list<std::uint32_t> values)
+    : BitSet(values.begin(), values.end()) {}
+
+std::uint32_t BitSet::toValue(size_t value) {
+    if (value > std::numeric_limits<std::uint32_t>::max()) {
+        throw RangeException("BitSet values have to fit in 32 bits, got " + std::to_string(value),
+                             IVW_CONTEXT_CUSTOM("BitSet"));
+    }
+    return static_cast<std::uint32_t>(value);
+}
+
+void BitSet::assign(std::vector<std::uint32_t> values) {
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+
+    containers_.clear();
+    for (auto it = values.begin(); it != values.end();) {
+        const auto key = static_cast<std::uint16_t>(*it >> 16);
+        const auto last = std::find_if(it, values.end(), [&](auto v) { return (v >> 16) != key; });
+        auto& c = containers_.emplace_back();
+        c.key = key;
+        const auto count = static_cast<size_t>(std::distance(it, last));
+        if (count > arrayMax) {
+            c.bitmap.assign(bitmapWords, 0);
+            for (; it != last; ++it) {
+                const auto low = static_cast<std::uint16_t>(*it);
+                c.bitmap[low >> 6] |= std::uint64_t{1} << (low & 63);
+            }
+            recount(c);
+        } else {
+            c.array.reserve(count);
+            for (; it != last; ++it) c.array.push_back(static_cast<std::uint16_t>(*it));
+            c.cardinality = static_cast<std::uint32_t>(c.array.size());
+        }
+    }
+}
+
+bool BitSet::empty() const { return containers_.empty(); }
+
+size_t BitSet::size() const {
+    size_t size = 0;
+    for (const auto& c : containers_) size += c.cardinality;
+    return size;
+}
+
+bool BitSet::contains(size_t value) const {
+    if (value > std::numeric_limits<std::uint32_t>::max()) return false;
+    const auto key = static_cast<std::uint16_t>(value >> 16);
+    const auto it = findContainer(containers_, key);
+    return it != containers_.end() && it->key == key &&
+           test(*it, static_cast<std::uint16_t>(value));
+}
+
+size_t BitSet::count(size_t value) const { return contains(value) ? 1 : 0; }
+
+bool BitSet::insert(size_t value) {
+    const auto v = toValue(value);
+    const auto key = static_cast<std::uint16_t>(v >> 16);
+    const auto low = static_cast<std::uint16_t>(v);
+
+    auto it = (containers_.empty() || containers_.back().key < key)
+                  ? containers_.end()
+                  : findContainer(containers_, key);
+    if (it == containers_.end() || it->key != key) {
+        it = containers_.insert(it, Container{});
+        it->key = key;
+    }
+    auto& c = *it;
+
+    if (c.isBitmap()) {
+        auto& word = c.bitmap[low >> 6];
+        const auto mask = std::uint64_t{1} << (low & 63);
+        if (word & mask) return false;
+        word |= mask;
+        ++c.cardinality;
+        return true;
+    }
+
+    const auto pos = (c.array.empty() || c.array.back() < low)
+                         ? c.array.end()
+                         : std::lower_bound(c.array.begin(), c.array.end(), low);
+    if (pos != c.array.end() && *pos == low) return false;
+    c.array.insert(pos, low);
+    normalize(c);
+    return true;
+}
+
+void BitSet::insertRange(size_t begin, size_t end) {
+    if (begin >= end) return;
+    toValue(end - 1);
+
+    for (size_t key = begin >> 16; key <= (end - 1) >> 16; ++key) {
+        const auto first = std::max(begin, key << 16) & 0xFFFF;
+        const auto last = std::min(end - 1, (key << 16) | 0xFFFF) & 0xFFFF;
+
+        auto it = findContainer(containers_, static_cast<std::uint16_t>(key));
+        if (it == containers_.end() || it->key != key) {
+            it = containers_.insert(it, Container{});
+            it->key = static_cast<std::uint16_t>(key);
+        }
+        auto& c = *it;
+        if (!c.isBitmap()) toBitmap(c);
+
+        for (auto word = first >> 6; word <= last >> 6; ++word) {
+            auto mask = ~std::uint64_t{0};
+            if (word == first >> 6) mask &= ~std::uint64_t{0} << (first & 63);
+            if (word == last >> 6) mask &= ~std::uint64_t{0} >> (63 - (last & 63));
+            c.bitmap[word] |= mask;
+        }
+        recount(c);
+        normalize(c);
+    }
+}
+
+size_t BitSet::erase(size_t value) {
+    if (value > std::numeric_limits<std::uint32_t>::max()) return 0;
+    const auto key = static_cast<std::uint16_t>(value >> 16);
+    const auto low = static_cast<std::uint16_t>(value);
+
+    const auto it = findContainer(containers_, key);
+    if (it == containers_.end() || it->key != key) return 0;
+    auto& c = *it;
+
+    if (c.isBitmap()) {
+        auto& word = c.bitmap[low >> 6];
+        const auto mask = std::uint64_t{1} << (low & 63);
+        if (!(word & mask)) return 0;
+        word &= ~mask;
+        --c.cardinality;
+    } else {
+        const auto pos = std::lower_bound(c.array.begin(), c.array.end(), low);
+        if (pos == c.array.end() || *pos != low) return 0;
+        c.array.erase(pos);
+    }
+    normalize(c);
+    if (c.cardinality == 0) containers_.erase(it);
+    return 1;
+}
+
+void BitSet::clear() { containers_.clear(); }
+
+BitSet& BitSet::operator|=(const BitSet& rhs) {
+    std::vector<Container> result;
+    result.reserve(containers_.size() + rhs.containers_.size());
+
+    auto a = containers_.begin();
+    auto b = rhs.containers_.begin();
+    while (a != containers_.end() || b != rhs.containers_.end()) {
+        if (b == rhs.containers_.end() || (a != containers_.end() && a->key < b->key)) {
+            result.push_back(std::move(*a++));
+        } else if (a == containers_.end() || b->key < a->key) {
+            result.push_back(*b++);
+        } else {
+            auto& c = result.emplace_back(std::move(*a++));
+            const auto& o = *b++;
+            if (!c.isBitmap() && o.isBitmap()) {
+                auto array = std::move(c.array);
+                c = o;
+                for (auto low : array) c.bitmap[low >> 6] |= std::uint64_t{1} << (low & 63);
+                recount(c);
+            } else if (c.isBitmap() && o.isBitmap()) {
+                for (size_t i = 0; i < bitmapWords; ++i) c.bitmap[i] |= o.bitmap[i];
+                recount(c);
+            } else if (c.isBitmap()) {
+                for (auto low : o.array) c.bitmap[low >> 6] |= std::uint64_t{1} << (low & 63);
+                recount(c);
+            } else {
+                std::vector<std::uint16_t> array;
+                array.reserve(c.array.size() + o.array.size());
+                std::set_union(c.array.begin(), c.array.end(), o.array.begin(), o.array.end(),
+                               std::back_inserter(array));
+                c.array = std::move(array);
+                normalize(c);
+            }
+        }
+    }
+    containers_ = std::move(result);
+    return *this;
+}
+
+BitSet& BitSet::operator&=(const BitSet& rhs) {
+    std::vector<Container> result;
+
+    auto a = containers_.begin();
+    auto b = rhs.containers_.begin();
+    while (a != containers_.end() && b != rhs.containers_.end()) {
+        if (a->key < b->key) {
+            ++a;
+        } else if (b->key < a->key) {
+            ++b;
+        } else {
+            auto& c = *a++;
+            const auto& o = *b++;
+            if (c.isBitmap() && o.isBitmap()) {
+                for (size_t i = 0; i < bitmapWords; ++i) c.bitmap[i] &= o.bitmap[i];
+                recount(c);
+            } else if (c.isBitmap()) {
+                std::vector<std::uint16_t> array;
+                std::copy_if(o.array.begin(), o.array.end(), std::back_inserter(array),
+                             [&](auto low) { return test(c, low); });
+                std::vector<std::uint64_t>{}.swap(c.bitmap);
+                c.array = std::move(array);
+            } else if (o.isBitmap()) {
+                c.array.erase(std::remove_if(c.array.begin(), c.array.end(),
+                                             [&](auto low) { return !test(o, low); }),
+                              c.array.end());
+            } else {
+                std::vector<std::uint16_t> array;
+                std::set_intersection(c.array.begin(), c.array.end(), o.array.begin(),
+                                      o.array.end(), std::back_inserter(array));
+                c.array = std::move(array);
+            }
+            normalize(c);
+            if (c.cardinality > 0) result.push_back(std::move(c));
+        }
+    }
+    containers_ = std::move(result);
+    return *this;
+}
+
+BitSet& BitSet::operator-=(const BitSet& rhs) {
+    std::vector<Container> result;
+    result.reserve(containers_.size());
+
+    auto b = rhs.containers_.begin();
+    for (auto& c : containers_) {
+        while (b != rhs.containers_.end() && b->key < c.key) ++b;
+        if (b == rhs.containers_.end() || b->key != c.key) {
+            result.push_back(std::move(c));
+            continue;
+        }
+        const auto& o = *b;
+        if (c.isBitmap() && o.isBitmap()) {
+            for (size_t i = 0; i < bitmapWords; ++i) c.bitmap[i] &= ~o.bitmap[i];
+            recount(c);
+        } else if (c.isBitmap()) {
+            for (auto low : o.array) c.bitmap[low >> 6] &= ~(std::uint64_t{1} << (low & 63));
+            recount(c);
+        } else if (o.isBitmap()) {
+            c.array.erase(std::remove_if(c.array.begin(), c.array.end(),
+                                         [&](auto low) { return test(o, low); }),
+                          c.array.end());
+        } else {
+            std::vector<std::uint16_t> array;
+            std::set_difference(c.array.begin(), c.array.end(), o.array.begin(), o.array.end(),
+                                std::back_inserter(array));
+            c.array = std::move(array);
+        }
+        normalize(c);
+        if (c.cardinality > 0) result.push_back(std::move(c));
+    }
+    containers_ = std::move(result);
+    return *this;
+}
+
+BitSet::const_iterator BitSet::begin() const { return const_iterator{&containers_, 0}; }
+
+BitSet::const_iterator BitSet::end() const {
+    return const_iterator{&containers_, containers_.size()};
+}
+
+std::vector<std::uint32_t> BitSet::toVector() const {
+    std::vector<std::uint32_t> values;
+    values.reserve(size());
+    forEach([&](std::uint32_t v) { values.push_back(v); });
+    return values;
+}
+
+size_t BitSet::sizeInBytes() const {
+    size_t bytes = containers_.capacity() * sizeof(Container);
+    for (const auto& c : containers_) {
+        bytes += c.array.capacity() * sizeof(std::uint16_t);
+        bytes += c.bitmap.capacity() * sizeof(std::uint64_t);
+    }
+    return bytes;
+}
+
+bool operator==(const BitSet& a, const BitSet& b) {
+    return std::equal(a.containers_.begin(), a.containers_.end(), b.containers_.begin(),
+                      b.containers_.end(), [](const auto& x, const auto& y) {
+                          return x.key == y.key && x.cardinality == y.cardinality &&
+                                 x.array == y.array && x.bitmap == y.bitmap;
+                      });
+}
+
+bool operator!=(const BitSet& a, const BitSet& b) { return !(a == b); }
+
+BitSet operator|(BitSet a, const BitSet& b) { return a |= b; }
+BitSet operator&(BitSet a, const BitSet& b) { return a &= b; }
+BitSet operator-(BitSet a, const BitSet& b) { return a -= b; }
+
+}  // namespace inviwo
@@ -41,6 +41,8 @@ BufferRAM::BufferRAM(const DataFormatBase *format, BufferUsage usage, BufferTarg
 
 std::type_index BufferRAM::getTypeIndex() const { return std::type_index(typeid(BufferRAM)); }
 
+size_t BufferRAM::getMemoryUsage() const { return getSize() * getSizeOfElement(); }
+
 //! [Format Dispatching Example]
 struct BufferRamCreationDispatcher {
 
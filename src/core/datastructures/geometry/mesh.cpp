@@ -90,6 +90,13 @@ const Mesh::BufferVector& Mesh::getBuffers() const { return buffers_; }
 
 const Mesh::IndexVector& Mesh::getIndexBuffers() const { return indices_; }
 
+size_t Mesh::getMemoryUsage() const {
+    size_t bytes = 0;
+    for (const auto& buffer : buffers_) bytes += buffer.second->getMemoryUsage();
+    for (const auto& index : indices_) bytes += index.second->getMemoryUsage();
+    return bytes;
+}
+
 void Mesh::addBuffer(BufferInfo info, std::shared_ptr<BufferBase> att) {
     auto it = std::find_if(buffers_.begin(), buffers_.end(),
                            [&](const auto& item) { return item.first.location == info.location; });
@@ -28,7 +28,10 @@
  *********************************************************************************/
 
 #include <inviwo/core/datastructures/histogram.h>
+#include <inviwo/core/util/exception.h>
+
 #include <algorithm>
+#include <cmath>
 #include <numeric>
 #include <functional>
 
@@ -92,6 +95,90 @@ NormalizedHistogram::NormalizedHistogram(dvec2 dataRange, std::vector<double> co
     }
 }
 
+HistogramAccumulator::HistogramAccumulator(dvec2 dataRange, size_t bins, size_t channels)
+    : dataRange_{dataRange}
+    , bins_{bins}
+    , scale_{static_cast<double>(bins - 1) / (dataRange.y - dataRange.x)}
+    , count_{0}
+    , channels_(channels) {
+    for (auto& channel : channels_) channel.bins.resize(bins, 0.0);
+}
+
+void HistogramAccumulator::combine(Channel& channel, size_t count, size_t otherCount, double mean,
+                                   double m2) {
+    const auto na = static_cast<double>(count);
+    const auto nb = static_cast<double>(otherCount);
+    const auto n = na + nb;
+    const auto delta = mean - channel.mean;
+    channel.mean += delta * nb / n;
+    channel.m2 += m2 + delta * delta * na * nb / n;
+}
+
+void HistogramAccumulator::merge(const HistogramAccumulator& other) {
+    if (other.count_ == 0) return;
+    if (other.bins_ != bins_ || other.channels_.size() != channels_.size() ||
+        other.dataRange_ != dataRange_) {
+        throw Exception("Can not merge histograms with different bins, range, or channels",
+                        IVW_CONTEXT);
+    }
+    for (size_t i = 0; i < channels_.size(); ++i) {
+        auto& channel = channels_[i];
+        const auto& otherChannel = other.channels_[i];
+        std::transform(channel.bins.begin(), channel.bins.end(), otherChannel.bins.begin(),
+                       channel.bins.begin(), std::plus<>{});
+        channel.min = std::min(channel.min, otherChannel.min);
+        channel.max = std::max(channel.max, otherChannel.max);
+        combine(channel, count_, other.count_, otherChannel.mean, otherChannel.m2);
+    }
+    count_ += other.count_;
+}
+
+void HistogramAccumulator::subtract(const HistogramAccumulator& other) {
+    if (other.count_ == 0) return;
+    if (other.bins_ != bins_ || other.channels_.size() != channels_.size() ||
+        other.dataRange_ != dataRange_ || other.count_ > count_) {
+        throw Exception("Can not subtract histogram, it is not part of this histogram",
+                        IVW_CONTEXT);
+    }
+    const auto n = static_cast<double>(count_ - other.count_);
+    const auto na = static_cast<double>(count_);
+    const auto nb = static_cast<double>(other.count_);
+    for (size_t i = 0; i < channels_.size(); ++i) {
+        auto& channel = channels_[i];
+        const auto& otherChannel = other.channels_[i];
+        std::transform(channel.bins.begin(), channel.bins.end(), otherChannel.bins.begin(),
+                       channel.bins.begin(), std::minus<>{});
+        if (n == 0.0) {
+            channel.mean = 0.0;
+            channel.m2 = 0.0;
+        } else {
+            // Invert the update in combine
+            const auto mean = (na * channel.mean - nb * otherChannel.mean) / n;
+            const auto delta = otherChannel.mean - mean;
+            channel.mean = mean;
+            channel.m2 = std::max(0.0, channel.m2 - otherChannel.m2 - delta * delta * n * nb / na);
+        }
+    }
+    count_ -= other.count_;
+}
+
+double HistogramAccumulator::getVariance(size_t channel) const {
+    return count_ > 1 ? channels_[channel].m2 / static_cast<double>(count_ - 1) : 0.0;
+}
+
+double HistogramAccumulator::getStandardDeviation(size_t channel) const {
+    return std::sqrt(getVariance(channel));
+}
+
+HistogramContainer HistogramAccumulator::getHistograms() const {
+    std::vector<NormalizedHistogram> histograms;
+    for (size_t i = 0; i < channels_.size(); ++i) {
+        histograms.emplace_back(dataRange_, channels_[i].bins, getMin(i), getMax(i), getMean(i),
+                                getStandardDeviation(i));
+    }
+    return HistogramContainer{std::move(histograms)};
+}
+
 double NormalizedHistogram::getMaximumBinValue() const { return maximumBinCount_; }
 
 std::vector<double>& NormalizedHistogram::getData() { return data_; }
@@ -102,6 +189,9 @@ double& NormalizedHistogram::operator[](size_t i) { return data_[i]; }
 
 const double& NormalizedHistogram::operator[](size_t i) const { return data_[i]; }
 
+HistogramContainer::HistogramContainer(std::vector<NormalizedHistogram> histograms)
+    : histograms_{std::move(histograms)} {}
+
 size_t HistogramContainer::size() const { return histograms_.size(); }
 
 bool HistogramContainer::empty() const { return histograms_.empty(); }
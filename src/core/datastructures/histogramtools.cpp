@@ -30,6 +30,9 @@
 #include <inviwo/core/datastructures/histogramtools.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/parallel.h>
+#include <inviwo/core/util/stringconversion.h>
 
 namespace inviwo {
 
@@ -61,25 +64,61 @@ std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
         histograms_ = std::make_shared<HistogramContainer>();
         calculation_ = std::make_shared<HistogramCalculationState>(histograms_, bins, dataRange);
 
-        dispatchPool([weakState = std::weak_ptr<HistogramCalculationState>(calculation_),
-                      stop = calculation_->stop_, volumeRam, dataRange, bins]() {
-            auto histograms = volumeRam->dispatch<HistogramContainer>([&](auto vr) {
-                return HistogramContainer(dataRange, bins, vr->getDataTyped(),
-                                          vr->getDataTyped() + glm::compMul(vr->getDimensions()));
+        calculation_->job_ =
+            dispatchPool([weakState = std::weak_ptr<HistogramCalculationState>(calculation_),
+                          stop = calculation_->stop_, volumeRam, dataRange, bins]() {
+                auto accumulator = std::make_shared<HistogramAccumulator>(
+                    util::accumulateHistogram(*volumeRam, dataRange, bins, stop.get()));
+                if (*stop) return;
+                auto histograms = accumulator->getHistograms();
+                dispatchFrontAndForget(
+                    [acc = std::move(accumulator), hist = std::move(histograms), weakState]() {
+                        if (auto s = weakState.lock()) {
+                            done(s, std::move(acc), std::move(hist));
+                        }
+                    });
             });
-            if (*stop) return;
-            dispatchFrontAndForget([hist = std::move(histograms), weakState]() {
-                if (auto s = weakState.lock()) {
-                    done(s, std::move(hist));
-                }
-            });
-        });
     }
     return calculation_;
 }
 
+void HistogramSupplier::editRegion(VolumeRAM& volumeRam, size3_t offset, size3_t dims,
+                                   const std::function<void(VolumeRAM&)>& edit) const {
+    if (glm::any(glm::greaterThan(offset + dims, volumeRam.getDimensions()))) {
+        throw Exception("Region " + toString(offset) + " + " + toString(dims) +
+                            " is outside of the volume " + toString(volumeRam.getDimensions()),
+                        IVW_CONTEXT);
+    }
+
+    if (!calculation_ || !calculation_->accumulator_) {
+        // The pending calculation might see the old values, cancel it and start over. Wait for
+        // it to stop since it reads the values that are about to be modified.
+        if (calculation_) {
+            *calculation_->stop_ = true;
+            if (calculation_->job_.valid()) {
+                InviwoApplication::getPtr()->getThreadPool().wait(calculation_->job_);
+            }
+        }
+        calculation_.reset();
+        histograms_ = std::make_shared<HistogramContainer>();
+        edit(volumeRam);
+        return;
+    }
+
+    auto& accumulator = *calculation_->accumulator_;
+    const auto before = util::accumulateHistogram(volumeRam, accumulator.getDataRange(),
+                                                  accumulator.getBins(), offset, dims);
+    edit(volumeRam);
+    accumulator.subtract(before);
+    accumulator.merge(util::accumulateHistogram(volumeRam, accumulator.getDataRange(),
+                                                accumulator.getBins(), offset, dims));
+    *histograms_ = accumulator.getHistograms();
+}
+
 void HistogramSupplier::done(std::shared_ptr<HistogramCalculationState> state,
+                             std::shared_ptr<HistogramAccumulator> accumulator,
                              HistogramContainer histograms) {
+    state->accumulator_ = std::move(accumulator);
     state->callbacks_.invoke(histograms);
     state->done = true;
     if (auto container = state->container_.lock()) {
@@ -87,4 +126,51 @@ void HistogramSupplier::done(std::shared_ptr<HistogramCalculationState> state,
     }
 }
 
+namespace {
+
+struct StopFlag {
+    explicit operator bool() const { return stop && *stop; }
+    const std::atomic<bool>* stop;
+};
+
+}  // namespace
+
+HistogramAccumulator util::accumulateHistogram(const VolumeRAM& volume, dvec2 dataRange,
+                                               size_t bins, const std::atomic<bool>* stop) {
+    return accumulateHistogram(volume, dataRange, bins, size3_t{0}, volume.getDimensions(), stop);
+}
+
+HistogramAccumulator util::accumulateHistogram(const VolumeRAM& volume, dvec2 dataRange,
+                                               size_t bins, size3_t offset, size3_t dims,
+                                               const std::atomic<bool>* stop) {
+    if (glm::any(glm::greaterThan(offset + dims, volume.getDimensions()))) {
+        throw Exception("Histogram region " + toString(offset) + " + " + toString(dims) +
+                            " is outside of the volume " + toString(volume.getDimensions()),
+                        IVW_CONTEXT_CUSTOM("util::accumulateHistogram"));
+    }
+
+    return volume.dispatch<HistogramAccumulator>([&](auto vr) {
+        using ValueType = util::PrecisionValueType<decltype(vr)>;
+        const auto data = vr->getDataTyped();
+        const util::IndexMapper3D index(vr->getDimensions());
+
+        // Every chunk of lines gets its own bins, they are merged in the end.
+        return util::parallelReduce(
+            size_t{0}, dims.y * dims.z, HistogramAccumulator::forType<ValueType>(dataRange, bins),
+            [&](size_t begin, size_t end, HistogramAccumulator accumulator) {
+                for (size_t line = begin; line < end; ++line) {
+                    const auto first =
+                        data + index(offset.x, offset.y + line % dims.y, offset.z + line / dims.y);
+                    accumulator.add(first, first + dims.x);
+                }
+                return accumulator;
+            },
+            [](HistogramAccumulator a, const HistogramAccumulator& b) {
+                a.merge(b);
+                return a;
+            },
+            0, StopFlag{stop});
+    });
+}
+
 }  // namespace inviwo
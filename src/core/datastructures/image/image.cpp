@@ -177,6 +177,12 @@ Layer* Image::getPickingLayer() { return pickingLayer_.get(); }
 
 size2_t Image::getDimensions() const { return getColorLayer()->getDimensions(); }
 
+size_t Image::getMemoryUsage() const {
+    size_t bytes = 0;
+    forEachLayer([&](const Layer& layer) { bytes += layer.getMemoryUsage(); });
+    return bytes;
+}
+
 void Image::setDimensions(size2_t dimensions) {
     for (auto layer : colorLayers_) layer->setDimensions(dimensions);
     if (depthLayer_) depthLayer_->setDimensions(dimensions);
@@ -65,6 +65,8 @@ void LayerDisk::updateDataFormat(const DataFormatBase* format) { setDataFormat(f
 
 std::type_index LayerDisk::getTypeIndex() const { return std::type_index(typeid(LayerDisk)); }
 
+bool LayerDisk::isReloadable() const { return getLoader() != nullptr; }
+
 void LayerDisk::setSwizzleMask(const SwizzleMask& mask) { swizzleMask_ = mask; }
 
 SwizzleMask LayerDisk::getSwizzleMask() const { return swizzleMask_; }
@@ -52,4 +52,8 @@ bool LayerRAM::copyRepresentationsTo(LayerRepresentation* targetLayerRam) const
 
 std::type_index LayerRAM::getTypeIndex() const { return std::type_index(typeid(LayerRAM)); }
 
+size_t LayerRAM::getMemoryUsage() const {
+    return glm::compMul(getDimensions()) * getDataFormat()->getSize();
+}
+
 }  // namespace inviwo
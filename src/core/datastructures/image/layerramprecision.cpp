@@ -42,6 +42,17 @@ struct LayerRAMCreationDispatcher {
         return std::make_shared<LayerRAMPrecision<F>>(dimensions, type, swizzleMask, interpolation,
                                                       wrapping);
     }
+    template <typename Result, typename T>
+    std::shared_ptr<LayerRAM> operator()(void* dataPtr, std::shared_ptr<void> dataOwner,
+                                         const size2_t& dimensions, LayerType type,
+                                         const SwizzleMask& swizzleMask,
+                                         InterpolationType interpolation,
+                                         const Wrapping2D& wrapping) {
+        using F = typename T::type;
+        return std::make_shared<LayerRAMPrecision<F>>(std::move(dataOwner),
+                                                      static_cast<F*>(dataPtr), dimensions, type,
+                                                      swizzleMask, interpolation, wrapping);
+    }
 };
 
 std::shared_ptr<LayerRAM> createLayerRAM(const size2_t& dimensions, LayerType type,
@@ -54,4 +65,16 @@ std::shared_ptr<LayerRAM> createLayerRAM(const size2_t& dimensions, LayerType ty
         format->getId(), disp, dimensions, type, swizzleMask, interpolation, wrapping);
 }
 
+std::shared_ptr<LayerRAM> createLayerRAM(const size2_t& dimensions, LayerType type,
+                                         const DataFormatBase* format, void* dataPtr,
+                                         std::shared_ptr<void> dataOwner,
+                                         const SwizzleMask& swizzleMask,
+                                         InterpolationType interpolation,
+                                         const Wrapping2D& wrapping) {
+    LayerRAMCreationDispatcher disp;
+    return dispatching::dispatch<std::shared_ptr<LayerRAM>, dispatching::filter::All>(
+        format->getId(), disp, dataPtr, std::move(dataOwner), dimensions, type, swizzleMask,
+        interpolation, wrapping);
+}
+
 }  // namespace inviwo
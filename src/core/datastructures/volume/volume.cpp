@@ -221,10 +221,14 @@ const StructuredCameraCoordinateTransformer<3>& Volume::getCoordinateTransformer
 }
 
 std::shared_ptr<HistogramCalculationState> Volume::calculateHistograms(size_t bins) const {
+    // The shared representation is kept from eviction until the calculation is done
+    return HistogramSupplier::startCalculation(getSharedRepresentation<VolumeRAM>(),
+                                               dataMap_.dataRange, bins);
+}
 
-    getRepresentation<VolumeRAM>();  // make sure lastValidRepresentation_ is VolumeRAM
-    return HistogramSupplier::startCalculation(
-        std::static_pointer_cast<VolumeRAM>(lastValidRepresentation_), dataMap_.dataRange, bins);
+void Volume::editRegion(size3_t offset, size3_t dims,
+                        const std::function<void(VolumeRAM&)>& edit) {
+    HistogramSupplier::editRegion(*getEditableRepresentation<VolumeRAM>(), offset, dims, edit);
 }
 
 template class IVW_CORE_TMPL_INST DataReaderType<Volume>;
@@ -0,0 +1,156 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/volume/volumebrickcache.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+
+namespace inviwo {
+
+VolumeBrickCache::VolumeBrickCache(size_t capacity)
+    : mutex_{}, entries_{}, lookup_{}, capacity_{capacity}, size_{0}, sourceId_{0}, loadId_{0} {}
+
+VolumeBrickCache::~VolumeBrickCache() = default;
+
+std::shared_ptr<VolumeBrickCache> VolumeBrickCache::getDefault() {
+    static auto cache = std::make_shared<VolumeBrickCache>(size_t{2} << 30);
+    return cache;
+}
+
+size_t VolumeBrickCache::newSourceId() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return sourceId_++;
+}
+
+std::shared_ptr<const VolumeRAM> VolumeBrickCache::get(
+    size_t source, size_t brick, const std::function<std::shared_ptr<VolumeRAM>()>& load) {
+
+    const Key key{source, brick};
+    std::promise<std::shared_ptr<const VolumeRAM>> promise;
+    size_t loadId = 0;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = lookup_.find(key);
+        if (it != lookup_.end()) {
+            entries_.splice(entries_.begin(), entries_, it->second);
+            auto future = it->second->brick;
+            lock.unlock();
+            return future.get();
+        }
+        loadId = loadId_++;
+        entries_.push_front(Entry{key, promise.get_future().share(), 0, loadId});
+        lookup_[key] = entries_.begin();
+    }
+
+    std::shared_ptr<const VolumeRAM> result;
+    try {
+        result = load();
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = lookup_.find(key);
+        if (it != lookup_.end() && it->second->load == loadId) {
+            entries_.erase(it->second);
+            lookup_.erase(it);
+        }
+        throw;
+    }
+    promise.set_value(result);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = lookup_.find(key);
+    // The entry might have been removed by erase or clear while loading
+    if (it != lookup_.end() && it->second->load == loadId) {
+        if (result) {
+            it->second->bytes = result->getNumberOfBytes();
+            size_ += it->second->bytes;
+            evict();
+        } else {
+            // Do not cache failed loads, the next call will try again
+            entries_.erase(it->second);
+            lookup_.erase(it);
+        }
+    }
+    return result;
+}
+
+void VolumeBrickCache::evict() {
+    // Bricks that are still loading have zero bytes and are skipped
+    for (auto it = entries_.rbegin(); it != entries_.rend() && size_ > capacity_;) {
+        if (it->bytes == 0) {
+            ++it;
+            continue;
+        }
+        size_ -= it->bytes;
+        lookup_.erase(it->key);
+        it = std::make_reverse_iterator(entries_.erase(std::next(it).base()));
+    }
+}
+
+void VolumeBrickCache::erase(size_t source) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->key.first == source) {
+            size_ -= it->bytes;
+            lookup_.erase(it->key);
+            it = entries_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void VolumeBrickCache::clear() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    entries_.clear();
+    lookup_.clear();
+    size_ = 0;
+}
+
+void VolumeBrickCache::setCapacity(size_t capacity) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    evict();
+}
+
+size_t VolumeBrickCache::getCapacity() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return capacity_;
+}
+
+size_t VolumeBrickCache::getSize() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return size_;
+}
+
+size_t VolumeBrickCache::getNumberOfBricks() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+}  // namespace inviwo
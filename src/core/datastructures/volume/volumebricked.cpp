@@ -0,0 +1,211 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/volume/volumebricked.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumeregionloader.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <cstring>
+
+namespace inviwo {
+
+namespace {
+
+/**
+ * The brick most recently returned to the calling thread. Consecutive lookups mostly hit the same
+ * brick when sampling, those are served from here without locking the shared cache.
+ */
+struct LastBrick {
+    std::weak_ptr<const void> source;  //< Only used as a key, compared by owner
+    size_t index = 0;
+    std::shared_ptr<const VolumeRAM> brick;
+};
+thread_local LastBrick lastBrick;
+
+}  // namespace
+
+VolumeBricked::Source::Source(std::shared_ptr<VolumeBrickCache> aCache)
+    : cache{std::move(aCache)}, id{cache->newSourceId()} {}
+
+VolumeBricked::Source::~Source() { cache->erase(id); }
+
+VolumeBricked::VolumeBricked(std::shared_ptr<const VolumeRegionLoader> loader,
+                             const VolumeRepresentation& src, size3_t brickSize,
+                             std::shared_ptr<VolumeBrickCache> cache)
+    : VolumeRepresentation(src.getDataFormat())
+    , dimensions_{src.getDimensions()}
+    , swizzleMask_{src.getSwizzleMask()}
+    , interpolation_{src.getInterpolation()}
+    , wrapping_{src.getWrapping()}
+    , brickSize_{glm::max(brickSize, size3_t{1})}
+    , loader_{std::move(loader)}
+    , source_{std::make_shared<Source>(cache ? std::move(cache) : VolumeBrickCache::getDefault())} {
+
+    if (!loader_) throw Exception("VolumeBricked requires a loader", IVW_CONTEXT);
+}
+
+VolumeBricked* VolumeBricked::clone() const { return new VolumeBricked(*this); }
+
+std::type_index VolumeBricked::getTypeIndex() const {
+    return std::type_index(typeid(VolumeBricked));
+}
+
+void VolumeBricked::setDimensions(size3_t) {
+    throw Exception("Can not set dimension of a Volume Bricked", IVW_CONTEXT);
+}
+
+const size3_t& VolumeBricked::getDimensions() const { return dimensions_; }
+
+void VolumeBricked::setSwizzleMask(const SwizzleMask& mask) { swizzleMask_ = mask; }
+
+SwizzleMask VolumeBricked::getSwizzleMask() const { return swizzleMask_; }
+
+void VolumeBricked::setInterpolation(InterpolationType interpolation) {
+    interpolation_ = interpolation;
+}
+
+InterpolationType VolumeBricked::getInterpolation() const { return interpolation_; }
+
+void VolumeBricked::setWrapping(const Wrapping3D& wrapping) { wrapping_ = wrapping; }
+
+Wrapping3D VolumeBricked::getWrapping() const { return wrapping_; }
+
+const size3_t& VolumeBricked::getBrickSize() const { return brickSize_; }
+
+size3_t VolumeBricked::getNumberOfBricks() const {
+    return (dimensions_ + brickSize_ - size3_t{1}) / brickSize_;
+}
+
+const VolumeRegionLoader& VolumeBricked::getLoader() const { return *loader_; }
+
+VolumeBrickCache& VolumeBricked::getCache() const { return *source_->cache; }
+
+std::shared_ptr<const VolumeRAM> VolumeBricked::getBrick(const size3_t& brick) const {
+    const auto nBricks = getNumberOfBricks();
+    if (glm::any(glm::greaterThanEqual(brick, nBricks))) {
+        throw RangeException("Brick index out of range", IVW_CONTEXT);
+    }
+    const auto index = util::IndexMapper3D(nBricks)(brick);
+
+    auto& last = lastBrick;
+    if (last.brick && last.index == index && !last.source.owner_before(source_) &&
+        !source_.owner_before(last.source)) {
+        return last.brick;
+    }
+
+    auto ram = source_->cache->get(source_->id, index, [&]() {
+        const auto offset = brick * brickSize_;
+        const auto extent = glm::min(brickSize_, dimensions_ - offset);
+        return loader_->loadRegion(*this, offset, extent);
+    });
+    last.source = source_;
+    last.index = index;
+    last.brick = ram;
+    return ram;
+}
+
+std::shared_ptr<const VolumeRAM> VolumeBricked::getBrickContaining(const size3_t& pos) const {
+    return getBrick(pos / brickSize_);
+}
+
+std::shared_ptr<VolumeRAM> VolumeBricked::getRegion(const size3_t& offset,
+                                                    const size3_t& extent) const {
+    if (glm::any(glm::greaterThan(offset + extent, dimensions_))) {
+        throw RangeException("Region out of range", IVW_CONTEXT);
+    }
+
+    auto region = createVolumeRAM(extent, getDataFormat(), nullptr, swizzleMask_, interpolation_,
+                                  wrapping_);
+    auto dst = static_cast<char*>(region->getData());
+    const auto elementSize = getDataFormat()->getSize();
+    const util::IndexMapper3D dstIm(extent);
+
+    forEachBrick(offset, extent, [&](const VolumeRAM& brick, const size3_t& brickOffset) {
+        const auto brickDims = brick.getDimensions();
+        const util::IndexMapper3D srcIm(brickDims);
+        const auto src = static_cast<const char*>(brick.getData());
+
+        // The overlap of the brick and the region, in volume coordinates
+        const auto begin = glm::max(offset, brickOffset);
+        const auto end = glm::min(offset + extent, brickOffset + brickDims);
+        const auto lineSize = (end.x - begin.x) * elementSize;
+
+        for (size_t z = begin.z; z < end.z; ++z) {
+            for (size_t y = begin.y; y < end.y; ++y) {
+                const size3_t pos{begin.x, y, z};
+                std::memcpy(dst + dstIm(pos - offset) * elementSize,
+                            src + srcIm(pos - brickOffset) * elementSize, lineSize);
+            }
+        }
+    });
+
+    return region;
+}
+
+double VolumeBricked::getAsDouble(const size3_t& pos) const {
+    return getBrickContaining(pos)->getAsDouble(pos % brickSize_);
+}
+
+dvec2 VolumeBricked::getAsDVec2(const size3_t& pos) const {
+    return getBrickContaining(pos)->getAsDVec2(pos % brickSize_);
+}
+
+dvec3 VolumeBricked::getAsDVec3(const size3_t& pos) const {
+    return getBrickContaining(pos)->getAsDVec3(pos % brickSize_);
+}
+
+dvec4 VolumeBricked::getAsDVec4(const size3_t& pos) const {
+    return getBrickContaining(pos)->getAsDVec4(pos % brickSize_);
+}
+
+namespace util {
+
+const VolumeBricked* getBrickedRepresentation(const Volume& volume, size_t minBytes) {
+    if (volume.hasRepresentation<VolumeRAM>()) return nullptr;
+    if (volume.hasRepresentation<VolumeBricked>()) return volume.getRepresentation<VolumeBricked>();
+    if (volume.hasRepresentation<VolumeDisk>()) {
+        const auto disk = volume.getRepresentation<VolumeDisk>();
+        const auto bytes = glm::compMul(disk->getDimensions()) * disk->getDataFormat()->getSize();
+        if (bytes > minBytes && dynamic_cast<const VolumeRegionLoader*>(disk->getLoader())) {
+            return volume.getRepresentation<VolumeBricked>();
+        }
+    }
+    return nullptr;
+}
+
+const VolumeBricked* getBrickedRepresentation(const Volume& volume) {
+    return getBrickedRepresentation(volume, VolumeBrickCache::getDefault()->getCapacity());
+}
+
+}  // namespace util
+
+}  // namespace inviwo
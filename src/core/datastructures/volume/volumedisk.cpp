@@ -55,6 +55,8 @@ VolumeDisk* VolumeDisk::clone() const { return new VolumeDisk(*this); }
 
 std::type_index VolumeDisk::getTypeIndex() const { return std::type_index(typeid(VolumeDisk)); }
 
+bool VolumeDisk::isReloadable() const { return getLoader() != nullptr; }
+
 void VolumeDisk::setDimensions(size3_t) {
     throw Exception("Can not set dimension of a Volume Disk", IVW_CONTEXT);
 }
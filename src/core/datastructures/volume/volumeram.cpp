@@ -36,4 +36,6 @@ VolumeRAM::VolumeRAM(const DataFormatBase* format) : VolumeRepresentation(format
 
 std::type_index VolumeRAM::getTypeIndex() const { return std::type_index(typeid(VolumeRAM)); }
 
+size_t VolumeRAM::getMemoryUsage() const { return getNumberOfBytes(); }
+
 }  // namespace inviwo
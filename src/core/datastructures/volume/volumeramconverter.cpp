@@ -29,6 +29,9 @@
 
 #include <inviwo/core/datastructures/volume/volumeramconverter.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeregionloader.h>
+
+#include <cstring>
 
 namespace inviwo {
 
@@ -42,4 +45,45 @@ void VolumeDisk2RAMConverter::update(std::shared_ptr<const VolumeDisk> source,
     source->updateRepresentation(destination);
 }
 
+std::shared_ptr<VolumeBricked> VolumeDisk2BrickedConverter::createFrom(
+    std::shared_ptr<const VolumeDisk> source) const {
+    std::shared_ptr<const DiskRepresentationLoader<VolumeRepresentation>> loader{
+        source->getLoader() ? source->getLoader()->clone() : nullptr};
+    if (auto regionLoader = dynamic_cast<const VolumeRegionLoader*>(loader.get())) {
+        // The region loader shares ownership of the cloned loader
+        return std::make_shared<VolumeBricked>(
+            std::shared_ptr<const VolumeRegionLoader>{loader, regionLoader}, *source);
+    }
+    throw ConverterException("The loader of the volume can not load regions", IVW_CONTEXT);
+}
+
+void VolumeDisk2BrickedConverter::update(std::shared_ptr<const VolumeDisk> source,
+                                         std::shared_ptr<VolumeBricked> destination) const {
+    if (source->getDimensions() != destination->getDimensions() ||
+        source->getDataFormat() != destination->getDataFormat()) {
+        throw ConverterException("Can not update a bricked volume with a different size or format",
+                                 IVW_CONTEXT);
+    }
+    destination->setSwizzleMask(source->getSwizzleMask());
+    destination->setInterpolation(source->getInterpolation());
+    destination->setWrapping(source->getWrapping());
+}
+
+std::shared_ptr<VolumeRAM> VolumeBricked2RAMConverter::createFrom(
+    std::shared_ptr<const VolumeBricked> source) const {
+    return source->getLoader().loadRegion(*source, size3_t{0}, source->getDimensions());
+}
+
+void VolumeBricked2RAMConverter::update(std::shared_ptr<const VolumeBricked> source,
+                                        std::shared_ptr<VolumeRAM> destination) const {
+    if (source->getDimensions() != destination->getDimensions()) {
+        destination->setDimensions(source->getDimensions());
+    }
+    const auto ram = createFrom(source);
+    std::memcpy(destination->getData(), ram->getData(), ram->getNumberOfBytes());
+    destination->setSwizzleMask(source->getSwizzleMask());
+    destination->setInterpolation(source->getInterpolation());
+    destination->setWrapping(source->getWrapping());
+}
+
 }  // namespace inviwo
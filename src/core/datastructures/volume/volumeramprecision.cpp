@@ -42,6 +42,17 @@ struct VolumeRamCreationDispatcher {
         return std::make_shared<VolumeRAMPrecision<F>>(static_cast<F*>(dataPtr), dimensions,
                                                        swizzleMask, interpolation, wrapping);
     }
+    template <typename Result, typename T>
+    std::shared_ptr<VolumeRAM> operator()(void* dataPtr, std::shared_ptr<void> dataOwner,
+                                          const size3_t& dimensions,
+                                          const SwizzleMask& swizzleMask,
+                                          InterpolationType interpolation,
+                                          const Wrapping3D& wrapping) {
+        using F = typename T::type;
+        return std::make_shared<VolumeRAMPrecision<F>>(std::move(dataOwner),
+                                                       static_cast<F*>(dataPtr), dimensions,
+                                                       swizzleMask, interpolation, wrapping);
+    }
 };
 
 std::shared_ptr<VolumeRAM> createVolumeRAM(const size3_t& dimensions, const DataFormatBase* format,
@@ -53,4 +64,15 @@ std::shared_ptr<VolumeRAM> createVolumeRAM(const size3_t& dimensions, const Data
         format->getId(), disp, dataPtr, dimensions, swizzleMask, interpolation, wrapping);
 }
 
+std::shared_ptr<VolumeRAM> createVolumeRAM(const size3_t& dimensions, const DataFormatBase* format,
+                                           void* dataPtr, std::shared_ptr<void> dataOwner,
+                                           const SwizzleMask& swizzleMask,
+                                           InterpolationType interpolation,
+                                           const Wrapping3D& wrapping) {
+    VolumeRamCreationDispatcher disp;
+    return dispatching::dispatch<std::shared_ptr<VolumeRAM>, dispatching::filter::All>(
+        format->getId(), disp, dataPtr, std::move(dataOwner), dimensions, swizzleMask,
+        interpolation, wrapping);
+}
+
 }  // namespace inviwo
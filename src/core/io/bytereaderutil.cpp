@@ -31,9 +31,70 @@
 #include <inviwo/core/io/datareaderexception.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/parallel.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 namespace inviwo {
 
+namespace {
+
+template <typename T>
+constexpr T byteSwap(T v) {
+    if constexpr (sizeof(T) == 2) {
+        return static_cast<T>((v >> 8) | (v << 8));
+    } else if constexpr (sizeof(T) == 4) {
+        return ((v & 0x000000FFu) << 24) | ((v & 0x0000FF00u) << 8) | ((v & 0x00FF0000u) >> 8) |
+               ((v & 0xFF000000u) >> 24);
+    } else {
+        return (static_cast<T>(byteSwap(static_cast<std::uint32_t>(v))) << 32) |
+               byteSwap(static_cast<std::uint32_t>(v >> 32));
+    }
+}
+
+// The data might not be aligned to T, memcpy avoids undefined behavior and is optimized away.
+template <typename T>
+void swapRange(char* data, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        T v;
+        std::memcpy(&v, data + i * sizeof(T), sizeof(T));
+        v = byteSwap(v);
+        std::memcpy(data + i * sizeof(T), &v, sizeof(T));
+    }
+}
+
+}  // namespace
+
+void util::swapByteOrder(void* data, size_t bytes, size_t elementSize) {
+    if (elementSize < 2) return;
+    auto bytePtr = static_cast<char*>(data);
+    const auto count = bytes / elementSize;
+
+    const auto swap = [&](size_t begin, size_t end) {
+        auto first = bytePtr + begin * elementSize;
+        switch (elementSize) {
+            case 2:
+                swapRange<std::uint16_t>(first, end - begin);
+                break;
+            case 4:
+                swapRange<std::uint32_t>(first, end - begin);
+                break;
+            case 8:
+                swapRange<std::uint64_t>(first, end - begin);
+                break;
+            default:
+                for (size_t i = begin; i < end; ++i, first += elementSize) {
+                    std::reverse(first, first + elementSize);
+                }
+                break;
+        }
+    };
+    // The swap is limited by memory bandwidth, only split large buffers.
+    util::parallelFor(size_t{0}, count, swap, std::max(size_t{1} << 20, count / 64));
+}
+
 void util::readBytesIntoBuffer(const std::string& file, size_t offset, size_t bytes,
                                bool littleEndian, size_t elementSize, void* dest) {
     auto fin = filesystem::ifstream(file, std::ios::in | std::ios::binary);
@@ -44,17 +105,7 @@ void util::readBytesIntoBuffer(const std::string& file, size_t offset, size_t by
         fin.read(static_cast<char*>(dest), bytes);
 
         if (!littleEndian && elementSize > 1) {
-            char* temp = new char[elementSize];
-
-            for (std::size_t i = 0; i < bytes; i += elementSize) {
-                for (std::size_t j = 0; j < elementSize; j++)
-                    temp[j] = static_cast<char*>(dest)[i + j];
-
-                for (std::size_t j = 0; j < elementSize; j++)
-                    static_cast<char*>(dest)[i + j] = temp[elementSize - j - 1];
-            }
-
-            delete[] temp;
+            swapByteOrder(dest, bytes, elementSize);
         }
     } else {
         throw DataReaderException("Error: Could not read from file: " + file,
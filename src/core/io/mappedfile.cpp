@@ -0,0 +1,128 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/mappedfile.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#ifdef WIN32
+struct IUnknown;  // Workaround for "combaseapi.h(229): error C2187: syntax error: 'identifier' was
+                  // unexpected here" when using /permissive-
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace inviwo {
+
+#ifdef WIN32
+
+MappedFile::MappedFile(const std::string& file, size_t offset, size_t size)
+    : view_{nullptr}
+    , viewSize_{0}
+    , data_{nullptr}
+    , size_{size}
+    , file_{INVALID_HANDLE_VALUE}
+    , mapping_{nullptr} {
+
+    const auto fail = [&](const std::string& message) {
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+        throw FileException(message + file, IVW_CONTEXT_CUSTOM("MappedFile"));
+    };
+
+    file_ = CreateFileW(util::toWstring(file).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) fail("Could not open file: ");
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file_, &fileSize) ||
+        static_cast<size_t>(fileSize.QuadPart) < offset + size) {
+        fail("Could not map file, it is too small: ");
+    }
+
+    mapping_ = CreateFileMappingW(file_, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (!mapping_) fail("Could not map file: ");
+
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const size_t viewOffset = offset - offset % info.dwAllocationGranularity;
+    viewSize_ = size + (offset - viewOffset);
+    view_ = MapViewOfFile(mapping_, FILE_MAP_COPY, static_cast<DWORD>(viewOffset >> 32),
+                          static_cast<DWORD>(viewOffset & 0xFFFFFFFF), viewSize_);
+    if (!view_) fail("Could not map file: ");
+
+    data_ = static_cast<char*>(view_) + (offset - viewOffset);
+}
+
+MappedFile::~MappedFile() {
+    UnmapViewOfFile(view_);
+    CloseHandle(mapping_);
+    CloseHandle(file_);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& file, size_t offset, size_t size)
+    : view_{nullptr}, viewSize_{0}, data_{nullptr}, size_{size} {
+
+    const int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw FileException("Could not open file: " + file, IVW_CONTEXT_CUSTOM("MappedFile"));
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < offset + size) {
+        ::close(fd);
+        throw FileException("Could not map file, it is too small: " + file,
+                            IVW_CONTEXT_CUSTOM("MappedFile"));
+    }
+
+    const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t viewOffset = offset - offset % pageSize;
+    viewSize_ = size + (offset - viewOffset);
+    // A private writable mapping is copy-on-write, the mapping stays valid after closing fd.
+    view_ = mmap(nullptr, viewSize_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+                 static_cast<off_t>(viewOffset));
+    ::close(fd);
+    if (view_ == MAP_FAILED) {
+        throw FileException("Could not map file: " + file, IVW_CONTEXT_CUSTOM("MappedFile"));
+    }
+
+    data_ = static_cast<char*>(view_) + (offset - viewOffset);
+}
+
+MappedFile::~MappedFile() { munmap(view_, viewSize_); }
+
+#endif
+
+}  // namespace inviwo
@@ -30,21 +30,46 @@
 #include <inviwo/core/io/rawvolumeramloader.h>
 
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/mappedfile.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <cstring>
 
 namespace inviwo {
 
-RawVolumeRAMLoader::RawVolumeRAMLoader(const std::string& rawFile, size_t offset, bool littleEndian)
-    : rawFile_(rawFile), offset_(offset), littleEndian_(littleEndian) {}
+RawVolumeRAMLoader::RawVolumeRAMLoader(const std::string& rawFile, size_t offset, bool littleEndian,
+                                       bool memoryMap)
+    : rawFile_(rawFile), offset_(offset), littleEndian_(littleEndian), memoryMap_(memoryMap) {}
 
 RawVolumeRAMLoader* RawVolumeRAMLoader::clone() const { return new RawVolumeRAMLoader(*this); }
 
 std::shared_ptr<VolumeRepresentation> RawVolumeRAMLoader::createRepresentation(
     const VolumeRepresentation& src) const {
 
-    const auto size = glm::compMul(src.getDimensions()) * src.getDataFormat()->getSize();
+    const auto format = src.getDataFormat();
+    const auto size = glm::compMul(src.getDimensions()) * format->getSize();
+    // Swap each component, not the whole element
+    const auto componentSize = format->getSize() / format->getComponents();
+
+    // The data has to be aligned to the component size to be used directly
+    if (memoryMap_ && size > 0 && offset_ % componentSize == 0) {
+        try {
+            auto mapped = std::make_shared<MappedFile>(rawFile_, offset_, size);
+            if (!littleEndian_ && componentSize > 1) {
+                util::swapByteOrder(mapped->data(), size, componentSize);
+            }
+            auto data = mapped->data();
+            return createVolumeRAM(src.getDimensions(), format, data, std::move(mapped),
+                                   src.getSwizzleMask(), src.getInterpolation(),
+                                   src.getWrapping());
+        } catch (const FileException& e) {
+            LogWarn("Memory mapping failed, reading the data instead: " << e.getMessage());
+        }
+    }
+
     auto data = std::make_unique<char[]>(size);
-    util::readBytesIntoBuffer(rawFile_, offset_, size, littleEndian_,
-                              src.getDataFormat()->getSize(), data.get());
+    util::readBytesIntoBuffer(rawFile_, offset_, size, littleEndian_, componentSize, data.get());
 
     auto volumeRAM =
         createVolumeRAM(src.getDimensions(), src.getDataFormat(), data.get(), src.getSwizzleMask(),
@@ -62,12 +87,65 @@ void RawVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentati
         volumeDst->setDimensions(src.getDimensions());
     }
 
+    const auto format = src.getDataFormat();
     const auto size = glm::compMul(src.getDimensions());
-    util::readBytesIntoBuffer(rawFile_, offset_, size * src.getDataFormat()->getSize(),
-                              littleEndian_, src.getDataFormat()->getSize(), volumeDst->getData());
+    util::readBytesIntoBuffer(rawFile_, offset_, size * format->getSize(), littleEndian_,
+                              format->getSize() / format->getComponents(), volumeDst->getData());
 
     volumeDst->setSwizzleMask(src.getSwizzleMask());
     volumeDst->setInterpolation(src.getInterpolation());
     volumeDst->setWrapping(src.getWrapping());
 }
+
+std::shared_ptr<VolumeRAM> RawVolumeRAMLoader::loadRegion(const VolumeRepresentation& src,
+                                                          size3_t offset, size3_t extent) const {
+    const auto format = src.getDataFormat();
+    const auto elementSize = format->getSize();
+    const auto componentSize = elementSize / format->getComponents();
+
+    auto region = createVolumeRAM(extent, format, nullptr, src.getSwizzleMask(),
+                                  src.getInterpolation(), src.getWrapping());
+    if (glm::compMul(extent) == 0) return region;
+
+    // The region is read line by line, [first, last) is the range of bytes that covers it
+    const util::IndexMapper3D im(src.getDimensions());
+    const auto first = im(offset) * elementSize;
+    const auto last = (im(offset + extent - size3_t{1}) + 1) * elementSize;
+    const auto lineSize = extent.x * elementSize;
+
+    const auto readLines = [&](auto readLine) {
+        auto dst = static_cast<char*>(region->getData());
+        for (size_t z = offset.z; z < offset.z + extent.z; ++z) {
+            for (size_t y = offset.y; y < offset.y + extent.y; ++y, dst += lineSize) {
+                readLine(im(offset.x, y, z) * elementSize - first, dst);
+            }
+        }
+    };
+
+    bool read = false;
+    if (memoryMap_) {
+        try {
+            const MappedFile mapped(rawFile_, offset_ + first, last - first);
+            const auto data = static_cast<const char*>(mapped.data());
+            readLines([&](size_t pos, char* dst) { std::memcpy(dst, data + pos, lineSize); });
+            read = true;
+        } catch (const FileException&) {
+        }
+    }
+    if (!read) {
+        auto fin = filesystem::ifstream(rawFile_, std::ios::in | std::ios::binary);
+        if (!fin.good()) {
+            throw DataReaderException("Error: Could not read from file: " + rawFile_, IVW_CONTEXT);
+        }
+        readLines([&](size_t pos, char* dst) {
+            fin.seekg(offset_ + first + pos);
+            fin.read(dst, lineSize);
+        });
+    }
+
+    if (!littleEndian_ && componentSize > 1) {
+        util::swapByteOrder(region->getData(), region->getNumberOfBytes(), componentSize);
+    }
+    return region;
+}
 }  // namespace inviwo
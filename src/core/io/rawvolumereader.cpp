@@ -46,7 +46,8 @@ RawVolumeReader::RawVolumeReader()
     , spacing_(0.01f)
     , format_(nullptr)
     , byteOffset_(0u)
-    , parametersSet_(false) {
+    , parametersSet_(false)
+    , memoryMap_(false) {
     addExtension(FileExtension("raw", "Raw binary file"));
 }
 
@@ -58,7 +59,8 @@ RawVolumeReader::RawVolumeReader(const RawVolumeReader& rhs)
     , spacing_(rhs.spacing_)
     , format_(rhs.format_)
     , byteOffset_(rhs.byteOffset_)
-    , parametersSet_(false) {}
+    , parametersSet_(false)
+    , memoryMap_(rhs.memoryMap_) {}
 
 RawVolumeReader& RawVolumeReader::operator=(const RawVolumeReader& that) {
     if (this != &that) {
@@ -69,6 +71,7 @@ RawVolumeReader& RawVolumeReader::operator=(const RawVolumeReader& that) {
         format_ = that.format_;
         dataMapper_ = that.dataMapper_;
         byteOffset_ = that.byteOffset_;
+        memoryMap_ = that.memoryMap_;
         DataReaderType<Volume>::operator=(that);
     }
 
@@ -87,6 +90,21 @@ void RawVolumeReader::setParameters(const DataFormatBase* format, ivec3 dimensio
     byteOffset_ = byteOffset;
 }
 
+bool RawVolumeReader::setOption(std::string_view key, std::any value) {
+    if (auto* memoryMap = std::any_cast<bool>(&value); memoryMap && key == "MemoryMap") {
+        memoryMap_ = *memoryMap;
+        return true;
+    }
+    return false;
+}
+
+std::any RawVolumeReader::getOption(std::string_view key) {
+    if (key == "MemoryMap") {
+        return memoryMap_;
+    }
+    return std::any{};
+}
+
 std::shared_ptr<Volume> RawVolumeReader::readData(const std::string& filePath) {
     return readData(filePath, nullptr);
 }
@@ -174,7 +192,8 @@ std::shared_ptr<Volume> RawVolumeReader::readData(const std::string& filePath,
         volume->setOffset(offset);
         volume->setWorldMatrix(wtm);
         auto vd = std::make_shared<VolumeDisk>(filePath, dimensions_, format_);
-        auto loader = std::make_unique<RawVolumeRAMLoader>(rawFile_, byteOffset_, littleEndian_);
+        auto loader = std::make_unique<RawVolumeRAMLoader>(rawFile_, byteOffset_, littleEndian_,
+                                                           memoryMap_);
         vd->setLoader(loader.release());
         volume->addRepresentation(vd);
 
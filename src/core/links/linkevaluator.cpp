@@ -38,6 +38,7 @@
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/network/networklock.h>
 #include <inviwo/core/properties/compositeproperty.h>
+#include <inviwo/core/util/trace.h>
 
 namespace inviwo {
 
@@ -197,6 +198,7 @@ void LinkEvaluator::evaluateLinksFromProperty(Property* modifiedProperty) {
     VisitedHelper helper(visited_, links);
 
     for (auto& link : links) {
+        TraceScope trace{"link", [&]() { return link.dst_->getPath(); }};
         link.converter_->convert(link.src_, link.dst_);
     }
 }
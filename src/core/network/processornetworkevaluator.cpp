@@ -29,12 +29,22 @@
 
 #include <inviwo/core/network/processornetworkevaluator.h>
 #include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/network/networkutils.h>
 #include <inviwo/core/network/networklock.h>
 #include <inviwo/core/util/clock.h>
+#include <inviwo/core/util/threadpool.h>
+#include <inviwo/core/util/trace.h>
+#include <inviwo/core/resourcemanager/memorymanager.h>
+
+#include <set>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
 
 namespace inviwo {
 
@@ -42,7 +52,8 @@ ProcessorNetworkEvaluator::ProcessorNetworkEvaluator(ProcessorNetwork* processor
     : processorNetwork_(processorNetwork)
     , processorsSorted_(util::topologicalSortFiltered(processorNetwork_))
     , evaulationQueued_(false)
-    , exceptionHandler_(StandardEvaluationErrorHandler()) {
+    , exceptionHandler_(StandardEvaluationErrorHandler())
+    , evaluationMode_(EvaluationMode::Serial) {
 
     processorNetwork_->addObserver(this);
 }
@@ -51,6 +62,10 @@ void ProcessorNetworkEvaluator::setExceptionHandler(EvaluationErrorHandler handl
     exceptionHandler_ = handler;
 }
 
+void ProcessorNetworkEvaluator::setEvaluationMode(EvaluationMode mode) { evaluationMode_ = mode; }
+
+EvaluationMode ProcessorNetworkEvaluator::getEvaluationMode() const { return evaluationMode_; }
+
 void ProcessorNetworkEvaluator::onProcessorNetworkEvaluateRequest() {
     // Direct request, thus we don't want to queue the evaluation anymore
     evaulationQueued_ = false;
@@ -100,59 +115,258 @@ void ProcessorNetworkEvaluator::evaluate() {
     notifyObserversProcessorNetworkEvaluationBegin();
 
     IVW_CPU_PROFILING_IF(500, "Evaluated Processor Network");
+    TraceScope trace{"network", "Evaluate Processor Network"};
+
+    switch (evaluationMode_) {
+        case EvaluationMode::Parallel:
+            evaluateParallel();
+            break;
+        case EvaluationMode::Serial:
+        default:
+            evaluateSerial();
+            break;
+    }
+
+    notifyObserversProcessorNetworkEvaluationEnd();
+
+    // Everything used in this evaluation is kept, see MemoryManager::enforceBudget
+    if (MemoryManager::isInitialized()) MemoryManager::getPtr()->enforceBudget();
+}
+
+bool ProcessorNetworkEvaluator::shouldProcess(Processor* processor) {
+    if (processor->isValid()) return false;
+    if (!processor->isReady()) {
+        try {
+            processor->doIfNotReady();
+        } catch (...) {
+            exceptionHandler_(processor, EvaluationType::NotReady, IVW_CONTEXT);
+        }
+        return false;
+    }
+    return true;
+}
+
+bool ProcessorNetworkEvaluator::prepareProcess(Processor* processor) {
+    try {
+        // re-initialize resources (e.g., shaders) if necessary
+        if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
+            TraceScope trace{"initializeResources", [&]() { return processor->getIdentifier(); }};
+            processor->initializeResources();
+        }
+    } catch (...) {
+        exceptionHandler_(processor, EvaluationType::InitResource, IVW_CONTEXT);
+        return false;
+    }
+
+    try {
+        // call onChange for all invalid inports
+        for (auto inport : processor->getInports()) {
+            if (!inport->isChanged()) continue;
+            TraceScope trace{"onChange", [&]() {
+                                 return processor->getIdentifier() + "." + inport->getIdentifier();
+                             }};
+            inport->callOnChangeIfChanged();
+        }
+    } catch (...) {
+        exceptionHandler_(processor, EvaluationType::PortOnChange, IVW_CONTEXT);
+        return false;
+    }
+    return true;
+}
+
+void ProcessorNetworkEvaluator::finishProcess(Processor* processor, std::exception_ptr error) {
+    if (error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (...) {
+            exceptionHandler_(processor, EvaluationType::Process, IVW_CONTEXT);
+        }
+    } else if (processor->isReady()) {
+        // Set processor as valid only if we still are ready.
+        // Callbacks might have made our inports invalid, if so abort
+        // the evaluation by not setting the processor valid.
+        processor->setValid();
+    }
 
+    processor->notifyObserversFinishedProcess(processor);
+}
+
+void ProcessorNetworkEvaluator::evaluateSerial() {
     for (auto processor : processorsSorted_) {
-        if (!processor->isValid()) {
-            if (processor->isReady()) {
-                try {
-                    // re-initialize resources (e.g., shaders) if necessary
-                    if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
-                        processor->initializeResources();
-                    }
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::InitResource, IVW_CONTEXT);
-                    continue;
-                }
+        if (!shouldProcess(processor) || !prepareProcess(processor)) continue;
 
-                try {
-                    // call onChange for all invalid inports
-                    for (auto inport : processor->getInports()) {
-                        inport->callOnChangeIfChanged();
-                    }
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::PortOnChange, IVW_CONTEXT);
-                    continue;
+        processor->notifyObserversAboutToProcess(processor);
+
+        std::exception_ptr error;
+        try {
+            IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
+            TraceScope trace{"process", [&]() { return processor->getIdentifier(); }};
+            // do the actual processing
+            processor->process();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        finishProcess(processor, error);
+    }
+}
+
+namespace {
+
+/**
+ * Only processors that are tagged as pure CPU processors are processed in the thread pool.
+ * GL and CL processors needs the render context of the main thread, Python processors the GIL,
+ * processor widgets the GUI thread, and PoolProcessors already run their work asynchronously.
+ */
+bool canProcessConcurrently(Processor* processor) {
+    const auto tags = processor->getTags();
+    return util::contains(tags.tags_, Tag::CPU) && !util::contains(tags.tags_, Tag::GL) &&
+           !util::contains(tags.tags_, Tag::CL) && !util::contains(tags.tags_, Tag::PY) &&
+           !processor->hasProcessorWidget() && !dynamic_cast<PoolProcessor*>(processor);
+}
+
+}  // namespace
+
+void ProcessorNetworkEvaluator::evaluateParallel() {
+    const auto size = processorsSorted_.size();
+
+    // Build the dependency graph from the port connections. Predecessors outside of the sorted
+    // list will not be evaluated and are ignored.
+    std::unordered_map<Processor*, size_t> index;
+    for (size_t i = 0; i < size; ++i) index[processorsSorted_[i]] = i;
+
+    std::vector<std::vector<size_t>> dependents(size);
+    std::vector<size_t> pending(size, 0);
+    for (size_t i = 0; i < size; ++i) {
+        for (auto inport : processorsSorted_[i]->getInports()) {
+            for (auto outport : inport->getConnectedOutports()) {
+                auto it = index.find(outport->getProcessor());
+                if (it != index.end() && util::push_back_unique(dependents[it->second], i)) {
+                    ++pending[i];
                 }
+            }
+        }
+    }
 
-                processor->notifyObserversAboutToProcess(processor);
+    // Ordered by topological position to keep the main thread evaluation order deterministic.
+    std::set<size_t> ready;
+    for (size_t i = 0; i < size; ++i) {
+        if (pending[i] == 0) ready.insert(i);
+    }
 
-                try {
-                    IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
-                    // do the actual processing
-                    processor->process();
+    // Keep one worker free for any jobs that the processed processors dispatch and wait for
+    auto& pool = processorNetwork_->getApplication()->getThreadPool();
+    const size_t maxConcurrent = pool.getSize() > 1 ? pool.getSize() - 1 : 0;
+    size_t running = 0;
+    size_t remaining = size;
 
-                    // Set processor as valid only if we still are ready.
-                    // Callbacks might have made our inports invalid, if so abort
-                    // the evaluation by not setting the processor valid.
-                    if (processor->isReady()) processor->setValid();
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<std::pair<size_t, std::exception_ptr>> finished;
 
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::Process, IVW_CONTEXT);
+    const auto release = [&](size_t i) {
+        --remaining;
+        for (auto dependent : dependents[i]) {
+            if (--pending[dependent] == 0) ready.insert(dependent);
+        }
+    };
+
+    const auto collect = [&](bool wait) {
+        std::vector<std::pair<size_t, std::exception_ptr>> done;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (wait) condition.wait(lock, [&]() { return !finished.empty(); });
+            std::swap(done, finished);
+        }
+        for (auto& [i, error] : done) {
+            --running;
+            finishProcess(processorsSorted_[i], error);
+            release(i);
+        }
+    };
+
+    while (remaining > 0) {
+        collect(false);
+
+        auto mainThreadCandidate = ready.end();
+        bool progress = false;
+        for (auto it = ready.begin(); it != ready.end(); ++it) {
+            auto i = *it;
+            auto processor = processorsSorted_[i];
+
+            if (!shouldProcess(processor)) {
+                ready.erase(it);
+                release(i);
+                progress = true;
+                break;
+            }
+
+            if (maxConcurrent > 0 && canProcessConcurrently(processor)) {
+                if (running >= maxConcurrent) continue;
+                ready.erase(it);
+                if (!prepareProcess(processor)) {
+                    release(i);
+                    progress = true;
+                    break;
                 }
+                processor->notifyObserversAboutToProcess(processor);
+                ++running;
+                pool.enqueueRaw([&mutex, &condition, &finished, processor, i]() {
+                    std::exception_ptr error;
+                    try {
+                        IVW_CPU_PROFILING_IF_CUSTOM(500, "ProcessorNetworkEvaluator",
+                                                    "Processed " << processor->getIdentifier());
+                        TraceScope trace{"process",
+                                         [&]() { return processor->getIdentifier(); }};
+                        processor->process();
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        finished.emplace_back(i, error);
+                    }
+                    condition.notify_one();
+                });
+                progress = true;
+                break;
+            } else if (mainThreadCandidate == ready.end()) {
+                mainThreadCandidate = it;
+            }
+        }
+        if (progress) continue;
 
-                processor->notifyObserversFinishedProcess(processor);
+        if (mainThreadCandidate != ready.end()) {
+            auto i = *mainThreadCandidate;
+            auto processor = processorsSorted_[i];
+            ready.erase(mainThreadCandidate);
 
-            } else {
+            if (prepareProcess(processor)) {
+                processor->notifyObserversAboutToProcess(processor);
+                std::exception_ptr error;
                 try {
-                    processor->doIfNotReady();
+                    IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
+                    TraceScope trace{"process", [&]() { return processor->getIdentifier(); }};
+                    processor->process();
                 } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::NotReady, IVW_CONTEXT);
+                    error = std::current_exception();
                 }
+                finishProcess(processor, error);
             }
+            release(i);
+        } else if (running > 0) {
+            // Everything left depends on processors in flight
+            collect(true);
+        } else {
+            // Should not happen for an acyclic network, bail out instead of waiting forever.
+            LogError("Parallel network evaluation stalled with " << remaining
+                                                                 << " unevaluated processors");
+            break;
         }
     }
 
-    notifyObserversProcessorNetworkEvaluationEnd();
+    // make sure no job outlives this scope
+    while (running > 0) collect(true);
 }
 
 void ProcessorNetworkEvaluator::onProcessorSinkChanged(Processor*) {
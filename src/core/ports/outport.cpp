@@ -69,6 +69,8 @@ void Outport::setValid() {
     isReady_.update();
 }
 
+size_t Outport::getMemoryUsage() const { return 0; }
+
 void Outport::propagateEvent(Event* event, Inport*) { processor_->propagateEvent(event, this); }
 
 const BaseCallBack* Outport::onConnect(std::function<void()> lambda) {
@@ -35,30 +35,39 @@
 namespace inviwo {
 
 CompositeProcessorFactoryObject::CompositeProcessorFactoryObject(const std::string& file)
-    : ProcessorFactoryObject(makeProcessorInfo(file)), file_{file} {}
+    : ProcessorFactoryObject(makeClassIdentifier(file),
+                             [file]() { return makeProcessorInfo(file); })
+    , file_{file} {}
 
 std::unique_ptr<Processor> CompositeProcessorFactoryObject::create(InviwoApplication* app) {
     auto pi = getProcessorInfo();
     return std::make_unique<CompositeProcessor>(pi.displayName, pi.displayName, app, file_);
 }
 
-ProcessorInfo CompositeProcessorFactoryObject::makeProcessorInfo(const std::string& file) {
+std::string CompositeProcessorFactoryObject::makeClassIdentifier(const std::string& file) {
+    return ProcessorTraits<CompositeProcessor>::getProcessorInfo().classIdentifier +
+           util::stripIdentifier(file);
+}
 
-    auto pi = ProcessorTraits<CompositeProcessor>::getProcessorInfo();
+ProcessorInfo CompositeProcessorFactoryObject::makeProcessorInfo(const std::string& file) {
     auto name = filesystem::getFileNameWithoutExtension(file);
-    auto id = pi.classIdentifier + util::stripIdentifier(file);
-
-    Deserializer d{file};
     std::string tags;
-    d.deserialize("DisplayName", name);
-    d.deserialize("Tags", tags);
+    try {
+        Deserializer d{file};
+        d.deserialize("DisplayName", name);
+        d.deserialize("Tags", tags);
+    } catch (const Exception& e) {
+        LogWarnCustom("CompositeProcessorFactoryObject",
+                      "Could not read the display name and tags of composite processor "
+                          << file << ": " << e.getMessage());
+    }
 
     return {
-        id,                 // Class identifier
-        name,               // Display name
-        "Composites",       // Category
-        CodeState::Stable,  // Code state
-        tags,               // Tags
+        makeClassIdentifier(file),  // Class identifier
+        name,                       // Display name
+        "Composites",               // Category
+        CodeState::Stable,          // Code state
+        tags,                       // Tags
     };
 }
 
@@ -30,6 +30,7 @@
 #include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/trace.h>
 
 namespace inviwo {
 
@@ -106,8 +107,15 @@ void PoolProcessor::submit(Submission& job) {
     job.setupProgress();
     states_.push_back(job.state);
     notifyObserversStartBackgroundWork(this, job.tasks.size());
+    auto& pool = getNetwork()->getApplication()->getThreadPool();
     for (auto& task : job.tasks) {
-        getNetwork()->getApplication()->getThreadPool().enqueueRaw(std::move(task));
+        if (Tracer::isEnabled()) {
+            task = [task = std::move(task), name = getIdentifier()]() {
+                TraceScope trace{"job", name};
+                task();
+            };
+        }
+        pool.enqueueRaw(std::move(task), ThreadPool::Priority::High);
     }
 }
 
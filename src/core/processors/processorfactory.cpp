@@ -60,6 +60,9 @@ bool ProcessorFactory::registerObject(ProcessorFactoryObject* processor) {
                         "(org.inviwo.processor) not like: '{}' in module {}",
                         processor->getClassIdentifier(), moduleId()));
     }
+    // Deferred processor info is not looked up here, that would defeat the purpose
+    if (!processor->hasProcessorInfo()) return true;
+
     if (processor->getCategory().empty()) {
         LogWarn(fmt::format("Processor '{}' in module '{}' has no category",
                             processor->getClassIdentifier(), moduleId()));
@@ -0,0 +1,59 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/processors/processorfactoryobject.h>
+
+namespace inviwo {
+
+ProcessorFactoryObject::ProcessorFactoryObject(ProcessorInfo info)
+    : classIdentifier_{info.classIdentifier}, getInfo_{}, info_{std::move(info)}, hasInfo_{true} {}
+
+ProcessorFactoryObject::ProcessorFactoryObject(std::string classIdentifier,
+                                               std::function<ProcessorInfo()> getInfo)
+    : classIdentifier_{std::move(classIdentifier)}
+    , getInfo_{std::move(getInfo)}
+    , info_{}
+    , hasInfo_{false} {}
+
+bool ProcessorFactoryObject::hasProcessorInfo() const { return hasInfo_; }
+
+const ProcessorInfo& ProcessorFactoryObject::info() const {
+    if (!hasInfo_) {
+        std::call_once(infoFlag_, [this]() {
+            const auto pi = getInfo_();
+            info_.emplace(classIdentifier_, pi.displayName, pi.category, pi.codeState, pi.tags,
+                          pi.visible);
+            getInfo_ = nullptr;
+            hasInfo_ = true;
+        });
+    }
+    return *info_;
+}
+
+}  // namespace inviwo
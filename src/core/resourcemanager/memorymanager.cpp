@@ -0,0 +1,207 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/resourcemanager/memorymanager.h>
+#include <inviwo/core/util/stdextensions.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace inviwo {
+
+MemoryManager* MemoryManager::instance_ = nullptr;
+
+MemoryManager::Entry::Entry(std::shared_ptr<Counters> counters, std::function<size_t()> evict)
+    : counters_{std::move(counters)}, bytes_{0}, lastUsed_{0}, evict_{std::move(evict)} {}
+
+MemoryManager::Entry::~Entry() {
+    for (auto& usage : usages_) counters_->release(usage);
+}
+
+void MemoryManager::Entry::setUsage(size_t bytes) {
+    if (bytes == 0) {
+        setUsage(std::vector<Usage>{});
+    } else {
+        setUsage(std::vector<Usage>{Usage{{}, bytes}});
+    }
+}
+
+void MemoryManager::Entry::setUsage(std::vector<Usage> usages) {
+    std::scoped_lock lock{usageMutex_};
+    // Claim the new usages first such that storage kept by the entry is not released in between
+    size_t bytes = 0;
+    for (auto& usage : usages) {
+        counters_->claim(usage);
+        bytes += usage.bytes;
+    }
+    for (auto& usage : usages_) counters_->release(usage);
+    usages_ = std::move(usages);
+    bytes_ = bytes;
+}
+
+size_t MemoryManager::Entry::getUsage() const { return bytes_.load(); }
+
+void MemoryManager::Entry::touch() { lastUsed_.store(++counters_->clock); }
+
+std::uint64_t MemoryManager::Entry::getLastUsed() const { return lastUsed_.load(); }
+
+size_t MemoryManager::Entry::evict() {
+    std::scoped_lock lock{mutex_};
+    return evict_ ? evict_() : 0;
+}
+
+void MemoryManager::Entry::detach() {
+    std::scoped_lock lock{mutex_};
+    evict_ = nullptr;
+}
+
+MemoryManager::Lease::Lease()
+    : counters_{MemoryManager::isInitialized() ? MemoryManager::getPtr()->counters_ : nullptr} {
+    if (counters_) {
+        std::scoped_lock lock{counters_->evictionMutex};
+        ++counters_->leases;
+    }
+}
+
+MemoryManager::Lease::Lease(MemoryManager& manager) : counters_{manager.counters_} {
+    std::scoped_lock lock{counters_->evictionMutex};
+    ++counters_->leases;
+}
+
+MemoryManager::Lease::~Lease() {
+    if (counters_) {
+        std::scoped_lock lock{counters_->evictionMutex};
+        --counters_->leases;
+    }
+}
+
+namespace {
+
+bool isUnshared(const MemoryManager::Usage& usage) {
+    const std::weak_ptr<const void> empty;
+    return !usage.storage.owner_before(empty) && !empty.owner_before(usage.storage);
+}
+
+}  // namespace
+
+void MemoryManager::Counters::claim(const Usage& item) {
+    if (isUnshared(item)) {
+        usage += item.bytes;
+        return;
+    }
+    std::scoped_lock lock{storageMutex};
+    auto& storage = storages.try_emplace(item.storage, Storage{0, 0}).first->second;
+    ++storage.count;
+    // The size of shared storage might have changed, like for a resized std::vector
+    if (item.bytes > storage.bytes) {
+        usage += item.bytes - storage.bytes;
+    } else {
+        usage -= storage.bytes - item.bytes;
+    }
+    storage.bytes = item.bytes;
+}
+
+void MemoryManager::Counters::release(const Usage& item) {
+    if (isUnshared(item)) {
+        usage -= item.bytes;
+        return;
+    }
+    std::scoped_lock lock{storageMutex};
+    auto it = storages.find(item.storage);
+    if (it == storages.end()) return;
+    if (--it->second.count == 0) {
+        usage -= it->second.bytes;
+        storages.erase(it);
+    }
+}
+
+MemoryManager::MemoryManager()
+    : counters_{std::make_shared<Counters>()}, budget_{0}, lastEnforced_{0}, pruneAt_{64} {}
+
+MemoryManager::~MemoryManager() = default;
+
+std::shared_ptr<MemoryManager::Entry> MemoryManager::track(std::function<size_t()> evict) {
+    auto entry = std::make_shared<Entry>(counters_, std::move(evict));
+    entry->touch();
+
+    std::scoped_lock lock{mutex_};
+    if (entries_.size() >= pruneAt_) {
+        util::erase_remove_if(entries_, [](auto& item) { return item.expired(); });
+        pruneAt_ = std::max(size_t{64}, 2 * entries_.size());
+    }
+    entries_.push_back(entry);
+    return entry;
+}
+
+size_t MemoryManager::getUsage() const { return counters_->usage.load(); }
+
+size_t MemoryManager::getNumberOfEntries() const {
+    std::scoped_lock lock{mutex_};
+    return static_cast<size_t>(std::count_if(entries_.begin(), entries_.end(),
+                                             [](auto& item) { return !item.expired(); }));
+}
+
+void MemoryManager::setBudget(size_t bytes) { budget_ = bytes; }
+
+size_t MemoryManager::getBudget() const { return budget_.load(); }
+
+size_t MemoryManager::enforceBudget() {
+    const auto budget = budget_.load();
+
+    std::vector<std::shared_ptr<Entry>> candidates;
+    {
+        std::scoped_lock lock{mutex_};
+        const auto lastEnforced = std::exchange(lastEnforced_, counters_->clock.load());
+        if (budget == 0 || counters_->usage.load() <= budget) return 0;
+
+        util::erase_remove_if(entries_, [&](auto& item) {
+            auto entry = item.lock();
+            if (!entry) return true;
+            if (entry->getUsage() > 0 && entry->getLastUsed() <= lastEnforced) {
+                candidates.push_back(std::move(entry));
+            }
+            return false;
+        });
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](auto& a, auto& b) { return a->getLastUsed() < b->getLastUsed(); });
+
+    // The entries are evicted without holding the lock since evicting locks the data objects.
+    std::scoped_lock evictionLock{counters_->evictionMutex};
+    if (counters_->leases > 0) return 0;
+    size_t freed = 0;
+    for (auto& entry : candidates) {
+        if (counters_->usage.load() <= budget) break;
+        freed += entry->evict();
+    }
+    return freed;
+}
+
+}  // namespace inviwo
@@ -28,6 +28,9 @@
  *********************************************************************************/
 
 #include <inviwo/core/resourcemanager/resourcemanager.h>
+#include <inviwo/core/resourcemanager/memorymanager.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/ports/outport.h>
 
 namespace inviwo {
 
@@ -58,4 +61,24 @@ void ResourceManager::setEnabled(bool enable) {
 
 size_t ResourceManager::numberOfResources() const { return resources_.size(); }
 
+size_t ResourceManager::getMemoryUsage() const {
+    return MemoryManager::isInitialized() ? MemoryManager::getPtr()->getUsage() : 0;
+}
+
+size_t ResourceManager::getMemoryUsage(const Outport& port) const { return port.getMemoryUsage(); }
+
+size_t ResourceManager::getMemoryUsage(const Processor& processor) const {
+    size_t bytes = 0;
+    for (auto outport : processor.getOutports()) bytes += outport->getMemoryUsage();
+    return bytes;
+}
+
+void ResourceManager::setMemoryBudget(size_t bytes) {
+    if (MemoryManager::isInitialized()) MemoryManager::getPtr()->setBudget(bytes);
+}
+
+size_t ResourceManager::getMemoryBudget() const {
+    return MemoryManager::isInitialized() ? MemoryManager::getPtr()->getBudget() : 0;
+}
+
 }  // namespace inviwo
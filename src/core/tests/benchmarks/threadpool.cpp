@@ -0,0 +1,204 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <inviwo/core/util/threadpool.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * The previous single queue thread pool, one std::queue behind one mutex, as a reference.
+ */
+class QueuePool {
+public:
+    QueuePool(size_t threads) {
+        for (size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([this]() {
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        condition.wait(lock, [this] { return stop || !tasks.empty(); });
+                        if (stop && tasks.empty()) return;
+                        task = std::move(tasks.front());
+                        tasks.pop();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+    ~QueuePool() {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            stop = true;
+        }
+        condition.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    template <class F>
+    auto enqueue(F&& f) -> std::future<std::invoke_result_t<F>> {
+        using return_type = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<return_type()>>(std::forward<F>(f));
+        auto res = task->get_future();
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            tasks.emplace([task]() { (*task)(); });
+        }
+        condition.notify_one();
+        return res;
+    }
+
+    void enqueueRaw(std::function<void()> f) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            tasks.emplace(std::move(f));
+        }
+        condition.notify_one();
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stop = false;
+};
+
+size_t threads() { return std::max(2u, std::thread::hardware_concurrency()); }
+
+// Many small tasks submitted from the main thread
+template <typename Pool>
+void Enqueue(benchmark::State& state) {
+    Pool pool(threads());
+    const auto nTasks = static_cast<size_t>(state.range(0));
+    std::vector<std::future<size_t>> futures;
+    futures.reserve(nTasks);
+
+    for (auto _ : state) {
+        futures.clear();
+        for (size_t i = 0; i < nTasks; ++i) {
+            futures.push_back(pool.enqueue([i]() { return i * i; }));
+        }
+        size_t sum = 0;
+        for (auto& future : futures) sum += future.get();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * nTasks);
+}
+
+// Fire and forget tasks, waiting on a counter
+template <typename Pool>
+void EnqueueRaw(benchmark::State& state) {
+    Pool pool(threads());
+    const auto nTasks = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state) {
+        std::atomic<size_t> count{0};
+        std::promise<void> done;
+        for (size_t i = 0; i < nTasks; ++i) {
+            pool.enqueueRaw([&count, &done, nTasks]() {
+                if (++count == nTasks) done.set_value();
+            });
+        }
+        done.get_future().wait();
+    }
+    state.SetItemsProcessed(state.iterations() * nTasks);
+}
+
+// Slab jobs that all read and write a shared buffer, like util::forEachVoxelParallel
+template <typename Pool>
+void Slabs(benchmark::State& state) {
+    Pool pool(threads());
+    const auto nJobs = static_cast<size_t>(state.range(0));
+    std::vector<float> data(size_t{1} << 22, 1.0f);
+    const auto slab = data.size() / nJobs;
+
+    for (auto _ : state) {
+        std::vector<std::future<void>> futures;
+        for (size_t job = 0; job < nJobs; ++job) {
+            futures.push_back(pool.enqueue([&data, job, slab]() {
+                for (size_t i = job * slab; i < (job + 1) * slab; ++i) data[i] = data[i] * 0.5f + 1.0f;
+            }));
+        }
+        for (auto& future : futures) future.wait();
+    }
+    state.SetBytesProcessed(state.iterations() * data.size() * sizeof(float));
+}
+
+// Nested fork/join, only possible without deadlocks in the work stealing pool.
+void NestedWorkStealing(benchmark::State& state) {
+    inviwo::ThreadPool pool(threads());
+
+    std::function<size_t(size_t)> sum = [&](size_t n) -> size_t {
+        if (n < 64) return n;
+        auto a = pool.enqueue(sum, n / 2);
+        auto b = pool.enqueue(sum, n - n / 2);
+        pool.wait(a);
+        pool.wait(b);
+        return a.get() + b.get();
+    };
+
+    const auto n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        auto res = pool.enqueue(sum, n).get();
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(Enqueue, QueuePool)->RangeMultiplier(8)->Range(64, 1 << 15);
+BENCHMARK_TEMPLATE(Enqueue, inviwo::ThreadPool)->RangeMultiplier(8)->Range(64, 1 << 15);
+
+BENCHMARK_TEMPLATE(EnqueueRaw, QueuePool)->RangeMultiplier(8)->Range(64, 1 << 15);
+BENCHMARK_TEMPLATE(EnqueueRaw, inviwo::ThreadPool)->RangeMultiplier(8)->Range(64, 1 << 15);
+
+BENCHMARK_TEMPLATE(Slabs, QueuePool)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK_TEMPLATE(Slabs, inviwo::ThreadPool)->RangeMultiplier(4)->Range(4, 1024);
+
+BENCHMARK(NestedWorkStealing)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
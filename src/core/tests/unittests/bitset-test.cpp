@@ -0,0 +1,159 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/bitset.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+// Random values clustered such that both sparse and dense blocks are created
+std::set<std::uint32_t> randomValues(size_t count, std::uint32_t max, std::mt19937& gen) {
+    std::uniform_int_distribution<std::uint32_t> dist(0, max);
+    std::set<std::uint32_t> values;
+    while (values.size() < count) values.insert(dist(gen));
+    return values;
+}
+
+void expectEqual(const std::set<std::uint32_t>& expected, const BitSet& set) {
+    EXPECT_EQ(expected.size(), set.size());
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+    const auto vec = set.toVector();
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), vec.begin(), vec.end()));
+}
+
+}  // namespace
+
+TEST(BitSet, Empty) {
+    BitSet set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(0, set.size());
+    EXPECT_FALSE(set.contains(0));
+    EXPECT_EQ(set.begin(), set.end());
+}
+
+TEST(BitSet, InsertErase) {
+    BitSet set;
+    EXPECT_TRUE(set.insert(5));
+    EXPECT_FALSE(set.insert(5));
+    EXPECT_TRUE(set.insert(70000));
+    EXPECT_TRUE(set.insert(1));
+    EXPECT_EQ(3, set.size());
+    EXPECT_EQ(1, set.count(70000));
+    EXPECT_EQ(0, set.count(6));
+    expectEqual({1, 5, 70000}, set);
+
+    EXPECT_EQ(1, set.erase(5));
+    EXPECT_EQ(0, set.erase(5));
+    EXPECT_EQ(1, set.erase(70000));
+    expectEqual({1}, set);
+    EXPECT_EQ(1, set.erase(1));
+    EXPECT_TRUE(set.empty());
+}
+
+TEST(BitSet, OutOfRange) {
+    BitSet set;
+    const size_t large = size_t{1} << 32;
+    EXPECT_FALSE(set.contains(large));
+    EXPECT_EQ(0, set.erase(large));
+    EXPECT_THROW(set.insert(large), RangeException);
+}
+
+TEST(BitSet, DenseBlocks) {
+    std::set<std::uint32_t> expected;
+    BitSet set;
+    for (std::uint32_t i = 0; i < 200000; i += 3) {
+        expected.insert(i);
+        set.insert(i);
+    }
+    expectEqual(expected, set);
+    // A dense block stores one bit per possible value
+    EXPECT_LT(set.sizeInBytes(), 4 * 8192 + 1024);
+
+    for (std::uint32_t i = 0; i < 200000; i += 6) {
+        expected.erase(i);
+        set.erase(i);
+    }
+    expectEqual(expected, set);
+    EXPECT_EQ(BitSet(expected.begin(), expected.end()), set);
+}
+
+TEST(BitSet, InsertRange) {
+    BitSet set;
+    set.insertRange(10, 20);
+    set.insertRange(65530, 200000);
+    std::set<std::uint32_t> expected;
+    for (std::uint32_t i = 10; i < 20; ++i) expected.insert(i);
+    for (std::uint32_t i = 65530; i < 200000; ++i) expected.insert(i);
+    expectEqual(expected, set);
+}
+
+TEST(BitSet, SetOperations) {
+    std::mt19937 gen(42);
+    for (auto [count, max] : {std::pair<size_t, std::uint32_t>{100, 1000000},
+                              std::pair<size_t, std::uint32_t>{20000, 200000},
+                              std::pair<size_t, std::uint32_t>{100000, 300000}}) {
+        const auto a = randomValues(count, max, gen);
+        const auto b = randomValues(count / 2, max, gen);
+        const BitSet sa(a.begin(), a.end());
+        const BitSet sb(b.begin(), b.end());
+        expectEqual(a, sa);
+        expectEqual(b, sb);
+
+        std::set<std::uint32_t> expected;
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                       std::inserter(expected, expected.end()));
+        expectEqual(expected, sa | sb);
+        expectEqual(expected, sb | sa);
+
+        expected.clear();
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                              std::inserter(expected, expected.end()));
+        expectEqual(expected, sa & sb);
+        expectEqual(expected, sb & sa);
+
+        expected.clear();
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                            std::inserter(expected, expected.end()));
+        expectEqual(expected, sa - sb);
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,219 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/copyonwrite.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/exception.h>
+
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+TEST(CopyOnWrite, Value) {
+    CopyOnWrite<std::vector<int>> a{std::vector<int>{1, 2, 3}};
+    auto b = a;
+    EXPECT_TRUE(a.isShared());
+    EXPECT_EQ(&a.get(), &b.get());
+
+    b.edit()[0] = 10;
+    EXPECT_FALSE(a.isShared());
+    EXPECT_FALSE(b.isShared());
+    EXPECT_NE(&a.get(), &b.get());
+    EXPECT_EQ(a.get(), std::vector<int>({1, 2, 3}));
+    EXPECT_EQ(b.get(), std::vector<int>({10, 2, 3}));
+
+    // Not shared any more, editing again should not copy
+    const auto* data = b.get().data();
+    b.edit()[1] = 20;
+    EXPECT_EQ(b.get().data(), data);
+}
+
+TEST(CopyOnWrite, Array) {
+    auto a = CopyOnWrite<int[]>::allocate(4);
+    std::iota(a.edit(), a.edit() + 4, 1);
+    auto b = a;
+    EXPECT_EQ(a.get(), b.get());
+
+    b.edit()[3] = 40;
+    EXPECT_NE(a.get(), b.get());
+    EXPECT_EQ(a.get()[3], 4);
+    EXPECT_EQ(b.get()[3], 40);
+    EXPECT_EQ(b.size(), 4);
+}
+
+TEST(CopyOnWrite, Exposed) {
+    auto a = CopyOnWrite<int[]>::allocate(4);
+    auto shared = a;
+
+    // A pointer that is handed out detaches the array, and later copies do not alias it
+    int* ptr = a.expose();
+    EXPECT_NE(ptr, shared.get());
+    EXPECT_TRUE(a.isExposed());
+    EXPECT_FALSE(a.isShared());
+    auto copy = a;
+    EXPECT_NE(copy.get(), ptr);
+    ptr[0] = 10;
+    EXPECT_EQ(copy.get()[0], 0);
+    EXPECT_EQ(shared.get()[0], 0);
+
+    // The copy of an exposed array is not exposed and can be shared again
+    auto copyOfCopy = copy;
+    EXPECT_EQ(copyOfCopy.get(), copy.get());
+
+    // Memory passed in by the caller is exposed from the start
+    int* data = new int[2]{1, 2};
+    CopyOnWrite<int[]> owned{data, 2};
+    auto ownedCopy = owned;
+    data[0] = 10;
+    EXPECT_EQ(ownedCopy.get()[0], 1);
+}
+
+TEST(CopyOnWrite, Release) {
+    auto a = CopyOnWrite<int[]>::allocate(4);
+    auto b = a;
+    EXPECT_THROW(a.release(), Exception);
+
+    a = CopyOnWrite<int[]>{};
+    int* data = b.expose();
+    b.release();
+    EXPECT_EQ(b.get(), data);
+    delete[] data;
+
+    auto owner = std::make_shared<std::vector<int>>(std::vector<int>{1, 2, 3});
+    CopyOnWrite<int[]> view{owner, owner->data(), owner->size()};
+    EXPECT_THROW(view.release(), Exception);
+}
+
+TEST(CopyOnWrite, ExternalArray) {
+    auto owner = std::make_shared<std::vector<int>>(std::vector<int>{1, 2, 3});
+    CopyOnWrite<int[]> view{owner, owner->data(), owner->size()};
+    EXPECT_EQ(view.get(), owner->data());
+    EXPECT_TRUE(view.isExposed());
+
+    // The owner might write to the memory, hence the view writes to it directly, and copies of
+    // the view get their own array
+    view.edit()[0] = 10;
+    EXPECT_EQ(view.get(), owner->data());
+    EXPECT_EQ((*owner)[0], 10);
+
+    auto copy = view;
+    EXPECT_NE(copy.get(), owner->data());
+    (*owner)[1] = 20;
+    EXPECT_EQ(copy.get()[0], 10);
+    EXPECT_EQ(copy.get()[1], 2);
+}
+
+TEST(CopyOnWrite, VolumePassThrough) {
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(size3_t(8, 8, 8));
+    auto* ptr = ram->getDataTyped();
+    std::iota(ptr, ptr + 512, 0.0f);
+    auto source = std::make_shared<Volume>(ram);
+
+    // The creator still has a pointer to the data, hence the first copy gets its own data
+    auto first = std::shared_ptr<Volume>(source->clone());
+    const auto* data = first->getRepresentation<VolumeRAM>()->getData();
+    EXPECT_NE(data, ptr);
+    ptr[0] = -10.0f;
+    EXPECT_EQ(first->getRepresentation<VolumeRAM>()->getAsDouble(size3_t(0)), 0.0);
+
+    // A chain of processors that only change the transformation
+    std::vector<std::shared_ptr<Volume>> chain{first};
+    for (int i = 0; i < 3; ++i) {
+        auto volume = std::shared_ptr<Volume>(chain.back()->clone());
+        volume->setOffset(vec3(static_cast<float>(i)));
+        chain.push_back(volume);
+    }
+    for (auto& volume : chain) {
+        EXPECT_EQ(volume->getRepresentation<VolumeRAM>()->getData(), data);
+    }
+
+    // Editing the end of the chain copies the data once, the others are not affected
+    auto edited = chain.back()->getEditableRepresentation<VolumeRAM>();
+    static_cast<float*>(edited->getData())[0] = -1.0f;
+    EXPECT_NE(edited->getData(), data);
+    EXPECT_EQ(first->getRepresentation<VolumeRAM>()->getAsDouble(size3_t(0)), 0.0);
+    EXPECT_EQ(chain[2]->getRepresentation<VolumeRAM>()->getAsDouble(size3_t(0)), 0.0);
+    EXPECT_EQ(edited->getAsDouble(size3_t(0)), -1.0);
+    EXPECT_EQ(edited->getAsDouble(size3_t(1, 0, 0)), 1.0);
+
+    // Writing through a shared representation does not change the copies either
+    auto firstRam = first->getEditableRepresentation<VolumeRAM>();
+    firstRam->setFromDouble(size3_t(2, 0, 0), 100.0);
+    EXPECT_EQ(firstRam->getAsDouble(size3_t(2, 0, 0)), 100.0);
+    EXPECT_EQ(chain[1]->getRepresentation<VolumeRAM>()->getAsDouble(size3_t(2, 0, 0)), 2.0);
+
+    // The data of a shared representation can not be released
+    EXPECT_THROW(chain[1]->getEditableRepresentation<VolumeRAM>()->removeDataOwnership(),
+                 Exception);
+}
+
+TEST(CopyOnWrite, LayerPassThrough) {
+    auto ram = std::make_shared<LayerRAMPrecision<vec4>>(size2_t(16, 16));
+    auto source = std::make_shared<Layer>(ram);
+    auto copy = std::shared_ptr<Layer>(source->clone());
+    const auto* data = source->getRepresentation<LayerRAM>()->getData();
+    EXPECT_EQ(copy->getRepresentation<LayerRAM>()->getData(), data);
+
+    copy->getEditableRepresentation<LayerRAM>()->setFromDVec4(size2_t(1, 1), dvec4(1.0));
+    EXPECT_NE(copy->getRepresentation<LayerRAM>()->getData(), data);
+    EXPECT_EQ(source->getRepresentation<LayerRAM>()->getAsDVec4(size2_t(1, 1)), dvec4(0.0));
+    EXPECT_EQ(copy->getRepresentation<LayerRAM>()->getAsDVec4(size2_t(1, 1)), dvec4(1.0));
+}
+
+TEST(CopyOnWrite, MeshPassThrough) {
+    auto positions = std::make_shared<Buffer<vec3>>(
+        std::make_shared<BufferRAMPrecision<vec3>>(std::vector<vec3>(100, vec3(1.0f))));
+    Mesh mesh;
+    mesh.addBuffer(BufferType::PositionAttrib, positions);
+
+    auto copy = std::shared_ptr<Mesh>(mesh.clone());
+    const auto* data = positions->getRepresentation<BufferRAM>()->getData();
+    EXPECT_EQ(copy->getBuffer(0)->getRepresentation<BufferRAM>()->getData(), data);
+
+    auto& container = static_cast<Buffer<vec3>*>(copy->getBuffer(0))
+                          ->getEditableRAMRepresentation()
+                          ->getDataContainer();
+    container.push_back(vec3(2.0f));
+    EXPECT_EQ(copy->getBuffer(0)->getSize(), 101);
+    EXPECT_EQ(positions->getSize(), 100);
+    EXPECT_EQ(positions->getRepresentation<BufferRAM>()->getData(), data);
+}
+
+}  // namespace inviwo
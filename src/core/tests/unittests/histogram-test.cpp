@@ -0,0 +1,220 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/histogram.h>
+#include <inviwo/core/datastructures/histogramtools.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<double> randomValues(size_t size, double mean, double stddev) {
+    std::mt19937 gen(42);
+    std::normal_distribution<double> dist(mean, stddev);
+    std::vector<double> values(size);
+    for (auto& v : values) v = dist(gen);
+    return values;
+}
+
+double variance(const std::vector<double>& values) {
+    const double mean =
+        std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+    double m2 = 0.0;
+    for (auto v : values) m2 += (v - mean) * (v - mean);
+    return m2 / static_cast<double>(values.size() - 1);
+}
+
+}  // namespace
+
+TEST(HistogramAccumulator, Moments) {
+    // A large offset breaks the naive sum of squares approach
+    const auto values = randomValues(10000, 1.0e8, 2.0);
+    auto acc = HistogramAccumulator::forType<double>(dvec2{1.0e8 - 10.0, 1.0e8 + 10.0}, 20);
+    acc.add(values.begin(), values.end());
+
+    EXPECT_EQ(acc.getCount(), values.size());
+    EXPECT_DOUBLE_EQ(acc.getMin(0), *std::min_element(values.begin(), values.end()));
+    EXPECT_DOUBLE_EQ(acc.getMax(0), *std::max_element(values.begin(), values.end()));
+    EXPECT_NEAR(acc.getVariance(0), variance(values), 1.0e-6);
+
+    const auto& counts = acc.getCounts(0);
+    EXPECT_EQ(std::accumulate(counts.begin(), counts.end(), 0.0),
+              static_cast<double>(values.size()));
+}
+
+TEST(HistogramAccumulator, MergeAndSubtract) {
+    const auto values = randomValues(5000, 10.0, 3.0);
+    const dvec2 range{-10.0, 30.0};
+
+    auto all = HistogramAccumulator::forType<double>(range, 64);
+    all.add(values.data(), values.data() + values.size());
+
+    auto first = HistogramAccumulator::forType<double>(range, 64);
+    first.add(values.data(), values.data() + 1234);
+    auto second = HistogramAccumulator::forType<double>(range, 64);
+    second.add(values.data() + 1234, values.data() + values.size());
+
+    auto merged = first;
+    merged.merge(second);
+    EXPECT_EQ(merged.getCount(), all.getCount());
+    EXPECT_NEAR(merged.getMean(0), all.getMean(0), 1.0e-10);
+    EXPECT_NEAR(merged.getVariance(0), all.getVariance(0), 1.0e-10);
+    EXPECT_EQ(merged.getCounts(0), all.getCounts(0));
+
+    merged.subtract(second);
+    EXPECT_EQ(merged.getCount(), first.getCount());
+    EXPECT_NEAR(merged.getMean(0), first.getMean(0), 1.0e-10);
+    EXPECT_NEAR(merged.getVariance(0), first.getVariance(0), 1.0e-8);
+    EXPECT_EQ(merged.getCounts(0), first.getCounts(0));
+
+    auto other = HistogramAccumulator::forType<double>(range, 32);
+    other.add(1.0);
+    EXPECT_THROW(merged.merge(other), Exception);
+}
+
+TEST(HistogramAccumulator, IntegralBins) {
+    auto acc = HistogramAccumulator::forType<unsigned char>(dvec2{0.0, 255.0}, 2048);
+    EXPECT_EQ(acc.getBins(), size_t{256});
+    for (int i = 0; i < 256; ++i) acc.add(static_cast<unsigned char>(i));
+    for (auto count : acc.getCounts(0)) EXPECT_EQ(count, 1.0);
+}
+
+TEST(HistogramAccumulator, Volume) {
+    const size3_t dims{17, 13, 11};
+    auto volume = std::make_shared<VolumeRAMPrecision<vec2>>(dims);
+    auto data = volume->getDataTyped();
+    for (size_t i = 0; i < glm::compMul(dims); ++i) {
+        data[i] = vec2{static_cast<float>(i % 100), static_cast<float>(i % 7)};
+    }
+    const dvec2 range{0.0, 100.0};
+
+    const auto acc = util::accumulateHistogram(*volume, range, 101);
+    const HistogramContainer serial(range, 101, data, data + glm::compMul(dims));
+    const auto histograms = acc.getHistograms();
+    ASSERT_EQ(histograms.size(), size_t{2});
+    for (size_t c = 0; c < 2; ++c) {
+        EXPECT_EQ(histograms[c].getData(), serial[c].getData());
+        EXPECT_NEAR(histograms[c].stats_.mean, serial[c].stats_.mean, 1.0e-10);
+        EXPECT_NEAR(histograms[c].stats_.standardDeviation, serial[c].stats_.standardDeviation,
+                    1.0e-10);
+    }
+
+    // Incremental update of a sub region
+    const size3_t offset{2, 3, 4};
+    const size3_t region{5, 6, 7};
+    auto updated = acc;
+    updated.subtract(util::accumulateHistogram(*volume, range, 101, offset, region));
+    for (size_t z = offset.z; z < offset.z + region.z; ++z) {
+        for (size_t y = offset.y; y < offset.y + region.y; ++y) {
+            for (size_t x = offset.x; x < offset.x + region.x; ++x) {
+                data[x + y * dims.x + z * dims.x * dims.y] = vec2{50.0f, 3.0f};
+            }
+        }
+    }
+    updated.merge(util::accumulateHistogram(*volume, range, 101, offset, region));
+    const auto full = util::accumulateHistogram(*volume, range, 101);
+    for (size_t c = 0; c < 2; ++c) {
+        EXPECT_EQ(updated.getCounts(c), full.getCounts(c));
+        EXPECT_NEAR(updated.getMean(c), full.getMean(c), 1.0e-10);
+        EXPECT_NEAR(updated.getVariance(c), full.getVariance(c), 1.0e-8);
+    }
+
+    EXPECT_THROW(util::accumulateHistogram(*volume, range, 101, offset, dims), Exception);
+}
+
+TEST(HistogramSupplier, EditRegion) {
+    const size3_t dims{23, 19, 17};
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(dims);
+    const auto values = randomValues(glm::compMul(dims), 50.0, 15.0);
+    std::copy(values.begin(), values.end(), ram->getDataTyped());
+    Volume volume(ram);
+    volume.dataMap_.dataRange = dvec2{0.0, 100.0};
+
+    bool done = false;
+    volume.calculateHistograms(128)->whenDone([&](const HistogramContainer&) { done = true; });
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!done && std::chrono::steady_clock::now() < deadline) {
+        InviwoApplication::getPtr()->processFront();
+    }
+    ASSERT_TRUE(done);
+    ASSERT_TRUE(volume.hasHistograms());
+
+    const size3_t offset{3, 4, 5};
+    const size3_t region{11, 7, 9};
+    volume.editRegion(offset, region, [&](VolumeRAM& vr) {
+        util::IndexMapper3D index(dims);
+        auto data = static_cast<float*>(vr.getData());
+        for (size_t z = offset.z; z < offset.z + region.z; ++z) {
+            for (size_t y = offset.y; y < offset.y + region.y; ++y) {
+                for (size_t x = offset.x; x < offset.x + region.x; ++x) {
+                    data[index(x, y, z)] = static_cast<float>((x + y + z) % 100);
+                }
+            }
+        }
+    });
+
+    const auto full = util::accumulateHistogram(*volume.getRepresentation<VolumeRAM>(),
+                                                dvec2{0.0, 100.0}, 128)
+                          .getHistograms();
+    const auto& updated = volume.getHistograms();
+    ASSERT_EQ(updated.size(), full.size());
+    EXPECT_EQ(updated[0].getData(), full[0].getData());
+    EXPECT_NEAR(updated[0].stats_.mean, full[0].stats_.mean, 1.0e-10);
+    EXPECT_NEAR(updated[0].stats_.standardDeviation, full[0].stats_.standardDeviation, 1.0e-8);
+
+    EXPECT_THROW(volume.editRegion(offset, dims, [](VolumeRAM&) {}), Exception);
+}
+
+TEST(HistogramSupplier, EditRegionDiscardsPendingCalculation) {
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(size3_t{8});
+    Volume volume(ram);
+    volume.calculateHistograms(16);
+    volume.editRegion(size3_t{0}, size3_t{2}, [](VolumeRAM& vr) {
+        static_cast<float*>(vr.getData())[0] = 1.0f;
+    });
+    EXPECT_FALSE(volume.hasHistograms());
+    EXPECT_EQ(static_cast<const float*>(ram->getData())[0], 1.0f);
+}
+
+}  // namespace inviwo
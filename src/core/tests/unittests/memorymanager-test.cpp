@@ -0,0 +1,239 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/resourcemanager/memorymanager.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <memory>
+
+namespace inviwo {
+
+namespace {
+
+class CountingLoader : public DiskRepresentationLoader<VolumeRepresentation> {
+public:
+    CountingLoader(std::shared_ptr<size_t> loads) : loads_{loads} {}
+    virtual CountingLoader* clone() const override { return new CountingLoader(*this); }
+
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
+        const VolumeRepresentation& src) const override {
+        ++*loads_;
+        auto ram = std::make_shared<VolumeRAMPrecision<float>>(src.getDimensions());
+        std::fill_n(ram->getDataTyped(), glm::compMul(src.getDimensions()), 3.0f);
+        return ram;
+    }
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
+                                      const VolumeRepresentation& src) const override {
+        auto ram = std::static_pointer_cast<VolumeRAMPrecision<float>>(dest);
+        ++*loads_;
+        std::fill_n(ram->getDataTyped(), glm::compMul(src.getDimensions()), 3.0f);
+    }
+
+private:
+    std::shared_ptr<size_t> loads_;
+};
+
+std::shared_ptr<Volume> makeDiskVolume(std::shared_ptr<size_t> loads) {
+    auto disk = std::make_shared<VolumeDisk>(size3_t{4, 4, 4}, DataFloat32::get());
+    disk->setLoader(new CountingLoader(loads));
+    return std::make_shared<Volume>(disk);
+}
+
+struct BudgetGuard {
+    BudgetGuard(size_t bytes) : old{MemoryManager::getPtr()->getBudget()} {
+        MemoryManager::getPtr()->setBudget(bytes);
+    }
+    ~BudgetGuard() { MemoryManager::getPtr()->setBudget(old); }
+    size_t old;
+};
+
+}  // namespace
+
+TEST(MemoryManager, TracksUsage) {
+    MemoryManager manager;
+    auto a = manager.track([]() { return size_t{0}; });
+    auto b = manager.track([]() { return size_t{0}; });
+    a->setUsage(100);
+    b->setUsage(50);
+    EXPECT_EQ(150, manager.getUsage());
+    EXPECT_EQ(2, manager.getNumberOfEntries());
+
+    a->setUsage(10);
+    EXPECT_EQ(60, manager.getUsage());
+    b.reset();
+    EXPECT_EQ(10, manager.getUsage());
+    EXPECT_EQ(1, manager.getNumberOfEntries());
+}
+
+TEST(MemoryManager, SharedStorageIsCountedOnce) {
+    MemoryManager manager;
+    auto storage = std::make_shared<int>(0);
+    auto a = manager.track([]() { return size_t{0}; });
+    auto b = manager.track([]() { return size_t{0}; });
+    a->setUsage({{storage, 100}, {{}, 10}});
+    b->setUsage({{storage, 100}});
+    EXPECT_EQ(110, manager.getUsage());
+    EXPECT_EQ(110, a->getUsage());
+    EXPECT_EQ(100, b->getUsage());
+
+    a.reset();
+    EXPECT_EQ(100, manager.getUsage());
+    b->setUsage(0);
+    EXPECT_EQ(0, manager.getUsage());
+}
+
+TEST(MemoryManager, LeasePostponesEviction) {
+    MemoryManager manager;
+    bool called = false;
+    auto entry = manager.track([&]() {
+        called = true;
+        return size_t{100};
+    });
+    entry->setUsage(100);
+    manager.setBudget(1);
+    manager.enforceBudget();
+    {
+        MemoryManager::Lease lease{manager};
+        EXPECT_EQ(0, manager.enforceBudget());
+        EXPECT_FALSE(called);
+    }
+    manager.enforceBudget();
+    EXPECT_TRUE(called);
+}
+
+TEST(MemoryManager, EvictsLeastRecentlyUsed) {
+    MemoryManager manager;
+    std::vector<int> evicted;
+    std::vector<std::shared_ptr<MemoryManager::Entry>> entries;
+    for (int i = 0; i < 3; ++i) {
+        entries.push_back(manager.track([&, i]() {
+            evicted.push_back(i);
+            entries[i]->setUsage(0);
+            return size_t{100};
+        }));
+        entries.back()->setUsage(100);
+    }
+    manager.setBudget(150);
+
+    // Everything was used since the previous call, nothing is evicted
+    EXPECT_EQ(0, manager.enforceBudget());
+    EXPECT_TRUE(evicted.empty());
+
+    entries[0]->touch();
+    EXPECT_EQ(200, manager.enforceBudget());
+    EXPECT_EQ((std::vector<int>{1, 2}), evicted);
+    EXPECT_EQ(100, manager.getUsage());
+}
+
+TEST(MemoryManager, DetachedEntriesAreNotEvicted) {
+    MemoryManager manager;
+    bool called = false;
+    auto entry = manager.track([&]() {
+        called = true;
+        return size_t{100};
+    });
+    entry->setUsage(100);
+    entry->detach();
+    manager.setBudget(1);
+    manager.enforceBudget();
+    manager.enforceBudget();
+    EXPECT_FALSE(called);
+}
+
+TEST(MemoryManager, VolumeRAMIsReloadedAfterEviction) {
+    auto loads = std::make_shared<size_t>(0);
+    auto volume = makeDiskVolume(loads);
+    const size_t bytes = 4 * 4 * 4 * sizeof(float);
+
+    EXPECT_EQ(3.0, volume->getRepresentation<VolumeRAM>()->getAsDouble(size3_t{1, 2, 3}));
+    EXPECT_EQ(1, *loads);
+    EXPECT_EQ(bytes, volume->getMemoryUsage());
+
+    BudgetGuard guard{1};
+    MemoryManager::getPtr()->enforceBudget();
+    MemoryManager::getPtr()->enforceBudget();
+    EXPECT_FALSE(volume->hasRepresentation<VolumeRAM>());
+    EXPECT_EQ(0, volume->getMemoryUsage());
+
+    EXPECT_EQ(3.0, volume->getRepresentation<VolumeRAM>()->getAsDouble(size3_t{1, 2, 3}));
+    EXPECT_EQ(2, *loads);
+}
+
+TEST(MemoryManager, SharedVolumeRAMIsKept) {
+    auto loads = std::make_shared<size_t>(0);
+    auto volume = makeDiskVolume(loads);
+    auto ram = volume->getSharedRepresentation<VolumeRAM>();
+
+    BudgetGuard guard{1};
+    MemoryManager::getPtr()->enforceBudget();
+    MemoryManager::getPtr()->enforceBudget();
+    ASSERT_TRUE(volume->hasRepresentation<VolumeRAM>());
+    EXPECT_EQ(ram.get(), volume->getRepresentation<VolumeRAM>());
+
+    ram.reset();
+    MemoryManager::getPtr()->enforceBudget();
+    MemoryManager::getPtr()->enforceBudget();
+    EXPECT_FALSE(volume->hasRepresentation<VolumeRAM>());
+    EXPECT_EQ(1, *loads);
+}
+
+TEST(MemoryManager, CopiesAreCountedOnce) {
+    const auto before = MemoryManager::getPtr()->getUsage();
+    auto volume = std::make_shared<Volume>(std::make_shared<VolumeRAMPrecision<float>>(size3_t{8}));
+    auto copy = std::shared_ptr<Volume>(volume->clone());
+    EXPECT_EQ(8 * 8 * 8 * sizeof(float), copy->getMemoryUsage());
+    EXPECT_EQ(before + 8 * 8 * 8 * sizeof(float), MemoryManager::getPtr()->getUsage());
+
+    // Editing the copy duplicates the data
+    copy->getEditableRepresentation<VolumeRAM>()->setFromDouble(size3_t{0}, 1.0);
+    copy->getRepresentation<VolumeRAM>();
+    EXPECT_EQ(before + 2 * 8 * 8 * 8 * sizeof(float), MemoryManager::getPtr()->getUsage());
+}
+
+TEST(MemoryManager, EditedVolumeRAMIsKept) {
+    auto loads = std::make_shared<size_t>(0);
+    auto volume = makeDiskVolume(loads);
+    volume->getEditableRepresentation<VolumeRAM>()->setFromDouble(size3_t{0, 0, 0}, 5.0);
+
+    BudgetGuard guard{1};
+    MemoryManager::getPtr()->enforceBudget();
+    MemoryManager::getPtr()->enforceBudget();
+    ASSERT_TRUE(volume->hasRepresentation<VolumeRAM>());
+    EXPECT_EQ(5.0, volume->getRepresentation<VolumeRAM>()->getAsDouble(size3_t{0, 0, 0}));
+    EXPECT_EQ(1, *loads);
+}
+
+}  // namespace inviwo
@@ -42,8 +42,14 @@
 
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/ports/dataoutport.h>
+#include <inviwo/core/util/raiiutils.h>
 
 #include <functional>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 
 namespace inviwo {
 
@@ -257,4 +263,100 @@ TEST(NetworkEvaluator, Error) {
     }
 }
 
+TEST(NetworkEvaluator, Parallel) {
+    // The evaluator keeps one worker free, two processors can only run concurrently with three.
+    auto app = InviwoApplication::getPtr();
+    const auto poolSize = app->getPoolSize();
+    app->resizePool(std::max(poolSize, size_t{3}));
+    util::OnScopeExit restorePool{[&]() { app->resizePool(poolSize); }};
+
+    ProcessorNetwork network{app};
+    ProcessorNetworkEvaluator evaluator{&network};
+    evaluator.setEvaluationMode(EvaluationMode::Parallel);
+    EXPECT_EQ(evaluator.getEvaluationMode(), EvaluationMode::Parallel);
+
+    auto at = createA();
+    auto a = at.get();
+    Instrument ai(*a);
+
+    std::atomic<int> aProcessed{0};
+    std::atomic<int> processedAfterA{0};
+    a->onProcess = [func = a->onProcess, &aProcessed](TestProcessor& p) {
+        func(p);
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(0));
+        ++aProcessed;
+    };
+
+    auto b1t = createB();
+    auto b1 = b1t.get();
+    Instrument b1i(*b1);
+    auto b2t = createB();
+    auto b2 = b2t.get();
+    Instrument b2i(*b2);
+    // Each b waits for the other one to start, which only happens if they run concurrently.
+    // The timeout keeps a serial evaluation from hanging the test.
+    std::mutex mutex;
+    std::condition_variable condition;
+    int started = 0;
+    int running = 0;
+    int maxRunning = 0;
+    for (auto b : {b1, b2}) {
+        b->onProcess = [func = b->onProcess, &aProcessed, &processedAfterA, &mutex, &condition,
+                        &started, &running, &maxRunning](TestProcessor& p) {
+            func(p);
+            if (aProcessed > 0) ++processedAfterA;
+
+            std::unique_lock<std::mutex> lock(mutex);
+            ++started;
+            ++running;
+            maxRunning = std::max(maxRunning, running);
+            condition.notify_all();
+            condition.wait_for(lock, std::chrono::seconds(10), [&]() { return started >= 2; });
+            --running;
+        };
+    }
+    const auto checkConcurrent = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        EXPECT_EQ(started, 2);
+        EXPECT_GE(maxRunning, 2);
+        started = 0;
+        maxRunning = 0;
+    };
+
+    {
+        SCOPED_TRACE("Add processors");
+        NetworkLock lock(&network);
+        network.addProcessor(std::move(at));
+        network.addProcessor(std::move(b1t));
+        network.addProcessor(std::move(b2t));
+    }
+    ai.checkAndReset(0, 0, 0);
+    b1i.checkAndReset(0, 0, 1);
+    b2i.checkAndReset(0, 0, 1);
+
+    {
+        SCOPED_TRACE("Add connections");
+        NetworkLock lock(&network);
+        network.addConnection(a->getOutports()[0], b1->getInports()[0]);
+        network.addConnection(a->getOutports()[0], b2->getInports()[0]);
+    }
+    ai.checkAndReset(1, 1, 0);
+    b1i.checkAndReset(1, 1, 0);
+    b2i.checkAndReset(1, 1, 0);
+    EXPECT_EQ(processedAfterA, 2);
+    checkConcurrent();
+
+    {
+        SCOPED_TRACE("Invalid output");
+        a->invalidate(InvalidationLevel::InvalidOutput);
+        ai.checkAndReset(0, 1, 0);
+        b1i.checkAndReset(0, 1, 0);
+        b2i.checkAndReset(0, 1, 0);
+        EXPECT_TRUE(a->isValid());
+        EXPECT_TRUE(b1->isValid());
+        EXPECT_TRUE(b2->isValid());
+        checkConcurrent();
+    }
+}
+
 }  // namespace inviwo
@@ -0,0 +1,133 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/parallel.h>
+#include <inviwo/core/util/threadpool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+TEST(ParallelFor, Range) {
+    std::vector<int> visits(10007, 0);
+    util::parallelFor(size_t{0}, visits.size(), [&](size_t i) { ++visits[i]; });
+    EXPECT_EQ(std::count(visits.begin(), visits.end(), 1), 10007);
+}
+
+TEST(ParallelFor, Chunks) {
+    std::vector<int> visits(1000, 0);
+    util::parallelFor(
+        size_t{10}, visits.size(),
+        [&](size_t begin, size_t end) {
+            EXPECT_LE(end - begin, size_t{7});
+            for (size_t i = begin; i < end; ++i) ++visits[i];
+        },
+        7);
+    EXPECT_EQ(std::accumulate(visits.begin(), visits.begin() + 10, 0), 0);
+    EXPECT_EQ(std::accumulate(visits.begin() + 10, visits.end(), 0), 990);
+}
+
+TEST(ParallelFor, Dims) {
+    const size3_t dims{7, 5, 3};
+    std::vector<std::atomic<int>> visits(dims.x * dims.y * dims.z);
+    util::parallelFor(dims, [&](const size3_t& pos) {
+        ++visits[pos.x + pos.y * dims.x + pos.z * dims.x * dims.y];
+    });
+    for (auto& v : visits) EXPECT_EQ(v.load(), 1);
+
+    std::atomic<size_t> count{0};
+    util::parallelFor(size2_t{13, 11}, [&](const size2_t&) { ++count; }, 1);
+    EXPECT_EQ(count.load(), size_t{13 * 11});
+}
+
+TEST(ParallelFor, Nested) {
+    std::atomic<size_t> count{0};
+    util::parallelFor(size_t{0}, size_t{50}, [&](size_t) {
+        util::parallelFor(size_t{0}, size_t{100}, [&](size_t) { ++count; });
+    });
+    EXPECT_EQ(count.load(), size_t{5000});
+}
+
+TEST(ParallelFor, Stop) {
+    std::atomic<bool> stop{true};
+    std::atomic<size_t> count{0};
+    util::parallelFor(size_t{0}, size_t{1000}, [&](size_t) { ++count; }, 10, stop);
+    EXPECT_EQ(count.load(), size_t{0});
+}
+
+TEST(ParallelFor, Exception) {
+    ThreadPool pool(4);
+    std::atomic<size_t> count{0};
+    auto chunk = [&](size_t begin, size_t) {
+        ++count;
+        if (begin == 500) throw std::runtime_error("error");
+    };
+    EXPECT_THROW(util::detail::parallelChunks(&pool, 0, 1000, 10, chunk), std::runtime_error);
+    EXPECT_LE(count.load(), size_t{100});
+}
+
+TEST(ParallelReduce, Sum) {
+    const auto sum = util::parallelReduce(
+        size_t{0}, size_t{100000}, size_t{0},
+        [](size_t begin, size_t end, size_t init) {
+            for (size_t i = begin; i < end; ++i) init += i;
+            return init;
+        },
+        [](size_t a, size_t b) { return a + b; });
+    EXPECT_EQ(sum, size_t{99999} * size_t{100000} / 2);
+
+    const auto empty = util::parallelReduce(
+        size_t{5}, size_t{5}, 42, [](size_t, size_t, int init) { return init + 1; },
+        [](int a, int b) { return a + b; });
+    EXPECT_EQ(empty, 42);
+}
+
+TEST(ParallelReduce, Order) {
+    // The partial results are combined in chunk order, i.e. non commutative combine works.
+    const auto str = util::parallelReduce(
+        size_t{0}, size_t{26}, std::string{},
+        [](size_t begin, size_t end, std::string init) {
+            for (size_t i = begin; i < end; ++i) init += static_cast<char>('a' + i);
+            return init;
+        },
+        [](std::string a, const std::string& b) { return a + b; }, 3);
+    EXPECT_EQ(str, "abcdefghijklmnopqrstuvwxyz");
+}
+
+}  // namespace inviwo
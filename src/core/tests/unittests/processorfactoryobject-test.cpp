@@ -0,0 +1,107 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/processors/processorfactoryobject.h>
+#include <inviwo/core/processors/compositeprocessorfactoryobject.h>
+#include <inviwo/core/io/serialization/serializer.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <cstdio>
+
+namespace inviwo {
+
+namespace {
+
+class TestFactoryObject : public ProcessorFactoryObject {
+public:
+    using ProcessorFactoryObject::ProcessorFactoryObject;
+    virtual std::unique_ptr<Processor> create(InviwoApplication*) override { return nullptr; }
+};
+
+}  // namespace
+
+TEST(ProcessorFactoryObject, InfoIsAvailable) {
+    const TestFactoryObject pfo{
+        {"org.inviwo.Test", "Test", "Testing", CodeState::Stable, Tags::CPU}};
+    EXPECT_TRUE(pfo.hasProcessorInfo());
+    EXPECT_EQ("org.inviwo.Test", pfo.getClassIdentifier());
+    EXPECT_EQ("Test", pfo.getDisplayName());
+    EXPECT_EQ("Testing", pfo.getCategory());
+}
+
+TEST(ProcessorFactoryObject, DeferredInfoIsLookedUpOnce) {
+    int calls = 0;
+    const TestFactoryObject pfo{"org.inviwo.Test", [&]() -> ProcessorInfo {
+                                    ++calls;
+                                    return {"ignored", "Test", "Testing", CodeState::Stable,
+                                            Tags::CPU};
+                                }};
+
+    EXPECT_FALSE(pfo.hasProcessorInfo());
+    EXPECT_EQ("org.inviwo.Test", pfo.getClassIdentifier());
+    EXPECT_EQ(0, calls);
+
+    EXPECT_EQ("Test", pfo.getDisplayName());
+    EXPECT_TRUE(pfo.hasProcessorInfo());
+    EXPECT_EQ("Testing", pfo.getCategory());
+    EXPECT_EQ(Tags::CPU, pfo.getTags());
+    EXPECT_EQ("org.inviwo.Test", pfo.getProcessorInfo().classIdentifier);
+    EXPECT_EQ(1, calls);
+}
+
+TEST(ProcessorFactoryObject, CompositeIsReadOnFirstUse) {
+    const auto file = filesystem::getInviwoUserSettingsPath() + "/deferred-composite.inv";
+    std::remove(file.c_str());
+
+    // The file is only read when the info is needed, hence it does not have to exist yet.
+    CompositeProcessorFactoryObject pfo{file};
+    EXPECT_FALSE(pfo.hasProcessorInfo());
+    EXPECT_EQ(0, pfo.getClassIdentifier().rfind("org.inviwo.CompositeProcessor", 0));
+
+    {
+        Serializer s{file};
+        s.serialize("DisplayName", std::string{"Deferred Composite"});
+        s.serialize("Tags", std::string{"CPU"});
+        s.writeFile();
+    }
+
+    EXPECT_EQ("Deferred Composite", pfo.getDisplayName());
+    EXPECT_EQ("Composites", pfo.getCategory());
+    EXPECT_EQ(Tags::CPU, pfo.getTags());
+    EXPECT_EQ(pfo.getClassIdentifier(), pfo.getProcessorInfo().classIdentifier);
+
+    std::remove(file.c_str());
+}
+
+}  // namespace inviwo
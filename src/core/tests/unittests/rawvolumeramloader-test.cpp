@@ -0,0 +1,129 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/io/rawvolumeramloader.h>
+#include <inviwo/core/io/rawvolumereader.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+struct RawFile {
+    template <typename T>
+    RawFile(const std::vector<T>& data, size_t offset)
+        : path{(std::filesystem::temp_directory_path() / "rawvolumeramloader-test.raw").string()} {
+        auto out = filesystem::ofstream(path, std::ios::out | std::ios::binary);
+        const std::vector<char> header(offset, 'x');
+        out.write(header.data(), header.size());
+        out.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(T));
+    }
+    ~RawFile() { std::remove(path.c_str()); }
+    std::string path;
+};
+
+template <typename T>
+std::vector<T> load(const std::string& path, size3_t dims, size_t offset, bool littleEndian,
+                    bool memoryMap) {
+    const VolumeRAMPrecision<T> src(dims);
+    RawVolumeRAMLoader loader(path, offset, littleEndian, memoryMap);
+    auto rep = std::static_pointer_cast<VolumeRAM>(loader.createRepresentation(src));
+    EXPECT_EQ(dims, rep->getDimensions());
+    const auto data = static_cast<const T*>(rep->getData());
+    return std::vector<T>(data, data + glm::compMul(dims));
+}
+
+}  // namespace
+
+TEST(RawVolumeRAMLoader, MappedAndReadAreEqual) {
+    const size3_t dims{7, 5, 3};
+    std::vector<std::uint16_t> data(glm::compMul(dims));
+    std::iota(data.begin(), data.end(), std::uint16_t{1});
+
+    for (size_t offset : {0, 4, 5}) {
+        RawFile file{data, offset};
+        EXPECT_EQ(data, load<std::uint16_t>(file.path, dims, offset, true, true));
+        EXPECT_EQ(data, load<std::uint16_t>(file.path, dims, offset, true, false));
+    }
+}
+
+TEST(RawVolumeRAMLoader, SwapsEachComponent) {
+    const size3_t dims{4, 3, 2};
+    std::vector<glm::u16vec2> data(glm::compMul(dims));
+    std::vector<glm::u16vec2> swapped(data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        const auto x = static_cast<std::uint16_t>(0x0102 + i);
+        const auto y = static_cast<std::uint16_t>(0x0a0b + i);
+        data[i] = glm::u16vec2{x, y};
+        swapped[i] = glm::u16vec2{static_cast<std::uint16_t>((x >> 8) | (x << 8)),
+                                  static_cast<std::uint16_t>((y >> 8) | (y << 8))};
+    }
+
+    RawFile file{swapped, 8};
+    EXPECT_EQ(data, load<glm::u16vec2>(file.path, dims, 8, false, true));
+    EXPECT_EQ(data, load<glm::u16vec2>(file.path, dims, 8, false, false));
+}
+
+TEST(RawVolumeRAMLoader, MappingIsCopyOnWrite) {
+    const size3_t dims{8, 8, 8};
+    std::vector<float> data(glm::compMul(dims), 1.0f);
+    RawFile file{data, 0};
+
+    {
+        const VolumeRAMPrecision<float> src(dims);
+        RawVolumeRAMLoader loader(file.path, 0, true, true);
+        auto rep = std::static_pointer_cast<VolumeRAM>(loader.createRepresentation(src));
+        static_cast<float*>(rep->getData())[0] = 2.0f;
+    }
+    EXPECT_EQ(data, load<float>(file.path, dims, 0, true, true));
+}
+
+TEST(RawVolumeRAMLoader, ReaderMemoryMapIsOptIn) {
+    RawVolumeReader reader;
+    EXPECT_FALSE(std::any_cast<bool>(reader.getOption("MemoryMap")));
+    EXPECT_TRUE(reader.setOption("MemoryMap", true));
+    EXPECT_TRUE(std::any_cast<bool>(reader.getOption("MemoryMap")));
+    std::unique_ptr<RawVolumeReader> copy{reader.clone()};
+    EXPECT_TRUE(std::any_cast<bool>(copy->getOption("MemoryMap")));
+    EXPECT_FALSE(reader.setOption("MemoryMap", 1));
+}
+
+}  // namespace inviwo
@@ -0,0 +1,148 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/threadpool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace inviwo {
+
+TEST(ThreadPool, NoWorkers) {
+    ThreadPool pool(0);
+    EXPECT_EQ(pool.getSize(), size_t{0});
+    auto future = pool.enqueue([](int a, int b) { return a + b; }, 1, 2);
+    EXPECT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(future.get(), 3);
+}
+
+TEST(ThreadPool, Enqueue) {
+    ThreadPool pool(4);
+    std::vector<std::future<size_t>> futures;
+    for (size_t i = 0; i < 1000; ++i) {
+        futures.push_back(pool.enqueue([i]() { return i; }));
+    }
+    size_t sum = 0;
+    for (auto& future : futures) sum += future.get();
+    EXPECT_EQ(sum, size_t{999 * 1000 / 2});
+}
+
+TEST(ThreadPool, Exception) {
+    ThreadPool pool(2);
+    auto future = pool.enqueue([]() -> int { throw std::runtime_error("error"); });
+    EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(ThreadPool, NestedWait) {
+    // A single worker waiting for nested tasks would dead lock without helping.
+    ThreadPool pool(1);
+    std::function<int(int)> fib = [&](int n) -> int {
+        if (n < 2) return n;
+        auto a = pool.enqueue(fib, n - 1);
+        auto b = pool.enqueue(fib, n - 2);
+        pool.wait(a);
+        pool.wait(b);
+        return a.get() + b.get();
+    };
+    EXPECT_EQ(pool.enqueue(fib, 15).get(), 610);
+}
+
+TEST(ThreadPool, Priority) {
+    ThreadPool pool(1);
+
+    std::promise<void> block;
+    auto blocked = block.get_future().share();
+    pool.enqueueRaw([blocked]() { blocked.wait(); });
+
+    std::mutex mutex;
+    std::vector<int> order;
+    const auto record = [&](int i) {
+        std::scoped_lock lock{mutex};
+        order.push_back(i);
+    };
+
+    auto low = pool.enqueue(ThreadPool::Priority::Low, record, 2);
+    auto normal = pool.enqueue(record, 1);
+    auto high = pool.enqueue(ThreadPool::Priority::High, record, 0);
+
+    block.set_value();
+    low.get();
+    normal.get();
+    high.get();
+
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2}));
+}
+
+TEST(ThreadPool, QueueSizeNeverWraps) {
+    ThreadPool pool(4);
+    const size_t nTasks = 20000;
+    std::atomic<bool> done{false};
+    std::atomic<size_t> maxSize{0};
+    std::thread watcher{[&]() {
+        while (!done) maxSize = std::max(maxSize.load(), pool.getQueueSize());
+    }};
+
+    // Tasks pushed from the workers go to their own queues, the others to the shared queue
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i < nTasks / 10; ++i) {
+        futures.push_back(pool.enqueue([&pool]() {
+            for (size_t j = 0; j < 9; ++j) pool.enqueueRaw([]() {});
+        }));
+    }
+    for (auto& future : futures) future.get();
+    while (pool.getQueueSize() != 0) {
+    }
+    done = true;
+    watcher.join();
+
+    EXPECT_LE(maxSize.load(), nTasks);
+}
+
+TEST(ThreadPool, Resize) {
+    ThreadPool pool(2);
+    std::atomic<size_t> count{0};
+    while (pool.trySetSize(6) != 6) {
+    }
+    for (size_t i = 0; i < 1000; ++i) pool.enqueueRaw([&count]() { ++count; });
+    while (pool.trySetSize(0) != 0) {
+    }
+    EXPECT_EQ(count, size_t{1000});
+}
+
+}  // namespace inviwo
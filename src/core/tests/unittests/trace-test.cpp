@@ -0,0 +1,143 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/trace.h>
+#include <inviwo/core/util/stdextensions.h>
+
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+struct TracingEnabled {
+    TracingEnabled() {
+        Tracer::clear();
+        Tracer::setEnabled(true);
+    }
+    ~TracingEnabled() {
+        Tracer::setEnabled(false);
+        Tracer::clear();
+    }
+};
+
+std::vector<Tracer::Event> testEvents() {
+    auto events = Tracer::getEvents();
+    util::erase_remove_if(events,
+                          [](auto& e) { return std::string_view{e.category} != "test"; });
+    return events;
+}
+
+}  // namespace
+
+TEST(Tracer, RecordsOnlyWhenEnabled) {
+    TracingEnabled tracing;
+    { TraceScope scope{"test", "a"}; }
+    Tracer::setEnabled(false);
+    { TraceScope scope{"test", "b"}; }
+
+    const auto events = testEvents();
+    ASSERT_EQ(1, events.size());
+    EXPECT_EQ("a", events[0].name);
+    EXPECT_GE(events[0].duration.count(), 0);
+}
+
+TEST(Tracer, NameFunctionIsOnlyCalledWhenEnabled) {
+    TracingEnabled tracing;
+    int calls = 0;
+    const auto name = [&]() {
+        ++calls;
+        return std::string(100, 'x');
+    };
+    { TraceScope scope{"test", name}; }
+    Tracer::setEnabled(false);
+    { TraceScope scope{"test", name}; }
+
+    EXPECT_EQ(1, calls);
+    const auto events = testEvents();
+    ASSERT_EQ(1, events.size());
+    EXPECT_EQ(std::string(Tracer::maxNameLength, 'x'), events[0].name);
+}
+
+TEST(Tracer, KeepsTheNewestEvents) {
+    TracingEnabled tracing;
+    const auto now = Tracer::clock::now();
+    for (size_t i = 0; i < Tracer::capacity + 10; ++i) {
+        Tracer::record("test", std::to_string(i), now + std::chrono::microseconds(i), now);
+    }
+    const auto events = testEvents();
+    ASSERT_EQ(Tracer::capacity, events.size());
+    EXPECT_EQ("10", events.front().name);
+    EXPECT_EQ(std::to_string(Tracer::capacity + 9), events.back().name);
+}
+
+TEST(Tracer, RecordsFromSeveralThreads) {
+    TracingEnabled tracing;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 100; ++i) {
+                TraceScope scope{"test", "work"};
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    const auto events = testEvents();
+    EXPECT_EQ(400, events.size());
+    std::set<std::uint32_t> ids;
+    for (auto& event : events) ids.insert(event.thread);
+    EXPECT_EQ(4, ids.size());
+    EXPECT_TRUE(std::is_sorted(events.begin(), events.end(),
+                               [](auto& a, auto& b) { return a.begin < b.begin; }));
+}
+
+TEST(Tracer, ExportsChromeTraceJson) {
+    TracingEnabled tracing;
+    { TraceScope scope{"test", "say \"hi\""}; }
+
+    std::stringstream ss;
+    Tracer::exportChromeTrace(ss);
+    const auto json = ss.str();
+    EXPECT_EQ(0, json.find("{\"traceEvents\":["));
+    const std::string event = R"("name":"say \"hi\"","cat":"test","ph":"X")";
+    EXPECT_NE(std::string::npos, json.find(event));
+}
+
+}  // namespace inviwo
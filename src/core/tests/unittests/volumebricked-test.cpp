@@ -0,0 +1,201 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumebricked.h>
+#include <inviwo/core/datastructures/volume/volumebrickcache.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/rawvolumeramloader.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+class VolumeBrickedTest : public ::testing::Test {
+protected:
+    VolumeBrickedTest()
+        : dims_{37, 21, 13}
+        , data_(glm::compMul(dims_))
+        , file_{(std::filesystem::temp_directory_path() / "volumebricked-test.raw").string()} {
+        std::iota(data_.begin(), data_.end(), 0.0f);
+        auto out = filesystem::ofstream(file_, std::ios::out | std::ios::binary);
+        out.write(reinterpret_cast<const char*>(data_.data()), data_.size() * sizeof(float));
+    }
+    ~VolumeBrickedTest() { std::remove(file_.c_str()); }
+
+    std::shared_ptr<Volume> createVolume() const {
+        auto volume = std::make_shared<Volume>(dims_, DataFloat32::get());
+        auto disk = std::make_shared<VolumeDisk>(file_, dims_, DataFloat32::get());
+        disk->setLoader(new RawVolumeRAMLoader(file_, 0, true));
+        volume->addRepresentation(disk);
+        return volume;
+    }
+
+    float value(const size3_t& pos) const { return data_[util::IndexMapper3D(dims_)(pos)]; }
+
+    size3_t dims_;
+    std::vector<float> data_;
+    std::string file_;
+};
+
+}  // namespace
+
+TEST(VolumeBrickCache, EvictsLeastRecentlyUsed) {
+    VolumeBrickCache cache(3 * 8 * sizeof(float));
+    const auto source = cache.newSourceId();
+    size_t loads = 0;
+    const auto load = [&]() {
+        ++loads;
+        return std::make_shared<VolumeRAMPrecision<float>>(size3_t{2, 2, 2});
+    };
+
+    cache.get(source, 0, load);
+    cache.get(source, 1, load);
+    cache.get(source, 2, load);
+    EXPECT_EQ(3, loads);
+    EXPECT_EQ(3, cache.getNumberOfBricks());
+
+    cache.get(source, 0, load);  // 0 is now the most recently used
+    EXPECT_EQ(3, loads);
+    cache.get(source, 3, load);  // evicts 1
+    EXPECT_EQ(4, loads);
+    EXPECT_EQ(3, cache.getNumberOfBricks());
+    EXPECT_EQ(3 * 8 * sizeof(float), cache.getSize());
+
+    cache.get(source, 0, load);
+    EXPECT_EQ(4, loads);
+    cache.get(source, 1, load);
+    EXPECT_EQ(5, loads);
+
+    cache.erase(source);
+    EXPECT_EQ(0, cache.getNumberOfBricks());
+    EXPECT_EQ(0, cache.getSize());
+}
+
+TEST(VolumeBrickCache, FailedLoadIsNotCached) {
+    VolumeBrickCache cache(1024);
+    const auto source = cache.newSourceId();
+    EXPECT_THROW(cache.get(source, 0,
+                           []() -> std::shared_ptr<VolumeRAM> {
+                               throw Exception("Failed", IVW_CONTEXT_CUSTOM("test"));
+                           }),
+                 Exception);
+    EXPECT_EQ(0, cache.getNumberOfBricks());
+    EXPECT_EQ(nullptr, cache.get(source, 0, []() { return std::shared_ptr<VolumeRAM>{}; }));
+    EXPECT_EQ(0, cache.getNumberOfBricks());
+    EXPECT_NE(nullptr, cache.get(source, 0, []() {
+        return std::make_shared<VolumeRAMPrecision<float>>(size3_t{2, 2, 2});
+    }));
+}
+
+TEST_F(VolumeBrickedTest, Bricks) {
+    auto volume = createVolume();
+    EXPECT_EQ(nullptr, util::getBrickedRepresentation(*volume));  // Small enough to load
+    auto bricked = util::getBrickedRepresentation(*volume, 0);
+    ASSERT_NE(nullptr, bricked);
+    EXPECT_FALSE(volume->hasRepresentation<VolumeRAM>());
+    EXPECT_EQ(dims_, bricked->getDimensions());
+    EXPECT_EQ(size3_t(1), bricked->getNumberOfBricks());
+
+    auto cache = std::make_shared<VolumeBrickCache>(size_t{1} << 20);
+    const VolumeBricked small{std::make_shared<RawVolumeRAMLoader>(file_, 0, true), *bricked,
+                              size3_t{8, 8, 8}, cache};
+    EXPECT_EQ(size3_t(5, 3, 2), small.getNumberOfBricks());
+
+    const auto last = small.getBrick(size3_t{4, 2, 1});
+    EXPECT_EQ(size3_t(5, 5, 5), last->getDimensions());
+    EXPECT_EQ(value(size3_t{32, 16, 8}), last->getAsDouble(size3_t{0}));
+    EXPECT_EQ(1, cache->getNumberOfBricks());
+
+    EXPECT_EQ(value(size3_t{17, 9, 3}), small.getAsDouble(size3_t{17, 9, 3}));
+    EXPECT_EQ(2, cache->getNumberOfBricks());
+
+    // Repeated lookups of the same brick give the same data, also after it left the cache
+    const auto brick = small.getBrick(size3_t{2, 1, 0});
+    EXPECT_EQ(brick, small.getBrick(size3_t{2, 1, 0}));
+    cache->clear();
+    EXPECT_EQ(value(size3_t{18, 10, 4}), small.getAsDouble(size3_t{18, 10, 4}));
+    EXPECT_EQ(value(size3_t{32, 16, 8}), small.getAsDouble(size3_t{32, 16, 8}));
+    EXPECT_EQ(1, cache->getNumberOfBricks());
+}
+
+TEST_F(VolumeBrickedTest, Region) {
+    auto volume = createVolume();
+    auto cache = std::make_shared<VolumeBrickCache>(size_t{1} << 20);
+    const VolumeBricked bricked{std::make_shared<RawVolumeRAMLoader>(file_, 0, true),
+                                *volume->getRepresentation<VolumeDisk>(), size3_t{8, 8, 8}, cache};
+
+    const size3_t offset{5, 7, 3};
+    const size3_t extent{12, 2, 6};
+    const auto region = bricked.getRegion(offset, extent);
+    ASSERT_EQ(extent, region->getDimensions());
+    // Only the bricks overlapping the region are loaded
+    EXPECT_EQ(3 * 2 * 2, cache->getNumberOfBricks());
+
+    size3_t pos;
+    for (pos.z = 0; pos.z < extent.z; ++pos.z) {
+        for (pos.y = 0; pos.y < extent.y; ++pos.y) {
+            for (pos.x = 0; pos.x < extent.x; ++pos.x) {
+                EXPECT_EQ(value(offset + pos), region->getAsDouble(pos));
+            }
+        }
+    }
+
+    size_t count = 0;
+    util::forEachVoxel<float>(bricked, offset, extent, [&](const size3_t& p, const float& v) {
+        EXPECT_EQ(value(p), v);
+        ++count;
+    });
+    EXPECT_EQ(glm::compMul(extent), count);
+}
+
+TEST_F(VolumeBrickedTest, ConvertToRAM) {
+    auto volume = createVolume();
+    ASSERT_NE(nullptr, util::getBrickedRepresentation(*volume, 0));
+
+    const auto ram = volume->getRepresentation<VolumeRAM>();
+    const auto data = static_cast<const float*>(ram->getData());
+    EXPECT_EQ(data_, std::vector<float>(data, data + data_.size()));
+    EXPECT_EQ(nullptr, util::getBrickedRepresentation(*volume, 0));
+}
+
+}  // namespace inviwo
@@ -0,0 +1,136 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/volumesampler.h>
+
+#include <random>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+// Trilinear interpolation of the voxels read through the generic VolumeRAM interface
+dvec3 referenceSample(const VolumeRAM& ram, const dvec3& pos) {
+    const size3_t last = ram.getDimensions() - size3_t(1);
+    const dvec3 samplePos = pos * dvec3(last);
+    const size3_t indexPos{samplePos};
+    dvec3 samples[8];
+    for (size_t i = 0; i < 8; ++i) {
+        const size3_t corner{indexPos.x + (i & 1), indexPos.y + ((i >> 1) & 1),
+                             indexPos.z + ((i >> 2) & 1)};
+        samples[i] = ram.getAsDVec3(glm::min(corner, last));
+    }
+    return Interpolation<dvec3>::trilinear(samples, samplePos - dvec3(indexPos));
+}
+
+template <typename T>
+std::shared_ptr<Volume> randomVolume(const size3_t& dims) {
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int> dist(0, 100);
+    auto ram = std::make_shared<VolumeRAMPrecision<T>>(dims);
+    auto data = ram->getDataTyped();
+    for (size_t i = 0; i < glm::compMul(dims); ++i) {
+        for (size_t c = 0; c < util::flat_extent<T>::value; ++c) {
+            util::glmcomp(data[i], c) = static_cast<typename util::value_type<T>::type>(dist(gen));
+        }
+    }
+    auto volume = std::make_shared<Volume>(ram);
+    volume->setModelMatrix(mat4{vec4{2, 0, 0, 0}, vec4{0, 3, 0, 0}, vec4{0, 0, 4, 0},
+                                vec4{-1, -1, -1, 1}});
+    return volume;
+}
+
+std::vector<dvec3> randomPositions(size_t size) {
+    std::mt19937 gen(1);
+    // Include some positions outside of the volume
+    std::uniform_real_distribution<double> dist(-0.1, 1.1);
+    std::vector<dvec3> positions(size);
+    for (auto& p : positions) p = dvec3{dist(gen), dist(gen), dist(gen)};
+    positions.push_back(dvec3{0.0});
+    positions.push_back(dvec3{1.0});
+    return positions;
+}
+
+template <typename T>
+void testSampler() {
+    const auto volume = randomVolume<T>(size3_t{7, 5, 4});
+    const auto ram = volume->getRepresentation<VolumeRAM>();
+    const auto positions = randomPositions(500);
+
+    VolumeDoubleSampler<3> sampler(volume);
+    std::vector<dvec3> batch(positions.size());
+    sampler.sampleBatch(positions, batch);
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const auto& p = positions[i];
+        const bool inside = glm::all(glm::greaterThanEqual(p, dvec3{0.0})) &&
+                            glm::all(glm::lessThanEqual(p, dvec3{1.0}));
+        const auto expected = inside ? referenceSample(*ram, p) : dvec3{0.0};
+        EXPECT_EQ(sampler.sample(p), expected);
+        EXPECT_EQ(batch[i], expected);
+    }
+}
+
+}  // namespace
+
+TEST(VolumeSampler, Float) { testSampler<float>(); }
+TEST(VolumeSampler, UInt8Vec3) { testSampler<glm::u8vec3>(); }
+TEST(VolumeSampler, Int16Vec4) { testSampler<glm::i16vec4>(); }
+
+TEST(VolumeSampler, BatchInModelSpace) {
+    const auto volume = randomVolume<vec3>(size3_t{9, 6, 5});
+    const auto positions = randomPositions(1000);
+    std::vector<dvec3> model(positions.size());
+    const dmat4 dataToModel{volume->getCoordinateTransformer().getDataToModelMatrix()};
+    for (size_t i = 0; i < positions.size(); ++i) {
+        model[i] = dvec3{dataToModel * dvec4{positions[i], 1.0}};
+    }
+
+    VolumeDoubleSampler<3> modelSampler(volume, CoordinateSpace::Model);
+    VolumeDoubleSampler<3> dataSampler(volume);
+    std::vector<dvec3> batch(positions.size());
+    std::vector<dvec3> batchSpace(positions.size());
+    modelSampler.sampleBatch(model, batch);
+    dataSampler.sampleBatch(model, batchSpace, CoordinateSpace::Model);
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        EXPECT_EQ(batch[i], modelSampler.sample(model[i]));
+        EXPECT_EQ(batchSpace[i], dataSampler.sample(model[i], CoordinateSpace::Model));
+    }
+}
+
+}  // namespace inviwo
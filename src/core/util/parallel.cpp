@@ -0,0 +1,133 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/parallel.h>
+#include <inviwo/core/util/threadpool.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace inviwo {
+
+namespace util {
+
+ThreadPool* detail::getParallelPool() {
+    return InviwoApplication::isInitialized() ? &InviwoApplication::getPtr()->getThreadPool()
+                                              : nullptr;
+}
+
+size_t detail::getGrainSize(ThreadPool* pool, size_t size, size_t grain) {
+    if (grain > 0) return grain;
+    const size_t threads = (pool ? pool->getSize() : 0) + 1;
+    return std::max(size_t{1}, size / (4 * threads));
+}
+
+namespace {
+
+struct ChunkState {
+    ChunkState(size_t aBegin, size_t aEnd, size_t aGrain, detail::ChunkRef aChunk)
+        : begin{aBegin}, end{aEnd}, grain{aGrain}, nChunks{(end - begin + grain - 1) / grain},
+          chunk{aChunk} {}
+
+    // Claim and run chunks until there are none left. Chunks are only run if claimed, so a
+    // task that is started after all chunks are done will never touch the chunk functor.
+    void work() {
+        for (size_t i = next++; i < nChunks; i = next++) {
+            if (!failed) {
+                try {
+                    const size_t chunkBegin = begin + i * grain;
+                    chunk(chunkBegin, std::min(end, chunkBegin + grain));
+                } catch (...) {
+                    std::scoped_lock lock{mutex};
+                    if (!error) error = std::current_exception();
+                    failed = true;
+                }
+            }
+            if (++done == nChunks) {
+                { std::scoped_lock lock{mutex}; }
+                condition.notify_all();
+            }
+        }
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock{mutex};
+        condition.wait(lock, [this]() { return done == nChunks; });
+    }
+
+    const size_t begin;
+    const size_t end;
+    const size_t grain;
+    const size_t nChunks;
+    const detail::ChunkRef chunk;
+
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable condition;
+};
+
+}  // namespace
+
+void detail::parallelChunks(ThreadPool* pool, size_t begin, size_t end, size_t grain,
+                            ChunkRef chunk) {
+    if (end <= begin) return;
+
+    grain = getGrainSize(pool, end - begin, grain);
+    const size_t nChunks = (end - begin + grain - 1) / grain;
+    const size_t nHelpers = pool ? std::min(pool->getSize(), nChunks - 1) : 0;
+
+    if (nHelpers == 0) {
+        for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grain) {
+            chunk(chunkBegin, std::min(end, chunkBegin + grain));
+        }
+        return;
+    }
+
+    // The state is shared with the helper tasks since they might start after we have returned.
+    auto state = std::make_shared<ChunkState>(begin, end, grain, chunk);
+    for (size_t i = 0; i < nHelpers; ++i) {
+        pool->enqueueRaw([state]() { state->work(); });
+    }
+    state->work();
+    state->wait();
+
+    if (state->error) std::rethrow_exception(state->error);
+}
+
+}  // namespace util
+
+}  // namespace inviwo
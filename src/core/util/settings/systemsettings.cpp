@@ -30,6 +30,8 @@
 #include <inviwo/core/util/settings/systemsettings.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/logstream.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/trace.h>
 
 namespace inviwo {
 
@@ -41,6 +43,8 @@ SystemSettings::SystemSettings(InviwoApplication* app)
                              {"developerMode", "Developer Mode", UsageMode::Development}},
                             1)
     , poolSize_("poolSize", "Pool Size", defaultPoolSize(), 0, 32)
+    , parallelEvaluation_("parallelEvaluation", "Parallel Network Evaluation (experimental)",
+                          false)
     , enablePortInspectors_("enablePortInspectors", "Enable port inspectors", true)
     , portInspectorSize_("portInspectorSize", "Port inspector size", 128, 1, 1024)
 #if __APPLE__
@@ -53,6 +57,7 @@ SystemSettings::SystemSettings(InviwoApplication* app)
     , logStackTraceProperty_("logStackTraceProperty", "Error stack trace log", false)
     , runtimeModuleReloading_("runtimeModuleReloding", "Runtime Module Reloading", false)
     , enableResourceManager_("enableResourceManager", "Enable Resource Manager", false)
+    , memoryBudget_("memoryBudget", "RAM Budget (MB, 0 = unlimited)", 0, 0, 1024 * 1024)
     , breakOnMessage_{"breakOnMessage",
                       "Break on Message",
                       {MessageBreakLevel::Off, MessageBreakLevel::Error, MessageBreakLevel::Warn,
@@ -60,12 +65,15 @@ SystemSettings::SystemSettings(InviwoApplication* app)
                       0}
     , breakOnException_{"breakOnException", "Break on Exception", false}
     , stackTraceInException_{"stackTraceInException", "Create Stack Trace for Exceptions", false}
+    , enableTracing_{"enableTracing", "Record Evaluation Trace", false}
+    , exportTrace_{"exportTrace", "Export Evaluation Trace"}
     , redirectCout_{"redirectCout", "Redirect cout to LogCentral", false}
     , redirectCerr_{"redirectCerr", "Redirect cerr to LogCentral", false} {
 
     addProperty(workspaceAuthor_);
     addProperty(applicationUsageMode_);
     addProperty(poolSize_);
+    addProperty(parallelEvaluation_);
     addProperty(enablePortInspectors_);
     addProperty(portInspectorSize_);
     addProperty(enableTouchProperty_);
@@ -74,9 +82,12 @@ SystemSettings::SystemSettings(InviwoApplication* app)
     addProperty(logStackTraceProperty_);
     addProperty(runtimeModuleReloading_);
     addProperty(enableResourceManager_);
+    addProperty(memoryBudget_);
     addProperty(breakOnMessage_);
     addProperty(breakOnException_);
     addProperty(stackTraceInException_);
+    addProperty(enableTracing_);
+    addProperty(exportTrace_);
     addProperty(redirectCout_);
     addProperty(redirectCerr_);
 
@@ -88,6 +99,17 @@ SystemSettings::SystemSettings(InviwoApplication* app)
         LogInfo("Inviwo needs to be restarted for Runtime Module Reloading change to take effect");
     });
 
+    enableTracing_.onChange([this]() { Tracer::setEnabled(enableTracing_); });
+    exportTrace_.onChange([]() {
+        const auto file = filesystem::getInviwoUserSettingsPath() + "/evaluation-trace.json";
+        try {
+            Tracer::exportChromeTrace(file);
+            LogInfo("Evaluation trace written to " << file);
+        } catch (const Exception& e) {
+            LogError(e.getMessage());
+        }
+    });
+
     breakOnMessage_.onChange(
         [this]() { LogCentral::getPtr()->setMessageBreakLevel(breakOnMessage_.get()); });
 
@@ -46,8 +46,9 @@ SystemCapabilities::SystemCapabilities() {
 #ifdef IVW_USE_SIGAR
     sigar_open(&sigar_);
 #endif
+    // The dynamic info, in particular the disk enumeration, can be slow to look up. It is only
+    // retrieved when requested, see printInfo.
     retrieveStaticInfo();
-    retrieveDynamicInfo();
 }
 
 SystemCapabilities::~SystemCapabilities() {
@@ -58,11 +59,11 @@ SystemCapabilities::~SystemCapabilities() {
 
 void SystemCapabilities::retrieveStaticInfo() {
     successOSInfo_ = lookupOSInfo();
+    successCPUInfo_ = lookupCPUInfo();
     buildInfo_ = util::getBuildInfo();
 }
 
 void SystemCapabilities::retrieveDynamicInfo() {
-    successCPUInfo_ = lookupCPUInfo();
     successMemoryInfo_ = lookupMemoryInfo();
     successDiskInfo_ = lookupDiskInfo();
     successProcessMemoryInfo_ = lookupProcessMemoryInfo();
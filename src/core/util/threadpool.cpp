@@ -37,15 +37,28 @@ namespace inviwo {
 // the constructor just launches some amount of workers
 ThreadPool::ThreadPool(size_t threads, std::function<void()> onThreadStart,
                        std::function<void()> onThreadStop)
-    : onThreadStart_{std::move(onThreadStart)}, onThreadStop_{std::move(onThreadStop)} {
-    while (workers.size() < threads) {
-        workers.push_back(std::make_unique<Worker>(*this));
-    }
+    : workers{}
+    , workers_mutex{}
+    , nWorkers{0}
+    , tasks{}
+    , queue_mutex{}
+    , count{0}
+    , queued{0}
+    , sleep_mutex{}
+    , condition{}
+    , sleeping{0}
+    , onThreadStart_{std::move(onThreadStart)}
+    , onThreadStop_{std::move(onThreadStop)} {
+    trySetSize(threads);
 }
 
 size_t ThreadPool::trySetSize(size_t size) {
-    while (workers.size() < size) {
-        workers.push_back(std::make_unique<Worker>(*this));
+    if (workers.size() < size) {
+        std::unique_lock<std::shared_mutex> lock(workers_mutex);
+        while (workers.size() < size) {
+            workers.push_back(std::make_unique<Worker>(*this));
+        }
+        nWorkers = workers.size();
     }
 
     if (workers.size() > size) {
@@ -60,51 +73,77 @@ size_t ThreadPool::trySetSize(size_t size) {
             if (active <= size) break;
         }
 
+        { std::unique_lock<std::mutex> lock(sleep_mutex); }
         condition.notify_all();
 
-        util::erase_remove_if(
-            workers, [](std::unique_ptr<Worker>& worker) { return worker->state == State::Done; });
+        // Join the finished workers outside of the lock, they might be waiting for it.
+        std::vector<std::unique_ptr<Worker>> done;
+        {
+            std::unique_lock<std::shared_mutex> lock(workers_mutex);
+            for (auto& worker : workers) {
+                if (worker->state == State::Done) done.push_back(std::move(worker));
+            }
+            util::erase_remove(workers, nullptr);
+            nWorkers = workers.size();
+        }
     }
     return workers.size();
 }
 
-size_t ThreadPool::getSize() const { return workers.size(); }
+size_t ThreadPool::getSize() const { return nWorkers; }
 
-size_t ThreadPool::getQueueSize() {
-    std::unique_lock<std::mutex> lock(queue_mutex);
-    return tasks.size();
-}
+size_t ThreadPool::getQueueSize() { return queued; }
 
 ThreadPool::~ThreadPool() {
     for (auto& worker : workers) worker->state = State::Abort;
+    { std::unique_lock<std::mutex> lock(sleep_mutex); }
     condition.notify_all();
-    workers.clear();  // this will join all threads.
+    // Join all threads before destroying any worker, the others might try to steal from it.
+    for (auto& worker : workers) worker->thread.join();
+    workers.clear();
+}
+
+ThreadPool::Worker*& ThreadPool::threadWorker() {
+    thread_local Worker* worker = nullptr;
+    return worker;
+}
+
+ThreadPool::Worker* ThreadPool::currentWorker() const {
+    auto worker = threadWorker();
+    return worker && &worker->pool == this ? worker : nullptr;
 }
 
-ThreadPool::Worker::~Worker() { thread.join(); }
+ThreadPool::Worker::~Worker() {
+    if (thread.joinable()) thread.join();
+}
 
-ThreadPool::Worker::Worker(ThreadPool& pool)
-    : state{State::Free}, thread{[this, &pool]() {
+ThreadPool::Worker::Worker(ThreadPool& aPool)
+    : pool{aPool}, state{State::Free}, queue_mutex{}, tasks{}, count{0}, thread{[this]() {
         pool.onThreadStart_();
-        util::OnScopeExit cleanup{[&pool]() { pool.onThreadStop_(); }};
+        util::OnScopeExit cleanup{[this]() { pool.onThreadStop_(); }};
+        threadWorker() = this;
 
         for (;;) {
-            std::function<void()> task;
-            state = State::Free;
-            {
-                std::unique_lock<std::mutex> lock(pool.queue_mutex);
-                pool.condition.wait(lock, [this, &pool] {
-                    return state == State::Abort || state == State::Stop || !pool.tasks.empty();
-                });
-                if (state == State::Abort || (state == State::Stop && pool.tasks.empty())) break;
-                task = std::move(pool.tasks.front());
-                pool.tasks.pop();
-            }
-            state = State::Working;
-            try {
-                task();
-            } catch (...) {  // Make sure we don't leak any exceptions.
+            if (auto task = pool.pop(this)) {
+                auto expected = State::Free;
+                state.compare_exchange_strong(expected, State::Working);
+                try {
+                    task();
+                } catch (...) {  // Make sure we don't leak any exceptions.
+                }
+                expected = State::Working;
+                state.compare_exchange_strong(expected, State::Free);
+                if (state == State::Abort) break;
+                continue;
             }
+
+            std::unique_lock<std::mutex> lock(pool.sleep_mutex);
+            ++pool.sleeping;
+            pool.condition.wait(lock, [this] {
+                return state == State::Abort || state == State::Stop || pool.queued > 0;
+            });
+            --pool.sleeping;
+            if (state == State::Abort || (state == State::Stop && pool.queued == 0)) break;
         }
         state = State::Done;
     }} {
@@ -112,14 +151,92 @@ ThreadPool::Worker::Worker(ThreadPool& pool)
     util::setThreadDescription(thread, "Inviwo Worker Thread");
 }
 
-void ThreadPool::enqueueRaw(std::function<void()> task) {
-    if (workers.empty()) {
-        task();  // No worker threads, just run the task.
+void ThreadPool::push(detail::Task task, Priority priority) {
+    const auto index = static_cast<size_t>(priority);
+    // The counts are incremented while the queue is locked, i.e. before any worker can take the
+    // task and decrement them.
+    if (auto worker = currentWorker()) {
+        std::unique_lock<std::mutex> lock(worker->queue_mutex);
+        worker->tasks[index].push_back(std::move(task));
+        ++worker->count;
+        ++queued;
     } else {
         std::unique_lock<std::mutex> lock(queue_mutex);
-        tasks.emplace(std::move(task));
+        tasks[index].push_back(std::move(task));
+        ++count;
+        ++queued;
+    }
+    // Only take the sleep lock if there might be someone waiting for it. Since both queued and
+    // sleeping are sequentially consistent a worker going to sleep will always either see the
+    // new task or be notified.
+    if (sleeping > 0) {
+        { std::unique_lock<std::mutex> lock(sleep_mutex); }
+        condition.notify_one();
+    }
+}
+
+detail::Task ThreadPool::pop(Worker* worker) {
+    if (queued == 0) return {};
+
+    const auto take = [&](std::deque<detail::Task>& queue, std::atomic<size_t>& count,
+                          bool back) {
+        detail::Task task;
+        if (!queue.empty()) {
+            if (back) {
+                task = std::move(queue.back());
+                queue.pop_back();
+            } else {
+                task = std::move(queue.front());
+                queue.pop_front();
+            }
+            --count;
+            --queued;
+        }
+        return task;
+    };
+
+    // The counts are checked before locking to avoid taking locks of empty queues.
+    for (size_t i = 0; i < nPriorities; ++i) {
+        // Newest task from our own queue, it is likely to be hot in the cache.
+        if (worker && worker->count > 0) {
+            std::unique_lock<std::mutex> lock(worker->queue_mutex);
+            if (auto task = take(worker->tasks[i], worker->count, true)) return task;
+        }
+        // Oldest task from the shared queue
+        if (count > 0) {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            if (auto task = take(tasks[i], count, false)) return task;
+        }
+        // Steal the oldest task from any other worker
+        {
+            std::shared_lock<std::shared_mutex> workersLock(workers_mutex);
+            for (auto& other : workers) {
+                if (other.get() == worker || other->count == 0) continue;
+                std::unique_lock<std::mutex> lock(other->queue_mutex);
+                if (auto task = take(other->tasks[i], other->count, false)) return task;
+            }
+        }
+    }
+    return {};
+}
+
+bool ThreadPool::runPendingTask() {
+    if (auto task = pop(currentWorker())) {
+        try {
+            task();
+        } catch (...) {  // Make sure we don't leak any exceptions.
+        }
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::enqueueRaw(std::function<void()> task, Priority priority) {
+    if (nWorkers == 0) {
+        task();  // No worker threads, just run the task.
+    } else {
+        push(detail::Task{std::move(task)}, priority);
     }
-    condition.notify_one();
 }
 
 }  // namespace inviwo
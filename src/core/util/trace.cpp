@@ -0,0 +1,267 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/trace.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/stdextensions.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <iomanip>
+#include <ostream>
+
+namespace inviwo {
+
+namespace {
+
+/**
+ * A slot in a ring buffer, guarded by a sequence lock. The sequence is odd while the owning thread
+ * writes the slot. Readers skip slots that are being written or were overwritten while read.
+ */
+struct Slot {
+    std::atomic<std::uint64_t> seq{0};
+    const char* category = nullptr;
+    std::int64_t begin = 0;
+    std::int64_t duration = 0;
+    std::uint32_t length = 0;
+    std::array<char, Tracer::maxNameLength> name{};
+};
+
+struct ThreadBuffer {
+    explicit ThreadBuffer(std::uint32_t id) : id{id}, slots(Tracer::capacity) {}
+
+    // Only called by the owning thread
+    void push(const char* category, std::string_view name, std::int64_t begin,
+              std::int64_t duration) {
+        const auto index = head.load(std::memory_order_relaxed);
+        auto& slot = slots[index % Tracer::capacity];
+        slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.category = category;
+        slot.begin = begin;
+        slot.duration = duration;
+        slot.length = static_cast<std::uint32_t>(std::min(name.size(), slot.name.size()));
+        std::copy_n(name.data(), slot.length, slot.name.data());
+
+        slot.seq.store(2 * index + 2, std::memory_order_release);
+        head.store(index + 1, std::memory_order_release);
+    }
+
+    void read(std::int64_t after, std::vector<Tracer::Event>& events) const {
+        const auto end = head.load(std::memory_order_acquire);
+        const auto start = end > Tracer::capacity ? end - Tracer::capacity : 0;
+        for (auto index = start; index < end; ++index) {
+            const auto& slot = slots[index % Tracer::capacity];
+            const auto seq = slot.seq.load(std::memory_order_acquire);
+            if (seq != 2 * index + 2) continue;
+
+            const auto category = slot.category;
+            const auto begin = slot.begin;
+            const auto duration = slot.duration;
+            const auto length = std::min<size_t>(slot.length, slot.name.size());
+            std::string name(slot.name.data(), length);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != seq || begin < after) continue;
+
+            events.push_back({category, std::move(name), std::chrono::nanoseconds{begin},
+                              std::chrono::nanoseconds{duration}, id});
+        }
+    }
+
+    const std::uint32_t id;
+    std::atomic<std::uint64_t> head{0};
+    std::atomic<bool> alive{true};
+    std::vector<Slot> slots;
+};
+
+struct Registry {
+    std::atomic<bool> enabled{false};
+    std::atomic<std::int64_t> clearedAt{0};
+    const Tracer::clock::time_point epoch = Tracer::clock::now();
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::uint32_t nextId = 0;
+};
+
+Registry& registry() {
+    static Registry registry;
+    return registry;
+}
+
+ThreadBuffer& localBuffer() {
+    struct Holder {
+        ~Holder() {
+            if (buffer) buffer->alive = false;
+        }
+        std::shared_ptr<ThreadBuffer> buffer;
+    };
+    thread_local Holder holder;
+
+    if (!holder.buffer) {
+        auto& reg = registry();
+        std::scoped_lock lock{reg.mutex};
+        holder.buffer = std::make_shared<ThreadBuffer>(reg.nextId++);
+        reg.buffers.push_back(holder.buffer);
+    }
+    return *holder.buffer;
+}
+
+std::int64_t sinceEpoch(Tracer::clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time - registry().epoch).count();
+}
+
+void writeJsonString(std::ostream& os, std::string_view str) {
+    os << '"';
+    for (const char c : str) {
+        switch (c) {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            case '\n':
+                os << "\\n";
+                break;
+            case '\t':
+                os << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buff[8];
+                    std::snprintf(buff, sizeof(buff), "\\u%04x", static_cast<unsigned>(c));
+                    os << buff;
+                } else {
+                    os << c;
+                }
+        }
+    }
+    os << '"';
+}
+
+}  // namespace
+
+void Tracer::setEnabled(bool enabled) { registry().enabled = enabled; }
+
+bool Tracer::isEnabled() { return registry().enabled.load(std::memory_order_relaxed); }
+
+void Tracer::record(const char* category, std::string_view name, clock::time_point begin,
+                    clock::time_point end) {
+    if (!isEnabled()) return;
+    localBuffer().push(category, name, sinceEpoch(begin),
+                       std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+}
+
+std::vector<Tracer::Event> Tracer::getEvents() {
+    auto& reg = registry();
+    const auto after = reg.clearedAt.load();
+
+    std::vector<Event> events;
+    {
+        std::scoped_lock lock{reg.mutex};
+        for (auto& buffer : reg.buffers) buffer->read(after, events);
+    }
+    std::stable_sort(events.begin(), events.end(),
+                     [](const Event& a, const Event& b) { return a.begin < b.begin; });
+    return events;
+}
+
+void Tracer::clear() {
+    auto& reg = registry();
+    reg.clearedAt = sinceEpoch(clock::now());
+
+    // Buffers of threads that have finished will not get any new events
+    std::scoped_lock lock{reg.mutex};
+    util::erase_remove_if(reg.buffers, [](auto& buffer) { return !buffer->alive; });
+}
+
+void Tracer::exportChromeTrace(std::ostream& os) {
+    const auto events = getEvents();
+    const auto toMicroseconds = [](std::chrono::nanoseconds time) {
+        return std::chrono::duration<double, std::micro>(time).count();
+    };
+
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto& event : events) {
+        os << (first ? "\n" : ",\n") << "{\"name\":";
+        writeJsonString(os, event.name);
+        os << ",\"cat\":";
+        writeJsonString(os, event.category ? event.category : "");
+        os << ",\"ph\":\"X\",\"ts\":" << toMicroseconds(event.begin)
+           << ",\"dur\":" << toMicroseconds(event.duration) << ",\"pid\":1,\"tid\":" << event.thread
+           << "}";
+        first = false;
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void Tracer::exportChromeTrace(const std::string& filename) {
+    auto file = filesystem::ofstream(filename);
+    if (!file) {
+        throw FileException("Could not open file \"" + filename + "\" for writing",
+                            IVW_CONTEXT_CUSTOM("Tracer"));
+    }
+    exportChromeTrace(file);
+}
+
+TraceScope::TraceScope(const char* category, std::string_view name)
+    : category_{nullptr}, length_{0} {
+    if (Tracer::isEnabled()) start(category, name);
+}
+
+TraceScope::~TraceScope() {
+    if (category_) {
+        Tracer::record(category_, std::string_view{name_.data(), length_}, begin_,
+                       Tracer::clock::now());
+    }
+}
+
+void TraceScope::start(const char* category, std::string_view name) {
+    category_ = category;
+    length_ = std::min(name.size(), name_.size());
+    std::copy_n(name.data(), length_, name_.data());
+    begin_ = Tracer::clock::now();
+}
+
+}  // namespace inviwo